@@ -0,0 +1,279 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Workloads.h"
+
+//==============================================================================
+/*  Runs each workload through a NullAudioIODevice at each combination of
+    buffer size and sample rate, and reports how long the callbacks took.
+
+    Run the app with --headless to use this instead of the GUI. See printUsage()
+    for the other options.
+*/
+class HeadlessPerformanceTest
+{
+public:
+    //==============================================================================
+    struct Settings
+    {
+        StringArray workloads = getWorkloadNames();
+        Array<int> bufferSizes { 64, 256, 1024 };
+        Array<double> sampleRates { 48000.0, 96000.0 };
+        double secondsPerRun = 2.0;
+        int numGraphRenderThreads = 0;
+        NullAudioIODevice::Timing timing = NullAudioIODevice::Timing::realTime;
+        File outputFile;
+    };
+
+    static void printUsage (const String& executableName)
+    {
+        std::cout << executableName << " --headless [options]" << std::endl
+                  << std::endl
+                  << "  --workloads=a,b,...      Any of: " << getWorkloadNames().joinIntoString (",") << " (default: all)" << std::endl
+                  << "  --buffer-sizes=a,b,...   Buffer sizes in samples (default: 64,256,1024)" << std::endl
+                  << "  --sample-rates=a,b,...   Sample rates in Hz (default: 48000,96000)" << std::endl
+                  << "  --duration=seconds       Length of each run (default: 2)" << std::endl
+                  << "  --graph-threads=n        Worker threads for the graph workload (default: 0)" << std::endl
+                  << "  --free-running           Run the callbacks back-to-back instead of once per buffer period" << std::endl
+                  << "  --output=file.json       Write the results to a file instead of stdout" << std::endl;
+    }
+
+    static Settings parseSettings (const ArgumentList& args)
+    {
+        Settings settings;
+
+        if (args.containsOption ("--workloads"))
+            settings.workloads = StringArray::fromTokens (args.getValueForOption ("--workloads"), ",", {});
+
+        if (args.containsOption ("--buffer-sizes"))
+        {
+            settings.bufferSizes.clear();
+
+            for (const auto& size : StringArray::fromTokens (args.getValueForOption ("--buffer-sizes"), ",", {}))
+                settings.bufferSizes.add (size.getIntValue());
+        }
+
+        if (args.containsOption ("--sample-rates"))
+        {
+            settings.sampleRates.clear();
+
+            for (const auto& rate : StringArray::fromTokens (args.getValueForOption ("--sample-rates"), ",", {}))
+                settings.sampleRates.add (rate.getDoubleValue());
+        }
+
+        if (args.containsOption ("--duration"))
+            settings.secondsPerRun = args.getValueForOption ("--duration").getDoubleValue();
+
+        if (args.containsOption ("--graph-threads"))
+            settings.numGraphRenderThreads = args.getValueForOption ("--graph-threads").getIntValue();
+
+        if (args.containsOption ("--free-running"))
+            settings.timing = NullAudioIODevice::Timing::asFastAsPossible;
+
+        if (args.containsOption ("--output"))
+            settings.outputFile = args.getFileForOption ("--output");
+
+        return settings;
+    }
+
+    //==============================================================================
+    /*  Runs all of the tests, and returns the process's exit code. */
+    static int run (const Settings& settings)
+    {
+        for (const auto& workloadName : settings.workloads)
+        {
+            if (! getWorkloadNames().contains (workloadName))
+            {
+                std::cerr << "Unknown workload: " << workloadName << std::endl;
+                return 1;
+            }
+        }
+
+        if (settings.secondsPerRun <= 0.0)
+        {
+            std::cerr << "The duration must be greater than zero" << std::endl;
+            return 1;
+        }
+
+        Array<var> runs;
+
+        for (const auto& workloadName : settings.workloads)
+        {
+            for (auto sampleRate : settings.sampleRates)
+            {
+                for (auto bufferSize : settings.bufferSizes)
+                {
+                    auto result = runWorkload (settings, workloadName, sampleRate, bufferSize);
+
+                    if (result.isVoid())
+                        return 1;
+
+                    runs.add (result);
+                }
+            }
+        }
+
+        DynamicObject::Ptr machine (new DynamicObject());
+        machine->setProperty ("os", SystemStats::getOperatingSystemName());
+        machine->setProperty ("cpuModel", SystemStats::getCpuModel());
+        machine->setProperty ("numCpus", SystemStats::getNumCpus());
+        machine->setProperty ("numPhysicalCpus", SystemStats::getNumPhysicalCpus());
+
+        DynamicObject::Ptr root (new DynamicObject());
+        root->setProperty ("juceVersion", SystemStats::getJUCEVersion());
+        root->setProperty ("time", Time::getCurrentTime().toISO8601 (true));
+        root->setProperty ("timing", settings.timing == NullAudioIODevice::Timing::realTime ? "realtime" : "freeRunning");
+        root->setProperty ("histogramBinWidthPercent", histogramBinWidthPercent);
+        root->setProperty ("machine", machine.get());
+        root->setProperty ("runs", runs);
+
+        const auto json = JSON::toString (root.get());
+
+        if (settings.outputFile == File())
+        {
+            std::cout << json << std::endl;
+            return 0;
+        }
+
+        if (! settings.outputFile.replaceWithText (json))
+        {
+            std::cerr << "Couldn't write to " << settings.outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+private:
+    //==============================================================================
+    static constexpr int histogramBinWidthPercent = 5, numHistogramBins = 40;
+
+    static var runWorkload (const Settings& settings, const String& workloadName, double sampleRate, int bufferSize)
+    {
+        const auto label = workloadName + " @ " + String (bufferSize) + " samples, " + String (sampleRate) + " Hz";
+
+        auto workload = createWorkload (workloadName, settings.numGraphRenderThreads);
+        AudioProcessorPlayer player;
+        player.setProcessor (workload.get());
+
+        NullAudioIODevice device ("Headless", settings.timing);
+        const auto error = device.open (3, 3, sampleRate, bufferSize);
+
+        if (error.isNotEmpty())
+        {
+            std::cerr << label << ": " << error << std::endl;
+            return {};
+        }
+
+        device.start (&player);
+
+        // Wait for anything that loads in the background, then give the caches and
+        // the CPU's clock a moment to settle before recording
+        for (int i = 0; i < 1000 && ! workload->isReady(); ++i)
+            Thread::sleep (10);
+
+        Thread::sleep (500);
+
+        const auto periodMs = 1000.0 * bufferSize / sampleRate;
+        const auto numCallbacks = jmax (1, roundToInt (settings.secondsPerRun * 1000.0 / periodMs));
+        const auto completed = device.recordCallbackTimings (numCallbacks, roundToInt (settings.secondsPerRun * 1000.0) * 10 + 5000);
+
+        // Not every platform reports a scheduling policy, so this only checks that the
+        // device's thread was started as a realtime thread
+        const auto isRealtimeThread = device.getRealtimeThreadStatus().has_value();
+
+        device.stop();
+        player.setProcessor (nullptr);
+
+        const auto timings = device.getRecordedCallbackTimings();
+
+        if (! completed || timings.empty())
+            std::cerr << label << ": only " << (int) timings.size() << " of " << numCallbacks << " callbacks ran" << std::endl;
+
+        if (timings.empty())
+            return {};
+
+        std::vector<double> durations;
+        std::vector<int> histogram ((size_t) numHistogramBins + 1, 0);
+        int numMisses = 0;
+        double maxLateness = 0.0;
+
+        for (const auto& t : timings)
+        {
+            durations.push_back (t.durationMs);
+            numMisses += t.missedDeadline ? 1 : 0;
+            maxLateness = jmax (maxLateness, t.latenessMs);
+
+            const auto bin = (size_t) jmin (numHistogramBins, (int) (100.0 * t.durationMs / periodMs / histogramBinWidthPercent));
+            ++histogram[bin];
+        }
+
+        std::sort (durations.begin(), durations.end());
+
+        const auto percentile = [&durations] (double p)
+        {
+            return durations[jmin (durations.size() - 1, (size_t) (p / 100.0 * (double) durations.size()))];
+        };
+
+        const auto mean = std::accumulate (durations.begin(), durations.end(), 0.0) / (double) durations.size();
+        const auto missRate = (double) numMisses / (double) timings.size();
+
+        std::cerr << label << ": mean " << String (100.0 * mean / periodMs, 1) << "%, p99 "
+                  << String (100.0 * percentile (99.0) / periodMs, 1) << "%, max "
+                  << String (100.0 * durations.back() / periodMs, 1) << "% of "
+                  << String (periodMs, 3) << " ms, " << numMisses << " missed deadlines" << std::endl;
+
+        DynamicObject::Ptr durationStats (new DynamicObject());
+        durationStats->setProperty ("mean", mean);
+        durationStats->setProperty ("min", durations.front());
+        durationStats->setProperty ("p50", percentile (50.0));
+        durationStats->setProperty ("p90", percentile (90.0));
+        durationStats->setProperty ("p99", percentile (99.0));
+        durationStats->setProperty ("p99.9", percentile (99.9));
+        durationStats->setProperty ("max", durations.back());
+
+        Array<var> histogramCounts;
+
+        for (auto count : histogram)
+            histogramCounts.add (count);
+
+        DynamicObject::Ptr result (new DynamicObject());
+        result->setProperty ("workload", workloadName);
+        result->setProperty ("bufferSize", bufferSize);
+        result->setProperty ("sampleRate", sampleRate);
+        result->setProperty ("deadlineMs", periodMs);
+        result->setProperty ("numCallbacks", (int) timings.size());
+        result->setProperty ("numDeadlineMisses", numMisses);
+        result->setProperty ("deadlineMissRate", missRate);
+        result->setProperty ("maxWakeUpLatenessMs", maxLateness);
+        result->setProperty ("realtimeThread", isRealtimeThread);
+        result->setProperty ("callbackDurationMs", durationStats.get());
+        result->setProperty ("histogram", histogramCounts);
+        return result.get();
+    }
+};
@@ -25,6 +25,7 @@
 
 #include <JuceHeader.h>
 #include "MainComponent.h"
+#include "HeadlessPerformanceTest.h"
 
 //==============================================================================
 class AudioPerformanceTestApplication final : public JUCEApplication
@@ -40,6 +41,22 @@ public:
     //==============================================================================
     void initialise (const String&) override
     {
+        const ArgumentList args (getApplicationName(), getCommandLineParameterArray());
+
+        if (args.containsOption ("--help|-h"))
+        {
+            HeadlessPerformanceTest::printUsage (getApplicationName());
+            quit();
+            return;
+        }
+
+        if (args.containsOption ("--headless"))
+        {
+            setApplicationReturnValue (HeadlessPerformanceTest::run (HeadlessPerformanceTest::parseSettings (args)));
+            quit();
+            return;
+        }
+
         mainWindow.reset (new MainWindow (getApplicationName()));
     }
 
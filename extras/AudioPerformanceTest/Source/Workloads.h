@@ -0,0 +1,345 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  A stereo processor that does a typical amount of some kind of DSP work, for
+    measuring how long audio callbacks take.
+*/
+class Workload : public AudioProcessor
+{
+public:
+    Workload()
+        : AudioProcessor (BusesProperties().withInput  ("Input",  AudioChannelSet::stereo())
+                                           .withOutput ("Output", AudioChannelSet::stereo()))
+    {}
+
+    /*  Returns false until the processor is ready to run at its normal cost, e.g.
+        because something is still being loaded in the background.
+    */
+    virtual bool isReady() const                                  { return true; }
+
+    //==============================================================================
+    void releaseResources() override                              {}
+    double getTailLengthSeconds() const override                  { return 0.0; }
+    bool acceptsMidi() const override                             { return false; }
+    bool producesMidi() const override                            { return false; }
+    AudioProcessorEditor* createEditor() override                 { return nullptr; }
+    bool hasEditor() const override                               { return false; }
+    int getNumPrograms() override                                 { return 1; }
+    int getCurrentProgram() override                              { return 0; }
+    void setCurrentProgram (int) override                         {}
+    const String getProgramName (int) override                    { return {}; }
+    void changeProgramName (int, const String&) override          {}
+    void getStateInformation (MemoryBlock&) override              {}
+    void setStateInformation (const void*, int) override          {}
+
+    using AudioProcessor::processBlock;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Workload)
+};
+
+//==============================================================================
+/*  Convolves the input with a long, reverb-like impulse response. */
+class ConvolutionWorkload final : public Workload
+{
+public:
+    const String getName() const override   { return "convolution"; }
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override
+    {
+        convolution.prepare ({ sampleRate, (uint32) samplesPerBlock, (uint32) getTotalNumOutputChannels() });
+
+        // Two seconds of exponentially decaying noise
+        const auto length = roundToInt (2.0 * sampleRate);
+        AudioBuffer<float> impulseResponse (2, length);
+        Random random (1);
+
+        for (int ch = 0; ch < impulseResponse.getNumChannels(); ++ch)
+            for (int i = 0; i < length; ++i)
+                impulseResponse.setSample (ch, i, (random.nextFloat() * 2.0f - 1.0f) * std::exp (-6.0f * (float) i / (float) length));
+
+        convolution.loadImpulseResponse (std::move (impulseResponse), sampleRate,
+                                         dsp::Convolution::Stereo::yes,
+                                         dsp::Convolution::Trim::no,
+                                         dsp::Convolution::Normalise::yes);
+    }
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        dsp::AudioBlock<float> block (buffer);
+        convolution.process (dsp::ProcessContextReplacing<float> (block));
+    }
+
+    bool isReady() const override           { return convolution.getCurrentIRSize() > 0; }
+
+private:
+    dsp::Convolution convolution;
+};
+
+//==============================================================================
+/*  Runs a waveshaper at eight times the sample rate. */
+class OversamplingWorkload final : public Workload
+{
+public:
+    const String getName() const override   { return "oversampling"; }
+
+    void prepareToPlay (double, int samplesPerBlock) override
+    {
+        oversampling = std::make_unique<dsp::Oversampling<float>> ((size_t) getTotalNumOutputChannels(), 3,
+                                                                   dsp::Oversampling<float>::filterHalfBandFIREquiripple,
+                                                                   true, false);
+        oversampling->initProcessing ((size_t) samplesPerBlock);
+    }
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        dsp::AudioBlock<float> block (buffer);
+        auto upsampled = oversampling->processSamplesUp (block);
+
+        for (size_t ch = 0; ch < upsampled.getNumChannels(); ++ch)
+        {
+            auto* samples = upsampled.getChannelPointer (ch);
+
+            for (size_t i = 0; i < upsampled.getNumSamples(); ++i)
+                samples[i] = std::tanh (samples[i] * 20.0f);
+        }
+
+        oversampling->processSamplesDown (block);
+    }
+
+private:
+    std::unique_ptr<dsp::Oversampling<float>> oversampling;
+};
+
+//==============================================================================
+/*  Plays a 32-note chord on a polyphonic synth with filtered sawtooth voices. */
+class SynthWorkload final : public Workload
+{
+public:
+    SynthWorkload()
+    {
+        for (int i = 0; i < numVoices; ++i)
+            synth.addVoice (new Voice());
+
+        synth.addSound (new Sound());
+    }
+
+    const String getName() const override   { return "synth"; }
+    bool acceptsMidi() const override       { return true; }
+
+    void prepareToPlay (double sampleRate, int) override
+    {
+        synth.setCurrentPlaybackSampleRate (sampleRate);
+        synth.allNotesOff (0, false);
+        notesStarted = false;
+    }
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) override
+    {
+        // The notes are held forever, so that every voice is busy in every block
+        if (! std::exchange (notesStarted, true))
+            for (int i = 0; i < numVoices; ++i)
+                midi.addEvent (MidiMessage::noteOn (1, 36 + i, 0.5f), 0);
+
+        buffer.clear();
+        synth.renderNextBlock (buffer, midi, 0, buffer.getNumSamples());
+    }
+
+private:
+    struct Sound final : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    struct Voice final : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override { return true; }
+
+        void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int) override
+        {
+            phase = 0.0f;
+            phaseDelta = (float) (MidiMessage::getMidiNoteInHertz (midiNoteNumber) / getSampleRate());
+            level = velocity * 0.05f;
+            filterState[0] = filterState[1] = 0.0f;
+
+            envelope.setSampleRate (getSampleRate());
+            envelope.setParameters ({ 0.01f, 0.1f, 0.8f, 0.5f });
+            envelope.noteOn();
+        }
+
+        void stopNote (float, bool allowTailOff) override
+        {
+            envelope.noteOff();
+
+            if (! allowTailOff)
+            {
+                envelope.reset();
+                clearCurrentNote();
+            }
+        }
+
+        void pitchWheelMoved (int) override      {}
+        void controllerMoved (int, int) override {}
+
+        void renderNextBlock (AudioBuffer<float>& output, int startSample, int numSamples) override
+        {
+            if (! isVoiceActive())
+                return;
+
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                const auto saw = 2.0f * phase - 1.0f;
+                phase += phaseDelta;
+                phase -= std::floor (phase);
+
+                // A pair of one-pole low-pass filters, to give the voice a bit of work to do
+                filterState[0] += 0.2f * (saw - filterState[0]);
+                filterState[1] += 0.2f * (filterState[0] - filterState[1]);
+
+                const auto sample = filterState[1] * level * envelope.getNextSample();
+
+                for (int ch = 0; ch < output.getNumChannels(); ++ch)
+                    output.addSample (ch, i, sample);
+            }
+
+            if (! envelope.isActive())
+                clearCurrentNote();
+        }
+
+        ADSR envelope;
+        float phase = 0.0f, phaseDelta = 0.0f, level = 0.0f;
+        float filterState[2] {};
+    };
+
+    static constexpr int numVoices = 32;
+
+    Synthesiser synth;
+    bool notesStarted = false;
+};
+
+//==============================================================================
+/*  Renders an AudioProcessorGraph of parallel chains of filters. */
+class GraphWorkload final : public Workload
+{
+public:
+    explicit GraphWorkload (int numRenderThreads)
+    {
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+        graph.setNumRenderThreads (numRenderThreads);
+
+        const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode));
+        const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode));
+
+        for (int chain = 0; chain < numChains; ++chain)
+        {
+            auto previous = input;
+
+            for (int i = 0; i < chainLength; ++i)
+            {
+                auto filter = graph.addNode (std::make_unique<FilterProcessor> (200.0 + 400.0 * (chain * chainLength + i)));
+                connectStereo (previous, filter);
+                previous = filter;
+            }
+
+            connectStereo (previous, output);
+        }
+    }
+
+    const String getName() const override   { return "graph"; }
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override
+    {
+        graph.setPlayConfigDetails (getTotalNumInputChannels(), getTotalNumOutputChannels(), sampleRate, samplesPerBlock);
+        graph.prepareToPlay (sampleRate, samplesPerBlock);
+    }
+
+    void releaseResources() override        { graph.releaseResources(); }
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) override
+    {
+        graph.processBlock (buffer, midi);
+    }
+
+private:
+    struct FilterProcessor final : public Workload
+    {
+        explicit FilterProcessor (double frequency) : cutoff (frequency) {}
+
+        const String getName() const override   { return "filter"; }
+
+        void prepareToPlay (double sampleRate, int) override
+        {
+            for (auto& filter : filters)
+            {
+                filter.setCoefficients (IIRCoefficients::makeLowPass (sampleRate, cutoff));
+                filter.reset();
+            }
+        }
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            for (int ch = 0; ch < jmin (buffer.getNumChannels(), (int) std::size (filters)); ++ch)
+                filters[(size_t) ch].processSamples (buffer.getWritePointer (ch), buffer.getNumSamples());
+        }
+
+        const double cutoff;
+        IIRFilter filters[2];
+    };
+
+    void connectStereo (AudioProcessorGraph::Node::Ptr source, AudioProcessorGraph::Node::Ptr destination)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+            graph.addConnection ({ { source->nodeID, ch }, { destination->nodeID, ch } });
+    }
+
+    static constexpr int numChains = 8, chainLength = 4;
+
+    AudioProcessorGraph graph;
+};
+
+//==============================================================================
+/*  Returns the names of the workloads that createWorkload() can make. */
+inline StringArray getWorkloadNames()
+{
+    return { "convolution", "oversampling", "synth", "graph" };
+}
+
+/*  Creates one of the workloads by name, or returns nullptr if the name isn't known. */
+inline std::unique_ptr<Workload> createWorkload (const String& workloadName, int numGraphRenderThreads)
+{
+    if (workloadName == "convolution")   return std::make_unique<ConvolutionWorkload>();
+    if (workloadName == "oversampling")  return std::make_unique<OversamplingWorkload>();
+    if (workloadName == "synth")         return std::make_unique<SynthWorkload>();
+    if (workloadName == "graph")         return std::make_unique<GraphWorkload> (numGraphRenderThreads);
+
+    return nullptr;
+}
@@ -26,6 +26,7 @@
 #include <JuceHeader.h>
 #include "UI/MainHostWindow.h"
 #include "Plugins/InternalPlugins.h"
+#include "Plugins/OfflineRenderer.h"
 
 #if ! (JUCE_PLUGINHOST_VST || JUCE_PLUGINHOST_VST3 || JUCE_PLUGINHOST_AU)
  #error "If you're building the audio plugin host, you probably want to enable VST and/or AU support"
@@ -127,6 +128,43 @@ private:
     AudioPluginFormatManager formatManager;
 };
 
+//==============================================================================
+/*  When the host is started with --render, this renders the graphs given on the
+    command line and then quits, without creating any windows.
+*/
+class OfflineRenderSession
+{
+public:
+    OfflineRenderSession()
+    {
+        formatManager.addDefaultFormats();
+        formatManager.addFormat (new InternalPluginFormat());
+
+        if (auto savedPluginList = getAppProperties().getUserSettings()->getXmlValue ("pluginList"))
+            knownPluginList.recreateFromXml (*savedPluginList);
+    }
+
+    void start (const StringArray& args)
+    {
+        const auto finish = [] (int numFailed)
+        {
+            JUCEApplicationBase::getInstance()->setApplicationReturnValue (numFailed > 0 ? 1 : 0);
+            JUCEApplicationBase::quit();
+        };
+
+        if (! renderer.startFromCommandLine (args, finish))
+        {
+            std::cerr << OfflineRenderer::getUsage() << std::endl;
+            finish (1);
+        }
+    }
+
+private:
+    AudioPluginFormatManager formatManager;
+    KnownPluginList knownPluginList;
+    OfflineRenderer renderer { formatManager, knownPluginList };
+};
+
 //==============================================================================
 class PluginHostApp final : public JUCEApplication,
                             private AsyncUpdater
@@ -154,6 +192,13 @@ public:
         appProperties.reset (new ApplicationProperties());
         appProperties->setStorageParameters (options);
 
+        if (OfflineRenderer::isRenderCommandLine (commandLine))
+        {
+            offlineRenderSession = std::make_unique<OfflineRenderSession>();
+            offlineRenderSession->start (getCommandLineParameterArray());
+            return;
+        }
+
         mainWindow.reset (new MainHostWindow());
 
         commandManager.registerAllCommandsForTarget (this);
@@ -205,6 +250,7 @@ public:
 
     void shutdown() override
     {
+        offlineRenderSession = nullptr;
         mainWindow = nullptr;
         appProperties = nullptr;
         LookAndFeel::setDefaultLookAndFeel (nullptr);
@@ -245,6 +291,7 @@ public:
 private:
     std::unique_ptr<MainHostWindow> mainWindow;
     std::unique_ptr<PluginScannerSubprocess> storedScannerSubprocess;
+    std::unique_ptr<OfflineRenderSession> offlineRenderSession;
 };
 
 static PluginHostApp& getApp()                    { return *dynamic_cast<PluginHostApp*> (JUCEApplication::getInstance()); }
@@ -0,0 +1,360 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+#include "PluginGraph.h"
+#include "InternalPlugins.h"
+
+// The graph's output channels are only those that the saved graph connects to its output node
+static int getNumOutputChannelsUsed (const XmlElement& graphXml)
+{
+    std::set<int> outputNodeIDs;
+
+    for (auto* filter : graphXml.getChildWithTagNameIterator ("FILTER"))
+    {
+        for (auto* child : filter->getChildIterator())
+        {
+            PluginDescription desc;
+
+            if (desc.loadFromXml (*child))
+            {
+                if (desc.pluginFormatName == InternalPluginFormat::getIdentifier() && desc.name == "Audio Output")
+                    outputNodeIDs.insert (filter->getIntAttribute ("uid"));
+
+                break;
+            }
+        }
+    }
+
+    int numChannels = 0;
+
+    for (auto* connection : graphXml.getChildWithTagNameIterator ("CONNECTION"))
+    {
+        const auto channel = connection->getIntAttribute ("dstChannel");
+
+        if (outputNodeIDs.count (connection->getIntAttribute ("dstFilter")) != 0
+             && channel != AudioProcessorGraph::midiChannelIndex)
+            numChannels = jmax (numChannels, channel + 1);
+    }
+
+    return numChannels;
+}
+
+//==============================================================================
+class OfflineRenderer::RenderJob final : public ThreadPoolJob
+{
+public:
+    RenderJob (const Job& jobToRender, const Options& optionsToUse)
+        : ThreadPoolJob ("Render " + jobToRender.outputFile.getFileName()),
+          job (jobToRender),
+          options (optionsToUse)
+    {
+    }
+
+    ~RenderJob() override
+    {
+        // The plugins must be deleted on the message thread
+        JUCE_ASSERT_MESSAGE_THREAD
+    }
+
+    /** Creates the reader, writer and graph. This must be called on the message thread. */
+    Result prepare (AudioPluginFormatManager& pluginFormatManager,
+                    KnownPluginList& knownPlugins,
+                    AudioFormatManager& audioFormatManager)
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        const auto graphXml = parseXMLIfTagMatches (job.graphFile, "FILTERGRAPH");
+
+        if (graphXml == nullptr)
+            return Result::fail ("Not a valid graph file: " + job.graphFile.getFullPathName());
+
+        reader.reset (audioFormatManager.createReaderFor (job.inputFile));
+
+        if (reader == nullptr)
+            return Result::fail ("Couldn't read the input file");
+
+        const auto numOutputChannels = getNumOutputChannelsUsed (*graphXml);
+
+        if (numOutputChannels == 0)
+            return Result::fail ("The graph doesn't have any connected outputs");
+
+        graph.setPlayConfigDetails ((int) reader->numChannels, numOutputChannels, reader->sampleRate, options.blockSize);
+        const auto loadResult = PluginGraph::loadGraphFromXml (graph, pluginFormatManager, knownPlugins, *graphXml);
+
+        if (loadResult.failed())
+            return loadResult;
+
+        if (auto* format = audioFormatManager.findFormatForFileExtension (job.outputFile.getFileExtension()))
+        {
+            const auto bitDepths = format->getPossibleBitDepths();
+            const auto bitDepth = bitDepths.contains (24) ? 24 : bitDepths.getLast();
+
+            job.outputFile.deleteFile();
+
+            if (auto stream = job.outputFile.createOutputStream())
+            {
+                writer.reset (format->createWriterFor (stream.get(), reader->sampleRate,
+                                                       (unsigned int) numOutputChannels,
+                                                       bitDepth, {}, 0));
+
+                if (writer != nullptr)
+                    stream.release();
+            }
+        }
+
+        if (writer == nullptr)
+            return Result::fail ("Couldn't write " + job.outputFile.getFullPathName());
+
+        graph.setNonRealtime (true);
+        graph.prepareToPlay (reader->sampleRate, options.blockSize);
+        return Result::ok();
+    }
+
+    JobStatus runJob() override
+    {
+        // The graph's output lags behind its input by its latency, so that much extra audio is
+        // rendered at the end, and the same amount is dropped from the start
+        const auto latency = (int64) graph.getLatencySamples();
+        const auto tailLength = roundToInt (options.tailLengthSeconds * reader->sampleRate);
+        const auto totalLength = reader->lengthInSamples + tailLength + latency;
+
+        AudioBuffer<float> buffer (jmax (graph.getTotalNumInputChannels(), graph.getTotalNumOutputChannels()),
+                                   options.blockSize);
+        MidiBuffer midi;
+
+        for (int64 position = 0; position < totalLength; position += options.blockSize)
+        {
+            if (shouldExit())
+            {
+                result = Result::fail ("Cancelled");
+                break;
+            }
+
+            const auto numSamples = (int) jmin ((int64) options.blockSize, totalLength - position);
+            AudioBuffer<float> block (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+
+            // Reading past the end of the file fills the block with silence for the tail
+            block.clear();
+            reader->read (&block, 0, numSamples, position, true, true);
+
+            midi.clear();
+            graph.processBlock (block, midi);
+
+            const auto numToDiscard = (int) jlimit ((int64) 0, (int64) numSamples, latency - position);
+
+            if (numToDiscard < numSamples && ! writer->writeFromAudioSampleBuffer (block, numToDiscard, numSamples - numToDiscard))
+            {
+                result = Result::fail ("Couldn't write " + job.outputFile.getFullPathName());
+                break;
+            }
+        }
+
+        writer = nullptr;
+        finished = true;
+        return jobHasFinished;
+    }
+
+    const Job& getJob() const noexcept      { return job; }
+    bool isFinished() const noexcept        { return finished; }
+    Result getResult() const                { return result; }
+
+private:
+    Job job;
+    Options options;
+
+    AudioProcessorGraph graph;
+    std::unique_ptr<AudioFormatReader> reader;
+    std::unique_ptr<AudioFormatWriter> writer;
+
+    Result result = Result::ok();
+    std::atomic<bool> finished { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderJob)
+};
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer (AudioPluginFormatManager& pfm, KnownPluginList& kpl)
+    : pluginFormatManager (pfm),
+      knownPlugins (kpl)
+{
+    audioFormatManager.registerBasicFormats();
+}
+
+OfflineRenderer::~OfflineRenderer()
+{
+    stopTimer();
+
+    if (pool != nullptr)
+        pool->removeAllJobs (true, 10000);
+
+    runningJobs.clear();
+}
+
+bool OfflineRenderer::isRenderCommandLine (const String& commandLine)
+{
+    return StringArray::fromTokens (commandLine, true).contains ("--render");
+}
+
+const char* OfflineRenderer::getUsage()
+{
+    return "Usage: AudioPluginHost --render <graph.filtergraph> <input> <output> [--render ...]\n"
+           "                       [--threads <n>] [--block-size <n>] [--tail <seconds>]\n\n"
+           "Renders the input audio file through the graph, writing the result to the output file.\n"
+           "If the input is a directory, each audio file in it is rendered to a WAV file with the\n"
+           "same name in the output directory. Jobs are rendered in parallel.";
+}
+
+bool OfflineRenderer::startFromCommandLine (const StringArray& args, std::function<void (int)> callback)
+{
+    Array<Job> jobs;
+    Options opts;
+
+    const auto getFile = [] (const String& arg)
+    {
+        return File::getCurrentWorkingDirectory().getChildFile (arg.unquoted());
+    };
+
+    for (int i = 0; i < args.size(); ++i)
+    {
+        const auto& arg = args[i];
+        const auto hasValues = [&] (int num) { return i + num < args.size(); };
+
+        if (arg == "--render" && hasValues (3))
+        {
+            const auto graphFile  = getFile (args[++i]);
+            const auto inputFile  = getFile (args[++i]);
+            const auto outputFile = getFile (args[++i]);
+
+            if (! inputFile.isDirectory())
+            {
+                jobs.add ({ graphFile, inputFile, outputFile });
+                continue;
+            }
+
+            outputFile.createDirectory();
+
+            for (const auto& file : inputFile.findChildFiles (File::findFiles, false, audioFormatManager.getWildcardForAllFormats()))
+                jobs.add ({ graphFile, file, outputFile.getChildFile (file.getFileNameWithoutExtension() + ".wav") });
+        }
+        else if (arg == "--threads" && hasValues (1))
+        {
+            opts.numThreads = args[++i].getIntValue();
+        }
+        else if (arg == "--block-size" && hasValues (1))
+        {
+            opts.blockSize = args[++i].getIntValue();
+        }
+        else if (arg == "--tail" && hasValues (1))
+        {
+            opts.tailLengthSeconds = args[++i].getDoubleValue();
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (jobs.isEmpty() || opts.numThreads <= 0 || opts.blockSize <= 0 || opts.tailLengthSeconds < 0.0)
+        return false;
+
+    start (jobs, opts, std::move (callback));
+    return true;
+}
+
+void OfflineRenderer::start (const Array<Job>& jobs, const Options& opts, std::function<void (int)> callback)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert (runningJobs.empty());
+
+    pendingJobs = jobs;
+    options = opts;
+    onFinished = std::move (callback);
+    numFailed = 0;
+
+    pool = std::make_unique<ThreadPool> (ThreadPoolOptions{}.withThreadName ("Offline render")
+                                                            .withNumberOfThreads (options.numThreads));
+
+    startNextJobs();
+    startTimer (10);
+}
+
+void OfflineRenderer::startNextJobs()
+{
+    // Only as many graphs as there are threads are kept alive at once, so that
+    // long batches don't create every plugin up-front
+    while (! pendingJobs.isEmpty() && (int) runningJobs.size() < options.numThreads)
+    {
+        auto renderJob = std::make_unique<RenderJob> (pendingJobs.removeAndReturn (0), options);
+        const auto result = renderJob->prepare (pluginFormatManager, knownPlugins, audioFormatManager);
+
+        if (result.failed())
+        {
+            std::cerr << renderJob->getJob().inputFile.getFullPathName() << ": " << result.getErrorMessage() << std::endl;
+            ++numFailed;
+            continue;
+        }
+
+        pool->addJob (renderJob.get(), false);
+        runningJobs.push_back (std::move (renderJob));
+    }
+}
+
+void OfflineRenderer::timerCallback()
+{
+    for (auto it = runningJobs.begin(); it != runningJobs.end();)
+    {
+        auto& renderJob = **it;
+
+        if (! renderJob.isFinished() || ! pool->waitForJobToFinish (&renderJob, 0))
+        {
+            ++it;
+            continue;
+        }
+
+        const auto& job = renderJob.getJob();
+
+        if (const auto result = renderJob.getResult(); result.wasOk())
+        {
+            std::cout << job.inputFile.getFullPathName() << " -> " << job.outputFile.getFullPathName() << std::endl;
+        }
+        else
+        {
+            std::cerr << job.inputFile.getFullPathName() << ": " << result.getErrorMessage() << std::endl;
+            ++numFailed;
+        }
+
+        it = runningJobs.erase (it);
+    }
+
+    startNextJobs();
+
+    if (runningJobs.empty() && pendingJobs.isEmpty())
+    {
+        stopTimer();
+        NullCheckedInvocation::invoke (onFinished, numFailed);
+    }
+}
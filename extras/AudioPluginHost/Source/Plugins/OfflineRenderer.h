@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    Renders audio files through saved filter graphs, without any UI or audio device.
+
+    This is used when the host is started with the --render option. Each job gets
+    its own copy of its graph, so that independent jobs can be rendered in parallel.
+    The plugins are created and destroyed on the message thread, and the audio is
+    processed on a thread pool as fast as the plugins allow.
+*/
+class OfflineRenderer final : private Timer
+{
+public:
+    //==============================================================================
+    struct Job
+    {
+        File graphFile, inputFile, outputFile;
+    };
+
+    struct Options
+    {
+        int blockSize = 512;
+        double tailLengthSeconds = 0.0;
+        int numThreads = SystemStats::getNumCpus();
+    };
+
+    //==============================================================================
+    OfflineRenderer (AudioPluginFormatManager&, KnownPluginList&);
+    ~OfflineRenderer() override;
+
+    /** Returns true if the command line asks for an offline render. */
+    static bool isRenderCommandLine (const String& commandLine);
+
+    /** Parses the jobs and options from the command line, and starts rendering them.
+
+        onFinished is called on the message thread when all the jobs have completed,
+        with the number of jobs that failed. Returns false if the command line
+        couldn't be parsed.
+    */
+    bool startFromCommandLine (const StringArray& args, std::function<void (int)> onFinished);
+
+    /** Starts rendering some jobs. */
+    void start (const Array<Job>&, const Options&, std::function<void (int)> onFinished);
+
+    static const char* getUsage();
+
+private:
+    //==============================================================================
+    class RenderJob;
+
+    void timerCallback() override;
+    void startNextJobs();
+
+    AudioPluginFormatManager& pluginFormatManager;
+    KnownPluginList& knownPlugins;
+    AudioFormatManager audioFormatManager;
+    std::unique_ptr<ThreadPool> pool;
+
+    Array<Job> pendingJobs;
+    Options options;
+    std::vector<std::unique_ptr<RenderJob>> runningJobs;
+    std::function<void (int)> onFinished;
+    int numFailed = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineRenderer)
+};
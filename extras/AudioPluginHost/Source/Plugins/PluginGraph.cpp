@@ -383,7 +383,10 @@ static XmlElement* createNodeXml (AudioProcessorGraph::Node* const node) noexcep
     return nullptr;
 }
 
-void PluginGraph::createNodeFromXml (const XmlElement& xml)
+static AudioProcessorGraph::Node::Ptr addNodeFromXml (AudioProcessorGraph& graph,
+                                                      AudioPluginFormatManager& formatManager,
+                                                      KnownPluginList& knownPlugins,
+                                                      const XmlElement& xml)
 {
     PluginDescriptionAndPreference pd;
     const auto nodeUsesARA = xml.getBoolAttribute ("useARA");
@@ -400,7 +403,7 @@ void PluginGraph::createNodeFromXml (const XmlElement& xml)
 
     auto createInstanceWithFallback = [&]() -> std::unique_ptr<AudioPluginInstance>
     {
-        auto createInstance = [this] (const PluginDescriptionAndPreference& description) -> std::unique_ptr<AudioPluginInstance>
+        auto createInstance = [&] (const PluginDescriptionAndPreference& description) -> std::unique_ptr<AudioPluginInstance>
         {
             String errorMessage;
 
@@ -455,7 +458,7 @@ void PluginGraph::createNodeFromXml (const XmlElement& xml)
             instance->setBusesLayout (layout);
         }
 
-        if (auto node = graph.addNode (std::move (instance), NodeID ((uint32) xml.getIntAttribute ("uid"))))
+        if (auto node = graph.addNode (std::move (instance), AudioProcessorGraph::NodeID ((uint32) xml.getIntAttribute ("uid"))))
         {
             if (auto* state = xml.getChildByName ("STATE"))
             {
@@ -469,23 +472,44 @@ void PluginGraph::createNodeFromXml (const XmlElement& xml)
             node->properties.set ("y", xml.getDoubleAttribute ("y"));
             node->properties.set ("useARA", xml.getBoolAttribute ("useARA"));
 
-            for (int i = 0; i < (int) PluginWindow::Type::numTypes; ++i)
+            return node;
+        }
+    }
+
+    return nullptr;
+}
+
+static void restoreConnectionsFromXml (AudioProcessorGraph& graph, const XmlElement& xml)
+{
+    for (auto* e : xml.getChildWithTagNameIterator ("CONNECTION"))
+    {
+        graph.addConnection ({ { AudioProcessorGraph::NodeID ((uint32) e->getIntAttribute ("srcFilter")), e->getIntAttribute ("srcChannel") },
+                               { AudioProcessorGraph::NodeID ((uint32) e->getIntAttribute ("dstFilter")), e->getIntAttribute ("dstChannel") } });
+    }
+
+    graph.removeIllegalConnections();
+}
+
+void PluginGraph::createNodeFromXml (const XmlElement& xml)
+{
+    if (auto node = addNodeFromXml (graph, formatManager, knownPlugins, xml))
+    {
+        for (int i = 0; i < (int) PluginWindow::Type::numTypes; ++i)
+        {
+            auto type = (PluginWindow::Type) i;
+
+            if (xml.hasAttribute (PluginWindow::getOpenProp (type)))
             {
-                auto type = (PluginWindow::Type) i;
+                node->properties.set (PluginWindow::getLastXProp (type), xml.getIntAttribute (PluginWindow::getLastXProp (type)));
+                node->properties.set (PluginWindow::getLastYProp (type), xml.getIntAttribute (PluginWindow::getLastYProp (type)));
+                node->properties.set (PluginWindow::getOpenProp  (type), xml.getIntAttribute (PluginWindow::getOpenProp (type)));
 
-                if (xml.hasAttribute (PluginWindow::getOpenProp (type)))
+                if (node->properties[PluginWindow::getOpenProp (type)])
                 {
-                    node->properties.set (PluginWindow::getLastXProp (type), xml.getIntAttribute (PluginWindow::getLastXProp (type)));
-                    node->properties.set (PluginWindow::getLastYProp (type), xml.getIntAttribute (PluginWindow::getLastYProp (type)));
-                    node->properties.set (PluginWindow::getOpenProp  (type), xml.getIntAttribute (PluginWindow::getOpenProp (type)));
+                    jassert (node->getProcessor() != nullptr);
 
-                    if (node->properties[PluginWindow::getOpenProp (type)])
-                    {
-                        jassert (node->getProcessor() != nullptr);
-
-                        if (auto w = getOrCreateWindowFor (node, type))
-                            w->toFront (true);
-                    }
+                    if (auto w = getOrCreateWindowFor (node, type))
+                        w->toFront (true);
                 }
             }
         }
@@ -522,13 +546,36 @@ void PluginGraph::restoreFromXml (const XmlElement& xml)
         changed();
     }
 
-    for (auto* e : xml.getChildWithTagNameIterator ("CONNECTION"))
+    restoreConnectionsFromXml (graph, xml);
+}
+
+Result PluginGraph::loadGraphFromXml (AudioProcessorGraph& graphToFill,
+                                      AudioPluginFormatManager& formatManager,
+                                      KnownPluginList& knownPlugins,
+                                      const XmlElement& xml)
+{
+    StringArray missingPlugins;
+
+    for (auto* e : xml.getChildWithTagNameIterator ("FILTER"))
     {
-        graph.addConnection ({ { NodeID ((uint32) e->getIntAttribute ("srcFilter")), e->getIntAttribute ("srcChannel") },
-                               { NodeID ((uint32) e->getIntAttribute ("dstFilter")), e->getIntAttribute ("dstChannel") } });
+        if (addNodeFromXml (graphToFill, formatManager, knownPlugins, *e) == nullptr)
+        {
+            PluginDescription desc;
+
+            for (auto* child : e->getChildIterator())
+                if (desc.loadFromXml (*child))
+                    break;
+
+            missingPlugins.add (desc.name.isNotEmpty() ? desc.name : e->getStringAttribute ("uid"));
+        }
     }
 
-    graph.removeIllegalConnections();
+    restoreConnectionsFromXml (graphToFill, xml);
+
+    if (! missingPlugins.isEmpty())
+        return Result::fail ("Couldn't create plugins: " + missingPlugins.joinIntoString (", "));
+
+    return Result::ok();
 }
 
 File PluginGraph::getDefaultGraphDocumentOnMobile()
@@ -102,6 +102,16 @@ public:
 
     static File getDefaultGraphDocumentOnMobile();
 
+    /** Adds the plugins and connections from a saved graph to an AudioProcessorGraph,
+        without opening any windows. This is used to render graphs without the UI.
+
+        Any plugins that can't be created are left out, and are listed in the result.
+    */
+    static Result loadGraphFromXml (AudioProcessorGraph&,
+                                    AudioPluginFormatManager&,
+                                    KnownPluginList&,
+                                    const XmlElement&);
+
     //==============================================================================
     AudioProcessorGraph graph;
 
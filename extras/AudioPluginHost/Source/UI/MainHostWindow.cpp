@@ -118,21 +118,28 @@ public:
     {
         if (scanInProcess)
         {
-            superprocess = nullptr;
+            releaseIdleSuperprocesses();
             format.findAllTypesForFile (result, fileOrIdentifier);
             return true;
         }
 
-        if (addPluginDescriptions (format.getName(), fileOrIdentifier, result))
-            return true;
+        // Each scanning thread uses its own subprocess, so that several files can be
+        // scanned at once, and a crash only affects the file that caused it
+        auto superprocess = takeIdleSuperprocess();
 
-        superprocess = nullptr;
-        return false;
+        if (! addPluginDescriptions (*superprocess, format.getName(), fileOrIdentifier, result))
+            return false;
+
+        // If the scan was cancelled, the subprocess might still send a late reply
+        if (! shouldExit())
+            returnIdleSuperprocess (std::move (superprocess));
+
+        return true;
     }
 
     void scanFinished() override
     {
-        superprocess = nullptr;
+        releaseIdleSuperprocesses();
     }
 
 private:
@@ -143,19 +150,17 @@ private:
 
         Failure indicates that the subprocess is unrecoverable and should be terminated.
     */
-    bool addPluginDescriptions (const String& formatName,
+    bool addPluginDescriptions (Superprocess& superprocess,
+                                const String& formatName,
                                 const String& fileOrIdentifier,
                                 OwnedArray<PluginDescription>& result)
     {
-        if (superprocess == nullptr)
-            superprocess = std::make_unique<Superprocess>();
-
         MemoryBlock block;
         MemoryOutputStream stream { block, true };
         stream.writeString (formatName);
         stream.writeString (fileOrIdentifier);
 
-        if (! superprocess->sendMessageToWorker (block))
+        if (! superprocess.sendMessageToWorker (block))
             return false;
 
         for (;;)
@@ -163,7 +168,7 @@ private:
             if (shouldExit())
                 return true;
 
-            const auto response = superprocess->getResponse();
+            const auto response = superprocess.getResponse();
 
             if (response.state == Superprocess::State::timeout)
                 continue;
@@ -183,6 +188,38 @@ private:
         }
     }
 
+    std::unique_ptr<Superprocess> takeIdleSuperprocess()
+    {
+        {
+            const std::lock_guard<std::mutex> lock { superprocessMutex };
+
+            if (! idleSuperprocesses.empty())
+            {
+                auto result = std::move (idleSuperprocesses.back());
+                idleSuperprocesses.pop_back();
+                return result;
+            }
+        }
+
+        return std::make_unique<Superprocess>();
+    }
+
+    void returnIdleSuperprocess (std::unique_ptr<Superprocess> superprocess)
+    {
+        const std::lock_guard<std::mutex> lock { superprocessMutex };
+        idleSuperprocesses.push_back (std::move (superprocess));
+    }
+
+    void releaseIdleSuperprocesses()
+    {
+        std::vector<std::unique_ptr<Superprocess>> toRelease;
+
+        {
+            const std::lock_guard<std::mutex> lock { superprocessMutex };
+            std::swap (toRelease, idleSuperprocesses);
+        }
+    }
+
     void handleChange()
     {
         if (auto* file = getAppProperties().getUserSettings())
@@ -194,7 +231,8 @@ private:
         handleChange();
     }
 
-    std::unique_ptr<Superprocess> superprocess;
+    std::mutex superprocessMutex;
+    std::vector<std::unique_ptr<Superprocess>> idleSuperprocesses;
 
     std::atomic<bool> scanInProcess { true };
 
@@ -229,8 +267,11 @@ public:
         validationModeBox.onChange = [this]
         {
             getAppProperties().getUserSettings()->setValue (scanModeKey, validationModeBox.getSelectedItemIndex());
+            updateNumberOfScanningThreads();
         };
 
+        updateNumberOfScanningThreads();
+
         handleResize();
     }
 
@@ -240,6 +281,14 @@ public:
     }
 
 private:
+    void updateNumberOfScanningThreads()
+    {
+        // Plug-ins scanned out-of-process can't interfere with one another, so it's safe
+        // to scan one file per core. In-process scans stay on a single thread.
+        const auto outOfProcess = validationModeBox.getSelectedItemIndex() == 1;
+        setNumberOfThreadsForScanning (outOfProcess ? jmax (1, SystemStats::getNumCpus()) : 1);
+    }
+
     void handleResize()
     {
         PluginListComponent::resized();
@@ -268,11 +317,15 @@ public:
         auto deadMansPedalFile = getAppProperties().getUserSettings()
                                    ->getFile().getSiblingFile ("RecentlyCrashedPluginsList");
 
-        setContentOwned (new CustomPluginListComponent (pluginFormatManager,
-                                                        owner.knownPluginList,
-                                                        deadMansPedalFile,
-                                                        getAppProperties().getUserSettings(),
-                                                        true), true);
+        auto listComponent = std::make_unique<CustomPluginListComponent> (pluginFormatManager,
+                                                                          owner.knownPluginList,
+                                                                          deadMansPedalFile,
+                                                                          getAppProperties().getUserSettings(),
+                                                                          true);
+        listComponent->setScanCache (&owner.pluginScanCache);
+        listComponent->onScanFinished = [this] { owner.savePluginScanCache(); };
+
+        setContentOwned (listComponent.release(), true);
 
         setResizable (true, false);
         setResizeLimits (300, 400, 800, 1500);
@@ -286,6 +339,8 @@ public:
     {
         getAppProperties().getUserSettings()->setValue ("listWindowPos", getWindowStateAsString());
         clearContentComponent();
+        owner.savePluginList();
+        owner.savePluginScanCache();
     }
 
     void closeButtonPressed() override
@@ -342,6 +397,9 @@ MainHostWindow::MainHostWindow()
     if (auto savedPluginList = getAppProperties().getUserSettings()->getXmlValue ("pluginList"))
         knownPluginList.recreateFromXml (*savedPluginList);
 
+    if (auto savedScanCache = getAppProperties().getUserSettings()->getXmlValue ("pluginScanCache"))
+        pluginScanCache.recreateFromXml (*savedScanCache);
+
     for (auto& t : internalTypes)
         knownPluginList.addType (t);
 
@@ -462,6 +520,22 @@ void MainHostWindow::tryToQuitApplication()
     JUCEApplication::quit();
 }
 
+void MainHostWindow::savePluginList()
+{
+    if (auto savedPluginList = std::unique_ptr<XmlElement> (knownPluginList.createXml()))
+        getAppProperties().getUserSettings()->setValue ("pluginList", savedPluginList.get());
+
+    getAppProperties().saveIfNeeded();
+}
+
+void MainHostWindow::savePluginScanCache()
+{
+    // The cache can be large, so it's only written when a scan has finished rather than
+    // every time the plugin list changes
+    getAppProperties().getUserSettings()->setValue ("pluginScanCache", pluginScanCache.createXml().get());
+    getAppProperties().saveIfNeeded();
+}
+
 void MainHostWindow::changeListenerCallback (ChangeBroadcaster* changed)
 {
     if (changed == &knownPluginList)
@@ -470,11 +544,7 @@ void MainHostWindow::changeListenerCallback (ChangeBroadcaster* changed)
 
         // save the plugin list every time it gets changed, so that if we're scanning
         // and it crashes, we've still saved the previous ones
-        if (auto savedPluginList = std::unique_ptr<XmlElement> (knownPluginList.createXml()))
-        {
-            getAppProperties().getUserSettings()->setValue ("pluginList", savedPluginList.get());
-            getAppProperties().saveIfNeeded();
-        }
+        savePluginList();
     }
     else if (graphHolder != nullptr && changed == graphHolder->graph.get())
     {
@@ -123,6 +123,8 @@ private:
     static void updateAutoScaleMenuItem (ApplicationCommandInfo& info);
 
     void showAudioSettings();
+    void savePluginList();
+    void savePluginScanCache();
 
     //==============================================================================
     AudioDeviceManager deviceManager;
@@ -130,6 +132,7 @@ private:
 
     std::vector<PluginDescription> internalTypes;
     KnownPluginList knownPluginList;
+    PluginScanCache pluginScanCache;
     KnownPluginList::SortMethod pluginSortMethod;
     Array<PluginDescriptionAndPreference> pluginDescriptionsAndPreference;
 
@@ -47,6 +47,40 @@ class ConsoleUnitTestRunner final : public UnitTestRunner
     }
 };
 
+//==============================================================================
+static int runBenchmarks (const ArgumentList& args)
+{
+    // Some of the benchmarks render text, which needs the font caches to be cleared up at the end
+    const ScopedJuceInitialiser_GUI juceInitialiser;
+
+    BenchmarkRunner runner;
+
+    if (args.containsOption ("--category"))
+        runner.runBenchmarksInCategory (args.getValueForOption ("--category"));
+    else
+        runner.runAllBenchmarks();
+
+    if (args.containsOption ("--output"))
+    {
+        const auto file = args.getFileForOption ("--output");
+        const auto format = file.hasFileExtension ("csv") ? BenchmarkRunner::Format::csv
+                                                          : BenchmarkRunner::Format::json;
+
+        FileOutputStream stream (file);
+
+        if (! stream.openedOk() || ! stream.setPosition (0) || ! stream.truncate().wasOk())
+        {
+            Logger::writeToLog ("Couldn't write to " + file.getFullPathName());
+            return 1;
+        }
+
+        runner.writeResults (stream, format);
+        Logger::writeToLog (newLine + "Results written to " + file.getFullPathName());
+    }
+
+    return 0;
+}
+
 
 //==============================================================================
 int main (int argc, char **argv)
@@ -55,13 +89,16 @@ int main (int argc, char **argv)
 
     if (args.containsOption ("--help|-h"))
     {
-        std::cout << argv[0] << " [--help|-h] [--list-categories] [--category=category] [--seed=seed]" << std::endl;
+        std::cout << argv[0] << " [--help|-h] [--list-categories] [--category=category] [--seed=seed]" << std::endl
+                  << argv[0] << " --benchmark [--list-categories] [--category=category] [--output=results.json|results.csv]" << std::endl;
         return 0;
     }
 
+    const auto benchmarking = args.containsOption ("--benchmark");
+
     if (args.containsOption ("--list-categories"))
     {
-        for (auto& category : UnitTest::getAllCategories())
+        for (auto& category : benchmarking ? Benchmark::getAllCategories() : UnitTest::getAllCategories())
             std::cout << category << std::endl;
 
         return  0;
@@ -70,6 +107,13 @@ int main (int argc, char **argv)
     ConsoleLogger logger;
     Logger::setCurrentLogger (&logger);
 
+    if (benchmarking)
+    {
+        const auto result = runBenchmarks (args);
+        Logger::setCurrentLogger (nullptr);
+        return result;
+    }
+
     ConsoleUnitTestRunner runner;
 
     auto seed = [&args]
@@ -670,6 +670,8 @@ private:
                                     Endianness,
                                     std::conditional_t<IsInterleaved, Interleaved, NonInterleaved>,
                                     std::conditional_t<IsConst, Const, NonConst>>;
+
+        static constexpr bool isNativeFloat32 = std::is_same_v<DataFormat, Float32> && std::is_base_of_v<Endianness, NativeEndian>;
     };
 
     template <bool IsInterleaved, bool IsConst, typename DataFormat, typename Endianness>
@@ -678,6 +680,8 @@ private:
         using Subtypes    = ChannelDataSubtypes<IsInterleaved, IsConst, DataFormat, Endianness>;
         using DataType    = typename Subtypes::DataType;
         using PointerType = typename Subtypes::PointerType;
+
+        static constexpr bool isNativeFloat32 = Subtypes::isNativeFloat32;
     };
 
     template <bool IsInterleaved, bool IsConst, typename... Format>
@@ -687,6 +691,8 @@ private:
         using DataType    = typename Subtypes::DataType;
         using PointerType = typename Subtypes::PointerType;
 
+        static constexpr bool isNativeFloat32 = Subtypes::isNativeFloat32;
+
         DataType data;
         int channels;
     };
@@ -727,6 +733,17 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        // When no conversion is needed, this is just a shuffle, which can be vectorised
+        if constexpr (decltype (source)::isNativeFloat32 && decltype (dest)::isNativeFloat32)
+        {
+            if (source.channels == dest.channels
+                && std::none_of (source.data, source.data + source.channels, [] (auto* chan) { return chan == nullptr; }))
+            {
+                FloatVectorOperations::interleave (dest.data, source.data, dest.channels, numSamples);
+                return;
+            }
+        }
+
         for (int i = 0; i < dest.channels; ++i)
         {
             const DestType destType (addBytesToPointer (dest.data, i * DestType::getBytesPerSample()), dest.channels);
@@ -771,6 +788,16 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        if constexpr (decltype (source)::isNativeFloat32 && decltype (dest)::isNativeFloat32)
+        {
+            if (source.channels == dest.channels
+                && std::none_of (dest.data, dest.data + dest.channels, [] (auto* chan) { return chan == nullptr; }))
+            {
+                FloatVectorOperations::deinterleave (dest.data, source.data, dest.channels, numSamples);
+                return;
+            }
+        }
+
         for (int i = 0; i < dest.channels; ++i)
         {
             if (auto* targetChan = dest.data[i])
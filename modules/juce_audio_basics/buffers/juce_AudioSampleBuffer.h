@@ -737,14 +737,7 @@ public:
                 jassert (isPositiveAndBelow (channel, numChannels));
                 jassert (startSample >= 0 && numSamples >= 0 && startSample + numSamples <= size);
 
-                const auto increment = (endGain - startGain) / (float) numSamples;
-                auto* d = channels[channel] + startSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ *= startGain;
-                    startGain += increment;
-                }
+                FloatVectorOperations::multiplyWithRamp (channels[channel] + startSample, startGain, endGain, numSamples);
             }
         }
     }
@@ -912,14 +905,7 @@ public:
             if (numSamples > 0)
             {
                 isClear = false;
-                const auto increment = (endGain - startGain) / (Type) numSamples;
-                auto* d = channels[destChannel] + destStartSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ += startGain * *source++;
-                    startGain += increment;
-                }
+                FloatVectorOperations::addWithRamp (channels[destChannel] + destStartSample, source, startGain, endGain, numSamples);
             }
         }
     }
@@ -1084,14 +1070,7 @@ public:
             if (numSamples > 0)
             {
                 isClear = false;
-                const auto increment = (endGain - startGain) / (Type) numSamples;
-                auto* d = channels[destChannel] + destStartSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ = startGain * *source++;
-                    startGain += increment;
-                }
+                FloatVectorOperations::copyWithRamp (channels[destChannel] + destStartSample, source, startGain, endGain, numSamples);
             }
         }
     }
@@ -1148,16 +1127,7 @@ public:
         if (numSamples <= 0 || channel < 0 || channel >= numChannels || isClear)
             return Type (0);
 
-        auto* data = channels[channel] + startSample;
-        double sum = 0.0;
-
-        for (int i = 0; i < numSamples; ++i)
-        {
-            auto sample = data[i];
-            sum += sample * sample;
-        }
-
-        return static_cast<Type> (std::sqrt (sum / numSamples));
+        return FloatVectorOperations::findRMS (channels[channel] + startSample, numSamples);
     }
 
     /** Reverses a part of a channel. */
@@ -63,8 +63,25 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm_or_ps (a, b); }
         static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return _mm_xor_ps (a, b); }
 
+        static forcedinline ParallelType abs (ParallelType a) noexcept                  { return _mm_and_ps (a, _mm_castsi128_ps (_mm_set1_epi32 (0x7fffffff))); }
+
         static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
         static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+        static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return (v[0] + v[1]) + (v[2] + v[3]); }
+
+        // Stores the values of a and b in turn, and the reverse
+        static forcedinline void interleave (Type* dest, ParallelType a, ParallelType b) noexcept
+        {
+            storeU (dest,               _mm_unpacklo_ps (a, b));
+            storeU (dest + numParallel, _mm_unpackhi_ps (a, b));
+        }
+
+        static forcedinline void deinterleave (const Type* src, ParallelType& a, ParallelType& b) noexcept
+        {
+            const auto lo = loadU (src), hi = loadU (src + numParallel);
+            a = _mm_shuffle_ps (lo, hi, _MM_SHUFFLE (2, 0, 2, 0));
+            b = _mm_shuffle_ps (lo, hi, _MM_SHUFFLE (3, 1, 3, 1));
+        }
     };
 
     struct BasicOps64
@@ -81,6 +98,7 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm_load1_pd (&v); }
         static forcedinline ParallelType loadA (const Type* v) noexcept                 { return _mm_load_pd (v); }
         static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm_loadu_pd (v); }
+        static forcedinline ParallelType loadWidened (const float* v) noexcept          { return _mm_cvtps_pd (_mm_castsi128_ps (_mm_loadl_epi64 (reinterpret_cast<const __m128i*> (v)))); }
         static forcedinline void storeA (Type* dest, ParallelType a) noexcept           { _mm_store_pd (dest, a); }
         static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm_storeu_pd (dest, a); }
 
@@ -95,8 +113,24 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm_or_pd (a, b); }
         static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return _mm_xor_pd (a, b); }
 
+        static forcedinline ParallelType abs (ParallelType a) noexcept                  { return _mm_and_pd (a, _mm_castsi128_pd (_mm_set1_epi64x (0x7fffffffffffffffLL))); }
+
         static forcedinline Type max (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1]); }
         static forcedinline Type min (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1]); }
+        static forcedinline Type sum (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return v[0] + v[1]; }
+
+        static forcedinline void interleave (Type* dest, ParallelType a, ParallelType b) noexcept
+        {
+            storeU (dest,               _mm_unpacklo_pd (a, b));
+            storeU (dest + numParallel, _mm_unpackhi_pd (a, b));
+        }
+
+        static forcedinline void deinterleave (const Type* src, ParallelType& a, ParallelType& b) noexcept
+        {
+            const auto lo = loadU (src), hi = loadU (src + numParallel);
+            a = _mm_unpacklo_pd (lo, hi);
+            b = _mm_unpackhi_pd (lo, hi);
+        }
     };
 
 
@@ -228,8 +262,15 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  {  return toflt (vorrq_u32 (toint (a), toint (b))); }
         static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  {  return toflt (veorq_u32 (toint (a), toint (b))); }
 
+        static forcedinline ParallelType abs (ParallelType a) noexcept                  { return vabsq_f32 (a); }
+
         static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
         static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+        static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return (v[0] + v[1]) + (v[2] + v[3]); }
+
+        // Stores the values of a and b in turn, and the reverse
+        static forcedinline void interleave (Type* dest, ParallelType a, ParallelType b) noexcept       { vst2q_f32 (dest, (float32x4x2_t { { a, b } })); }
+        static forcedinline void deinterleave (const Type* src, ParallelType& a, ParallelType& b) noexcept { const auto v = vld2q_f32 (src); a = v.val[0]; b = v.val[1]; }
     };
 
     struct BasicOps64
@@ -260,8 +301,14 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  {  return toflt (toint (a) | toint (b)); }
         static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  {  return toflt (toint (a) ^ toint (b)); }
 
+        static forcedinline ParallelType abs (ParallelType a) noexcept                  { return std::abs (a); }
+
         static forcedinline Type max (ParallelType a) noexcept  { return a; }
         static forcedinline Type min (ParallelType a) noexcept  { return a; }
+        static forcedinline Type sum (ParallelType a) noexcept  { return a; }
+
+        static forcedinline void interleave (Type* dest, ParallelType a, ParallelType b) noexcept          { dest[0] = a; dest[1] = b; }
+        static forcedinline void deinterleave (const Type* src, ParallelType& a, ParallelType& b) noexcept { a = src[0]; b = src[1]; }
     };
 
     #define JUCE_BEGIN_VEC_OP \
@@ -488,7 +535,474 @@ namespace FloatVectorHelpers
 
             return Range<Type>::findMinAndMax (src, num);
         }
+
+        template <typename Size>
+        static Size findIndexOfPeak (const Type* src, Size num) noexcept
+        {
+            // Find the largest magnitude first, and then look for the first value that has it
+            Type peak = 0;
+            Size i = 0;
+
+            if (num >= (Size) Mode::numParallel)
+            {
+                auto val = Mode::abs (Mode::loadU (src));
+
+                for (i = Mode::numParallel; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+                    val = Mode::max (val, Mode::abs (Mode::loadU (src + i)));
+
+                peak = Mode::max (val);
+            }
+
+            for (; i < num; ++i)
+                peak = jmax (peak, std::abs (src[i]));
+
+            for (i = 0; i < num; ++i)
+                if (exactlyEqual (std::abs (src[i]), peak))
+                    return i;
+
+            return 0;
+        }
+    };
+
+    /*  The gain for each value is calculated from its index rather than by adding up the
+        increments, so that the gains don't drift over long ramps.
+    */
+    template <typename Mode>
+    struct GainRamp
+    {
+        using Type = typename Mode::Type;
+        using ParallelType = typename Mode::ParallelType;
+
+        template <typename Size>
+        static void multiply (Type* dest, Type startGain, Type increment, Size num) noexcept
+        {
+            Gains gains (startGain, increment);
+            Size i = 0;
+
+            for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+                Mode::storeU (dest + i, Mode::mul (Mode::loadU (dest + i), gains.next()));
+
+            for (; i < num; ++i)
+                dest[i] *= startGain + increment * (Type) i;
+        }
+
+        template <typename Size>
+        static void copy (Type* dest, const Type* src, Type startGain, Type increment, Size num) noexcept
+        {
+            Gains gains (startGain, increment);
+            Size i = 0;
+
+            for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+                Mode::storeU (dest + i, Mode::mul (Mode::loadU (src + i), gains.next()));
+
+            for (; i < num; ++i)
+                dest[i] = src[i] * (startGain + increment * (Type) i);
+        }
+
+        template <typename Size>
+        static void add (Type* dest, const Type* src, Type startGain, Type increment, Size num) noexcept
+        {
+            Gains gains (startGain, increment);
+            Size i = 0;
+
+            for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+                Mode::storeU (dest + i, Mode::add (Mode::loadU (dest + i), Mode::mul (Mode::loadU (src + i), gains.next())));
+
+            for (; i < num; ++i)
+                dest[i] += src[i] * (startGain + increment * (Type) i);
+        }
+
+    private:
+        struct Gains
+        {
+            Gains (Type startGain, Type increment) noexcept
+                : start (Mode::load1 (startGain)),
+                  inc (Mode::load1 (increment)),
+                  step (Mode::load1 ((Type) Mode::numParallel))
+            {
+                Type offsets[Mode::numParallel];
+
+                for (int i = 0; i < (int) Mode::numParallel; ++i)
+                    offsets[i] = (Type) i;
+
+                indices = Mode::loadU (offsets);
+            }
+
+            forcedinline ParallelType next() noexcept
+            {
+                const auto gains = Mode::add (start, Mode::mul (inc, indices));
+                indices = Mode::add (indices, step);
+                return gains;
+            }
+
+            ParallelType start, inc, step, indices;
+        };
+    };
+
+    template <typename Mode>
+    struct Sum
+    {
+        using Type = typename Mode::Type;
+
+        template <typename Size>
+        static Type dotProduct (const Type* src1, const Type* src2, Size num) noexcept
+        {
+            auto sum = Mode::load1 ((Type) 0);
+            Size i = 0;
+
+            for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+                sum = Mode::add (sum, Mode::mul (Mode::loadU (src1 + i), Mode::loadU (src2 + i)));
+
+            auto result = Mode::sum (sum);
+
+            for (; i < num; ++i)
+                result += src1[i] * src2[i];
+
+            return result;
+        }
+    };
+
+    template <typename Mode>
+    struct Interleaving
+    {
+        using Type = typename Mode::Type;
+        using ParallelType = typename Mode::ParallelType;
+
+        template <typename Size>
+        static void interleaveStereo (Type* dest, const Type* left, const Type* right, Size num) noexcept
+        {
+            Size i = 0;
+
+            for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+                Mode::interleave (dest + 2 * i, Mode::loadU (left + i), Mode::loadU (right + i));
+
+            for (; i < num; ++i)
+            {
+                dest[2 * i]     = left[i];
+                dest[2 * i + 1] = right[i];
+            }
+        }
+
+        template <typename Size>
+        static void deinterleaveStereo (Type* left, Type* right, const Type* src, Size num) noexcept
+        {
+            Size i = 0;
+
+            for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+            {
+                ParallelType l, r;
+                Mode::deinterleave (src + 2 * i, l, r);
+                Mode::storeU (left + i, l);
+                Mode::storeU (right + i, r);
+            }
+
+            for (; i < num; ++i)
+            {
+                left[i]  = src[2 * i];
+                right[i] = src[2 * i + 1];
+            }
+        }
+    };
+   #endif
+
+   #if JUCE_USE_AVX_DISPATCH
+    //==============================================================================
+    enum class InstructionSet
+    {
+        fallback,   // SSE
+        avx2,       // AVX2 with FMA
+        avx512      // AVX-512F
+    };
+
+    /*  A CPU may support AVX while the OS (or a virtual machine) doesn't save the wider
+        registers when it switches threads, in which case using them would crash. If
+        CPUID says that the OS has enabled XGETBV, then XCR0 says which of the registers'
+        states it saves.
+    */
+    static uint64 getRegisterStatesSavedByOS() noexcept
+    {
+        constexpr uint32 osxsaveBit = 1u << 27;
+
+       #if JUCE_MSVC
+        int info[4] = {};
+        __cpuid (info, 1);
+
+        if (((uint32) info[2] & osxsaveBit) == 0)
+            return 0;
+
+        return (uint64) _xgetbv (0);
+       #else
+        unsigned int a = 0, b = 0, c = 0, d = 0;
+        __cpuid (1, a, b, c, d);
+
+        if ((c & osxsaveBit) == 0)
+            return 0;
+
+        uint32 low = 0, high = 0;
+        asm volatile ("xgetbv" : "=a" (low), "=d" (high) : "c" (0));
+        return ((uint64) high << 32) | low;
+       #endif
+    }
+
+    static bool isInstructionSetAvailable (InstructionSet set) noexcept
+    {
+        // XCR0 bits 1 and 2 are the SSE and AVX registers, and bits 5 to 7 are the
+        // AVX-512 mask registers and the upper halves of the 512-bit registers
+        constexpr uint64 avxStates = 0x06, avx512States = 0xe6;
+        static const auto savedStates = getRegisterStatesSavedByOS();
+
+        switch (set)
+        {
+            case InstructionSet::avx512:    return (savedStates & avx512States) == avx512States && SystemStats::hasAVX512F();
+            case InstructionSet::avx2:      return (savedStates & avxStates) == avxStates && SystemStats::hasAVX2() && SystemStats::hasFMA3();
+            case InstructionSet::fallback:  return true;
+        }
+
+        return false;
+    }
+
+    static InstructionSet getBestAvailableInstructionSet() noexcept
+    {
+        for (auto set : { InstructionSet::avx512, InstructionSet::avx2 })
+            if (isInstructionSetAvailable (set))
+                return set;
+
+        return InstructionSet::fallback;
+    }
+
+    static std::atomic<InstructionSet>& getInstructionSet() noexcept
+    {
+        static std::atomic<InstructionSet> instructionSet { getBestAvailableInstructionSet() };
+        return instructionSet;
+    }
+
+    /*  Forces the functions to use a particular instruction set, which must be available
+        on this machine. This is only intended for testing and benchmarking.
+    */
+    struct ScopedInstructionSet
+    {
+        explicit ScopedInstructionSet (InstructionSet set) noexcept
+            : previous (getInstructionSet().exchange (set))
+        {
+            jassert (isInstructionSetAvailable (set));
+        }
+
+        ~ScopedInstructionSet() noexcept    { getInstructionSet() = previous; }
+
+        const InstructionSet previous;
     };
+
+   #if JUCE_CLANG
+    #pragma clang attribute push (__attribute__ ((target ("avx2,fma"))), apply_to = function)
+   #elif JUCE_GCC
+    #pragma GCC push_options
+    #pragma GCC target ("avx2,fma")
+   #endif
+
+    namespace AVX2
+    {
+        struct BasicOps32
+        {
+            using Type = float;
+            using ParallelType = __m256;
+            enum { numParallel = 8 };
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_ps (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_ps (v); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_ps (dest, a); }
+            static forcedinline ParallelType loadAndConvert (const int* v) noexcept         { return _mm256_cvtepi32_ps (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (v))); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+            static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_ps (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
+            static forcedinline ParallelType abs (ParallelType a) noexcept                  { return _mm256_and_ps (a, _mm256_castsi256_ps (_mm256_set1_epi32 (0x7fffffff))); }
+
+            // a * b + c, and c - a * b
+            static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept     { return _mm256_fmadd_ps (a, b, c); }
+            static forcedinline ParallelType negMulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fnmadd_ps (a, b, c); }
+
+            static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (jmax (v[0], v[1], v[2], v[3]), jmax (v[4], v[5], v[6], v[7])); }
+            static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (jmin (v[0], v[1], v[2], v[3]), jmin (v[4], v[5], v[6], v[7])); }
+            static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return ((v[0] + v[1]) + (v[2] + v[3])) + ((v[4] + v[5]) + (v[6] + v[7])); }
+
+            // The unpack instructions work within each 128-bit half, so the halves need swapping over afterwards
+            static forcedinline void interleave (Type* dest, ParallelType a, ParallelType b) noexcept
+            {
+                const auto lo = _mm256_unpacklo_ps (a, b), hi = _mm256_unpackhi_ps (a, b);
+                storeU (dest,               _mm256_permute2f128_ps (lo, hi, 0x20));
+                storeU (dest + numParallel, _mm256_permute2f128_ps (lo, hi, 0x31));
+            }
+
+            static forcedinline void deinterleave (const Type* src, ParallelType& a, ParallelType& b) noexcept
+            {
+                const auto x = loadU (src), y = loadU (src + numParallel);
+                const auto lo = _mm256_permute2f128_ps (x, y, 0x20), hi = _mm256_permute2f128_ps (x, y, 0x31);
+                a = _mm256_shuffle_ps (lo, hi, _MM_SHUFFLE (2, 0, 2, 0));
+                b = _mm256_shuffle_ps (lo, hi, _MM_SHUFFLE (3, 1, 3, 1));
+            }
+        };
+
+        struct BasicOps64
+        {
+            using Type = double;
+            using ParallelType = __m256d;
+            enum { numParallel = 4 };
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_pd (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_pd (v); }
+            static forcedinline ParallelType loadWidened (const float* v) noexcept          { return _mm256_cvtps_pd (_mm_loadu_ps (v)); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_pd (dest, a); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_pd (a, b); }
+            static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_pd (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_pd (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_pd (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_pd (a, b); }
+            static forcedinline ParallelType abs (ParallelType a) noexcept                  { return _mm256_and_pd (a, _mm256_castsi256_pd (_mm256_set1_epi64x (0x7fffffffffffffffLL))); }
+
+            static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept     { return _mm256_fmadd_pd (a, b, c); }
+            static forcedinline ParallelType negMulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fnmadd_pd (a, b, c); }
+
+            static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
+            static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+            static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return (v[0] + v[1]) + (v[2] + v[3]); }
+
+            static forcedinline void interleave (Type* dest, ParallelType a, ParallelType b) noexcept
+            {
+                const auto lo = _mm256_unpacklo_pd (a, b), hi = _mm256_unpackhi_pd (a, b);
+                storeU (dest,               _mm256_permute2f128_pd (lo, hi, 0x20));
+                storeU (dest + numParallel, _mm256_permute2f128_pd (lo, hi, 0x31));
+            }
+
+            static forcedinline void deinterleave (const Type* src, ParallelType& a, ParallelType& b) noexcept
+            {
+                const auto x = loadU (src), y = loadU (src + numParallel);
+                const auto lo = _mm256_permute2f128_pd (x, y, 0x20), hi = _mm256_permute2f128_pd (x, y, 0x31);
+                a = _mm256_unpacklo_pd (lo, hi);
+                b = _mm256_unpackhi_pd (lo, hi);
+            }
+        };
+
+        #include "juce_FloatVectorOperationsKernels.h"
+    }
+
+   #if JUCE_CLANG
+    #pragma clang attribute pop
+    #pragma clang attribute push (__attribute__ ((target ("avx512f,avx2,fma"))), apply_to = function)
+   #elif JUCE_GCC
+    #pragma GCC pop_options
+    #pragma GCC push_options
+    #pragma GCC target ("avx512f,avx2,fma")
+   #endif
+
+    // Some versions of GCC give false warnings about the AVX-512 intrinsics
+    JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wmaybe-uninitialized", "-Wuninitialized")
+
+    namespace AVX512
+    {
+        struct BasicOps32
+        {
+            using Type = float;
+            using ParallelType = __m512;
+            enum { numParallel = 16 };
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm512_set1_ps (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_ps (v); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_ps (dest, a); }
+            static forcedinline ParallelType loadAndConvert (const int* v) noexcept         { return _mm512_cvtepi32_ps (_mm512_loadu_si512 (v)); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_ps (a, b); }
+            static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm512_sub_ps (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_ps (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_ps (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_ps (a, b); }
+
+            // The floating point bitwise operations need AVX-512DQ, so use the integer ones
+            static forcedinline ParallelType abs (ParallelType a) noexcept                  { return _mm512_castsi512_ps (_mm512_and_si512 (_mm512_castps_si512 (a), _mm512_set1_epi32 (0x7fffffff))); }
+
+            static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept     { return _mm512_fmadd_ps (a, b, c); }
+            static forcedinline ParallelType negMulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fnmadd_ps (a, b, c); }
+
+            static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return *std::max_element (v, v + numParallel); }
+            static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return *std::min_element (v, v + numParallel); }
+            static forcedinline Type sum (ParallelType a) noexcept { return _mm512_reduce_add_ps (a); }
+
+            static forcedinline void interleave (Type* dest, ParallelType a, ParallelType b) noexcept
+            {
+                storeU (dest,               _mm512_permutex2var_ps (a, _mm512_setr_epi32 (0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23), b));
+                storeU (dest + numParallel, _mm512_permutex2var_ps (a, _mm512_setr_epi32 (8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31), b));
+            }
+
+            static forcedinline void deinterleave (const Type* src, ParallelType& a, ParallelType& b) noexcept
+            {
+                const auto x = loadU (src), y = loadU (src + numParallel);
+                a = _mm512_permutex2var_ps (x, _mm512_setr_epi32 (0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30), y);
+                b = _mm512_permutex2var_ps (x, _mm512_setr_epi32 (1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31), y);
+            }
+        };
+
+        struct BasicOps64
+        {
+            using Type = double;
+            using ParallelType = __m512d;
+            enum { numParallel = 8 };
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm512_set1_pd (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_pd (v); }
+            static forcedinline ParallelType loadWidened (const float* v) noexcept          { return _mm512_cvtps_pd (_mm256_loadu_ps (v)); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_pd (dest, a); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_pd (a, b); }
+            static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm512_sub_pd (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_pd (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_pd (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_pd (a, b); }
+            static forcedinline ParallelType abs (ParallelType a) noexcept                  { return _mm512_castsi512_pd (_mm512_and_si512 (_mm512_castpd_si512 (a), _mm512_set1_epi64 (0x7fffffffffffffffLL))); }
+
+            static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept     { return _mm512_fmadd_pd (a, b, c); }
+            static forcedinline ParallelType negMulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fnmadd_pd (a, b, c); }
+
+            static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return *std::max_element (v, v + numParallel); }
+            static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return *std::min_element (v, v + numParallel); }
+            static forcedinline Type sum (ParallelType a) noexcept { return _mm512_reduce_add_pd (a); }
+
+            static forcedinline void interleave (Type* dest, ParallelType a, ParallelType b) noexcept
+            {
+                storeU (dest,               _mm512_permutex2var_pd (a, _mm512_setr_epi64 (0, 8, 1, 9, 2, 10, 3, 11), b));
+                storeU (dest + numParallel, _mm512_permutex2var_pd (a, _mm512_setr_epi64 (4, 12, 5, 13, 6, 14, 7, 15), b));
+            }
+
+            static forcedinline void deinterleave (const Type* src, ParallelType& a, ParallelType& b) noexcept
+            {
+                const auto x = loadU (src), y = loadU (src + numParallel);
+                a = _mm512_permutex2var_pd (x, _mm512_setr_epi64 (0, 2, 4, 6, 8, 10, 12, 14), y);
+                b = _mm512_permutex2var_pd (x, _mm512_setr_epi64 (1, 3, 5, 7, 9, 11, 13, 15), y);
+            }
+        };
+
+        #include "juce_FloatVectorOperationsKernels.h"
+    }
+
+    JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+
+   #if JUCE_CLANG
+    #pragma clang attribute pop
+   #elif JUCE_GCC
+    #pragma GCC pop_options
+   #endif
+
+    // Calls the AVX version of a function if one has been chosen, and returns its result
+    #define JUCE_DISPATCH_VEC_OP(functionCall) \
+        switch (FloatVectorHelpers::getInstructionSet().load (std::memory_order_relaxed)) \
+        { \
+            case FloatVectorHelpers::InstructionSet::avx512:    return FloatVectorHelpers::AVX512::functionCall; \
+            case FloatVectorHelpers::InstructionSet::avx2:      return FloatVectorHelpers::AVX2::functionCall; \
+            case FloatVectorHelpers::InstructionSet::fallback:  break; \
+        }
+   #else
+    #define JUCE_DISPATCH_VEC_OP(functionCall)
    #endif
 
 //==============================================================================
@@ -520,6 +1034,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vfill (&valueToFill, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (fill (dest, valueToFill, num))
         JUCE_PERFORM_VEC_OP_DEST (dest[i] = valueToFill,
                                   val,
                                   JUCE_LOAD_NONE,
@@ -533,6 +1048,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vfillD (&valueToFill, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (fill (dest, valueToFill, num))
         JUCE_PERFORM_VEC_OP_DEST (dest[i] = valueToFill,
                                   val,
                                   JUCE_LOAD_NONE,
@@ -546,6 +1062,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmul (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (copyWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
                                       Mode::mul (mult, s),
                                       JUCE_LOAD_SRC,
@@ -560,6 +1077,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmulD (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (copyWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
                                       Mode::mul (mult, s),
                                       JUCE_LOAD_SRC,
@@ -574,6 +1092,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsadd (dest, 1, &amount, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (add (dest, amount, num))
         JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount,
                                   Mode::add (d, amountToAdd),
                                   JUCE_LOAD_DEST,
@@ -584,6 +1103,7 @@ namespace
     template <typename Size>
     void add (double* dest, double amount, Size num) noexcept
     {
+        JUCE_DISPATCH_VEC_OP (add (dest, amount, num))
         JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount,
                                   Mode::add (d, amountToAdd),
                                   JUCE_LOAD_DEST,
@@ -596,6 +1116,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsadd (src, 1, &amount, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (add (dest, src, amount, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount,
                                       Mode::add (am, s),
                                       JUCE_LOAD_SRC,
@@ -610,6 +1131,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsaddD (src, 1, &amount, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (add (dest, src, amount, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount,
                                       Mode::add (am, s),
                                       JUCE_LOAD_SRC,
@@ -624,6 +1146,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (add (dest, src, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
                                       Mode::add (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -637,6 +1160,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vaddD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (add (dest, src, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
                                       Mode::add (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -650,6 +1174,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (add (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
                                             Mode::add (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -663,6 +1188,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vaddD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (add (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
                                             Mode::add (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -676,6 +1202,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsub (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (subtract (dest, src, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i],
                                       Mode::sub (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -689,6 +1216,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsubD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (subtract (dest, src, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i],
                                       Mode::sub (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -702,6 +1230,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsub (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (subtract (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i],
                                             Mode::sub (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -715,6 +1244,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsubD (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (subtract (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i],
                                             Mode::sub (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -728,6 +1258,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (addWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
                                       Mode::add (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -742,6 +1273,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmaD (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (addWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
                                       Mode::add (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -756,6 +1288,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (addWithMultiply (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
                                                  Mode::add (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -769,6 +1302,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmaD ((double*) src1, 1, (double*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (addWithMultiply (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
                                                  Mode::add (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -779,6 +1313,7 @@ namespace
     template <typename Size>
     void subtractWithMultiply (float* dest, const float* src, float multiplier, Size num) noexcept
     {
+        JUCE_DISPATCH_VEC_OP (subtractWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier,
                                       Mode::sub (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -789,6 +1324,7 @@ namespace
     template <typename Size>
     void subtractWithMultiply (double* dest, const double* src, double multiplier, Size num) noexcept
     {
+        JUCE_DISPATCH_VEC_OP (subtractWithMultiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier,
                                       Mode::sub (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -799,6 +1335,7 @@ namespace
     template <typename Size>
     void subtractWithMultiply (float* dest, const float* src1, const float* src2, Size num) noexcept
     {
+        JUCE_DISPATCH_VEC_OP (subtractWithMultiply (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i],
                                                  Mode::sub (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -808,6 +1345,7 @@ namespace
     template <typename Size>
     void subtractWithMultiply (double* dest, const double* src1, const double* src2, Size num) noexcept
     {
+        JUCE_DISPATCH_VEC_OP (subtractWithMultiply (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i],
                                                  Mode::sub (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -820,6 +1358,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (multiply (dest, src, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
                                       Mode::mul (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -833,6 +1372,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmulD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (multiply (dest, src, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
                                       Mode::mul (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -846,6 +1386,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmul (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (multiply (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i],
                                             Mode::mul (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -859,6 +1400,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmulD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (multiply (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i],
                                             Mode::mul (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -872,6 +1414,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (multiply (dest, multiplier, num))
         JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
                                   Mode::mul (d, mult),
                                   JUCE_LOAD_DEST,
@@ -885,6 +1428,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmulD (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (multiply (dest, multiplier, num))
         JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
                                   Mode::mul (d, mult),
                                   JUCE_LOAD_DEST,
@@ -895,6 +1439,7 @@ namespace
     template <typename Size>
     void multiply (float* dest, const float* src, float multiplier, Size num) noexcept
     {
+        JUCE_DISPATCH_VEC_OP (multiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
                                       Mode::mul (mult, s),
                                       JUCE_LOAD_SRC,
@@ -905,6 +1450,7 @@ namespace
     template <typename Size>
     void multiply (double* dest, const double* src, double multiplier, Size num) noexcept
     {
+        JUCE_DISPATCH_VEC_OP (multiply (dest, src, multiplier, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
                                       Mode::mul (mult, s),
                                       JUCE_LOAD_SRC,
@@ -938,6 +1484,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vabs ((float*) src, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (abs (dest, src, num))
         [[maybe_unused]] FloatVectorHelpers::signMask32 signMask;
         signMask.i = 0x7fffffffUL;
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = std::abs (src[i]),
@@ -954,6 +1501,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vabsD ((double*) src, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (abs (dest, src, num))
         [[maybe_unused]] FloatVectorHelpers::signMask64 signMask;
         signMask.i = 0x7fffffffffffffffULL;
 
@@ -968,6 +1516,7 @@ namespace
     template <typename Size>
     void min (float* dest, const float* src, float comp, Size num) noexcept
     {
+        JUCE_DISPATCH_VEC_OP (min (dest, src, comp, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp),
                                       Mode::min (s, cmp),
                                       JUCE_LOAD_SRC,
@@ -978,6 +1527,7 @@ namespace
     template <typename Size>
     void min (double* dest, const double* src, double comp, Size num) noexcept
     {
+        JUCE_DISPATCH_VEC_OP (min (dest, src, comp, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp),
                                       Mode::min (s, cmp),
                                       JUCE_LOAD_SRC,
@@ -991,6 +1541,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmin ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (min (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]),
                                             Mode::min (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -1004,6 +1555,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vminD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (min (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]),
                                             Mode::min (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -1014,6 +1566,7 @@ namespace
     template <typename Size>
     void max (float* dest, const float* src, float comp, Size num) noexcept
     {
+        JUCE_DISPATCH_VEC_OP (max (dest, src, comp, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp),
                                       Mode::max (s, cmp),
                                       JUCE_LOAD_SRC,
@@ -1024,6 +1577,7 @@ namespace
     template <typename Size>
     void max (double* dest, const double* src, double comp, Size num) noexcept
     {
+        JUCE_DISPATCH_VEC_OP (max (dest, src, comp, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp),
                                       Mode::max (s, cmp),
                                       JUCE_LOAD_SRC,
@@ -1037,6 +1591,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmax ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (max (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]),
                                             Mode::max (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -1050,6 +1605,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmaxD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (max (dest, src1, src2, num))
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]),
                                             Mode::max (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -1065,6 +1621,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vclip ((float*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (clip (dest, src, low, high, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
                                       Mode::max (Mode::min (s, hi), lo),
                                       JUCE_LOAD_SRC,
@@ -1082,6 +1639,7 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vclipD ((double*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_VEC_OP (clip (dest, src, low, high, num))
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
                                       Mode::max (Mode::min (s, hi), lo),
                                       JUCE_LOAD_SRC,
@@ -1095,6 +1653,7 @@ namespace
     Range<float> findMinAndMax (const float* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_VEC_OP (findMinAndMax (src, num))
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinAndMax (src, num);
        #else
         return Range<float>::findMinAndMax (src, num);
@@ -1105,6 +1664,7 @@ namespace
     Range<double> findMinAndMax (const double* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_VEC_OP (findMinAndMax (src, num))
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinAndMax (src, num);
        #else
         return Range<double>::findMinAndMax (src, num);
@@ -1115,6 +1675,7 @@ namespace
     float findMinimum (const float* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_VEC_OP (findMinimum (src, num))
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, true);
        #else
         return juce::findMinimum (src, num);
@@ -1125,6 +1686,7 @@ namespace
     double findMinimum (const double* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_VEC_OP (findMinimum (src, num))
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, true);
        #else
         return juce::findMinimum (src, num);
@@ -1135,6 +1697,7 @@ namespace
     float findMaximum (const float* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_VEC_OP (findMaximum (src, num))
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, false);
        #else
         return juce::findMaximum (src, num);
@@ -1145,6 +1708,7 @@ namespace
     double findMaximum (const double* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_VEC_OP (findMaximum (src, num))
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, false);
        #else
         return juce::findMaximum (src, num);
@@ -1154,6 +1718,7 @@ namespace
     template <typename Size>
     void convertFixedToFloat (float* dest, const int* src, float multiplier, Size num) noexcept
     {
+        JUCE_DISPATCH_VEC_OP (convertFixedToFloat (dest, src, multiplier, num))
        #if JUCE_USE_ARM_NEON
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = (float) src[i] * multiplier,
                                   vmulq_n_f32 (vcvtq_f32_s32 (vld1q_s32 (src)), multiplier),
@@ -1168,6 +1733,225 @@ namespace
        #endif
     }
 
+    template <typename Type, typename Size>
+    void multiplyWithRamp (Type* dest, Type startGain, Type increment, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        if constexpr (std::is_same_v<Type, float>)
+            vDSP_vrampmul (dest, 1, &startGain, &increment, dest, 1, (vDSP_Length) num);
+        else
+            vDSP_vrampmulD (dest, 1, &startGain, &increment, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_DISPATCH_VEC_OP (multiplyWithRamp (dest, startGain, increment, num))
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        GainRamp<typename ModeType<sizeof (Type)>::Mode>::multiply (dest, startGain, increment, num);
+       #else
+        for (Size i = 0; i < num; ++i)
+            dest[i] *= startGain + increment * (Type) i;
+       #endif
+       #endif
+    }
+
+    template <typename Type, typename Size>
+    void copyWithRamp (Type* dest, const Type* src, Type startGain, Type increment, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        if constexpr (std::is_same_v<Type, float>)
+            vDSP_vrampmul (src, 1, &startGain, &increment, dest, 1, (vDSP_Length) num);
+        else
+            vDSP_vrampmulD (src, 1, &startGain, &increment, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_DISPATCH_VEC_OP (copyWithRamp (dest, src, startGain, increment, num))
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        GainRamp<typename ModeType<sizeof (Type)>::Mode>::copy (dest, src, startGain, increment, num);
+       #else
+        for (Size i = 0; i < num; ++i)
+            dest[i] = src[i] * (startGain + increment * (Type) i);
+       #endif
+       #endif
+    }
+
+    template <typename Type, typename Size>
+    void addWithRamp (Type* dest, const Type* src, Type startGain, Type increment, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        if constexpr (std::is_same_v<Type, float>)
+            vDSP_vrampmuladd (src, 1, &startGain, &increment, dest, 1, (vDSP_Length) num);
+        else
+            vDSP_vrampmuladdD (src, 1, &startGain, &increment, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_DISPATCH_VEC_OP (addWithRamp (dest, src, startGain, increment, num))
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        GainRamp<typename ModeType<sizeof (Type)>::Mode>::add (dest, src, startGain, increment, num);
+       #else
+        for (Size i = 0; i < num; ++i)
+            dest[i] += src[i] * (startGain + increment * (Type) i);
+       #endif
+       #endif
+    }
+
+    template <typename Type, typename Size>
+    Type dotProduct (const Type* src1, const Type* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        Type result = 0;
+
+        if constexpr (std::is_same_v<Type, float>)
+            vDSP_dotpr (src1, 1, src2, 1, &result, (vDSP_Length) num);
+        else
+            vDSP_dotprD (src1, 1, src2, 1, &result, (vDSP_Length) num);
+
+        return result;
+       #else
+        JUCE_DISPATCH_VEC_OP (dotProduct (src1, src2, num))
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return Sum<typename ModeType<sizeof (Type)>::Mode>::dotProduct (src1, src2, num);
+       #else
+        Type result = 0;
+
+        for (Size i = 0; i < num; ++i)
+            result += src1[i] * src2[i];
+
+        return result;
+       #endif
+       #endif
+    }
+
+    // Floats are squared and summed as doubles, so that long arrays don't lose precision
+    template <typename Size>
+    double sumOfSquaresAsDouble (const float* src, Size num) noexcept
+    {
+        JUCE_DISPATCH_VEC_OP (sumOfSquaresAsDouble (src, num))
+       #if JUCE_USE_SSE_INTRINSICS
+        using Mode = BasicOps64;
+
+        auto sum = Mode::load1 (0.0);
+        Size i = 0;
+
+        for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+        {
+            const auto values = Mode::loadWidened (src + i);
+            sum = Mode::add (sum, Mode::mul (values, values));
+        }
+
+        auto result = Mode::sum (sum);
+       #else
+        double result = 0;
+        Size i = 0;
+       #endif
+
+        for (; i < num; ++i)
+            result += (double) src[i] * (double) src[i];
+
+        return result;
+    }
+
+    template <typename Size>
+    double sumOfSquaresAsDouble (const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        double result = 0;
+        vDSP_svesqD (src, 1, &result, (vDSP_Length) num);
+        return result;
+       #else
+        return dotProduct (src, src, num);
+       #endif
+    }
+
+    template <typename Type, typename Size>
+    Type sumOfSquares (const Type* src, Size num) noexcept
+    {
+        return (Type) sumOfSquaresAsDouble (src, num);
+    }
+
+    template <typename Type, typename Size>
+    Size findIndexOfPeak (const Type* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        if (num == 0)
+            return 0;
+
+        Type peak;
+        vDSP_Length index;
+
+        if constexpr (std::is_same_v<Type, float>)
+            vDSP_maxmgvi (src, 1, &peak, &index, (vDSP_Length) num);
+        else
+            vDSP_maxmgviD (src, 1, &peak, &index, (vDSP_Length) num);
+
+        return (Size) index;
+       #else
+        JUCE_DISPATCH_VEC_OP (findIndexOfPeak (src, num))
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return MinMax<typename ModeType<sizeof (Type)>::Mode>::findIndexOfPeak (src, num);
+       #else
+        Size peakIndex = 0;
+
+        for (Size i = 1; i < num; ++i)
+            if (std::abs (src[i]) > std::abs (src[peakIndex]))
+                peakIndex = i;
+
+        return peakIndex;
+       #endif
+       #endif
+    }
+
+    template <typename Type, typename Size>
+    void interleave (Type* dest, const Type* const* src, int numChannels, Size num) noexcept
+    {
+        if (numChannels == 1)
+        {
+            memcpy (dest, src[0], (size_t) num * sizeof (Type));
+            return;
+        }
+
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        if (numChannels == 2)
+        {
+            JUCE_DISPATCH_VEC_OP (interleaveStereo (dest, src[0], src[1], num))
+            Interleaving<typename ModeType<sizeof (Type)>::Mode>::interleaveStereo (dest, src[0], src[1], num);
+            return;
+        }
+       #endif
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto* s = src[ch];
+            auto* d = dest + ch;
+
+            for (Size i = 0; i < num; ++i)
+                d[i * (Size) numChannels] = s[i];
+        }
+    }
+
+    template <typename Type, typename Size>
+    void deinterleave (Type* const* dest, const Type* src, int numChannels, Size num) noexcept
+    {
+        if (numChannels == 1)
+        {
+            memcpy (dest[0], src, (size_t) num * sizeof (Type));
+            return;
+        }
+
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        if (numChannels == 2)
+        {
+            JUCE_DISPATCH_VEC_OP (deinterleaveStereo (dest[0], dest[1], src, num))
+            Interleaving<typename ModeType<sizeof (Type)>::Mode>::deinterleaveStereo (dest[0], dest[1], src, num);
+            return;
+        }
+       #endif
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto* s = src + ch;
+            auto* d = dest[ch];
+
+            for (Size i = 0; i < num; ++i)
+                d[i] = s[i * (Size) numChannels];
+        }
+    }
+
 } // namespace
 } // namespace FloatVectorHelpers
 
@@ -1408,6 +2192,90 @@ FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::findMax
     return FloatVectorHelpers::findMaximum (src, numValues);
 }
 
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::multiplyWithRamp (FloatType* dest,
+                                                                                      FloatType startGain,
+                                                                                      FloatType endGain,
+                                                                                      CountType numValues) noexcept
+{
+    if (numValues > 0)
+        FloatVectorHelpers::multiplyWithRamp (dest, startGain, (endGain - startGain) / (FloatType) numValues, numValues);
+}
+
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::copyWithRamp (FloatType* dest,
+                                                                                  const FloatType* src,
+                                                                                  FloatType startGain,
+                                                                                  FloatType endGain,
+                                                                                  CountType numValues) noexcept
+{
+    if (numValues > 0)
+        FloatVectorHelpers::copyWithRamp (dest, src, startGain, (endGain - startGain) / (FloatType) numValues, numValues);
+}
+
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::addWithRamp (FloatType* dest,
+                                                                                 const FloatType* src,
+                                                                                 FloatType startGain,
+                                                                                 FloatType endGain,
+                                                                                 CountType numValues) noexcept
+{
+    if (numValues > 0)
+        FloatVectorHelpers::addWithRamp (dest, src, startGain, (endGain - startGain) / (FloatType) numValues, numValues);
+}
+
+template <typename FloatType, typename CountType>
+FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::dotProduct (const FloatType* src1,
+                                                                                     const FloatType* src2,
+                                                                                     CountType numValues) noexcept
+{
+    return FloatVectorHelpers::dotProduct (src1, src2, numValues);
+}
+
+template <typename FloatType, typename CountType>
+FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::sumOfSquares (const FloatType* src,
+                                                                                       CountType numValues) noexcept
+{
+    return FloatVectorHelpers::sumOfSquares (src, numValues);
+}
+
+template <typename FloatType, typename CountType>
+FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::findRMS (const FloatType* src,
+                                                                                  CountType numValues) noexcept
+{
+    if (numValues > 0)
+        return (FloatType) std::sqrt (FloatVectorHelpers::sumOfSquaresAsDouble (src, numValues) / (double) numValues);
+
+    return 0;
+}
+
+template <typename FloatType, typename CountType>
+CountType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::findIndexOfPeak (const FloatType* src,
+                                                                                         CountType numValues) noexcept
+{
+    return FloatVectorHelpers::findIndexOfPeak (src, numValues);
+}
+
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::interleave (FloatType* dest,
+                                                                                const FloatType* const* src,
+                                                                                int numChannels,
+                                                                                CountType numSamples) noexcept
+{
+    jassert (numChannels > 0);
+    FloatVectorHelpers::interleave (dest, src, numChannels, numSamples);
+}
+
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::deinterleave (FloatType* const* dest,
+                                                                                  const FloatType* src,
+                                                                                  int numChannels,
+                                                                                  CountType numSamples) noexcept
+{
+    jassert (numChannels > 0);
+    FloatVectorHelpers::deinterleave (dest, src, numChannels, numSamples);
+}
+
 template struct FloatVectorOperationsBase<float, int>;
 template struct FloatVectorOperationsBase<float, size_t>;
 template struct FloatVectorOperationsBase<double, int>;
@@ -1644,6 +2512,88 @@ public:
             FloatVectorOperations::fill (data2, (ValueType) 3, num);
             FloatVectorOperations::addWithMultiply (data1, data1, data2, num);
             u.expect (areAllValuesEqual (data1, num, (ValueType) 8));
+
+            doRampTest (u, random, data1, data2, num);
+            doReductionTest (u, random, data1, data2, num);
+            doInterleavingTest (u, random, num);
+        }
+
+        static void doRampTest (UnitTest& u, Random& random, ValueType* data1, ValueType* data2, int num)
+        {
+            const auto startGain = (ValueType) 0.25, endGain = (ValueType) 1.75;
+            HeapBlock<ValueType> expected (num);
+
+            const auto getGain = [&] (int i)
+            {
+                return startGain + (endGain - startGain) * (ValueType) i / (ValueType) num;
+            };
+
+            fillRandomly (random, data1, num);
+            fillRandomly (random, data2, num);
+
+            for (int i = 0; i < num; ++i)
+                expected[i] = data2[i] + data1[i] * getGain (i);
+
+            FloatVectorOperations::addWithRamp (data2, data1, startGain, endGain, num);
+            u.expect (buffersAreClose (data2, expected, num));
+
+            for (int i = 0; i < num; ++i)
+                expected[i] = data1[i] * getGain (i);
+
+            FloatVectorOperations::copyWithRamp (data2, data1, startGain, endGain, num);
+            u.expect (buffersAreClose (data2, expected, num));
+
+            FloatVectorOperations::multiplyWithRamp (data1, startGain, endGain, num);
+            u.expect (buffersAreClose (data1, expected, num));
+        }
+
+        static void doReductionTest (UnitTest& u, Random& random, ValueType* data1, ValueType* data2, int num)
+        {
+            fillRandomly (random, data1, num);
+            fillRandomly (random, data2, num);
+
+            double dot = 0.0, squares = 0.0;
+
+            for (int i = 0; i < num; ++i)
+            {
+                dot += (double) data1[i] * (double) data2[i];
+                squares += (double) data1[i] * (double) data1[i];
+            }
+
+            u.expect (valuesAreClose (FloatVectorOperations::dotProduct (data1, data2, num), (ValueType) dot));
+            u.expect (valuesAreClose (FloatVectorOperations::sumOfSquares (data1, num), (ValueType) squares));
+            u.expect (valuesAreClose (FloatVectorOperations::findRMS (data1, num), (ValueType) std::sqrt (squares / num)));
+
+            // The negative peak has the larger magnitude, and the first of two equal peaks wins
+            const auto peakIndex = random.nextInt (num);
+            data1[peakIndex] = (ValueType) -2000;
+
+            for (int i = peakIndex + 1; i < num; i += 7)
+                data1[i] = (ValueType) 2000;
+
+            u.expectEquals (FloatVectorOperations::findIndexOfPeak (data1, num), peakIndex);
+        }
+
+        static void doInterleavingTest (UnitTest& u, Random& random, int num)
+        {
+            const auto numChannels = random.nextInt ({ 1, 6 });
+            AudioBuffer<ValueType> channels (numChannels, num), result (numChannels, num);
+            HeapBlock<ValueType> interleaved (numChannels * num);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                fillRandomly (random, channels.getWritePointer (ch), num);
+
+            FloatVectorOperations::interleave (interleaved.get(), channels.getArrayOfReadPointers(), numChannels, num);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < num; ++i)
+                    if (! exactlyEqual (interleaved[i * numChannels + ch], channels.getSample (ch, i)))
+                        return u.expect (false, "interleave gave the wrong result");
+
+            FloatVectorOperations::deinterleave (result.getArrayOfWritePointers(), interleaved.get(), numChannels, num);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                u.expect (std::equal (result.getReadPointer (ch), result.getReadPointer (ch) + num, channels.getReadPointer (ch)));
         }
 
         static void doConversionTest (UnitTest& u, float* data1, float* data2, int* const int1, int num)
@@ -1695,8 +2645,141 @@ public:
         {
             return std::abs (v1 - v2) < std::numeric_limits<ValueType>::epsilon();
         }
+
+        // For results that can be rounded differently depending on the order of the operations
+        static bool valuesAreClose (ValueType actual, ValueType expected)
+        {
+            const auto tolerance = std::is_same_v<ValueType, float> ? (ValueType) 1.0e-4 : (ValueType) 1.0e-12;
+            return std::abs (actual - expected) <= tolerance * jmax ((ValueType) 1, std::abs (expected));
+        }
+
+        static bool buffersAreClose (const ValueType* d1, const ValueType* d2, int num)
+        {
+            while (--num >= 0)
+                if (! valuesAreClose (*d1++, *d2++))
+                    return false;
+
+            return true;
+        }
     };
 
+   #if JUCE_USE_AVX_DISPATCH
+    template <typename ValueType>
+    void compareWithFallback (Random random)
+    {
+        using FVO = FloatVectorOperations;
+        using FloatVectorHelpers::InstructionSet;
+
+        // Odd sizes and offsets, so that the scalar loops at the ends are exercised too
+        const int num = random.nextInt (300) + 1;
+        const int offset = random.nextInt (7);
+
+        HeapBlock<ValueType> src1 (num + 8), src2 (num + 8), expected (num + 8), actual (num + 8);
+        HeapBlock<int> ints (num + 8);
+
+        for (int i = 0; i < num + 8; ++i)
+        {
+            src1[i] = (ValueType) (random.nextDouble() * 2.0 - 1.0);
+            src2[i] = (ValueType) (random.nextDouble() * 2.0 - 1.0);
+            ints[i] = random.nextInt();
+        }
+
+        const auto s1 = src1 + offset, s2 = src2 + offset;
+
+        const auto check = [&] (InstructionSet set, const String& operation, auto&& function)
+        {
+            {
+                const FloatVectorHelpers::ScopedInstructionSet scope (InstructionSet::fallback);
+                FVO::copy (expected.get(), s2, num);
+                function (expected.get());
+            }
+
+            {
+                const FloatVectorHelpers::ScopedInstructionSet scope (set);
+                FVO::copy (actual + offset, s2, num);
+                function (actual + offset);
+            }
+
+            for (int i = 0; i < num; ++i)
+            {
+                // The fused multiply-adds are rounded once rather than twice
+                const auto tolerance = std::numeric_limits<ValueType>::epsilon() * (ValueType) 4;
+
+                if (std::abs (expected[i] - actual[offset + i]) > tolerance)
+                {
+                    expect (false, operation + " gave the wrong result");
+                    return;
+                }
+            }
+        };
+
+        for (auto set : { InstructionSet::avx2, InstructionSet::avx512 })
+        {
+            if (! FloatVectorHelpers::isInstructionSetAvailable (set))
+                continue;
+
+            const auto half = (ValueType) 0.5;
+
+            check (set, "fill",                   [&] (ValueType* d) { FVO::fill (d, half, num); });
+            check (set, "copyWithMultiply",       [&] (ValueType* d) { FVO::copyWithMultiply (d, s1, half, num); });
+            check (set, "add scalar",             [&] (ValueType* d) { FVO::add (d, half, num); });
+            check (set, "add source and scalar",  [&] (ValueType* d) { FVO::add (d, s1, half, num); });
+            check (set, "add",                    [&] (ValueType* d) { FVO::add (d, s1, num); });
+            check (set, "add two sources",        [&] (ValueType* d) { FVO::add (d, s1, s2, num); });
+            check (set, "subtract",               [&] (ValueType* d) { FVO::subtract (d, s1, num); });
+            check (set, "subtract two sources",   [&] (ValueType* d) { FVO::subtract (d, s1, s2, num); });
+            check (set, "addWithMultiply scalar", [&] (ValueType* d) { FVO::addWithMultiply (d, s1, half, num); });
+            check (set, "addWithMultiply",        [&] (ValueType* d) { FVO::addWithMultiply (d, s1, s2, num); });
+            check (set, "subtractWithMultiply scalar", [&] (ValueType* d) { FVO::subtractWithMultiply (d, s1, half, num); });
+            check (set, "subtractWithMultiply",   [&] (ValueType* d) { FVO::subtractWithMultiply (d, s1, s2, num); });
+            check (set, "multiply",               [&] (ValueType* d) { FVO::multiply (d, s1, num); });
+            check (set, "multiply two sources",   [&] (ValueType* d) { FVO::multiply (d, s1, s2, num); });
+            check (set, "multiply scalar",        [&] (ValueType* d) { FVO::multiply (d, half, num); });
+            check (set, "multiply source by scalar", [&] (ValueType* d) { FVO::multiply (d, s1, half, num); });
+            check (set, "negate",                 [&] (ValueType* d) { FVO::negate (d, s1, num); });
+            check (set, "abs",                    [&] (ValueType* d) { FVO::abs (d, s1, num); });
+            check (set, "min scalar",             [&] (ValueType* d) { FVO::min (d, s1, (ValueType) 0, num); });
+            check (set, "min",                    [&] (ValueType* d) { FVO::min (d, s1, s2, num); });
+            check (set, "max scalar",             [&] (ValueType* d) { FVO::max (d, s1, (ValueType) 0, num); });
+            check (set, "max",                    [&] (ValueType* d) { FVO::max (d, s1, s2, num); });
+            check (set, "clip",                   [&] (ValueType* d) { FVO::clip (d, s1, -half, half, num); });
+            check (set, "multiplyWithRamp",       [&] (ValueType* d) { FVO::multiplyWithRamp (d, half, (ValueType) 2, num); });
+            check (set, "copyWithRamp",           [&] (ValueType* d) { FVO::copyWithRamp (d, s1, half, (ValueType) 2, num); });
+            check (set, "addWithRamp",            [&] (ValueType* d) { FVO::addWithRamp (d, s1, half, (ValueType) 2, num); });
+
+            const FloatVectorHelpers::ScopedInstructionSet scope (set);
+            expect (FVO::findMinAndMax (s1, num) == Range<ValueType>::findMinAndMax (s1, num));
+            expect (exactlyEqual (FVO::findMinimum (s1, num), juce::findMinimum (s1, num)));
+            expect (exactlyEqual (FVO::findMaximum (s1, num), juce::findMaximum (s1, num)));
+
+            const auto peak = std::max_element (s1, s1 + num, [] (auto a, auto b) { return std::abs (a) < std::abs (b); });
+            expectEquals (FVO::findIndexOfPeak (s1, num), (int) (peak - s1));
+
+            auto dot = (ValueType) 0;
+
+            for (int i = 0; i < num; ++i)
+                dot += s1[i] * s2[i];
+
+            expect (std::abs (FVO::dotProduct (s1, s2, num) - dot) <= std::numeric_limits<ValueType>::epsilon() * (ValueType) num);
+
+            FVO::interleave (actual.get(), std::array<const ValueType*, 2> { s1, s2 }.data(), 2, num / 2);
+            FVO::deinterleave (std::array<ValueType*, 2> { expected.get(), expected + num / 2 }.data(), actual.get(), 2, num / 2);
+
+            for (int i = 0; i < num / 2; ++i)
+                expect (exactlyEqual (actual[2 * i], s1[i]) && exactlyEqual (actual[2 * i + 1], s2[i])
+                        && exactlyEqual (expected[i], s1[i]) && exactlyEqual (expected[num / 2 + i], s2[i]));
+
+            if constexpr (std::is_same_v<ValueType, float>)
+            {
+                FVO::convertFixedToFloat (actual.get(), ints + offset, 1.0f / 65536.0f, num);
+
+                for (int i = 0; i < num; ++i)
+                    expect (exactlyEqual (actual[i], (float) ints[offset + i] * (1.0f / 65536.0f)));
+            }
+        }
+    }
+   #endif
+
     void runTest() override
     {
         beginTest ("FloatVectorOperations");
@@ -1706,11 +2789,151 @@ public:
             TestRunner<float>::runTest (*this, getRandom());
             TestRunner<double>::runTest (*this, getRandom());
         }
+
+        beginTest ("Float RMS is accumulated in double precision");
+        {
+            // Summing this many squares in float would drift far from the exact result
+            AudioBuffer<float> buffer (1, 1 << 22);
+            FloatVectorOperations::fill (buffer.getWritePointer (0), 0.1f, buffer.getNumSamples());
+
+            const auto expectedSquares = (double) buffer.getNumSamples() * (double) 0.1f * (double) 0.1f;
+
+            expectWithinAbsoluteError ((double) FloatVectorOperations::sumOfSquares (buffer.getReadPointer (0), buffer.getNumSamples()),
+                                       expectedSquares, expectedSquares * 1.0e-6);
+            expectWithinAbsoluteError (buffer.getRMSLevel (0, 0, buffer.getNumSamples()), 0.1f, 1.0e-6f);
+            expectWithinAbsoluteError (buffer.getRMSLevel (0, 1, buffer.getNumSamples() - 1), 0.1f, 1.0e-6f);
+        }
+
+       #if JUCE_USE_AVX_DISPATCH
+        beginTest ("AVX versions match the fallback versions");
+
+        for (int i = 200; --i >= 0;)
+        {
+            compareWithFallback<float> (getRandom());
+            compareWithFallback<double> (getRandom());
+        }
+       #endif
     }
 };
 
 static FloatVectorOperationsTests vectorOpTests;
 
+//==============================================================================
+class FloatVectorOperationsBenchmark final : public Benchmark
+{
+public:
+    FloatVectorOperationsBenchmark()
+        : Benchmark ("FloatVectorOperations", UnitTestCategories::audio)
+    {}
+
+    void runBenchmark() override
+    {
+       #if JUCE_USE_AVX_DISPATCH
+        // Measures each function with each instruction set that this machine supports,
+        // and then logs a table of how much faster the AVX versions are
+        using FloatVectorHelpers::InstructionSet;
+
+        std::map<String, std::map<InstructionSet, double>> times;
+        StringArray operationNames;
+
+        for (auto set : { InstructionSet::fallback, InstructionSet::avx2, InstructionSet::avx512 })
+        {
+            if (! FloatVectorHelpers::isInstructionSetAvailable (set))
+                continue;
+
+            const FloatVectorHelpers::ScopedInstructionSet scope (set);
+            const String setName (set == InstructionSet::avx512 ? "avx512" : (set == InstructionSet::avx2 ? "avx2" : "sse"));
+
+            const auto record = [&] (const String& operationName, double nanoseconds)
+            {
+                operationNames.addIfNotAlreadyThere (operationName);
+                times[operationName][set] = nanoseconds;
+            };
+
+            runBenchmarks<float> ("float, " + setName, "float", record);
+            runBenchmarks<double> ("double, " + setName, "double", record);
+        }
+
+        logMessage (String ("Function").paddedRight (' ', 36) + String ("SSE (ns)").paddedLeft (' ', 10)
+                      + String ("AVX2").paddedLeft (' ', 18) + String ("AVX-512").paddedLeft (' ', 18));
+
+        for (const auto& operationName : operationNames)
+        {
+            auto& row = times[operationName];
+            auto line = operationName.paddedRight (' ', 36) + String (row[InstructionSet::fallback], 1).paddedLeft (' ', 10);
+
+            for (auto set : { InstructionSet::avx2, InstructionSet::avx512 })
+            {
+                const auto it = row.find (set);
+                line += (it != row.end() && it->second > 0.0)
+                            ? (String (it->second, 1) + " (" + String (row[InstructionSet::fallback] / it->second, 2) + "x)").paddedLeft (' ', 18)
+                            : String ("-").paddedLeft (' ', 18);
+            }
+
+            logMessage (line);
+        }
+       #else
+        runBenchmarks<float> ("float", "float", [] (const String&, double) {});
+        runBenchmarks<double> ("double", "double", [] (const String&, double) {});
+       #endif
+    }
+
+private:
+    template <typename ValueType, typename RecordFn>
+    void runBenchmarks (const String& caseSuffix, const String& typeName, RecordFn&& record)
+    {
+        using FVO = FloatVectorOperations;
+        constexpr int num = 512;
+
+        HeapBlock<ValueType> src1 (num), src2 (num), dest (num);
+        Random random (1);
+
+        for (int i = 0; i < num; ++i)
+        {
+            src1[i] = (ValueType) (random.nextDouble() * 2.0 - 1.0);
+            src2[i] = (ValueType) (random.nextDouble() * 2.0 - 1.0);
+        }
+
+        FVO::copy (dest.get(), src1.get(), num);
+
+        const std::array<const ValueType*, 2> stereo { src1.get(), src2.get() };
+        const std::array<ValueType*, 2> stereoDest { dest.get(), dest + num / 2 };
+
+        const auto measureOperation = [&] (const char* operationName, auto&& operation)
+        {
+            record (String (operationName) + " (" + typeName + ")",
+                    measure (String (operationName) + " (" + caseSuffix + ")", [&]
+                    {
+                        operation();
+                        doNotOptimise (dest[0]);
+                    }, num));
+        };
+
+        measureOperation ("copy",               [&] { FVO::copy (dest.get(), src1.get(), num); });
+        measureOperation ("copyWithMultiply",   [&] { FVO::copyWithMultiply (dest.get(), src1.get(), (ValueType) 0.5, num); });
+        measureOperation ("add",                [&] { FVO::add (dest.get(), src1.get(), src2.get(), num); });
+        measureOperation ("multiply",           [&] { FVO::multiply (dest.get(), src1.get(), src2.get(), num); });
+        measureOperation ("addWithMultiply",    [&] { FVO::addWithMultiply (dest.get(), src1.get(), (ValueType) 0.5, num); });
+        measureOperation ("clip",               [&] { FVO::clip (dest.get(), src1.get(), (ValueType) -0.5, (ValueType) 0.5, num); });
+        measureOperation ("findMinAndMax",      [&] { doNotOptimise (FVO::findMinAndMax (src1.get(), num)); });
+        measureOperation ("findMaximum",        [&] { doNotOptimise (FVO::findMaximum (src1.get(), num)); });
+        measureOperation ("fill",               [&] { FVO::fill (dest.get(), (ValueType) 0.5, num); });
+        measureOperation ("subtract",           [&] { FVO::subtract (dest.get(), src1.get(), src2.get(), num); });
+        measureOperation ("multiply (scalar)",  [&] { FVO::multiply (dest.get(), src1.get(), (ValueType) 0.5, num); });
+        measureOperation ("subtractWithMultiply", [&] { FVO::subtractWithMultiply (dest.get(), src1.get(), src2.get(), num); });
+        measureOperation ("abs",                [&] { FVO::abs (dest.get(), src1.get(), num); });
+        measureOperation ("max",                [&] { FVO::max (dest.get(), src1.get(), src2.get(), num); });
+        measureOperation ("copyWithRamp",       [&] { FVO::copyWithRamp (dest.get(), src1.get(), (ValueType) 0.5, (ValueType) 0.75, num); });
+        measureOperation ("addWithRamp",        [&] { FVO::addWithRamp (dest.get(), src1.get(), (ValueType) 0.5, (ValueType) 0.75, num); });
+        measureOperation ("dotProduct",         [&] { doNotOptimise (FVO::dotProduct (src1.get(), src2.get(), num)); });
+        measureOperation ("findIndexOfPeak",    [&] { doNotOptimise (FVO::findIndexOfPeak (src1.get(), num)); });
+        measureOperation ("interleave (stereo)", [&] { FVO::interleave (dest.get(), stereo.data(), 2, num / 2); });
+        measureOperation ("deinterleave (stereo)", [&] { FVO::deinterleave (stereoDest.data(), src1.get(), 2, num / 2); });
+    }
+};
+
+static FloatVectorOperationsBenchmark vectorOpBenchmark;
+
 #endif
 
 } // namespace juce
@@ -136,6 +136,52 @@ struct FloatVectorOperationsBase
 
     /** Finds the maximum value in the given array. */
     static FloatType JUCE_CALLTYPE findMaximum (const FloatType* src, CountType numValues) noexcept;
+
+    /** Multiplies the destination values by a gain that changes linearly from one value to the next.
+
+        The first value is multiplied by startGain, and endGain is the gain that would apply
+        to the value after the last one. This means that the ramps join up smoothly if the
+        endGain of one block is used as the startGain of the next.
+    */
+    static void JUCE_CALLTYPE multiplyWithRamp (FloatType* dest, FloatType startGain, FloatType endGain, CountType numValues) noexcept;
+
+    /** Multiplies the source values by a changing gain and stores the results in the destination array.
+        The gain changes in the same way as it does in multiplyWithRamp().
+    */
+    static void JUCE_CALLTYPE copyWithRamp (FloatType* dest, const FloatType* src, FloatType startGain, FloatType endGain, CountType numValues) noexcept;
+
+    /** Multiplies the source values by a changing gain, then adds them to the destination values.
+        The gain changes in the same way as it does in multiplyWithRamp().
+    */
+    static void JUCE_CALLTYPE addWithRamp (FloatType* dest, const FloatType* src, FloatType startGain, FloatType endGain, CountType numValues) noexcept;
+
+    /** Returns the sum of the products of the corresponding source1 and source2 values. */
+    static FloatType JUCE_CALLTYPE dotProduct (const FloatType* src1, const FloatType* src2, CountType numValues) noexcept;
+
+    /** Returns the sum of the squares of the values in the given array.
+
+        Float values are accumulated in double precision, so long arrays don't lose accuracy.
+    */
+    static FloatType JUCE_CALLTYPE sumOfSquares (const FloatType* src, CountType numValues) noexcept;
+
+    /** Returns the root mean square of the values in the given array, or 0 if it's empty.
+
+        Float values are accumulated in double precision, so long arrays don't lose accuracy.
+    */
+    static FloatType JUCE_CALLTYPE findRMS (const FloatType* src, CountType numValues) noexcept;
+
+    /** Returns the index of the value with the largest magnitude in the given array.
+        If more than one value has that magnitude, this returns the first one's index.
+    */
+    static CountType JUCE_CALLTYPE findIndexOfPeak (const FloatType* src, CountType numValues) noexcept;
+
+    /** Copies a set of separate channels into a single interleaved array, so that sample i
+        of channel c ends up in dest[i * numChannels + c].
+    */
+    static void JUCE_CALLTYPE interleave (FloatType* dest, const FloatType* const* src, int numChannels, CountType numSamples) noexcept;
+
+    /** Copies an interleaved array into a set of separate channels. This is the reverse of interleave(). */
+    static void JUCE_CALLTYPE deinterleave (FloatType* const* dest, const FloatType* src, int numChannels, CountType numSamples) noexcept;
 };
 
 #if ! DOXYGEN
@@ -161,7 +207,16 @@ struct NameForwarder : public Bases...
           Bases::clip...,
           Bases::findMinAndMax...,
           Bases::findMinimum...,
-          Bases::findMaximum...;
+          Bases::findMaximum...,
+          Bases::multiplyWithRamp...,
+          Bases::copyWithRamp...,
+          Bases::addWithRamp...,
+          Bases::dotProduct...,
+          Bases::sumOfSquares...,
+          Bases::findRMS...,
+          Bases::findIndexOfPeak...,
+          Bases::interleave...,
+          Bases::deinterleave...;
 };
 
 } // namespace detail
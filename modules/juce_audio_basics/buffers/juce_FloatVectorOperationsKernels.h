@@ -0,0 +1,461 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+/*  The FloatVectorOperations functions, written in terms of a set of BasicOps32 and
+    BasicOps64 structs.
+
+    This file deliberately has no include guard: juce_FloatVectorOperations.cpp
+    includes it once for each instruction set that it can choose at runtime, inside
+    a namespace that declares the BasicOps structs for that instruction set, and with
+    the compiler set up to generate code for it.
+*/
+
+template <int typeSize> struct ModeType    { using Mode = BasicOps32; };
+template <>             struct ModeType<8> { using Mode = BasicOps64; };
+
+/*  Compilers only clear the upper halves of the wide registers on the way out of a
+    function when they're optimising, and the callers are compiled for SSE, which
+    gets much slower if those halves are left dirty. So the kernels do it themselves
+    as soon as they've finished with the wide registers.
+*/
+#define JUCE_WIDE_VEC_LOOP(vecOp, normalOp) \
+    Size i = 0; \
+    for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)  Mode::storeU (dest + i, vecOp); \
+    _mm256_zeroupper(); \
+    for (; i < num; ++i)  normalOp;
+
+template <typename Type, typename Size>
+void fill (Type* dest, Type valueToFill, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    const auto val = Mode::load1 (valueToFill);
+    JUCE_WIDE_VEC_LOOP (val, dest[i] = valueToFill)
+}
+
+template <typename Type, typename Size>
+void copyWithMultiply (Type* dest, const Type* src, Type multiplier, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    const auto mult = Mode::load1 (multiplier);
+    JUCE_WIDE_VEC_LOOP (Mode::mul (mult, Mode::loadU (src + i)), dest[i] = src[i] * multiplier)
+}
+
+template <typename Type, typename Size>
+void add (Type* dest, Type amount, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    const auto amountToAdd = Mode::load1 (amount);
+    JUCE_WIDE_VEC_LOOP (Mode::add (Mode::loadU (dest + i), amountToAdd), dest[i] += amount)
+}
+
+template <typename Type, typename Size>
+void add (Type* dest, const Type* src, Type amount, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    const auto am = Mode::load1 (amount);
+    JUCE_WIDE_VEC_LOOP (Mode::add (am, Mode::loadU (src + i)), dest[i] = src[i] + amount)
+}
+
+template <typename Type, typename Size>
+void add (Type* dest, const Type* src, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    JUCE_WIDE_VEC_LOOP (Mode::add (Mode::loadU (dest + i), Mode::loadU (src + i)), dest[i] += src[i])
+}
+
+template <typename Type, typename Size>
+void add (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    JUCE_WIDE_VEC_LOOP (Mode::add (Mode::loadU (src1 + i), Mode::loadU (src2 + i)), dest[i] = src1[i] + src2[i])
+}
+
+template <typename Type, typename Size>
+void subtract (Type* dest, const Type* src, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    JUCE_WIDE_VEC_LOOP (Mode::sub (Mode::loadU (dest + i), Mode::loadU (src + i)), dest[i] -= src[i])
+}
+
+template <typename Type, typename Size>
+void subtract (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    JUCE_WIDE_VEC_LOOP (Mode::sub (Mode::loadU (src1 + i), Mode::loadU (src2 + i)), dest[i] = src1[i] - src2[i])
+}
+
+template <typename Type, typename Size>
+void addWithMultiply (Type* dest, const Type* src, Type multiplier, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    const auto mult = Mode::load1 (multiplier);
+    JUCE_WIDE_VEC_LOOP (Mode::mulAdd (mult, Mode::loadU (src + i), Mode::loadU (dest + i)), dest[i] += src[i] * multiplier)
+}
+
+template <typename Type, typename Size>
+void addWithMultiply (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    JUCE_WIDE_VEC_LOOP (Mode::mulAdd (Mode::loadU (src1 + i), Mode::loadU (src2 + i), Mode::loadU (dest + i)), dest[i] += src1[i] * src2[i])
+}
+
+template <typename Type, typename Size>
+void subtractWithMultiply (Type* dest, const Type* src, Type multiplier, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    const auto mult = Mode::load1 (multiplier);
+    JUCE_WIDE_VEC_LOOP (Mode::negMulAdd (mult, Mode::loadU (src + i), Mode::loadU (dest + i)), dest[i] -= src[i] * multiplier)
+}
+
+template <typename Type, typename Size>
+void subtractWithMultiply (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    JUCE_WIDE_VEC_LOOP (Mode::negMulAdd (Mode::loadU (src1 + i), Mode::loadU (src2 + i), Mode::loadU (dest + i)), dest[i] -= src1[i] * src2[i])
+}
+
+template <typename Type, typename Size>
+void multiply (Type* dest, const Type* src, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    JUCE_WIDE_VEC_LOOP (Mode::mul (Mode::loadU (dest + i), Mode::loadU (src + i)), dest[i] *= src[i])
+}
+
+template <typename Type, typename Size>
+void multiply (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    JUCE_WIDE_VEC_LOOP (Mode::mul (Mode::loadU (src1 + i), Mode::loadU (src2 + i)), dest[i] = src1[i] * src2[i])
+}
+
+template <typename Type, typename Size>
+void multiply (Type* dest, Type multiplier, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    const auto mult = Mode::load1 (multiplier);
+    JUCE_WIDE_VEC_LOOP (Mode::mul (Mode::loadU (dest + i), mult), dest[i] *= multiplier)
+}
+
+template <typename Type, typename Size>
+void multiply (Type* dest, const Type* src, Type multiplier, Size num) noexcept
+{
+    copyWithMultiply (dest, src, multiplier, num);
+}
+
+template <typename Type, typename Size>
+void abs (Type* dest, const Type* src, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    JUCE_WIDE_VEC_LOOP (Mode::abs (Mode::loadU (src + i)), dest[i] = std::abs (src[i]))
+}
+
+template <typename Type, typename Size>
+void min (Type* dest, const Type* src, Type comp, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    const auto cmp = Mode::load1 (comp);
+    JUCE_WIDE_VEC_LOOP (Mode::min (Mode::loadU (src + i), cmp), dest[i] = jmin (src[i], comp))
+}
+
+template <typename Type, typename Size>
+void min (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    JUCE_WIDE_VEC_LOOP (Mode::min (Mode::loadU (src1 + i), Mode::loadU (src2 + i)), dest[i] = jmin (src1[i], src2[i]))
+}
+
+template <typename Type, typename Size>
+void max (Type* dest, const Type* src, Type comp, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    const auto cmp = Mode::load1 (comp);
+    JUCE_WIDE_VEC_LOOP (Mode::max (Mode::loadU (src + i), cmp), dest[i] = jmax (src[i], comp))
+}
+
+template <typename Type, typename Size>
+void max (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    JUCE_WIDE_VEC_LOOP (Mode::max (Mode::loadU (src1 + i), Mode::loadU (src2 + i)), dest[i] = jmax (src1[i], src2[i]))
+}
+
+template <typename Type, typename Size>
+void clip (Type* dest, const Type* src, Type low, Type high, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    const auto lo = Mode::load1 (low);
+    const auto hi = Mode::load1 (high);
+    JUCE_WIDE_VEC_LOOP (Mode::max (Mode::min (Mode::loadU (src + i), hi), lo), dest[i] = jmax (jmin (src[i], high), low))
+}
+
+template <typename Size>
+void convertFixedToFloat (float* dest, const int* src, float multiplier, Size num) noexcept
+{
+    using Mode = BasicOps32;
+    const auto mult = Mode::load1 (multiplier);
+    JUCE_WIDE_VEC_LOOP (Mode::mul (mult, Mode::loadAndConvert (src + i)), dest[i] = (float) src[i] * multiplier)
+}
+
+template <typename Type, typename Size>
+Type findMinOrMax (const Type* src, Size num, const bool isMinimum) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+
+    if (num < (Size) Mode::numParallel)
+        return isMinimum ? juce::findMinimum (src, num)
+                         : juce::findMaximum (src, num);
+
+    auto val = Mode::loadU (src);
+    Size i = Mode::numParallel;
+
+    if (isMinimum)
+    {
+        for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+            val = Mode::min (val, Mode::loadU (src + i));
+    }
+    else
+    {
+        for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+            val = Mode::max (val, Mode::loadU (src + i));
+    }
+
+    auto result = isMinimum ? Mode::min (val)
+                            : Mode::max (val);
+    _mm256_zeroupper();
+
+    for (; i < num; ++i)
+        result = isMinimum ? jmin (result, src[i])
+                           : jmax (result, src[i]);
+
+    return result;
+}
+
+template <typename Type, typename Size>
+Range<Type> findMinAndMax (const Type* src, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+
+    if (num < (Size) Mode::numParallel)
+        return Range<Type>::findMinAndMax (src, num);
+
+    auto mn = Mode::loadU (src);
+    auto mx = mn;
+    Size i = Mode::numParallel;
+
+    for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+    {
+        const auto v = Mode::loadU (src + i);
+        mn = Mode::min (mn, v);
+        mx = Mode::max (mx, v);
+    }
+
+    Range<Type> result (Mode::min (mn), Mode::max (mx));
+    _mm256_zeroupper();
+
+    for (; i < num; ++i)
+        result = result.getUnionWith (src[i]);
+
+    return result;
+}
+
+template <typename Type, typename Size>
+Type findMinimum (const Type* src, Size num) noexcept
+{
+    return findMinOrMax (src, num, true);
+}
+
+template <typename Type, typename Size>
+Type findMaximum (const Type* src, Size num) noexcept
+{
+    return findMinOrMax (src, num, false);
+}
+
+template <typename Type, typename Size>
+Size findIndexOfPeak (const Type* src, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+
+    Type peak = 0;
+    Size i = 0;
+
+    if (num >= (Size) Mode::numParallel)
+    {
+        auto val = Mode::abs (Mode::loadU (src));
+
+        for (i = Mode::numParallel; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+            val = Mode::max (val, Mode::abs (Mode::loadU (src + i)));
+
+        peak = Mode::max (val);
+        _mm256_zeroupper();
+    }
+
+    for (; i < num; ++i)
+        peak = jmax (peak, std::abs (src[i]));
+
+    for (i = 0; i < num; ++i)
+        if (exactlyEqual (std::abs (src[i]), peak))
+            return i;
+
+    return 0;
+}
+
+template <typename Type, typename Size>
+Type dotProduct (const Type* src1, const Type* src2, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+
+    auto sum = Mode::load1 ((Type) 0);
+    Size i = 0;
+
+    for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+        sum = Mode::mulAdd (Mode::loadU (src1 + i), Mode::loadU (src2 + i), sum);
+
+    auto result = Mode::sum (sum);
+    _mm256_zeroupper();
+
+    for (; i < num; ++i)
+        result += src1[i] * src2[i];
+
+    return result;
+}
+
+template <typename Size>
+double sumOfSquaresAsDouble (const float* src, Size num) noexcept
+{
+    using Mode = BasicOps64;
+
+    auto sum = Mode::load1 (0.0);
+    Size i = 0;
+
+    for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+    {
+        const auto values = Mode::loadWidened (src + i);
+        sum = Mode::mulAdd (values, values, sum);
+    }
+
+    auto result = Mode::sum (sum);
+    _mm256_zeroupper();
+
+    for (; i < num; ++i)
+        result += (double) src[i] * (double) src[i];
+
+    return result;
+}
+
+//==============================================================================
+// The gains for the ramps are worked out from the index of each value, as in the SSE versions
+template <typename Mode>
+struct RampGains
+{
+    using Type = typename Mode::Type;
+    using ParallelType = typename Mode::ParallelType;
+
+    RampGains (Type startGain, Type increment) noexcept
+        : start (Mode::load1 (startGain)),
+          inc (Mode::load1 (increment)),
+          step (Mode::load1 ((Type) Mode::numParallel))
+    {
+        Type offsets[Mode::numParallel];
+
+        for (int i = 0; i < (int) Mode::numParallel; ++i)
+            offsets[i] = (Type) i;
+
+        indices = Mode::loadU (offsets);
+    }
+
+    forcedinline ParallelType next() noexcept
+    {
+        const auto gains = Mode::mulAdd (inc, indices, start);
+        indices = Mode::add (indices, step);
+        return gains;
+    }
+
+    ParallelType start, inc, step, indices;
+};
+
+template <typename Type, typename Size>
+void multiplyWithRamp (Type* dest, Type startGain, Type increment, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    RampGains<Mode> gains (startGain, increment);
+    JUCE_WIDE_VEC_LOOP (Mode::mul (Mode::loadU (dest + i), gains.next()), dest[i] *= startGain + increment * (Type) i)
+}
+
+template <typename Type, typename Size>
+void copyWithRamp (Type* dest, const Type* src, Type startGain, Type increment, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    RampGains<Mode> gains (startGain, increment);
+    JUCE_WIDE_VEC_LOOP (Mode::mul (Mode::loadU (src + i), gains.next()), dest[i] = src[i] * (startGain + increment * (Type) i))
+}
+
+template <typename Type, typename Size>
+void addWithRamp (Type* dest, const Type* src, Type startGain, Type increment, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    RampGains<Mode> gains (startGain, increment);
+    JUCE_WIDE_VEC_LOOP (Mode::mulAdd (Mode::loadU (src + i), gains.next(), Mode::loadU (dest + i)), dest[i] += src[i] * (startGain + increment * (Type) i))
+}
+
+//==============================================================================
+template <typename Type, typename Size>
+void interleaveStereo (Type* dest, const Type* left, const Type* right, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    Size i = 0;
+
+    for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+        Mode::interleave (dest + 2 * i, Mode::loadU (left + i), Mode::loadU (right + i));
+
+    _mm256_zeroupper();
+
+    for (; i < num; ++i)
+    {
+        dest[2 * i]     = left[i];
+        dest[2 * i + 1] = right[i];
+    }
+}
+
+template <typename Type, typename Size>
+void deinterleaveStereo (Type* left, Type* right, const Type* src, Size num) noexcept
+{
+    using Mode = typename ModeType<sizeof (Type)>::Mode;
+    Size i = 0;
+
+    for (; i + (Size) Mode::numParallel <= num; i += (Size) Mode::numParallel)
+    {
+        typename Mode::ParallelType l, r;
+        Mode::deinterleave (src + 2 * i, l, r);
+        Mode::storeU (left + i, l);
+        Mode::storeU (right + i, r);
+    }
+
+    _mm256_zeroupper();
+
+    for (; i < num; ++i)
+    {
+        left[i]  = src[2 * i];
+        right[i] = src[2 * i + 1];
+    }
+}
+
+#undef JUCE_WIDE_VEC_LOOP
@@ -35,7 +35,15 @@
  #define alloca __builtin_alloca
 #endif
 
-#if JUCE_USE_SSE_INTRINSICS
+#if JUCE_USE_AVX_DISPATCH
+ #include <immintrin.h>
+
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#elif JUCE_USE_SSE_INTRINSICS
  #include <emmintrin.h>
 #endif
 
@@ -70,6 +70,22 @@
  #undef JUCE_USE_SSE_INTRINSICS
 #endif
 
+/*  When this is enabled, FloatVectorOperations checks the CPU at runtime, and uses
+    AVX2/FMA or AVX-512 versions of its functions when they're supported.
+*/
+#if JUCE_MINGW || (JUCE_CLANG && defined (_MSC_VER))
+ #define JUCE_USE_AVX_DISPATCH 0
+#endif
+
+#ifndef JUCE_USE_AVX_DISPATCH
+ #define JUCE_USE_AVX_DISPATCH 1
+#endif
+
+#if ! JUCE_USE_SSE_INTRINSICS
+ #undef JUCE_USE_AVX_DISPATCH
+ #define JUCE_USE_AVX_DISPATCH 0
+#endif
+
 #if __ARM_NEON__ && ! (JUCE_USE_VDSP_FRAMEWORK || defined (JUCE_USE_ARM_NEON))
  #define JUCE_USE_ARM_NEON 1
 #endif
@@ -82,10 +98,10 @@
 #endif
 
 //==============================================================================
-#include "buffers/juce_AudioDataConverters.h"
 JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4661)
 #include "buffers/juce_FloatVectorOperations.h"
 JUCE_END_IGNORE_WARNINGS_MSVC
+#include "buffers/juce_AudioDataConverters.h"
 #include "buffers/juce_AudioSampleBuffer.h"
 #include "buffers/juce_AudioChannelSet.h"
 #include "buffers/juce_AudioProcessLoadMeasurer.h"
@@ -0,0 +1,1113 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  Carries audio from one device's callback to another's, when the two devices
+    are running from different clocks.
+
+    The writer pushes blocks into a lock-free FIFO, and the reader resamples them
+    as it pulls them out. Each time the reader is called, it estimates how much
+    audio is in the FIFO, and a PI controller nudges the resampling ratio to keep
+    that amount at a fixed target. Once the loop has settled, the correction that
+    it applies is the drift between the two clocks.
+*/
+class AggregateDeviceFifo
+{
+public:
+    AggregateDeviceFifo (int numChannelsToUse,
+                         double writerSampleRate, int writerBlockSize,
+                         double readerSampleRate, int readerBlockSize)
+        : numChannels (numChannelsToUse),
+          writerRate (writerSampleRate),
+          readerRate (readerSampleRate),
+          writerBlockSeconds (writerBlockSize / writerSampleRate),
+          nominalRatio (writerSampleRate / readerSampleRate),
+          interpolators ((size_t) numChannelsToUse)
+    {
+        const auto maxSamplesPerRead = (int) std::ceil (readerBlockSize * nominalRatio * (1.0 + maxCorrection)) + 1;
+
+        // The writer delivers whole blocks, so there may be up to a block less than the
+        // estimated level when the reader runs. The rest is a margin for scheduling jitter.
+        targetLevel = 1.5 * (writerBlockSize + maxSamplesPerRead);
+
+        const auto capacity = nextPowerOfTwo (roundToInt (targetLevel) * 4 + writerBlockSize);
+        buffer.setSize (numChannels, capacity);
+        fifo.setTotalSize (capacity);
+
+        reset();
+    }
+
+    int getNumChannels() const noexcept             { return numChannels; }
+
+    /** Clears the FIFO. This must only be called while neither end is in use. */
+    void reset()
+    {
+        fifo.reset();
+        buffer.clear();
+        isReading = false;
+        integral = 0.0;
+        ratio = nominalRatio;
+        drift = 0.0;
+        numXRuns = 0;
+        latencySeconds = getTargetLatencySeconds();
+    }
+
+    /** The latency that the FIFO aims to add, once it has settled. */
+    double getTargetLatencySeconds() const noexcept
+    {
+        return (targetLevel + (double) WindowedSincInterpolator::getBaseLatency()) / writerRate;
+    }
+
+    double getDriftPPM() const noexcept             { return drift * 1.0e6; }
+    double getLatencySeconds() const noexcept       { return latencySeconds; }
+    int getNumXRuns() const noexcept                { return numXRuns; }
+
+    //==============================================================================
+    /** Called by the writing device, with the time at which its callback started. */
+    void write (const float* const* source, int numSamples, double time) noexcept
+    {
+        if (fifo.getFreeSpace() < numSamples)
+        {
+            ++numXRuns;
+            return;
+        }
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            buffer.copyFrom (i, start1, source[i], size1);
+
+            if (size2 > 0)
+                buffer.copyFrom (i, start2, source[i] + size1, size2);
+        }
+
+        lastWriteTime = time;
+        fifo.finishedWrite (size1 + size2);
+    }
+
+    /** Called by the reading device, with the time at which its callback started. */
+    void read (float* const* dest, int numSamples, double time) noexcept
+    {
+        const auto numReady = fifo.getNumReady();
+
+        // The writer's device has been filling its own buffer since its last callback,
+        // so counting that too removes the sawtooth that the block size would add
+        const auto timeSinceWrite = jlimit (0.0, writerBlockSeconds, time - lastWriteTime.load());
+        const auto level = numReady + timeSinceWrite * writerRate;
+
+        if (! isReading)
+        {
+            if (numReady < targetLevel)
+            {
+                clear (dest, numSamples);
+                return;
+            }
+
+            for (auto& interpolator : interpolators)
+                interpolator.reset();
+
+            smoothedLevel = level;
+            isReading = true;
+        }
+
+        const auto blockSeconds = numSamples / readerRate;
+        smoothedLevel += (1.0 - std::exp (-blockSeconds / levelSmoothingSeconds)) * (level - smoothedLevel);
+
+        const auto error = smoothedLevel - targetLevel;
+        const auto maxIntegral = maxCorrection * writerRate / integralGain;
+        integral = jlimit (-maxIntegral, maxIntegral, integral + error * blockSeconds);
+
+        const auto correction = jlimit (-maxCorrection, maxCorrection,
+                                        (proportionalGain * error + integralGain * integral) / writerRate);
+        ratio = nominalRatio * (1.0 + correction);
+        drift = correction;
+        latencySeconds = (smoothedLevel + (double) WindowedSincInterpolator::getBaseLatency()) / writerRate;
+
+        const auto numNeeded = (int) std::ceil (ratio * numSamples) + 1;
+
+        if (numReady < numNeeded)
+        {
+            // Start again once the FIFO has refilled, keeping the drift that was measured so far
+            ++numXRuns;
+            isReading = false;
+            clear (dest, numSamples);
+            return;
+        }
+
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (numNeeded, start1, size1, start2, size2);
+
+        // The interpolators read straight out of the circular buffer, wrapping round at its end
+        const auto capacity = fifo.getTotalSize();
+        int numUsed = 0;
+
+        for (int i = 0; i < numChannels; ++i)
+            numUsed = interpolators[(size_t) i].process (ratio, buffer.getReadPointer (i) + start1, dest[i],
+                                                         numSamples, capacity - start1, capacity);
+
+        fifo.finishedRead (numUsed);
+    }
+
+private:
+    void clear (float* const* dest, int numSamples) const noexcept
+    {
+        for (int i = 0; i < numChannels; ++i)
+            FloatVectorOperations::clear (dest[i], numSamples);
+    }
+
+    // These give a critically damped loop that settles in about ten seconds, which
+    // keeps the pitch changes from scheduling jitter far below audibility
+    static constexpr double proportionalGain = 1.0, integralGain = 0.25;
+    static constexpr double levelSmoothingSeconds = 0.5;
+    static constexpr double maxCorrection = 0.01;
+
+    const int numChannels;
+    const double writerRate, readerRate, writerBlockSeconds, nominalRatio;
+    double targetLevel = 0.0;
+
+    AudioBuffer<float> buffer;
+    AbstractFifo fifo { 2 };
+    std::atomic<double> lastWriteTime { 0.0 };
+
+    // Only used by the reader
+    std::vector<WindowedSincInterpolator> interpolators;
+    bool isReading = false;
+    double smoothedLevel = 0.0, integral = 0.0, ratio = 1.0;
+
+    std::atomic<double> drift { 0.0 }, latencySeconds { 0.0 };
+    std::atomic<int> numXRuns { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AggregateDeviceFifo)
+};
+
+static double getTimeForAggregateDevice() noexcept
+{
+    return Time::getMillisecondCounterHiRes() * 0.001;
+}
+
+//==============================================================================
+struct AggregateAudioIODevice::Member
+{
+    std::unique_ptr<AudioIODevice> device;
+    bool useInputs = true, useOutputs = true;
+    bool isOpen = false;
+
+    // The index of this device's first channel among the aggregate's channels
+    int firstInputChannel = 0, firstOutputChannel = 0;
+
+    std::unique_ptr<AggregateDeviceFifo> inputFifo, outputFifo;
+    std::unique_ptr<SubDeviceCallback> callback;
+
+    int getNumInputChannels() const     { return useInputs  ? device->getInputChannelNames().size()  : 0; }
+    int getNumOutputChannels() const    { return useOutputs ? device->getOutputChannelNames().size() : 0; }
+
+    BigInteger getActiveInputChannels() const
+    {
+        return isOpen && useInputs ? device->getActiveInputChannels() << firstInputChannel : BigInteger();
+    }
+
+    BigInteger getActiveOutputChannels() const
+    {
+        return isOpen && useOutputs ? device->getActiveOutputChannels() << firstOutputChannel : BigInteger();
+    }
+};
+
+//==============================================================================
+class AggregateAudioIODevice::MasterCallback final : public AudioIODeviceCallback
+{
+public:
+    explicit MasterCallback (AggregateAudioIODevice& o) : owner (o) {}
+
+    void audioDeviceIOCallbackWithContext (const float* const* inputs, int numInputs,
+                                           float* const* outputs, int numOutputs,
+                                           int numSamples,
+                                           const AudioIODeviceCallbackContext& context) override
+    {
+        owner.processMasterBlock (inputs, numInputs, outputs, numOutputs, numSamples, context);
+    }
+
+    void audioDeviceAboutToStart (AudioIODevice*) override
+    {
+        if (owner.callback != nullptr)
+            owner.callback->audioDeviceAboutToStart (&owner);
+    }
+
+    void audioDeviceStopped() override
+    {
+        if (owner.callback != nullptr)
+            owner.callback->audioDeviceStopped();
+    }
+
+    void audioDeviceError (const String& errorMessage) override
+    {
+        if (owner.callback != nullptr)
+            owner.callback->audioDeviceError (errorMessage);
+    }
+
+private:
+    AggregateAudioIODevice& owner;
+};
+
+class AggregateAudioIODevice::SubDeviceCallback final : public AudioIODeviceCallback
+{
+public:
+    SubDeviceCallback (AggregateAudioIODevice& o, Member& m) : owner (o), member (m) {}
+
+    void audioDeviceIOCallbackWithContext (const float* const* inputs, int numInputs,
+                                           float* const* outputs, int numOutputs,
+                                           int numSamples,
+                                           const AudioIODeviceCallbackContext&) override
+    {
+        const auto now = getTimeForAggregateDevice();
+
+        if (member.inputFifo != nullptr)
+        {
+            jassert (numInputs == member.inputFifo->getNumChannels());
+            ignoreUnused (numInputs);
+            member.inputFifo->write (inputs, numSamples, now);
+        }
+
+        if (member.outputFifo != nullptr)
+        {
+            jassert (numOutputs == member.outputFifo->getNumChannels());
+            member.outputFifo->read (outputs, numSamples, now);
+        }
+        else
+        {
+            for (int i = 0; i < numOutputs; ++i)
+                FloatVectorOperations::clear (outputs[i], numSamples);
+        }
+    }
+
+    void audioDeviceAboutToStart (AudioIODevice*) override {}
+    void audioDeviceStopped() override {}
+
+    void audioDeviceError (const String& errorMessage) override
+    {
+        const ScopedLock sl (owner.callbackLock);
+
+        if (owner.callback != nullptr)
+            owner.callback->audioDeviceError (member.device->getName() + ": " + errorMessage);
+    }
+
+private:
+    AggregateAudioIODevice& owner;
+    Member& member;
+};
+
+//==============================================================================
+AggregateAudioIODevice::AggregateAudioIODevice (const String& deviceName,
+                                                const String& typeNameToUse,
+                                                std::vector<SubDevice> devicesToCombine)
+    : AudioIODevice (deviceName, typeNameToUse),
+      masterCallback (std::make_unique<MasterCallback> (*this))
+{
+    for (auto& d : devicesToCombine)
+    {
+        jassert (d.device != nullptr);
+
+        auto member = std::make_unique<Member>();
+        member->device = std::move (d.device);
+        member->useInputs = d.useInputs;
+        member->useOutputs = d.useOutputs;
+        member->callback = std::make_unique<SubDeviceCallback> (*this, *member);
+        members.push_back (std::move (member));
+    }
+
+    jassert (! members.empty());
+}
+
+AggregateAudioIODevice::~AggregateAudioIODevice()
+{
+    close();
+}
+
+AudioIODevice* AggregateAudioIODevice::getSubDevice (int index) const noexcept
+{
+    return isPositiveAndBelow (index, members.size()) ? members[(size_t) index]->device.get() : nullptr;
+}
+
+bool AggregateAudioIODevice::usesInputsOf (int index) const noexcept
+{
+    return isPositiveAndBelow (index, members.size()) && members[(size_t) index]->useInputs;
+}
+
+bool AggregateAudioIODevice::usesOutputsOf (int index) const noexcept
+{
+    return isPositiveAndBelow (index, members.size()) && members[(size_t) index]->useOutputs;
+}
+
+std::vector<AggregateAudioIODevice::LinkStatus> AggregateAudioIODevice::getLinkStatus() const
+{
+    std::vector<LinkStatus> result;
+
+    for (size_t i = 0; i < members.size(); ++i)
+    {
+        for (auto* fifo : { members[i]->inputFifo.get(), members[i]->outputFifo.get() })
+        {
+            if (fifo != nullptr)
+            {
+                LinkStatus status;
+                status.subDeviceIndex = (int) i;
+                status.isInput = fifo == members[i]->inputFifo.get();
+                status.driftPPM = fifo->getDriftPPM();
+                status.latencySeconds = fifo->getLatencySeconds();
+                status.numXRuns = fifo->getNumXRuns();
+                result.push_back (status);
+            }
+        }
+    }
+
+    return result;
+}
+
+//==============================================================================
+StringArray AggregateAudioIODevice::getOutputChannelNames()
+{
+    StringArray names;
+
+    for (auto& m : members)
+    {
+        if (m->useOutputs)
+        {
+            for (auto& channelName : m->device->getOutputChannelNames())
+                names.add (members.size() > 1 ? m->device->getName() + ": " + channelName : channelName);
+        }
+    }
+
+    return names;
+}
+
+StringArray AggregateAudioIODevice::getInputChannelNames()
+{
+    StringArray names;
+
+    for (auto& m : members)
+    {
+        if (m->useInputs)
+        {
+            for (auto& channelName : m->device->getInputChannelNames())
+                names.add (members.size() > 1 ? m->device->getName() + ": " + channelName : channelName);
+        }
+    }
+
+    return names;
+}
+
+std::optional<BigInteger> AggregateAudioIODevice::getDefaultOutputChannels() const
+{
+    std::optional<BigInteger> result;
+    int firstChannel = 0;
+
+    for (auto& m : members)
+    {
+        if (! m->useOutputs)
+            continue;
+
+        if (const auto defaults = m->device->getDefaultOutputChannels())
+            result = result.value_or (BigInteger()) | (*defaults << firstChannel);
+
+        firstChannel += m->getNumOutputChannels();
+    }
+
+    return result;
+}
+
+std::optional<BigInteger> AggregateAudioIODevice::getDefaultInputChannels() const
+{
+    std::optional<BigInteger> result;
+    int firstChannel = 0;
+
+    for (auto& m : members)
+    {
+        if (! m->useInputs)
+            continue;
+
+        if (const auto defaults = m->device->getDefaultInputChannels())
+            result = result.value_or (BigInteger()) | (*defaults << firstChannel);
+
+        firstChannel += m->getNumInputChannels();
+    }
+
+    return result;
+}
+
+// The other devices are resampled to match the master, so only the master's settings matter here
+Array<double> AggregateAudioIODevice::getAvailableSampleRates()   { return members.front()->device->getAvailableSampleRates(); }
+Array<int> AggregateAudioIODevice::getAvailableBufferSizes()      { return members.front()->device->getAvailableBufferSizes(); }
+int AggregateAudioIODevice::getDefaultBufferSize()                { return members.front()->device->getDefaultBufferSize(); }
+int AggregateAudioIODevice::getCurrentBufferSizeSamples()         { return members.front()->device->getCurrentBufferSizeSamples(); }
+double AggregateAudioIODevice::getCurrentSampleRate()             { return members.front()->device->getCurrentSampleRate(); }
+int AggregateAudioIODevice::getCurrentBitDepth()                  { return members.front()->device->getCurrentBitDepth(); }
+bool AggregateAudioIODevice::isOpen()                             { return deviceIsOpen; }
+bool AggregateAudioIODevice::isPlaying()                          { return callback != nullptr && members.front()->device->isPlaying(); }
+int AggregateAudioIODevice::getOutputLatencyInSamples()           { return getLatencyInSamples (false); }
+int AggregateAudioIODevice::getInputLatencyInSamples()            { return getLatencyInSamples (true); }
+
+String AggregateAudioIODevice::getLastError()
+{
+    if (lastError.isNotEmpty())
+        return lastError;
+
+    for (auto& m : members)
+        if (m->isOpen)
+            if (auto error = m->device->getLastError(); error.isNotEmpty())
+                return m->device->getName() + ": " + error;
+
+    return {};
+}
+
+BigInteger AggregateAudioIODevice::getActiveOutputChannels() const
+{
+    BigInteger result;
+
+    for (auto& m : members)
+        result |= m->getActiveOutputChannels();
+
+    return result;
+}
+
+BigInteger AggregateAudioIODevice::getActiveInputChannels() const
+{
+    BigInteger result;
+
+    for (auto& m : members)
+        result |= m->getActiveInputChannels();
+
+    return result;
+}
+
+bool AggregateAudioIODevice::setRealtimeThreadOptions (const Thread::RealtimeOptions& options)
+{
+    bool anyAccepted = false;
+
+    for (auto& m : members)
+        anyAccepted = m->device->setRealtimeThreadOptions (options) || anyAccepted;
+
+    return anyAccepted;
+}
+
+std::optional<Thread::RealtimeStatus> AggregateAudioIODevice::getRealtimeThreadStatus() const
+{
+    // The callback is made on the clock master's thread
+    if (members.empty())
+        return {};
+
+    return members.front()->device->getRealtimeThreadStatus();
+}
+
+int AggregateAudioIODevice::getXRunCount() const noexcept
+{
+    int result = 0;
+
+    for (auto& m : members)
+    {
+        if (m->isOpen)
+            result += jmax (0, m->device->getXRunCount());
+
+        for (auto* fifo : { m->inputFifo.get(), m->outputFifo.get() })
+            if (fifo != nullptr)
+                result += fifo->getNumXRuns();
+    }
+
+    return result;
+}
+
+int AggregateAudioIODevice::getLatencyInSamples (bool forInput)
+{
+    const auto sampleRate = getCurrentSampleRate();
+    int result = 0;
+
+    for (auto& m : members)
+    {
+        if (! m->isOpen || ! (forInput ? m->useInputs : m->useOutputs))
+            continue;
+
+        const auto deviceRate = m->device->getCurrentSampleRate();
+        const auto deviceLatency = forInput ? m->device->getInputLatencyInSamples()
+                                            : m->device->getOutputLatencyInSamples();
+        auto latency = deviceRate > 0.0 ? deviceLatency * sampleRate / deviceRate : (double) deviceLatency;
+
+        if (auto* fifo = forInput ? m->inputFifo.get() : m->outputFifo.get())
+            latency += fifo->getTargetLatencySeconds() * sampleRate;
+
+        result = jmax (result, roundToInt (latency));
+    }
+
+    return result;
+}
+
+//==============================================================================
+template <typename Type>
+static Type getNearestAvailable (const Array<Type>& available, Type target)
+{
+    if (available.isEmpty())
+        return target;
+
+    auto result = available.getFirst();
+
+    for (auto value : available)
+        if (std::abs (value - target) < std::abs (result - target))
+            result = value;
+
+    return result;
+}
+
+String AggregateAudioIODevice::open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                                     double sampleRate, int bufferSizeSamples)
+{
+    close();
+    lastError.clear();
+
+    int firstInput = 0, firstOutput = 0;
+
+    for (size_t i = 0; i < members.size(); ++i)
+    {
+        auto& m = *members[i];
+        const auto isMaster = i == 0;
+        const auto numInputs = m.getNumInputChannels();
+        const auto numOutputs = m.getNumOutputChannels();
+
+        m.firstInputChannel = firstInput;
+        m.firstOutputChannel = firstOutput;
+        firstInput += numInputs;
+        firstOutput += numOutputs;
+
+        auto inputs = inputChannels.getBitRange (m.firstInputChannel, numInputs);
+        auto outputs = outputChannels.getBitRange (m.firstOutputChannel, numOutputs);
+
+        if (inputs.isZero() && outputs.isZero())
+        {
+            if (! isMaster)
+                continue;
+
+            // The master has to run to provide the clock, even when none of its channels are needed
+            if (numOutputs > 0)
+                outputs.setBit (0);
+            else if (numInputs > 0)
+                inputs.setBit (0);
+        }
+
+        auto rate = sampleRate;
+        auto bufferSize = bufferSizeSamples;
+
+        if (! isMaster)
+        {
+            auto& master = *members.front()->device;
+            rate = getNearestAvailable (m.device->getAvailableSampleRates(), master.getCurrentSampleRate());
+            bufferSize = getNearestAvailable (m.device->getAvailableBufferSizes(), master.getCurrentBufferSizeSamples());
+        }
+
+        const auto error = m.device->open (inputs, outputs, rate, bufferSize);
+
+        if (error.isNotEmpty())
+        {
+            close();
+            lastError = m.device->getName() + ": " + error;
+            return lastError;
+        }
+
+        m.isOpen = true;
+    }
+
+    auto& master = *members.front()->device;
+    const auto masterRate = master.getCurrentSampleRate();
+    const auto masterBlockSize = master.getCurrentBufferSizeSamples();
+    int numFifoInputs = 0, numFifoOutputs = 0;
+
+    for (size_t i = 1; i < members.size(); ++i)
+    {
+        auto& m = *members[i];
+
+        if (! m.isOpen)
+            continue;
+
+        const auto rate = m.device->getCurrentSampleRate();
+        const auto blockSize = m.device->getCurrentBufferSizeSamples();
+
+        if (const auto numInputs = m.getActiveInputChannels().countNumberOfSetBits(); numInputs > 0)
+        {
+            m.inputFifo = std::make_unique<AggregateDeviceFifo> (numInputs, rate, blockSize, masterRate, masterBlockSize);
+            numFifoInputs += numInputs;
+        }
+
+        if (const auto numOutputs = m.getActiveOutputChannels().countNumberOfSetBits(); numOutputs > 0)
+        {
+            m.outputFifo = std::make_unique<AggregateDeviceFifo> (numOutputs, masterRate, masterBlockSize, rate, blockSize);
+            numFifoOutputs += numOutputs;
+        }
+    }
+
+    // Leave some room in case the master's callbacks vary in size
+    const auto maxBlockSize = masterBlockSize * 2;
+    inputScratch.setSize (numFifoInputs, maxBlockSize);
+    outputScratch.setSize (numFifoOutputs, maxBlockSize);
+    inputPointers.ensureStorageAllocated (getActiveInputChannels().countNumberOfSetBits());
+    outputPointers.ensureStorageAllocated (getActiveOutputChannels().countNumberOfSetBits());
+
+    deviceIsOpen = true;
+    return {};
+}
+
+void AggregateAudioIODevice::close()
+{
+    stop();
+
+    for (auto& m : members)
+    {
+        if (m->isOpen)
+            m->device->close();
+
+        m->isOpen = false;
+        m->inputFifo.reset();
+        m->outputFifo.reset();
+    }
+
+    deviceIsOpen = false;
+}
+
+void AggregateAudioIODevice::start (AudioIODeviceCallback* newCallback)
+{
+    if (! deviceIsOpen || newCallback == nullptr || newCallback == callback)
+        return;
+
+    stop();
+
+    for (auto& m : members)
+    {
+        for (auto* fifo : { m->inputFifo.get(), m->outputFifo.get() })
+            if (fifo != nullptr)
+                fifo->reset();
+    }
+
+    {
+        const ScopedLock sl (callbackLock);
+        callback = newCallback;
+    }
+
+    // The other devices start first, so that the master's inputs are already arriving
+    for (size_t i = 1; i < members.size(); ++i)
+        if (members[i]->isOpen)
+            members[i]->device->start (members[i]->callback.get());
+
+    members.front()->device->start (masterCallback.get());
+}
+
+void AggregateAudioIODevice::stop()
+{
+    if (callback == nullptr)
+        return;
+
+    // This calls the callback's audioDeviceStopped()
+    members.front()->device->stop();
+
+    for (size_t i = 1; i < members.size(); ++i)
+        if (members[i]->isOpen)
+            members[i]->device->stop();
+
+    const ScopedLock sl (callbackLock);
+    callback = nullptr;
+}
+
+void AggregateAudioIODevice::processMasterBlock (const float* const* inputs, int numInputs,
+                                                 float* const* outputs, int numOutputs,
+                                                 int numSamples, const AudioIODeviceCallbackContext& context)
+{
+    const auto now = getTimeForAggregateDevice();
+    const auto& master = *members.front();
+
+    // If this fails, the master is using bigger blocks than it said it would
+    jassert (numSamples <= inputScratch.getNumSamples() || (inputScratch.getNumChannels() == 0 && outputScratch.getNumChannels() == 0));
+    const auto numSamplesForFifos = jmin (numSamples, jmax (inputScratch.getNumSamples(), outputScratch.getNumSamples()));
+
+    inputPointers.clearQuick();
+    outputPointers.clearQuick();
+
+    if (master.useInputs)
+        for (int i = 0; i < numInputs; ++i)
+            inputPointers.add (inputs[i]);
+
+    if (master.useOutputs)
+        for (int i = 0; i < numOutputs; ++i)
+            outputPointers.add (outputs[i]);
+
+    int inputScratchChannel = 0, outputScratchChannel = 0;
+
+    for (size_t i = 1; i < members.size(); ++i)
+    {
+        auto& m = *members[i];
+
+        if (m.inputFifo != nullptr)
+        {
+            auto* const* channels = inputScratch.getArrayOfWritePointers() + inputScratchChannel;
+            m.inputFifo->read (channels, numSamplesForFifos, now);
+            inputScratchChannel += m.inputFifo->getNumChannels();
+
+            for (int ch = 0; ch < m.inputFifo->getNumChannels(); ++ch)
+                inputPointers.add (channels[ch]);
+        }
+
+        if (m.outputFifo != nullptr)
+        {
+            auto* const* channels = outputScratch.getArrayOfWritePointers() + outputScratchChannel;
+            outputScratchChannel += m.outputFifo->getNumChannels();
+
+            for (int ch = 0; ch < m.outputFifo->getNumChannels(); ++ch)
+                outputPointers.add (channels[ch]);
+        }
+    }
+
+    {
+        const ScopedLock sl (callbackLock);
+
+        if (callback != nullptr)
+        {
+            callback->audioDeviceIOCallbackWithContext (inputPointers.getRawDataPointer(),
+                                                        inputPointers.size(),
+                                                        outputPointers.getRawDataPointer(),
+                                                        outputPointers.size(),
+                                                        numSamplesForFifos,
+                                                        context);
+        }
+        else
+        {
+            for (auto* channel : outputPointers)
+                FloatVectorOperations::clear (channel, numSamplesForFifos);
+        }
+    }
+
+    // Any of the master's channels that aren't being used are silent
+    if (! master.useOutputs)
+        for (int i = 0; i < numOutputs; ++i)
+            FloatVectorOperations::clear (outputs[i], numSamples);
+    else if (numSamplesForFifos < numSamples)
+        for (int i = 0; i < numOutputs; ++i)
+            FloatVectorOperations::clear (outputs[i] + numSamplesForFifos, numSamples - numSamplesForFifos);
+
+    outputScratchChannel = 0;
+
+    for (size_t i = 1; i < members.size(); ++i)
+    {
+        if (auto* fifo = members[i]->outputFifo.get())
+        {
+            fifo->write (outputScratch.getArrayOfReadPointers() + outputScratchChannel, numSamplesForFifos, now);
+            outputScratchChannel += fifo->getNumChannels();
+        }
+    }
+}
+
+//==============================================================================
+AggregateAudioIODeviceType::AggregateAudioIODeviceType (OwnedArray<AudioIODeviceType> typesToCombine)
+    : AudioIODeviceType (aggregateTypeName),
+      types (std::move (typesToCombine))
+{
+    for (auto* type : types)
+        type->addListener (this);
+}
+
+AggregateAudioIODeviceType::~AggregateAudioIODeviceType()
+{
+    for (auto* type : types)
+        type->removeListener (this);
+}
+
+void AggregateAudioIODeviceType::scanForDevices()
+{
+    for (auto* type : types)
+        type->scanForDevices();
+}
+
+StringArray AggregateAudioIODeviceType::getDeviceNames (bool wantInputNames) const
+{
+    StringArray names;
+
+    for (auto* type : types)
+        for (auto& name : type->getDeviceNames (wantInputNames))
+            names.add (type->getTypeName() + ": " + name);
+
+    return names;
+}
+
+int AggregateAudioIODeviceType::getDefaultDeviceIndex (bool forInput) const
+{
+    int firstIndex = 0;
+
+    for (auto* type : types)
+    {
+        const auto numDevices = type->getDeviceNames (forInput).size();
+
+        if (numDevices > 0)
+            return firstIndex + jlimit (0, numDevices - 1, type->getDefaultDeviceIndex (forInput));
+
+        firstIndex += numDevices;
+    }
+
+    return -1;
+}
+
+int AggregateAudioIODeviceType::getIndexOfDevice (AudioIODevice* device, bool asInput) const
+{
+    if (auto* aggregate = dynamic_cast<AggregateAudioIODevice*> (device))
+    {
+        for (int i = 0; i < aggregate->getNumSubDevices(); ++i)
+        {
+            if (asInput ? aggregate->usesInputsOf (i) : aggregate->usesOutputsOf (i))
+            {
+                auto* subDevice = aggregate->getSubDevice (i);
+                return getDeviceNames (asInput).indexOf (subDevice->getTypeName() + ": " + subDevice->getName());
+            }
+        }
+    }
+
+    return -1;
+}
+
+bool AggregateAudioIODeviceType::hasSeparateInputsAndOutputs() const
+{
+    return true;
+}
+
+AudioIODeviceType* AggregateAudioIODeviceType::findType (const String& deviceName, String& nameWithinType) const
+{
+    for (auto* type : types)
+    {
+        const auto prefix = type->getTypeName() + ": ";
+
+        if (deviceName.startsWith (prefix))
+        {
+            nameWithinType = deviceName.substring (prefix.length());
+            return type;
+        }
+    }
+
+    return nullptr;
+}
+
+AudioIODevice* AggregateAudioIODeviceType::createDevice (const String& outputDeviceName, const String& inputDeviceName)
+{
+    String outputName, inputName;
+    auto* outputType = findType (outputDeviceName, outputName);
+    auto* inputType = findType (inputDeviceName, inputName);
+
+    std::vector<AggregateAudioIODevice::SubDevice> devices;
+
+    const auto addDevice = [&devices] (AudioIODevice* device, bool useInputs, bool useOutputs)
+    {
+        if (device == nullptr)
+            return false;
+
+        devices.push_back ({ std::unique_ptr<AudioIODevice> (device), useInputs, useOutputs });
+        return true;
+    };
+
+    if (outputType != nullptr && outputType == inputType && outputName == inputName)
+    {
+        if (! addDevice (outputType->createDevice (outputName, inputName), true, true))
+            return nullptr;
+    }
+    else
+    {
+        // The output device is the clock master, because glitches are most noticeable in the output
+        if (outputType != nullptr
+             && ! addDevice (outputType->createDevice (outputName, outputType->hasSeparateInputsAndOutputs() ? String() : outputName),
+                             false, true))
+            return nullptr;
+
+        if (inputType != nullptr
+             && ! addDevice (inputType->createDevice (inputType->hasSeparateInputsAndOutputs() ? String() : inputName, inputName),
+                             true, false))
+            return nullptr;
+    }
+
+    if (devices.empty())
+        return nullptr;
+
+    return new AggregateAudioIODevice (outputType != nullptr ? outputDeviceName : inputDeviceName,
+                                       getTypeName(), std::move (devices));
+}
+
+void AggregateAudioIODeviceType::audioDeviceListChanged()
+{
+    callDeviceChangeListeners();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AggregateAudioIODeviceTests final : public UnitTest
+{
+public:
+    AggregateAudioIODeviceTests() : UnitTest ("AggregateAudioIODevice", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        beginTest ("FIFOs compensate for clock drift");
+        {
+            constexpr double nominalRate = 48000.0, drift = 300.0e-6;
+            constexpr double writerRate = nominalRate * (1.0 + drift);
+            constexpr int writerBlockSize = 64, readerBlockSize = 256;
+            constexpr double frequency = 1000.0;
+
+            AggregateDeviceFifo fifo (1, nominalRate, writerBlockSize, nominalRate, readerBlockSize);
+
+            std::vector<float> writeBlock (writerBlockSize), readBlock (readerBlockSize);
+            double nextWriteTime = 0.0, nextReadTime = 0.0, phase = 0.0;
+            float lastSample = 0.0f, maxStep = 0.0f, maxLevel = 0.0f;
+            int numXRunsWhenSettled = 0;
+
+            while (nextReadTime < 60.0)
+            {
+                if (nextWriteTime <= nextReadTime)
+                {
+                    for (auto& sample : writeBlock)
+                    {
+                        sample = (float) std::sin (phase);
+                        phase += MathConstants<double>::twoPi * frequency / nominalRate;
+                    }
+
+                    const float* channels[] = { writeBlock.data() };
+                    fifo.write (channels, writerBlockSize, nextWriteTime);
+                    nextWriteTime += writerBlockSize / writerRate;
+                    continue;
+                }
+
+                float* channels[] = { readBlock.data() };
+                fifo.read (channels, readerBlockSize, nextReadTime);
+                nextReadTime += readerBlockSize / nominalRate;
+
+                if (nextReadTime < 40.0)
+                {
+                    numXRunsWhenSettled = fifo.getNumXRuns();
+                    lastSample = readBlock.back();
+                    continue;
+                }
+
+                for (auto sample : readBlock)
+                {
+                    maxStep = jmax (maxStep, std::abs (sample - lastSample));
+                    maxLevel = jmax (maxLevel, std::abs (sample));
+                    lastSample = sample;
+                }
+            }
+
+            expectWithinAbsoluteError (fifo.getDriftPPM(), drift * 1.0e6, 10.0);
+            expectEquals (fifo.getNumXRuns(), numXRunsWhenSettled);
+            expectWithinAbsoluteError (fifo.getLatencySeconds(), fifo.getTargetLatencySeconds(), 0.001);
+
+            // The output should be an unbroken sine wave
+            expectWithinAbsoluteError (maxLevel, 1.0f, 0.02f);
+            expectLessThan (maxStep, (float) (MathConstants<double>::twoPi * frequency / nominalRate) * 1.02f);
+        }
+
+        beginTest ("The device type combines the inputs and outputs of different devices");
+        {
+            OwnedArray<AudioIODeviceType> typesToCombine;
+            typesToCombine.add (AudioIODeviceType::createAudioIODeviceType_Null());
+            AggregateAudioIODeviceType type (std::move (typesToCombine));
+            type.scanForDevices();
+
+            const auto names = type.getDeviceNames (false);
+            expectEquals (names.size(), 2);
+            expect (names[0].startsWith ("Null: "));
+
+            std::unique_ptr<AudioIODevice> single (type.createDevice (names[0], names[0]));
+            expect (single != nullptr);
+            expectEquals (single->getTypeName(), String (AggregateAudioIODeviceType::aggregateTypeName));
+            expectEquals (single->getOutputChannelNames()[0], String ("Output 1"));
+            expectEquals (type.getIndexOfDevice (single.get(), true), 0);
+
+            std::unique_ptr<AudioIODevice> combined (type.createDevice (names[0], names[1]));
+            expect (combined != nullptr);
+            expectEquals (type.getIndexOfDevice (combined.get(), false), 0);
+            expectEquals (type.getIndexOfDevice (combined.get(), true), 1);
+            expect (combined->getInputChannelNames()[0].startsWith (names[1].fromFirstOccurrenceOf (": ", false, false)));
+
+            expect (type.createDevice ("Nonexistent: device", {}) == nullptr);
+        }
+
+        beginTest ("An aggregate device runs callbacks with the channels of all its devices");
+        {
+            std::vector<AggregateAudioIODevice::SubDevice> devices;
+            devices.push_back ({ std::make_unique<NullAudioIODevice> ("master", NullAudioIODevice::Timing::realTime), false, true });
+            devices.push_back ({ std::make_unique<NullAudioIODevice> ("other", NullAudioIODevice::Timing::realTime), true, false });
+
+            AggregateAudioIODevice device ("aggregate", AggregateAudioIODeviceType::aggregateTypeName, std::move (devices));
+            expect (device.open (3, 1, 48000.0, 256).isEmpty());
+
+            expectEquals (device.getActiveInputChannels().countNumberOfSetBits(), 2);
+            expectEquals (device.getActiveOutputChannels().countNumberOfSetBits(), 1);
+            expectGreaterThan (device.getInputLatencyInSamples(), 256);
+
+            CountingCallback callback;
+            device.start (&callback);
+            expect (callback.waitForCallbacks (20));
+            device.stop();
+
+            expectEquals (callback.numInputChannels.load(), 2);
+            expectEquals (callback.numOutputChannels.load(), 1);
+
+            const auto status = device.getLinkStatus();
+            expectEquals ((int) status.size(), 1);
+            expectEquals (status.front().subDeviceIndex, 1);
+            expect (status.front().isInput);
+        }
+    }
+
+private:
+    struct CountingCallback final : public AudioIODeviceCallback
+    {
+        void audioDeviceIOCallbackWithContext (const float* const*, int numInputs,
+                                               float* const*, int numOutputs,
+                                               int, const AudioIODeviceCallbackContext&) override
+        {
+            numInputChannels = numInputs;
+            numOutputChannels = numOutputs;
+
+            if (++numCallbacks == target)
+                event.signal();
+        }
+
+        void audioDeviceAboutToStart (AudioIODevice*) override  {}
+        void audioDeviceStopped() override                       {}
+
+        bool waitForCallbacks (int num)
+        {
+            target = num;
+            return numCallbacks >= num || event.wait (10000);
+        }
+
+        std::atomic<int> numCallbacks { 0 }, target { -1 }, numInputChannels { 0 }, numOutputChannels { 0 };
+        WaitableEvent event;
+    };
+};
+
+static AggregateAudioIODeviceTests aggregateAudioIODeviceTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An audio device that combines the channels of several other devices.
+
+    The first device is used as the clock master, and the audio callback is made
+    from its thread. Every other device runs its own callback, and exchanges audio
+    with the master through lock-free FIFOs. Because the devices' clocks will
+    drift apart, the amount of audio in each FIFO is continuously monitored, and
+    the drift is corrected by resampling the audio as it's read from the FIFO.
+
+    The devices' channels are presented one after the other, in the order that
+    the devices were supplied, with each channel name prefixed by its device's name.
+
+    Using the FIFOs adds some latency to the channels of all but the master
+    device, which is included in the latencies that this device reports. Use
+    getLinkStatus() to see the drift and latency of each FIFO while it's running.
+
+    @see AggregateAudioIODeviceType
+
+    @tags{Audio}
+*/
+class JUCE_API  AggregateAudioIODevice  : public AudioIODevice
+{
+public:
+    //==============================================================================
+    /** One of the devices to combine, and which of its channels to use. */
+    struct SubDevice
+    {
+        std::unique_ptr<AudioIODevice> device;
+        bool useInputs = true, useOutputs = true;
+    };
+
+    /** Creates a device that combines some other devices.
+
+        The first device in the list is the clock master.
+    */
+    AggregateAudioIODevice (const String& deviceName,
+                            const String& typeName,
+                            std::vector<SubDevice> devicesToCombine);
+
+    /** Destructor. */
+    ~AggregateAudioIODevice() override;
+
+    //==============================================================================
+    /** Returns the number of devices being combined. */
+    int getNumSubDevices() const noexcept                   { return (int) members.size(); }
+
+    /** Returns one of the devices being combined. Index 0 is the clock master. */
+    AudioIODevice* getSubDevice (int index) const noexcept;
+
+    /** Returns true if this device's inputs include the given sub-device's inputs. */
+    bool usesInputsOf (int index) const noexcept;
+
+    /** Returns true if this device's outputs include the given sub-device's outputs. */
+    bool usesOutputsOf (int index) const noexcept;
+
+    /** The current state of the FIFO that carries audio between the clock master
+        and one of the other devices.
+    */
+    struct LinkStatus
+    {
+        /** The index of the sub-device. */
+        int subDeviceIndex = 0;
+
+        /** True if this carries the device's inputs to the master, or false if it
+            carries the master's audio to the device's outputs.
+        */
+        bool isInput = false;
+
+        /** How much faster the device that writes to the FIFO is running than its
+            nominal speed, relative to the device that reads from it, in parts per million.
+        */
+        double driftPPM = 0.0;
+
+        /** The latency added by the FIFO and the resampler, in seconds. */
+        double latencySeconds = 0.0;
+
+        /** The number of times that the FIFO has run empty or overflowed. */
+        int numXRuns = 0;
+    };
+
+    /** Returns the state of each FIFO.
+
+        This can be called from any thread while the device is running.
+    */
+    std::vector<LinkStatus> getLinkStatus() const;
+
+    //==============================================================================
+    /** @internal */
+    StringArray getOutputChannelNames() override;
+    /** @internal */
+    StringArray getInputChannelNames() override;
+    /** @internal */
+    std::optional<BigInteger> getDefaultOutputChannels() const override;
+    /** @internal */
+    std::optional<BigInteger> getDefaultInputChannels() const override;
+    /** @internal */
+    Array<double> getAvailableSampleRates() override;
+    /** @internal */
+    Array<int> getAvailableBufferSizes() override;
+    /** @internal */
+    int getDefaultBufferSize() override;
+    /** @internal */
+    String open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                 double sampleRate, int bufferSizeSamples) override;
+    /** @internal */
+    void close() override;
+    /** @internal */
+    bool isOpen() override;
+    /** @internal */
+    void start (AudioIODeviceCallback*) override;
+    /** @internal */
+    void stop() override;
+    /** @internal */
+    bool isPlaying() override;
+    /** @internal */
+    String getLastError() override;
+    /** @internal */
+    int getCurrentBufferSizeSamples() override;
+    /** @internal */
+    double getCurrentSampleRate() override;
+    /** @internal */
+    int getCurrentBitDepth() override;
+    /** @internal */
+    BigInteger getActiveOutputChannels() const override;
+    /** @internal */
+    BigInteger getActiveInputChannels() const override;
+    /** @internal */
+    int getOutputLatencyInSamples() override;
+    /** @internal */
+    int getInputLatencyInSamples() override;
+    /** @internal */
+    int getXRunCount() const noexcept override;
+    /** @internal */
+    bool setRealtimeThreadOptions (const Thread::RealtimeOptions&) override;
+    /** @internal */
+    std::optional<Thread::RealtimeStatus> getRealtimeThreadStatus() const override;
+
+private:
+    //==============================================================================
+    class MasterCallback;
+    class SubDeviceCallback;
+    struct Member;
+
+    void processMasterBlock (const float* const* inputs, int numInputs,
+                             float* const* outputs, int numOutputs,
+                             int numSamples, const AudioIODeviceCallbackContext&);
+    int getLatencyInSamples (bool forInput);
+
+    std::vector<std::unique_ptr<Member>> members;
+    std::unique_ptr<MasterCallback> masterCallback;
+
+    AudioBuffer<float> inputScratch, outputScratch;
+    Array<const float*> inputPointers;
+    Array<float*> outputPointers;
+
+    CriticalSection callbackLock;
+    AudioIODeviceCallback* callback = nullptr;
+    String lastError;
+    bool deviceIsOpen = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AggregateAudioIODevice)
+};
+
+//==============================================================================
+/**
+    A device type that lets you use the inputs of one device together with the
+    outputs of another, even when they belong to different device types or don't
+    share a clock.
+
+    It wraps some other device types, and lists all of their devices, with each
+    name prefixed by the name of its type. Choosing the same device for input and
+    output opens it normally, and choosing two different ones creates an
+    AggregateAudioIODevice, with the output device as its clock master.
+
+    To use it, pass it to AudioDeviceManager::addAudioDeviceType(), or enable the
+    JUCE_AGGREGATE_AUDIO_DEVICE flag to have every AudioDeviceManager include one
+    that wraps the platform's device types.
+
+    @tags{Audio}
+*/
+class JUCE_API  AggregateAudioIODeviceType  : public AudioIODeviceType,
+                                              private AudioIODeviceType::Listener
+{
+public:
+    //==============================================================================
+    /** Creates a type that combines the devices of some other types. */
+    explicit AggregateAudioIODeviceType (OwnedArray<AudioIODeviceType> typesToCombine);
+
+    /** Destructor. */
+    ~AggregateAudioIODeviceType() override;
+
+    /** The name of this device type. */
+    static constexpr const char* aggregateTypeName = "Aggregate";
+
+    //==============================================================================
+    /** @internal */
+    void scanForDevices() override;
+    /** @internal */
+    StringArray getDeviceNames (bool wantInputNames) const override;
+    /** @internal */
+    int getDefaultDeviceIndex (bool forInput) const override;
+    /** @internal */
+    int getIndexOfDevice (AudioIODevice*, bool asInput) const override;
+    /** @internal */
+    bool hasSeparateInputsAndOutputs() const override;
+    /** @internal */
+    AudioIODevice* createDevice (const String& outputDeviceName, const String& inputDeviceName) override;
+
+private:
+    //==============================================================================
+    void audioDeviceListChanged() override;
+    AudioIODeviceType* findType (const String& deviceName, String& nameWithinType) const;
+
+    OwnedArray<AudioIODeviceType> types;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AggregateAudioIODeviceType)
+};
+
+} // namespace juce
@@ -233,7 +233,7 @@ static void addIfNotNull (OwnedArray<AudioIODeviceType>& list, AudioIODeviceType
         list.add (device);
 }
 
-void AudioDeviceManager::createAudioDeviceTypes (OwnedArray<AudioIODeviceType>& list)
+static void createPlatformAudioDeviceTypes (OwnedArray<AudioIODeviceType>& list)
 {
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_WASAPI (WASAPIDeviceMode::shared));
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_WASAPI (WASAPIDeviceMode::exclusive));
@@ -248,6 +248,24 @@ void AudioDeviceManager::createAudioDeviceTypes (OwnedArray<AudioIODeviceType>&
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_Oboe());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_OpenSLES());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_Android());
+
+   #if JUCE_NULL_AUDIO_DEVICE
+    addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_Null());
+   #endif
+}
+
+void AudioDeviceManager::createAudioDeviceTypes (OwnedArray<AudioIODeviceType>& list)
+{
+    createPlatformAudioDeviceTypes (list);
+
+   #if JUCE_AGGREGATE_AUDIO_DEVICE
+    // The aggregate type needs its own instances of the types that it combines
+    OwnedArray<AudioIODeviceType> typesToCombine;
+    createPlatformAudioDeviceTypes (typesToCombine);
+
+    if (! typesToCombine.isEmpty())
+        list.add (new AggregateAudioIODeviceType (std::move (typesToCombine)));
+   #endif
 }
 
 void AudioDeviceManager::addAudioDeviceType (std::unique_ptr<AudioIODeviceType> newDeviceType)
@@ -42,6 +42,8 @@ void AudioIODeviceCallback::audioDeviceError (const String&)    {}
 bool AudioIODevice::setAudioPreprocessingEnabled (bool)         { return false; }
 bool AudioIODevice::hasControlPanel() const                     { return false; }
 int  AudioIODevice::getXRunCount() const noexcept               { return -1; }
+bool AudioIODevice::setRealtimeThreadOptions (const Thread::RealtimeOptions&)   { return false; }
+std::optional<Thread::RealtimeStatus> AudioIODevice::getRealtimeThreadStatus() const  { return {}; }
 
 bool AudioIODevice::showControlPanel()
 {
@@ -343,6 +343,29 @@ public:
     */
     virtual int getXRunCount() const noexcept;
 
+    //==============================================================================
+    /** Sets the options used to make the device's audio thread a realtime thread.
+
+        This lets you choose the thread's scheduling policy and priority, the cores it
+        may run on, and whether memory should be locked and the stack prefaulted before
+        it starts. The options will take effect the next time the device is opened.
+
+        Only some devices support this, and the default implementation just returns false.
+
+        @see getRealtimeThreadStatus, Thread::RealtimeOptions
+    */
+    virtual bool setRealtimeThreadOptions (const Thread::RealtimeOptions& options);
+
+    /** Returns the realtime settings that are actually in effect for the device's
+        audio thread.
+
+        This returns nullopt if the device isn't running, or if it doesn't support
+        setRealtimeThreadOptions().
+
+        @see setRealtimeThreadOptions
+    */
+    virtual std::optional<Thread::RealtimeStatus> getRealtimeThreadStatus() const;
+
     //==============================================================================
 protected:
     /** Creates a device, setting its name and type member variables. */
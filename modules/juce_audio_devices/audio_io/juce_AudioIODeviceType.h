@@ -166,6 +166,10 @@ public:
     static AudioIODeviceType* createAudioIODeviceType_Oboe();
     /** Creates a Bela device type if it's available on this platform, or returns null. */
     static AudioIODeviceType* createAudioIODeviceType_Bela();
+    /** Creates a device type whose devices aren't connected to any hardware. This is available on all platforms.
+        @see NullAudioIODevice
+    */
+    static AudioIODeviceType* createAudioIODeviceType_Null();
 
    #ifndef DOXYGEN
     [[deprecated ("You should call the method which takes a WASAPIDeviceMode instead.")]]
@@ -0,0 +1,528 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+constexpr int nullDeviceNumChannels = 32;
+
+static int64 getNullDeviceTimeNs() noexcept
+{
+    return (int64) std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//==============================================================================
+NullAudioIODevice::NullAudioIODevice (const String& deviceName, Timing timingToUse)
+    : AudioIODevice (deviceName, deviceTypeName),
+      Thread ("JUCE Null audio device"),
+      timing (timingToUse)
+{
+}
+
+NullAudioIODevice::~NullAudioIODevice()
+{
+    close();
+}
+
+StringArray NullAudioIODevice::getOutputChannelNames()
+{
+    StringArray names;
+
+    for (int i = 1; i <= nullDeviceNumChannels; ++i)
+        names.add ("Output " + String (i));
+
+    return names;
+}
+
+StringArray NullAudioIODevice::getInputChannelNames()
+{
+    StringArray names;
+
+    for (int i = 1; i <= nullDeviceNumChannels; ++i)
+        names.add ("Input " + String (i));
+
+    return names;
+}
+
+std::optional<BigInteger> NullAudioIODevice::getDefaultOutputChannels() const
+{
+    BigInteger channels;
+    channels.setRange (0, 2, true);
+    return channels;
+}
+
+std::optional<BigInteger> NullAudioIODevice::getDefaultInputChannels() const
+{
+    return getDefaultOutputChannels();
+}
+
+Array<double> NullAudioIODevice::getAvailableSampleRates()
+{
+    return { 22050.0, 32000.0, 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+}
+
+Array<int> NullAudioIODevice::getAvailableBufferSizes()
+{
+    return { 16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 2048, 4096 };
+}
+
+int NullAudioIODevice::getDefaultBufferSize()                       { return 512; }
+bool NullAudioIODevice::isOpen()                                    { return deviceIsOpen; }
+bool NullAudioIODevice::isPlaying()                                 { return callback != nullptr; }
+String NullAudioIODevice::getLastError()                            { return {}; }
+int NullAudioIODevice::getCurrentBufferSizeSamples()                { return currentBufferSize; }
+double NullAudioIODevice::getCurrentSampleRate()                    { return currentSampleRate; }
+int NullAudioIODevice::getCurrentBitDepth()                         { return 32; }
+BigInteger NullAudioIODevice::getActiveOutputChannels() const       { return activeOutputChannels; }
+BigInteger NullAudioIODevice::getActiveInputChannels() const        { return activeInputChannels; }
+int NullAudioIODevice::getOutputLatencyInSamples()                  { return 0; }
+int NullAudioIODevice::getInputLatencyInSamples()                   { return 0; }
+int NullAudioIODevice::getXRunCount() const noexcept                { return numDeadlineMisses; }
+
+bool NullAudioIODevice::setRealtimeThreadOptions (const RealtimeOptions& options)
+{
+    threadOptions = options;
+    return true;
+}
+
+std::optional<Thread::RealtimeStatus> NullAudioIODevice::getRealtimeThreadStatus() const
+{
+    return getRealtimeStatus();
+}
+
+String NullAudioIODevice::open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                                double sampleRate, int bufferSizeSamples)
+{
+    close();
+
+    activeInputChannels = inputChannels;
+    activeInputChannels.setRange (nullDeviceNumChannels, activeInputChannels.getHighestBit() + 1 - nullDeviceNumChannels, false);
+    activeOutputChannels = outputChannels;
+    activeOutputChannels.setRange (nullDeviceNumChannels, activeOutputChannels.getHighestBit() + 1 - nullDeviceNumChannels, false);
+
+    currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
+    currentBufferSize = bufferSizeSamples > 0 ? bufferSizeSamples : getDefaultBufferSize();
+
+    inputBuffer.setSize (activeInputChannels.countNumberOfSetBits(), currentBufferSize);
+    inputBuffer.clear();
+    outputBuffer.setSize (activeOutputChannels.countNumberOfSetBits(), currentBufferSize);
+
+    const auto options = threadOptions.withApproximateAudioProcessingTime (currentBufferSize, currentSampleRate);
+
+    // Without permission to use a real-time scheduler, this falls back to a normal thread
+    if (! startRealtimeThread (options))
+        startThread (Priority::highest);
+
+    deviceIsOpen = true;
+    return {};
+}
+
+void NullAudioIODevice::close()
+{
+    stop();
+    stopThread (5000);
+    deviceIsOpen = false;
+}
+
+void NullAudioIODevice::start (AudioIODeviceCallback* newCallback)
+{
+    if (! deviceIsOpen || newCallback == nullptr || newCallback == callback)
+        return;
+
+    stop();
+    newCallback->audioDeviceAboutToStart (this);
+    resetStatistics();
+    setCallback (newCallback);
+}
+
+void NullAudioIODevice::stop()
+{
+    auto* oldCallback = callback;
+    setCallback (nullptr);
+
+    if (oldCallback != nullptr)
+        oldCallback->audioDeviceStopped();
+}
+
+template <typename Fn>
+void NullAudioIODevice::callWithStartStopLock (Fn&& fn) const
+{
+    // When running as fast as possible, the audio thread would otherwise take the
+    // lock again as soon as it released it, and this thread might never get a turn
+    ++numThreadsWaitingForLock;
+    const ScopedLock sl (startStopLock);
+    --numThreadsWaitingForLock;
+
+    fn();
+}
+
+void NullAudioIODevice::setCallback (AudioIODeviceCallback* newCallback)
+{
+    callWithStartStopLock ([&] { callback = newCallback; });
+}
+
+//==============================================================================
+NullAudioIODevice::Statistics NullAudioIODevice::getStatistics() const
+{
+    Statistics result;
+    result.numCallbacks = numCallbacks;
+    result.numDeadlineMisses = numDeadlineMisses;
+
+    const auto elapsedSeconds = (double) (getNullDeviceTimeNs() - statisticsStartNs) * 1.0e-9;
+
+    if (elapsedSeconds > 0.0)
+    {
+        result.callbacksPerSecond = (double) result.numCallbacks / elapsedSeconds;
+
+        if (currentSampleRate > 0.0)
+            result.realTimeRatio = result.callbacksPerSecond * currentBufferSize / currentSampleRate;
+    }
+
+    if (result.numCallbacks > 0)
+        result.averageCallbackMs = (double) totalCallbackNs * 1.0e-6 / (double) result.numCallbacks;
+
+    result.maximumCallbackMs = (double) maxCallbackNs * 1.0e-6;
+    return result;
+}
+
+void NullAudioIODevice::resetStatistics()
+{
+    numCallbacks = 0;
+    numDeadlineMisses = 0;
+    totalCallbackNs = 0;
+    maxCallbackNs = 0;
+    statisticsStartNs = getNullDeviceTimeNs();
+}
+
+bool NullAudioIODevice::recordCallbackTimings (int numCallbacksToRecord, int timeoutMs)
+{
+    jassert (numCallbacksToRecord > 0);
+
+    callWithStartStopLock ([&]
+    {
+        recordedTimings.assign ((size_t) numCallbacksToRecord, {});
+        numTimingsRecorded = 0;
+        numTimingsToRecord = (size_t) numCallbacksToRecord;
+        timingsRecorded.reset();
+    });
+
+    const auto result = timingsRecorded.wait ((double) timeoutMs);
+
+    callWithStartStopLock ([&] { numTimingsToRecord = 0; });
+    return result;
+}
+
+std::vector<NullAudioIODevice::CallbackTiming> NullAudioIODevice::getRecordedCallbackTimings() const
+{
+    std::vector<CallbackTiming> result;
+
+    callWithStartStopLock ([&]
+    {
+        result.assign (recordedTimings.begin(), recordedTimings.begin() + (ptrdiff_t) numTimingsRecorded);
+    });
+
+    return result;
+}
+
+void NullAudioIODevice::addCallbackTime (Clock::duration callbackTime, Clock::duration lateness, bool missedDeadline) noexcept
+{
+    const auto ns = (int64) std::chrono::duration_cast<std::chrono::nanoseconds> (callbackTime).count();
+
+    ++numCallbacks;
+    totalCallbackNs += ns;
+
+    if (ns > maxCallbackNs)
+        maxCallbackNs = ns;
+
+    if (missedDeadline)
+        ++numDeadlineMisses;
+
+    if (numTimingsRecorded < numTimingsToRecord)
+    {
+        using Ms = std::chrono::duration<double, std::milli>;
+        recordedTimings[numTimingsRecorded] = { Ms (callbackTime).count(), Ms (lateness).count(), missedDeadline };
+
+        if (++numTimingsRecorded == numTimingsToRecord)
+            timingsRecorded.signal();
+    }
+}
+
+void NullAudioIODevice::run()
+{
+    const auto period = std::chrono::duration_cast<Clock::duration> (std::chrono::duration<double> (currentBufferSize / currentSampleRate));
+    auto nextCallbackTime = Clock::now();
+
+    while (! threadShouldExit())
+    {
+        // A real device would need the next block one period after this one was due
+        const auto dueTime = nextCallbackTime;
+        nextCallbackTime += period;
+        auto calledBack = false, missedDeadline = false;
+
+        while (numThreadsWaitingForLock > 0)
+            std::this_thread::yield();
+
+        {
+            const ScopedLock sl (startStopLock);
+
+            if (callback != nullptr)
+            {
+                const auto callbackStart = Clock::now();
+
+                callback->audioDeviceIOCallbackWithContext (inputBuffer.getArrayOfReadPointers(),
+                                                            inputBuffer.getNumChannels(),
+                                                            outputBuffer.getArrayOfWritePointers(),
+                                                            outputBuffer.getNumChannels(),
+                                                            currentBufferSize,
+                                                            {});
+
+                const auto callbackEnd = Clock::now();
+
+                missedDeadline = timing == Timing::asFastAsPossible ? callbackEnd - callbackStart > period
+                                                                    : callbackEnd > nextCallbackTime;
+
+                const auto lateness = timing == Timing::realTime ? jmax (Clock::duration{}, callbackStart - dueTime)
+                                                                 : Clock::duration{};
+
+                addCallbackTime (callbackEnd - callbackStart, lateness, missedDeadline);
+                calledBack = true;
+            }
+        }
+
+        if (timing == Timing::asFastAsPossible && calledBack)
+            continue;
+
+        // After a miss, carry on from now rather than trying to catch up
+        if (missedDeadline || Clock::now() > nextCallbackTime)
+            nextCallbackTime = Clock::now();
+        else
+            std::this_thread::sleep_until (nextCallbackTime);
+    }
+}
+
+//==============================================================================
+class NullAudioIODeviceType final : public AudioIODeviceType
+{
+public:
+    NullAudioIODeviceType()
+        : AudioIODeviceType (NullAudioIODevice::deviceTypeName)
+    {
+    }
+
+    void scanForDevices() override {}
+
+    StringArray getDeviceNames (bool) const override
+    {
+        return { getDeviceName (NullAudioIODevice::Timing::realTime),
+                 getDeviceName (NullAudioIODevice::Timing::asFastAsPossible) };
+    }
+
+    int getDefaultDeviceIndex (bool) const override                { return 0; }
+    bool hasSeparateInputsAndOutputs() const override              { return false; }
+
+    int getIndexOfDevice (AudioIODevice* device, bool) const override
+    {
+        if (auto* nullDevice = dynamic_cast<NullAudioIODevice*> (device))
+            return nullDevice->getTiming() == NullAudioIODevice::Timing::realTime ? 0 : 1;
+
+        return -1;
+    }
+
+    AudioIODevice* createDevice (const String& outputDeviceName, const String& inputDeviceName) override
+    {
+        const auto name = outputDeviceName.isNotEmpty() ? outputDeviceName : inputDeviceName;
+
+        for (const auto timing : { NullAudioIODevice::Timing::realTime, NullAudioIODevice::Timing::asFastAsPossible })
+            if (name == getDeviceName (timing))
+                return new NullAudioIODevice (name, timing);
+
+        return nullptr;
+    }
+
+private:
+    static String getDeviceName (NullAudioIODevice::Timing timing)
+    {
+        return timing == NullAudioIODevice::Timing::realTime ? "Null Device (Real-Time)"
+                                                             : "Null Device (As Fast As Possible)";
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NullAudioIODeviceType)
+};
+
+AudioIODeviceType* AudioIODeviceType::createAudioIODeviceType_Null()   { return new NullAudioIODeviceType(); }
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class NullAudioIODeviceTests final : public UnitTest
+{
+public:
+    NullAudioIODeviceTests() : UnitTest ("NullAudioIODevice", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        beginTest ("The device type can be used by an AudioDeviceManager");
+        {
+            AudioDeviceManager manager;
+            manager.addAudioDeviceType (std::unique_ptr<AudioIODeviceType> (AudioIODeviceType::createAudioIODeviceType_Null()));
+            manager.setCurrentAudioDeviceType (NullAudioIODevice::deviceTypeName, true);
+
+            AudioDeviceManager::AudioDeviceSetup setup;
+            setup.outputDeviceName = "Null Device (As Fast As Possible)";
+            setup.inputDeviceName = setup.outputDeviceName;
+            setup.sampleRate = 48000.0;
+            setup.bufferSize = 256;
+            setup.useDefaultInputChannels = setup.useDefaultOutputChannels = true;
+
+            expect (manager.setAudioDeviceSetup (setup, true).isEmpty());
+
+            auto* device = dynamic_cast<NullAudioIODevice*> (manager.getCurrentAudioDevice());
+            expect (device != nullptr);
+
+            CountingCallback callback;
+            manager.addAudioCallback (&callback);
+            expect (callback.waitForCallbacks (100));
+            manager.removeAudioCallback (&callback);
+
+            expectEquals (callback.numOutputChannels.load(), 2);
+            expectEquals (callback.numSamples.load(), 256);
+            expect (device->getStatistics().numCallbacks > 0);
+        }
+
+        beginTest ("Real-time devices are paced to the sample rate");
+        {
+            NullAudioIODevice device ("test", NullAudioIODevice::Timing::realTime);
+            expect (device.open (0, 3, 48000.0, 480).isEmpty());
+
+            CountingCallback callback;
+            const auto startTime = Time::getMillisecondCounterHiRes();
+            device.start (&callback);
+            expect (callback.waitForCallbacks (20));
+            const auto elapsedMs = Time::getMillisecondCounterHiRes() - startTime;
+            device.stop();
+
+            // 20 blocks of 10ms each
+            expectGreaterOrEqual (elapsedMs, 150.0);
+            expectEquals (callback.numOutputChannels.load(), 2);
+            expect (callback.stopped);
+        }
+
+        beginTest ("Slow callbacks are counted as deadline misses");
+        {
+            NullAudioIODevice device ("test", NullAudioIODevice::Timing::asFastAsPossible);
+            expect (device.open (0, 1, 48000.0, 48).isEmpty());
+
+            CountingCallback callback;
+            callback.callbackDurationMs = 5;
+            device.start (&callback);
+            expect (callback.waitForCallbacks (5));
+            device.stop();
+
+            const auto stats = device.getStatistics();
+            expectEquals ((int) stats.numCallbacks, stats.numDeadlineMisses);
+            expectEquals (device.getXRunCount(), stats.numDeadlineMisses);
+            expectGreaterOrEqual (stats.maximumCallbackMs, 5.0);
+            expectLessThan (stats.realTimeRatio, 1.0);
+        }
+
+        beginTest ("The timings of individual callbacks can be recorded");
+        {
+            NullAudioIODevice device ("test", NullAudioIODevice::Timing::asFastAsPossible);
+            expect (device.open (0, 1, 48000.0, 48).isEmpty());
+
+            CountingCallback callback;
+            callback.callbackDurationMs = 2;
+            device.start (&callback);
+            expect (device.recordCallbackTimings (5, 5000));
+            device.stop();
+
+            const auto timings = device.getRecordedCallbackTimings();
+            expectEquals ((int) timings.size(), 5);
+
+            for (const auto& t : timings)
+            {
+                expectGreaterOrEqual (t.durationMs, 2.0);
+                expect (t.missedDeadline);
+                expectEquals (t.latenessMs, 0.0);
+            }
+        }
+
+        beginTest ("Realtime thread options are applied to the device's thread");
+        {
+            NullAudioIODevice device ("test", NullAudioIODevice::Timing::asFastAsPossible);
+            expect (! device.getRealtimeThreadStatus().has_value());
+            expect (device.setRealtimeThreadOptions (Thread::RealtimeOptions{}.withStackPrefaultBytes (32 * 1024)));
+            expect (device.open (0, 1, 48000.0, 64).isEmpty());
+
+            CountingCallback callback;
+            device.start (&callback);
+            expect (callback.waitForCallbacks (5));
+
+            // Without permission to create a realtime thread, the device uses a normal one
+            if (const auto status = device.getRealtimeThreadStatus())
+                expectEquals (status->numStackBytesPrefaulted, (size_t) 32 * 1024);
+
+            device.close();
+            expect (! device.getRealtimeThreadStatus().has_value());
+        }
+    }
+
+private:
+    struct CountingCallback final : public AudioIODeviceCallback
+    {
+        void audioDeviceIOCallbackWithContext (const float* const*, int,
+                                               float* const*, int numOutputs,
+                                               int numSamplesIn,
+                                               const AudioIODeviceCallbackContext&) override
+        {
+            numOutputChannels = numOutputs;
+            numSamples = numSamplesIn;
+
+            if (callbackDurationMs > 0)
+                Thread::sleep (callbackDurationMs);
+
+            if (++numCallbacks == target)
+                event.signal();
+        }
+
+        void audioDeviceAboutToStart (AudioIODevice*) override  {}
+        void audioDeviceStopped() override                       { stopped = true; }
+
+        bool waitForCallbacks (int num)
+        {
+            target = num;
+            return numCallbacks >= num || event.wait (10000);
+        }
+
+        std::atomic<int> numCallbacks { 0 }, target { -1 }, numOutputChannels { 0 }, numSamples { 0 };
+        int callbackDurationMs = 0;
+        bool stopped = false;
+        WaitableEvent event;
+    };
+};
+
+static NullAudioIODeviceTests nullAudioIODeviceTests;
+
+#endif
+
+} // namespace juce
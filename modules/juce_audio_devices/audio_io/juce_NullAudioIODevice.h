@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An audio device that isn't connected to any hardware.
+
+    The device calls its AudioIODeviceCallback from a high-priority thread, either
+    paced to the sample rate like a real device, or as fast as the callback can run.
+    Its inputs are silent, and anything written to its outputs is discarded.
+
+    This lets you run an app's complete AudioDeviceManager and callback path on
+    machines with no sound hardware, e.g. to benchmark it on a build server. Use
+    getStatistics() to find out how well the callback is keeping up.
+
+    To use it, create its device type with AudioIODeviceType::createAudioIODeviceType_Null()
+    and pass that to AudioDeviceManager::addAudioDeviceType(), or enable the
+    JUCE_NULL_AUDIO_DEVICE flag to have every AudioDeviceManager include it.
+
+    @see AudioIODeviceType::createAudioIODeviceType_Null
+
+    @tags{Audio}
+*/
+class JUCE_API  NullAudioIODevice  : public AudioIODevice,
+                                     private Thread
+{
+public:
+    //==============================================================================
+    /** How the device schedules its callbacks. */
+    enum class Timing
+    {
+        realTime,           /**< Each callback starts when a real device would need the next block. */
+        asFastAsPossible    /**< Each callback starts as soon as the previous one has finished. */
+    };
+
+    /** Creates a device.
+
+        You'd normally let the device type create these, but you can also use this
+        class directly without an AudioDeviceManager.
+    */
+    NullAudioIODevice (const String& deviceName, Timing timing);
+
+    /** Destructor. */
+    ~NullAudioIODevice() override;
+
+    //==============================================================================
+    /** Measurements of the callbacks made since the device was started. */
+    struct Statistics
+    {
+        /** The number of callbacks that have completed. */
+        int64 numCallbacks = 0;
+
+        /** The number of callbacks that didn't finish in time.
+
+            In real-time mode, this counts callbacks that ended after the point at which
+            a real device would have needed the next block. When running as fast as
+            possible, it counts callbacks that took longer than the duration of the
+            audio that they produced.
+        */
+        int numDeadlineMisses = 0;
+
+        /** The average number of callbacks per second of wall-clock time. */
+        double callbacksPerSecond = 0.0;
+
+        /** The number of seconds of audio processed per second of wall-clock time. */
+        double realTimeRatio = 0.0;
+
+        /** The average and longest time spent in a single callback. */
+        double averageCallbackMs = 0.0, maximumCallbackMs = 0.0;
+    };
+
+    /** Returns the measurements made since the device started, or since the last
+        call to resetStatistics().
+
+        This may be called from any thread.
+    */
+    Statistics getStatistics() const;
+
+    /** Clears the measurements. */
+    void resetStatistics();
+
+    //==============================================================================
+    /** The timing of a single callback, as recorded by recordCallbackTimings(). */
+    struct CallbackTiming
+    {
+        /** How long the callback ran for, in milliseconds. */
+        double durationMs = 0.0;
+
+        /** How long after it was due the callback started, in milliseconds. This is
+            always zero when running as fast as possible.
+        */
+        double latenessMs = 0.0;
+
+        /** True if the callback didn't finish in time.
+            @see Statistics::numDeadlineMisses
+        */
+        bool missedDeadline = false;
+    };
+
+    /** Records the timings of the next few callbacks, and returns when they have all
+        been recorded, or when the timeout has passed.
+
+        The space for the timings is allocated here, so the audio thread doesn't have
+        to. Returns true if all of the callbacks were recorded.
+    */
+    bool recordCallbackTimings (int numCallbacksToRecord, int timeoutMs);
+
+    /** Returns the timings recorded by the last call to recordCallbackTimings(). */
+    std::vector<CallbackTiming> getRecordedCallbackTimings() const;
+
+    /** Returns the timing mode that was passed to the constructor. */
+    Timing getTiming() const noexcept                       { return timing; }
+
+    //==============================================================================
+    /** The name of the device type that creates these devices. */
+    static constexpr const char* deviceTypeName = "Null";
+
+    //==============================================================================
+    /** @internal */
+    StringArray getOutputChannelNames() override;
+    /** @internal */
+    StringArray getInputChannelNames() override;
+    /** @internal */
+    std::optional<BigInteger> getDefaultOutputChannels() const override;
+    /** @internal */
+    std::optional<BigInteger> getDefaultInputChannels() const override;
+    /** @internal */
+    Array<double> getAvailableSampleRates() override;
+    /** @internal */
+    Array<int> getAvailableBufferSizes() override;
+    /** @internal */
+    int getDefaultBufferSize() override;
+    /** @internal */
+    String open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                 double sampleRate, int bufferSizeSamples) override;
+    /** @internal */
+    void close() override;
+    /** @internal */
+    bool isOpen() override;
+    /** @internal */
+    void start (AudioIODeviceCallback*) override;
+    /** @internal */
+    void stop() override;
+    /** @internal */
+    bool isPlaying() override;
+    /** @internal */
+    String getLastError() override;
+    /** @internal */
+    int getCurrentBufferSizeSamples() override;
+    /** @internal */
+    double getCurrentSampleRate() override;
+    /** @internal */
+    int getCurrentBitDepth() override;
+    /** @internal */
+    BigInteger getActiveOutputChannels() const override;
+    /** @internal */
+    BigInteger getActiveInputChannels() const override;
+    /** @internal */
+    int getOutputLatencyInSamples() override;
+    /** @internal */
+    int getInputLatencyInSamples() override;
+    /** @internal */
+    int getXRunCount() const noexcept override;
+    /** @internal */
+    bool setRealtimeThreadOptions (const RealtimeOptions&) override;
+    /** @internal */
+    std::optional<RealtimeStatus> getRealtimeThreadStatus() const override;
+
+private:
+    //==============================================================================
+    using Clock = std::chrono::steady_clock;
+
+    void run() override;
+    void setCallback (AudioIODeviceCallback*);
+    void addCallbackTime (Clock::duration callbackTime, Clock::duration lateness, bool missedDeadline) noexcept;
+
+    template <typename Fn>
+    void callWithStartStopLock (Fn&&) const;
+
+    const Timing timing;
+    RealtimeOptions threadOptions;
+
+    BigInteger activeInputChannels, activeOutputChannels;
+    double currentSampleRate = 0.0;
+    int currentBufferSize = 0;
+    bool deviceIsOpen = false;
+
+    AudioBuffer<float> inputBuffer, outputBuffer;
+
+    CriticalSection startStopLock;
+    AudioIODeviceCallback* callback = nullptr;
+
+    std::atomic<int64> numCallbacks { 0 }, totalCallbackNs { 0 }, maxCallbackNs { 0 }, statisticsStartNs { 0 };
+    mutable std::atomic<int> numThreadsWaitingForLock { 0 };
+    std::atomic<int> numDeadlineMisses { 0 };
+
+    // These are only used with the startStopLock held
+    std::vector<CallbackTiming> recordedTimings;
+    size_t numTimingsToRecord = 0, numTimingsRecorded = 0;
+    WaitableEvent timingsRecorded;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NullAudioIODevice)
+};
+
+} // namespace juce
@@ -260,6 +260,8 @@ namespace juce
 #include "audio_io/juce_AudioDeviceManager.cpp"
 #include "audio_io/juce_AudioIODevice.cpp"
 #include "audio_io/juce_AudioIODeviceType.cpp"
+#include "audio_io/juce_NullAudioIODevice.cpp"
+#include "audio_io/juce_AggregateAudioIODevice.cpp"
 #include "midi_io/juce_MidiMessageCollector.cpp"
 #include "sources/juce_AudioSourcePlayer.cpp"
 #include "sources/juce_AudioTransportSource.cpp"
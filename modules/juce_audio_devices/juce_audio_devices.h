@@ -109,6 +109,16 @@
  #define JUCE_ALSA 1
 #endif
 
+/** Config: JUCE_ALSA_MMAP
+    Makes ALSA devices use mmap access when the device supports it. This converts the
+    audio directly between the device's buffer and the callback's channels, rather
+    than going through an intermediate buffer, which helps when using very small
+    buffer sizes.
+*/
+#ifndef JUCE_ALSA_MMAP
+ #define JUCE_ALSA_MMAP 0
+#endif
+
 /** Config: JUCE_JACK
     Enables JACK audio devices (Linux only).
 */
@@ -123,6 +133,24 @@
  #define JUCE_BELA 0
 #endif
 
+/** Config: JUCE_NULL_AUDIO_DEVICE
+    Adds a device type with devices that aren't connected to any hardware to every
+    AudioDeviceManager. This is useful for running and benchmarking apps on machines
+    without any sound hardware. See NullAudioIODevice.
+*/
+#ifndef JUCE_NULL_AUDIO_DEVICE
+ #define JUCE_NULL_AUDIO_DEVICE 0
+#endif
+
+/** Config: JUCE_AGGREGATE_AUDIO_DEVICE
+    Adds an AggregateAudioIODeviceType to every AudioDeviceManager, which allows the
+    inputs and outputs to come from different devices, even if their clocks aren't
+    synchronised.
+*/
+#ifndef JUCE_AGGREGATE_AUDIO_DEVICE
+ #define JUCE_AGGREGATE_AUDIO_DEVICE 0
+#endif
+
 /** Config: JUCE_USE_ANDROID_OBOE
     Enables Oboe devices (Android only).
 */
@@ -180,6 +208,8 @@ namespace juce
 
 #include "audio_io/juce_AudioIODevice.h"
 #include "audio_io/juce_AudioIODeviceType.h"
+#include "audio_io/juce_NullAudioIODevice.h"
+#include "audio_io/juce_AggregateAudioIODevice.h"
 #include "audio_io/juce_SystemAudioVolume.h"
 #include "sources/juce_AudioSourcePlayer.h"
 #include "sources/juce_AudioTransportSource.h"
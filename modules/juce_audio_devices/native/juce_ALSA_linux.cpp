@@ -208,6 +208,21 @@ public:
             return false;
         }
 
+        isMmap = false;
+
+       #if JUCE_ALSA_MMAP
+        if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_INTERLEAVED) >= 0)
+        {
+            isMmap = true;
+            isInterleaved = true;
+        }
+        else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_NONINTERLEAVED) >= 0)
+        {
+            isMmap = true;
+            isInterleaved = false;
+        }
+        else
+       #endif
         if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED) >= 0) // works better for plughw..
             isInterleaved = true;
         else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_NONINTERLEAVED) >= 0)
@@ -310,6 +325,9 @@ public:
     //==============================================================================
     bool writeToOutputDevice (AudioBuffer<float>& outputChannelBuffer, const int numSamples)
     {
+        if (isMmap)
+            return transferMmap (outputChannelBuffer, numSamples);
+
         jassert (numChannelsRunning <= outputChannelBuffer.getNumChannels());
         float* const* const data = outputChannelBuffer.getArrayOfWritePointers();
         snd_pcm_sframes_t numDone = 0;
@@ -348,6 +366,9 @@ public:
 
     bool readFromInputDevice (AudioBuffer<float>& inputChannelBuffer, const int numSamples)
     {
+        if (isMmap)
+            return transferMmap (inputChannelBuffer, numSamples);
+
         jassert (numChannelsRunning <= inputChannelBuffer.getNumChannels());
         float* const* const data = inputChannelBuffer.getArrayOfWritePointers();
 
@@ -402,6 +423,7 @@ public:
     String error;
     int bitDepth, numChannelsRunning, latency;
     int underrunCount = 0, overrunCount = 0;
+    bool isMmap = false;
 
 private:
     //==============================================================================
@@ -467,6 +489,101 @@ private:
     }
 
     //==============================================================================
+    // Converts between the callback's channels and the device's own buffer, so that
+    // no intermediate copy is needed
+    bool transferMmap (AudioBuffer<float>& channelBuffer, const int numSamples)
+    {
+        jassert (numChannelsRunning <= channelBuffer.getNumChannels());
+        float* const* const data = channelBuffer.getArrayOfWritePointers();
+
+        for (int numDone = 0; numDone < numSamples;)
+        {
+            const auto avail = snd_pcm_avail_update (handle);
+
+            if (avail < 0)
+            {
+                if (! recoverMmap ((int) avail))
+                    return false;
+
+                continue;
+            }
+
+            if (avail == 0)
+            {
+                const auto waitResult = snd_pcm_wait (handle, 2000);
+
+                if (waitResult == 0)
+                {
+                    error = "timed out waiting for the device";
+                    JUCE_ALSA_LOG ("Error: " + error);
+                    return false;
+                }
+
+                if (waitResult < 0 && ! recoverMmap (waitResult))
+                    return false;
+
+                continue;
+            }
+
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0;
+            auto numFrames = (snd_pcm_uframes_t) (numSamples - numDone);
+
+            if (JUCE_ALSA_FAILED (snd_pcm_mmap_begin (handle, &areas, &offset, &numFrames)))
+                return false;
+
+            for (int i = 0; i < numChannelsRunning; ++i)
+            {
+                // With interleaved access, the converter picks the channel out of each frame
+                const auto& area = areas[isInterleaved ? 0 : i];
+                auto* deviceData = static_cast<char*> (area.addr) + (area.first + offset * area.step) / 8;
+                const auto deviceChannel = isInterleaved ? i : 0;
+
+                if (isInput)
+                    converter->convertSamples (data[i] + numDone, 0, deviceData, deviceChannel, (int) numFrames);
+                else
+                    converter->convertSamples (deviceData, deviceChannel, data[i] + numDone, 0, (int) numFrames);
+            }
+
+            const auto numCommitted = snd_pcm_mmap_commit (handle, offset, numFrames);
+
+            if (numCommitted < 0 || (snd_pcm_uframes_t) numCommitted != numFrames)
+            {
+                if (! recoverMmap (numCommitted < 0 ? (int) numCommitted : -EPIPE))
+                    return false;
+
+                continue;
+            }
+
+            numDone += (int) numFrames;
+        }
+
+        // Unlike snd_pcm_writei, committing mmap data doesn't start playback
+        if (! isInput && snd_pcm_state (handle) == SND_PCM_STATE_PREPARED)
+            return ! JUCE_ALSA_FAILED (snd_pcm_start (handle));
+
+        return true;
+    }
+
+    bool recoverMmap (int err)
+    {
+        if (err == -EPIPE)
+        {
+            if (isInput)
+                overrunCount++;
+            else
+                underrunCount++;
+        }
+
+        if (JUCE_ALSA_FAILED (snd_pcm_recover (handle, err, 1 /* silent */)))
+            return false;
+
+        // After recovering, a capture stream has to be restarted explicitly
+        return ! isInput
+                || snd_pcm_state (handle) != SND_PCM_STATE_PREPARED
+                || ! JUCE_ALSA_FAILED (snd_pcm_start (handle));
+    }
+
     bool failed (const int errorNum)
     {
         if (errorNum >= 0)
@@ -618,7 +735,13 @@ public:
         if (outputDevice != nullptr && JUCE_ALSA_FAILED (snd_pcm_prepare (outputDevice->handle)))
             return;
 
-        startThread (Priority::high);
+        // snd_pcm_readi would start capturing on the first read, but mmap access has to do it explicitly
+        if (inputDevice != nullptr && inputDevice->isMmap && JUCE_ALSA_FAILED (snd_pcm_start (inputDevice->handle)))
+            return;
+
+        // Without permission to use a realtime scheduler, fall back to a normal thread
+        if (! (threadOptions.has_value() && startRealtimeThread (*threadOptions)))
+            startThread (Priority::high);
 
         int count = 1000;
 
@@ -785,6 +908,7 @@ public:
     Array<double> sampleRates;
     StringArray channelNamesOut, channelNamesIn;
     AudioIODeviceCallback* callback = nullptr;
+    std::optional<RealtimeOptions> threadOptions;
 
 private:
     //==============================================================================
@@ -935,6 +1059,17 @@ public:
 
     int getXRunCount() const noexcept override       { return internal.getXRunCount(); }
 
+    bool setRealtimeThreadOptions (const Thread::RealtimeOptions& options) override
+    {
+        internal.threadOptions = options;
+        return true;
+    }
+
+    std::optional<Thread::RealtimeStatus> getRealtimeThreadStatus() const override
+    {
+        return internal.getRealtimeStatus();
+    }
+
     void start (AudioIODeviceCallback* callback) override
     {
         if (! isOpen_)
@@ -1298,4 +1433,114 @@ static inline AudioIODeviceType* createAudioIODeviceType_ALSA_PCMDevices()
     return new ALSAAudioIODeviceType (false, "ALSA");
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+// These use ALSA's null and file plugins, so they don't need any audio hardware
+class ALSADeviceTests final : public UnitTest
+{
+public:
+    ALSADeviceTests()
+        : UnitTest ("ALSA devices", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        constexpr auto blockSize = 256;
+        constexpr auto numBlocks = 8;
+        constexpr auto numChannels = 2;
+
+        const auto getSample = [] (int channel, int sample)
+        {
+            return (float) ((sample * (channel + 1)) % 64) / 64.0f - 0.5f;
+        };
+
+        beginTest ("Playback writes the callback's audio to the device");
+        {
+            const TemporaryFile temp (".raw");
+            ALSADevice device ("file:'" + temp.getFile().getFullPathName() + "',raw", false);
+            expect (device.error.isEmpty(), device.error);
+
+            if (device.error.isEmpty())
+            {
+                expect (device.setParameters (44100, numChannels, blockSize), device.error);
+                expectDeviceUsesMmap (device);
+
+                AudioBuffer<float> buffer (numChannels, blockSize);
+
+                for (auto block = 0; block < numBlocks; ++block)
+                {
+                    // The non-mmap path converts the buffer in place, so it's refilled every time
+                    for (auto channel = 0; channel < numChannels; ++channel)
+                        for (auto sample = 0; sample < blockSize; ++sample)
+                            buffer.setSample (channel, sample, getSample (channel, block * blockSize + sample));
+
+                    expect (device.writeToOutputDevice (buffer, blockSize), device.error);
+                }
+
+                device.closeNow();
+
+                // The null plugin behind the file plugin accepts any format, so the device
+                // uses its first choice, interleaved little-endian floats
+                expectEquals (device.bitDepth, 32);
+
+                MemoryBlock written;
+                expect (temp.getFile().loadFileAsData (written));
+
+                const auto numFrames = (int) (written.getSize() / (sizeof (float) * numChannels));
+                expect (numFrames > 0 && numFrames <= numBlocks * blockSize);
+
+                auto numMismatches = 0;
+
+                for (auto frame = 0; frame < numFrames; ++frame)
+                {
+                    for (auto channel = 0; channel < numChannels; ++channel)
+                    {
+                        float value;
+                        written.copyTo (&value, (int) sizeof (float) * (frame * numChannels + channel), sizeof (float));
+
+                        if (! exactlyEqual (ByteOrder::swapIfBigEndian (value), getSample (channel, frame)))
+                            ++numMismatches;
+                    }
+                }
+
+                expectEquals (numMismatches, 0);
+            }
+        }
+
+        beginTest ("Capture reads whole blocks from the device");
+        {
+            ALSADevice device ("null", true);
+            expect (device.error.isEmpty(), device.error);
+
+            if (device.error.isEmpty())
+            {
+                expect (device.setParameters (44100, numChannels, blockSize), device.error);
+                expectDeviceUsesMmap (device);
+
+                AudioBuffer<float> buffer (numChannels, blockSize);
+
+                for (auto block = 0; block < numBlocks; ++block)
+                    expect (device.readFromInputDevice (buffer, blockSize), device.error);
+
+                expectEquals (device.overrunCount, 0);
+            }
+        }
+    }
+
+private:
+    void expectDeviceUsesMmap (const ALSADevice& device)
+    {
+       #if JUCE_ALSA_MMAP
+        expect (device.isMmap);
+       #else
+        expect (! device.isMmap);
+       #endif
+    }
+};
+
+static ALSADeviceTests alsaDeviceTests;
+
+#endif
+
 } // namespace juce
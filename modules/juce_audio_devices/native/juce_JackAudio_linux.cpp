@@ -76,6 +76,8 @@ JUCE_DECL_JACK_FUNCTION (int, jack_port_connected_to, (const jack_port_t* port,
 JUCE_DECL_JACK_FUNCTION (int, jack_set_xrun_callback, (jack_client_t* client, JackXRunCallback xrun_callback, void* arg), (client, xrun_callback, arg))
 JUCE_DECL_JACK_FUNCTION (int, jack_port_flags, (const jack_port_t* port), (port))
 JUCE_DECL_JACK_FUNCTION (jack_port_t*, jack_port_by_name, (jack_client_t* client, const char* name), (client, name))
+JUCE_DECL_JACK_FUNCTION (int, jack_set_thread_init_callback, (jack_client_t* client, JackThreadInitCallback thread_init_callback, void* arg), (client, thread_init_callback, arg))
+JUCE_DECL_JACK_FUNCTION (jack_native_thread_t, jack_client_thread_id, (jack_client_t* client), (client))
 JUCE_DECL_VOID_JACK_FUNCTION (jack_free, (void* ptr), (ptr))
 
 #if JUCE_DEBUG
@@ -285,6 +287,7 @@ public:
         close();
 
         xruns.store (0, std::memory_order_relaxed);
+        juce::jack_set_thread_init_callback (client, threadInitCallback, this);
         juce::jack_set_process_callback (client, processCallback, this);
         juce::jack_set_port_connect_callback (client, portConnectCallback, this);
         juce::jack_on_shutdown (client, shutdownCallback, this);
@@ -349,6 +352,7 @@ public:
             [[maybe_unused]] const auto result = juce::jack_deactivate (client);
             jassert (result == 0);
 
+            juce::jack_set_thread_init_callback (client, threadInitCallback, nullptr);
             juce::jack_set_xrun_callback (client, xrunCallback, nullptr);
             juce::jack_set_process_callback (client, processCallback, nullptr);
             juce::jack_set_port_connect_callback (client, portConnectCallback, nullptr);
@@ -357,6 +361,9 @@ public:
         }
 
         deviceIsOpen = false;
+
+        const SpinLock::ScopedLockType sl (realtimeThreadStatusLock);
+        realtimeThreadStatus.reset();
     }
 
     void start (AudioIODeviceCallback* newCallback) override
@@ -389,6 +396,39 @@ public:
     String getLastError() override                   { return lastError; }
     int getXRunCount() const noexcept override       { return xruns.load (std::memory_order_relaxed); }
 
+    bool setRealtimeThreadOptions (const Thread::RealtimeOptions& options) override
+    {
+        realtimeThreadOptions = options;
+        return true;
+    }
+
+    std::optional<Thread::RealtimeStatus> getRealtimeThreadStatus() const override
+    {
+        auto status = [&]
+        {
+            const SpinLock::ScopedLockType sl (realtimeThreadStatusLock);
+            return realtimeThreadStatus;
+        }();
+
+        // The server may change the thread's scheduling after it has been initialised,
+        // so this part of the status is read from the thread itself
+        if (status.has_value() && client != nullptr)
+        {
+            int policy = 0;
+            sched_param param{};
+
+            if (pthread_getschedparam (juce::jack_client_thread_id (client), &policy, &param) == 0)
+            {
+                status->nativePriority = param.sched_priority;
+                status->schedulingPolicy = policy == SCHED_FIFO ? std::make_optional (Thread::RealtimeOptions::SchedulingPolicy::fifo)
+                                         : policy == SCHED_RR   ? std::make_optional (Thread::RealtimeOptions::SchedulingPolicy::roundRobin)
+                                                                : std::nullopt;
+            }
+        }
+
+        return status;
+    }
+
     BigInteger getActiveOutputChannels() const override  { return activeOutputChannels; }
     BigInteger getActiveInputChannels()  const override  { return activeInputChannels;  }
 
@@ -527,9 +567,20 @@ private:
             device->mainThreadDispatcher.updateActivePorts();
     }
 
-    static void threadInitCallback (void* /* callbackArgument */)
+    static void threadInitCallback (void* callbackArgument)
     {
         JUCE_JACK_LOG ("JackAudioIODevice::initialise");
+
+        if (auto* device = static_cast<JackAudioIODevice*> (callbackArgument))
+        {
+            if (device->realtimeThreadOptions.has_value())
+            {
+                const auto status = Thread::applyRealtimeOptionsToCurrentThread (*device->realtimeThreadOptions);
+
+                const SpinLock::ScopedLockType sl (device->realtimeThreadStatusLock);
+                device->realtimeThreadStatus = status;
+            }
+        }
     }
 
     static void shutdownCallback (void* callbackArgument)
@@ -572,6 +623,10 @@ private:
 
     std::atomic<int> xruns { 0 };
 
+    std::optional<Thread::RealtimeOptions> realtimeThreadOptions;
+    std::optional<Thread::RealtimeStatus> realtimeThreadStatus;
+    mutable SpinLock realtimeThreadStatusLock;
+
     std::function<void()> notifyChannelsChanged;
     MainThreadDispatcher mainThreadDispatcher { *this };
 };
@@ -163,6 +163,8 @@
 #include "format_types/juce_VSTMidiEventList.h"
 #include "format_types/juce_VSTPluginFormat.h"
 #include "format_types/juce_ARAHosting.h"
+#include "scanning/juce_MappedPluginList.h"
+#include "scanning/juce_PluginScanCache.h"
 #include "scanning/juce_PluginDirectoryScanner.h"
 #include "scanning/juce_PluginListComponent.h"
 #include "utilities/juce_AudioProcessorParameterWithID.h"
@@ -140,9 +140,20 @@ public:
     using NodeAndChannel = AudioProcessorGraph::NodeAndChannel;
 
 private:
-    static auto equalRange (const std::set<NodeAndChannel>& pins, const NodeID node)
+    /*  Finds all the entries belonging to a particular node in a set or map keyed by
+        NodeAndChannel. std::equal_range would be linear here, because the containers' iterators
+        aren't random-access, so this uses the container's own logarithmic lookup instead.
+    */
+    template <typename Container>
+    static auto equalRange (const Container& container, const NodeID node)
     {
-        return std::equal_range (pins.cbegin(), pins.cend(), node, ImplicitNode::compare);
+        const auto begin = container.lower_bound (NodeAndChannel { node, std::numeric_limits<int>::min() });
+        auto end = begin;
+
+        while (end != container.cend() && ! ImplicitNode::compare (node, *end))
+            ++end;
+
+        return std::make_pair (begin, end);
     }
 
     using Map = std::map<NodeAndChannel, std::set<NodeAndChannel>>;
@@ -285,41 +296,79 @@ public:
     bool operator== (const Connections& other) const { return sourcesForDestination == other.sourcesForDestination; }
     bool operator!= (const Connections& other) const { return sourcesForDestination != other.sourcesForDestination; }
 
+    /*  Records, for each source, the last step of a rendering order at which it is read, and
+        the input channels that read it at that step.
+    */
     class DestinationsForSources
     {
     public:
-        explicit DestinationsForSources (Map m) : map (std::move (m)) {}
-
-        bool isSourceConnectedToDestinationNodeIgnoringChannel (const NodeAndChannel& source, NodeID dest, int channel) const
+        /*  Returns true if the source is read by the node at the given step (on a channel other
+            than channelToIgnore), or by any node that is rendered after that step.
+        */
+        bool isSourceNeededFromStep (const NodeAndChannel& source, int step, int channelToIgnore) const
         {
-            if (const auto destIter = map.find (source); destIter != map.cend())
-            {
-                const auto [begin, end] = equalRange (destIter->second, dest);
-                return std::any_of (begin, end, [&] (const NodeAndChannel& nodeAndChannel)
-                {
-                    return nodeAndChannel != NodeAndChannel { dest, channel };
-                });
-            }
+            const auto iter = map.find (source);
 
-            return false;
+            if (iter == map.cend() || iter->second.step < step)
+                return false;
+
+            if (iter->second.step > step)
+                return true;
+
+            const auto& channels = iter->second.channels;
+            return std::any_of (channels.begin(), channels.end(), [&] (int c) { return c != channelToIgnore; });
         }
 
     private:
-        Map map;
+        friend class Connections;
+
+        struct LastUse
+        {
+            int step = -1;
+            std::vector<int> channels;
+        };
+
+        std::map<NodeAndChannel, LastUse> map;
     };
 
     /*  Reverses the graph, to allow fast lookup by source.
         This is expensive, don't call this more than necessary!
     */
-    auto getDestinationsForSources() const
+    template <typename NodeArray>
+    auto getDestinationsForSources (const NodeArray& renderingOrder) const
     {
-        Map destinationsForSources;
+        std::map<NodeID, int> stepForNode;
+
+        for (int i = 0; i < renderingOrder.size(); ++i)
+            stepForNode.emplace (renderingOrder.getUnchecked (i)->nodeID, i);
+
+        DestinationsForSources result;
 
         for (const auto& [destination, sources] : sourcesForDestination)
+        {
+            const auto stepIter = stepForNode.find (destination.nodeID);
+
+            if (stepIter == stepForNode.cend())
+                continue;
+
+            const auto step = stepIter->second;
+
             for (const auto& source : sources)
-                destinationsForSources[source].insert (destination);
+            {
+                auto& lastUse = result.map[source];
+
+                if (lastUse.step < step)
+                {
+                    lastUse.step = step;
+                    lastUse.channels.clear();
+                }
+
+                if (lastUse.step == step)
+                    lastUse.channels.push_back (destination.channelIndex);
+            }
+        }
 
-        return DestinationsForSources (std::move (destinationsForSources));
+        return result;
     }
 
 private:
@@ -362,7 +411,7 @@ private:
 
     std::pair<Map::const_iterator, Map::const_iterator> getMatchingDestinations (NodeID destID) const
     {
-        return std::equal_range (sourcesForDestination.cbegin(), sourcesForDestination.cend(), destID, ImplicitNode::compare);
+        return equalRange (sourcesForDestination, destID);
     }
 
     Map sourcesForDestination;
@@ -494,6 +543,350 @@ private:
     std::optional<PrepareSettings> current, next;
 };
 
+//==============================================================================
+/*  Describes the dependencies between the jobs of a render sequence, and hands out jobs to
+    whichever thread asks for one while the sequence is being rendered in parallel.
+
+    A job is a run of render ops which must execute in order (normally a node's ProcessOp,
+    preceded by the ops that gather its inputs). Jobs are ordered by the resources they touch:
+    if two jobs access the same buffer and at least one of them writes to it, the later job
+    must wait for the earlier one. Because the sequence builder recycles buffers, this also
+    takes care of write-after-read hazards, not just the connections between nodes.
+
+    The per-block state is reset by the audio thread before the workers are woken, and after
+    that all bookkeeping is done with atomics, so running the schedule never locks or allocates.
+*/
+class ParallelRenderSchedule
+{
+public:
+    struct Resource
+    {
+        enum class Kind { audioChannel, midiBuffer, graphAudioOutput, graphMidiOutput };
+
+        static Resource audioChannel (int index)    { return { Kind::audioChannel, index }; }
+        static Resource midiBuffer (int index)      { return { Kind::midiBuffer, index }; }
+        static Resource graphAudioOutput()          { return { Kind::graphAudioOutput, 0 }; }
+        static Resource graphMidiOutput()           { return { Kind::graphMidiOutput, 0 }; }
+
+        bool operator< (const Resource& other) const noexcept
+        {
+            return std::tie (kind, index) < std::tie (other.kind, other.index);
+        }
+
+        Kind kind;
+        int index;
+    };
+
+    /*  Collects the resources that are touched by the ops of a single job. */
+    class JobResources
+    {
+    public:
+        void read (Resource r)
+        {
+            // The first audio channel is the shared read-only block of zeros
+            if (! (r.kind == Resource::Kind::audioChannel && r.index == 0))
+                usage.emplace (r, false);
+        }
+
+        void write (Resource r)
+        {
+            if (! (r.kind == Resource::Kind::audioChannel && r.index == 0))
+                usage[r] = true;
+        }
+
+    private:
+        friend class ParallelRenderSchedule;
+        std::map<Resource, bool> usage;
+    };
+
+    /*  Call on the main thread, in rendering order. */
+    void addJob (const JobResources& resources)
+    {
+        const auto jobIndex = (int) jobs.size();
+        jobs.emplace_back();
+
+        std::set<int> dependencies;
+
+        for (const auto& [resource, writes] : resources.usage)
+        {
+            auto& history = resourceHistory[resource];
+
+            if (history.lastWriter >= 0)
+                dependencies.insert (history.lastWriter);
+
+            if (writes)
+            {
+                dependencies.insert (history.readersSinceLastWrite.begin(), history.readersSinceLastWrite.end());
+                history.readersSinceLastWrite.clear();
+                history.lastWriter = jobIndex;
+            }
+            else
+            {
+                history.readersSinceLastWrite.push_back (jobIndex);
+            }
+        }
+
+        for (auto dependency : dependencies)
+            jobs[(size_t) dependency].successors.push_back (jobIndex);
+
+        jobs.back().numDependencies = (int) dependencies.size();
+    }
+
+    /*  Call on the main thread once all jobs have been added. */
+    void prepare()
+    {
+        resourceHistory.clear();
+        pendingDependencies = std::vector<std::atomic<int>> (jobs.size());
+        readyJobs = std::vector<std::atomic<int>> (jobs.size());
+    }
+
+    int getNumJobs() const noexcept { return (int) jobs.size(); }
+
+    /*  Call on the audio thread before any other thread may run jobs. */
+    void reset() noexcept
+    {
+        for (auto& slot : readyJobs)
+            slot.store (noJob, std::memory_order_relaxed);
+
+        numReady.store (0, std::memory_order_relaxed);
+        nextToRun.store (0, std::memory_order_relaxed);
+        numFinished.store (0, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            pendingDependencies[i].store (jobs[i].numDependencies, std::memory_order_relaxed);
+
+            if (jobs[i].numDependencies == 0)
+                pushReadyJob ((int) i);
+        }
+
+        std::atomic_thread_fence (std::memory_order_release);
+    }
+
+    /*  May be called concurrently from any number of threads. Runs jobs until none are ready. */
+    template <typename RunJob>
+    void runAvailableJobs (RunJob&& runJob) noexcept
+    {
+        for (auto job = popReadyJob(); job != noJob; job = popReadyJob())
+        {
+            while (job != noJob)
+            {
+                runJob (job);
+                job = finishJob (job);
+            }
+        }
+    }
+
+    bool isFinished() const noexcept
+    {
+        return numFinished.load (std::memory_order_acquire) == (int) jobs.size();
+    }
+
+private:
+    static constexpr int noJob = -1;
+
+    /*  Marks a job as finished and releases its successors. The first successor that becomes
+        ready is returned so that it can be run directly by the same thread, which keeps the data
+        that was just written in this core's cache.
+    */
+    int finishJob (int job) noexcept
+    {
+        auto next = noJob;
+
+        for (auto successor : jobs[(size_t) job].successors)
+        {
+            if (pendingDependencies[(size_t) successor].fetch_sub (1, std::memory_order_acq_rel) == 1)
+            {
+                if (next == noJob)
+                    next = successor;
+                else
+                    pushReadyJob (successor);
+            }
+        }
+
+        numFinished.fetch_add (1, std::memory_order_acq_rel);
+        return next;
+    }
+
+    void pushReadyJob (int job) noexcept
+    {
+        // Each job becomes ready exactly once per block, so the queue can never overflow
+        const auto slot = numReady.fetch_add (1, std::memory_order_acq_rel);
+        readyJobs[(size_t) slot].store (job, std::memory_order_release);
+    }
+
+    int popReadyJob() noexcept
+    {
+        auto slot = nextToRun.load (std::memory_order_acquire);
+
+        while (slot < numReady.load (std::memory_order_acquire))
+        {
+            if (nextToRun.compare_exchange_weak (slot, slot + 1, std::memory_order_acq_rel))
+            {
+                // The slot has been reserved, but the pushing thread may not have published it yet
+                for (;;)
+                {
+                    const auto job = readyJobs[(size_t) slot].load (std::memory_order_acquire);
+
+                    if (job != noJob)
+                        return job;
+                }
+            }
+        }
+
+        return noJob;
+    }
+
+    struct Job
+    {
+        std::vector<int> successors;
+        int numDependencies = 0;
+    };
+
+    struct ResourceHistory
+    {
+        int lastWriter = -1;
+        std::vector<int> readersSinceLastWrite;
+    };
+
+    std::vector<Job> jobs;
+    std::map<Resource, ResourceHistory> resourceHistory;
+
+    std::vector<std::atomic<int>> pendingDependencies, readyJobs;
+    std::atomic<int> numReady { 0 }, nextToRun { 0 }, numFinished { 0 };
+};
+
+//==============================================================================
+/*  A set of real-time worker threads that help the audio thread to render a graph.
+
+    Workers sleep on a LightweightSemaphore between blocks. The audio thread signals it when it
+    publishes a new block, which doesn't take any locks, and only makes a system call if a worker
+    is actually asleep.
+*/
+class GraphRenderThreadPool
+{
+public:
+    struct Task
+    {
+        virtual ~Task() = default;
+
+        /*  Called concurrently by the audio thread and the workers. */
+        virtual void runAvailableJobs() noexcept = 0;
+        virtual bool isFinished() const noexcept = 0;
+    };
+
+    explicit GraphRenderThreadPool (int numThreads)
+    {
+        for (int i = 0; i < numThreads; ++i)
+        {
+            auto worker = std::make_unique<Worker> (*this, i);
+
+            if (! worker->startRealtimeThread (Thread::RealtimeOptions{}.withPriority (9)))
+                worker->startThread (Thread::Priority::highest);
+
+            workers.push_back (std::move (worker));
+        }
+    }
+
+    ~GraphRenderThreadPool()
+    {
+        for (auto& worker : workers)
+            worker->signalThreadShouldExit();
+
+        wakeUp.signal ((int) workers.size());
+
+        for (auto& worker : workers)
+            worker->stopThread (-1);
+    }
+
+    int getNumThreads() const noexcept { return (int) workers.size(); }
+
+    /*  Call from the audio thread only. Returns once every job of the task has been run. */
+    void perform (Task& task) noexcept
+    {
+        currentTask.store (&task);
+
+        if (const auto numSleeping = numSleepingWorkers.load(); numSleeping > 0)
+            wakeUp.signal (numSleeping);
+
+        while (! task.isFinished())
+            task.runAvailableJobs();
+
+        currentTask.store (nullptr);
+
+        // Make sure that no worker still holds a reference to the task before returning
+        while (numBusyWorkers.load() != 0)
+            Thread::yield();
+    }
+
+private:
+    class Worker final : public Thread
+    {
+    public:
+        Worker (GraphRenderThreadPool& p, int index)
+            : Thread ("Graph render thread " + String (index + 1)), pool (p) {}
+
+        ~Worker() override
+        {
+            stopThread (-1);
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                if (pool.helpWithCurrentTask())
+                    continue;
+
+                pool.numSleepingWorkers.fetch_add (1);
+
+                // Re-check after announcing that we're about to sleep, so that a task that was
+                // published in the meantime can't be missed. If the audio thread signals for a
+                // worker that then doesn't wait, the next wait returns straight away instead.
+                if (pool.currentTask.load() == nullptr)
+                    pool.wakeUp.wait (100);
+
+                pool.numSleepingWorkers.fetch_sub (1);
+            }
+        }
+
+    private:
+        GraphRenderThreadPool& pool;
+    };
+
+    bool helpWithCurrentTask() noexcept
+    {
+        numBusyWorkers.fetch_add (1);
+        auto* task = currentTask.load();
+
+        if (task != nullptr)
+            task->runAvailableJobs();
+
+        numBusyWorkers.fetch_sub (1);
+        return task != nullptr;
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<Task*> currentTask { nullptr };
+    std::atomic<int> numBusyWorkers { 0 }, numSleepingWorkers { 0 };
+    LightweightSemaphore wakeUp;
+
+    JUCE_DECLARE_NON_COPYABLE (GraphRenderThreadPool)
+};
+
+//==============================================================================
+/*  The parameter events passed to AudioProcessorGraph::processBlockWithParameterEvents. */
+struct BlockParameterEvents
+{
+    Span<const AudioProcessorGraph::ParameterEvent> events;
+
+    // The position of the chunk currently being rendered, within the block that the events
+    // refer to
+    int startSample = 0;
+
+    int minimumSubBlockSize = 0;
+};
+
 //==============================================================================
 template <typename FloatType>
 struct GraphRenderSequence
@@ -512,10 +905,15 @@ struct GraphRenderSequence
     {
         GlobalIO globalIO;
         AudioPlayHead* audioPlayHead;
+        BlockParameterEvents parameterEvents;
         int numSamples;
     };
 
-    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead)
+    void perform (AudioBuffer<FloatType>& buffer,
+                  MidiBuffer& midiMessages,
+                  AudioPlayHead* audioPlayHead,
+                  BlockParameterEvents parameterEvents,
+                  GraphRenderThreadPool* threadPool)
     {
         auto numSamples = buffer.getNumSamples();
         auto maxSamples = renderingBuffer.getNumSamples();
@@ -534,7 +932,10 @@ struct GraphRenderSequence
 
                 // Splitting up the buffer like this will cause the play head and host time to be
                 // invalid for all but the first chunk...
-                perform (audioChunk, midiChunk, audioPlayHead);
+                auto chunkEvents = parameterEvents;
+                chunkEvents.startSample += chunkStartSample;
+
+                perform (audioChunk, midiChunk, audioPlayHead, chunkEvents, threadPool);
 
                 chunkStartSample += maxSamples;
             }
@@ -552,10 +953,18 @@ struct GraphRenderSequence
                                       midiMessages,
                                       currentMidiOutputBuffer },
                                     audioPlayHead,
+                                    parameterEvents,
                                     numSamples };
 
-            for (const auto& op : renderOps)
-                op->process (context);
+            if (threadPool != nullptr && parallelRenderer != nullptr)
+            {
+                parallelRenderer->perform (*threadPool, context);
+            }
+            else
+            {
+                for (const auto& op : renderOps)
+                    op->process (context);
+            }
         }
 
         for (int i = 0; i < buffer.getNumChannels(); ++i)
@@ -583,6 +992,11 @@ struct GraphRenderSequence
                 FloatVectorOperations::clear (channelBuffer, c.numSamples);
             }
 
+            void addResources (ParallelRenderSchedule::JobResources& r) const override
+            {
+                r.write (ParallelRenderSchedule::Resource::audioChannel (index));
+            }
+
             FloatType* channelBuffer = nullptr;
             int index = 0;
         };
@@ -607,6 +1021,12 @@ struct GraphRenderSequence
                 FloatVectorOperations::copy (toBuffer, fromBuffer, c.numSamples);
             }
 
+            void addResources (ParallelRenderSchedule::JobResources& r) const override
+            {
+                r.read  (ParallelRenderSchedule::Resource::audioChannel (from));
+                r.write (ParallelRenderSchedule::Resource::audioChannel (to));
+            }
+
             FloatType* fromBuffer = nullptr;
             FloatType* toBuffer = nullptr;
             int from = 0, to = 0;
@@ -632,6 +1052,12 @@ struct GraphRenderSequence
                 FloatVectorOperations::add (toBuffer, fromBuffer, c.numSamples);
             }
 
+            void addResources (ParallelRenderSchedule::JobResources& r) const override
+            {
+                r.read  (ParallelRenderSchedule::Resource::audioChannel (from));
+                r.write (ParallelRenderSchedule::Resource::audioChannel (to));
+            }
+
             FloatType* fromBuffer = nullptr;
             FloatType* toBuffer = nullptr;
             int from = 0, to = 0;
@@ -640,6 +1066,83 @@ struct GraphRenderSequence
         renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
     }
 
+    /*  Sums several channels into dstIndex. If accumulate is false, the previous contents of
+        dstIndex are replaced.
+    */
+    void addMixChannelOp (const std::vector<int>& srcIndices, int dstIndex, bool accumulate)
+    {
+        if (srcIndices.empty())
+        {
+            if (! accumulate)
+                addClearChannelOp (dstIndex);
+
+            return;
+        }
+
+        if (srcIndices.size() == 1)
+        {
+            if (accumulate)
+                addAddChannelOp (srcIndices.front(), dstIndex);
+            else
+                addCopyChannelOp (srcIndices.front(), dstIndex);
+
+            return;
+        }
+
+        struct MixOp final : public RenderOp
+        {
+            MixOp (const std::vector<int>& fromIn, int toIn, bool accumulateIn)
+                : from (fromIn), fromBuffers (fromIn.size()), to (toIn), accumulate (accumulateIn) {}
+
+            void prepare (FloatType* const* renderBuffer, MidiBuffer*) override
+            {
+                for (size_t i = 0; i < from.size(); ++i)
+                    fromBuffers[i] = renderBuffer[from[i]];
+
+                toBuffer = renderBuffer[to];
+            }
+
+            void process (const Context& c) override
+            {
+                // Mixing a chunk at a time means that the destination stays in the cache while
+                // all the sources are added to it, rather than being streamed once per source
+                constexpr int chunkSize = 256;
+
+                for (int start = 0; start < c.numSamples; start += chunkSize)
+                {
+                    const auto num = jmin (chunkSize, c.numSamples - start);
+                    auto* dest = toBuffer + start;
+                    auto source = fromBuffers.cbegin();
+
+                    if (! accumulate)
+                    {
+                        FloatVectorOperations::add (dest, source[0] + start, source[1] + start, num);
+                        source += 2;
+                    }
+
+                    for (; source != fromBuffers.cend(); ++source)
+                        FloatVectorOperations::add (dest, *source + start, num);
+                }
+            }
+
+            void addResources (ParallelRenderSchedule::JobResources& r) const override
+            {
+                for (auto index : from)
+                    r.read (ParallelRenderSchedule::Resource::audioChannel (index));
+
+                r.write (ParallelRenderSchedule::Resource::audioChannel (to));
+            }
+
+            std::vector<int> from;
+            std::vector<const FloatType*> fromBuffers;
+            FloatType* toBuffer = nullptr;
+            int to = 0;
+            bool accumulate = true;
+        };
+
+        renderOps.push_back (std::make_unique<MixOp> (srcIndices, dstIndex, accumulate));
+    }
+
     JUCE_END_IGNORE_WARNINGS_MSVC
 
     void addClearMidiBufferOp (int index)
@@ -658,6 +1161,11 @@ struct GraphRenderSequence
                 channelBuffer->clear();
             }
 
+            void addResources (ParallelRenderSchedule::JobResources& r) const override
+            {
+                r.write (ParallelRenderSchedule::Resource::midiBuffer (index));
+            }
+
             MidiBuffer* channelBuffer = nullptr;
             int index = 0;
         };
@@ -682,6 +1190,12 @@ struct GraphRenderSequence
                 *toBuffer = *fromBuffer;
             }
 
+            void addResources (ParallelRenderSchedule::JobResources& r) const override
+            {
+                r.read  (ParallelRenderSchedule::Resource::midiBuffer (from));
+                r.write (ParallelRenderSchedule::Resource::midiBuffer (to));
+            }
+
             MidiBuffer* fromBuffer = nullptr;
             MidiBuffer* toBuffer = nullptr;
             int from = 0, to = 0;
@@ -707,6 +1221,12 @@ struct GraphRenderSequence
                 toBuffer->addEvents (*fromBuffer, 0, c.numSamples, 0);
             }
 
+            void addResources (ParallelRenderSchedule::JobResources& r) const override
+            {
+                r.read  (ParallelRenderSchedule::Resource::midiBuffer (from));
+                r.write (ParallelRenderSchedule::Resource::midiBuffer (to));
+            }
+
             MidiBuffer* fromBuffer = nullptr;
             MidiBuffer* toBuffer = nullptr;
             int from = 0, to = 0;
@@ -745,6 +1265,11 @@ struct GraphRenderSequence
                 }
             }
 
+            void addResources (ParallelRenderSchedule::JobResources& r) const override
+            {
+                r.write (ParallelRenderSchedule::Resource::audioChannel (channel));
+            }
+
             std::vector<FloatType> buffer;
             FloatType* channelBuffer = nullptr;
             const int channel;
@@ -757,7 +1282,8 @@ struct GraphRenderSequence
     void addProcessOp (const Node::Ptr& node,
                        const Array<int>& audioChannelsUsed,
                        int totalNumChans,
-                       int midiBuffer)
+                       int midiBuffer,
+                       bool timeNode)
     {
         auto op = [&]() -> std::unique_ptr<NodeOp>
         {
@@ -782,7 +1308,10 @@ struct GraphRenderSequence
             return std::make_unique<ProcessOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
         }();
 
-        renderOps.push_back (std::move (op));
+        if (timeNode)
+            renderOps.push_back (std::make_unique<TimedOp> (std::move (op)));
+        else
+            renderOps.push_back (std::move (op));
     }
 
     void prepareBuffers (int blockSize)
@@ -797,8 +1326,6 @@ struct GraphRenderSequence
         midiBuffers.clearQuick();
         midiBuffers.resize (numMidiBuffersNeeded);
 
-        const int defaultMIDIBufferSize = 512;
-
         midiChunk.ensureSize (defaultMIDIBufferSize);
 
         for (auto&& m : midiBuffers)
@@ -808,6 +1335,16 @@ struct GraphRenderSequence
             op->prepare (renderingBuffer.getArrayOfWritePointers(), midiBuffers.data());
     }
 
+    /*  Works out which ops may run concurrently. Call after the sequence has been built, and
+        before it is used with a thread pool.
+    */
+    void prepareParallelRendering()
+    {
+        parallelRenderer = std::make_unique<ParallelRenderer> (renderOps);
+    }
+
+    static constexpr size_t defaultMIDIBufferSize = 512;
+
     int numBuffersNeeded = 0, numMidiBuffersNeeded = 0;
 
     AudioBuffer<FloatType> renderingBuffer, currentAudioOutputBuffer;
@@ -824,6 +1361,12 @@ private:
         virtual ~RenderOp() = default;
         virtual void prepare (FloatType* const*, MidiBuffer*) = 0;
         virtual void process (const Context&) = 0;
+        virtual void addResources (ParallelRenderSchedule::JobResources&) const = 0;
+
+        /*  The ops that prepare a node's inputs are emitted directly before the node's own op,
+            so each node op closes a job for parallel rendering.
+        */
+        virtual bool endsJob() const { return false; }
     };
 
     struct NodeOp : public RenderOp
@@ -842,7 +1385,7 @@ private:
                 audioChannelsToUse.add (0);
         }
 
-        void prepare (FloatType* const* renderBuffer, MidiBuffer* buffers) final
+        void prepare (FloatType* const* renderBuffer, MidiBuffer* buffers) override
         {
             for (size_t i = 0; i < audioChannels.size(); ++i)
                 audioChannels[i] = renderBuffer[audioChannelsToUse.getUnchecked ((int) i)];
@@ -852,6 +1395,8 @@ private:
 
         void process (const Context& c) final
         {
+            JUCE_TRACE_SCOPE ("audio", "AudioProcessorGraph node");
+
             processor.setPlayHead (c.audioPlayHead);
 
             auto numAudioChannels = [this]
@@ -872,10 +1417,25 @@ private:
             else
             {
                 const auto bypass = node->isBypassed() && processor.getBypassParameter() == nullptr;
-                processWithBuffer (c.globalIO, bypass, buffer, *midiBuffer);
+                processWithContext (c, bypass, buffer, *midiBuffer);
             }
         }
 
+        virtual void processWithContext (const Context& c, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi)
+        {
+            processWithBuffer (c.globalIO, bypass, audio, midi);
+        }
+
+        void addResources (ParallelRenderSchedule::JobResources& r) const override
+        {
+            for (const auto& index : audioChannelsToUse)
+                r.write (ParallelRenderSchedule::Resource::audioChannel (index));
+
+            r.write (ParallelRenderSchedule::Resource::midiBuffer (midiBufferToUse));
+        }
+
+        bool endsJob() const final { return true; }
+
         virtual void processWithBuffer (const GlobalIO&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) = 0;
 
         const Node::Ptr node;
@@ -891,11 +1451,111 @@ private:
     {
         using NodeOp::NodeOp;
 
+        void prepare (FloatType* const* renderBuffer, MidiBuffer* buffers) final
+        {
+            NodeOp::prepare (renderBuffer, buffers);
+
+            // The sub-blocks only ever hold events taken from the node's incoming buffer, so
+            // reserving the same space means that splitting a block won't allocate unless the
+            // incoming buffer has had to grow too
+            subBlockMidi.ensureSize (defaultMIDIBufferSize);
+            processedMidi.ensureSize (defaultMIDIBufferSize);
+        }
+
         void processWithBuffer (const GlobalIO&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
         {
             callProcess (bypass, audio, midi);
         }
 
+        void processWithContext (const Context& c, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
+        {
+            const auto& blockEvents = c.parameterEvents;
+
+            if (blockEvents.events.empty())
+            {
+                callProcess (bypass, audio, midi);
+                return;
+            }
+
+            const auto numSamples = audio.getNumSamples();
+            const auto nodeID = this->node->nodeID;
+            const auto& parameters = this->processor.getParameters();
+
+            auto iter = blockEvents.events.begin();
+            const auto end = blockEvents.events.end();
+
+            // Returns the position of this node's next event, relative to the start of this chunk
+            const auto findNextEvent = [&]
+            {
+                while (iter != end && (iter->nodeID != nodeID || iter->samplePosition < blockEvents.startSample))
+                    ++iter;
+
+                return iter != end ? iter->samplePosition - blockEvents.startSample
+                                   : std::numeric_limits<int>::max();
+            };
+
+            const auto applyEventsBefore = [&] (int position)
+            {
+                for (auto next = findNextEvent(); next < position; next = findNextEvent())
+                {
+                    if (auto* parameter = parameters[iter->parameterIndex])
+                        parameter->setValue (iter->value);
+
+                    ++iter;
+                }
+            };
+
+            if (! this->node->splitsBlocksAtParameterEvents())
+            {
+                applyEventsBefore (numSamples);
+                callProcess (bypass, audio, midi);
+                return;
+            }
+
+            const auto minimumSize = jmax (1, blockEvents.minimumSubBlockSize);
+            processedMidi.clear();
+
+            for (int start = 0; start < numSamples;)
+            {
+                // Changes that would result in a sub-block shorter than the minimum size are
+                // applied early, at the start of the current sub-block
+                applyEventsBefore (jmin (start + minimumSize, numSamples));
+                auto subBlockEnd = jmin (findNextEvent(), numSamples);
+
+                if (subBlockEnd < numSamples && numSamples - subBlockEnd < minimumSize)
+                {
+                    // Changes too close to the end of the block are applied at the start of a
+                    // final sub-block of the minimum size, or at the start of this one if there
+                    // isn't room to split it
+                    subBlockEnd = numSamples - minimumSize;
+
+                    if (subBlockEnd - start < minimumSize)
+                    {
+                        applyEventsBefore (numSamples);
+                        subBlockEnd = numSamples;
+                    }
+                }
+
+                if (start == 0 && subBlockEnd == numSamples)
+                {
+                    callProcess (bypass, audio, midi);
+                    return;
+                }
+
+                const auto length = subBlockEnd - start;
+                AudioBuffer<FloatType> subBlock (audio.getArrayOfWritePointers(), audio.getNumChannels(), start, length);
+
+                subBlockMidi.clear();
+                subBlockMidi.addEvents (midi, start, length, -start);
+                callProcess (bypass, subBlock, subBlockMidi);
+                processedMidi.addEvents (subBlockMidi, 0, length, start);
+
+                start = subBlockEnd;
+            }
+
+            midi.swapWith (processedMidi);
+        }
+
         void callProcess (bool bypass, AudioBuffer<float>& buffer, MidiBuffer& midi)
         {
             if (this->processor.isUsingDoublePrecision())
@@ -934,6 +1594,7 @@ private:
         }
 
         AudioBuffer<float> tempBufferFloat, tempBufferDouble;
+        MidiBuffer subBlockMidi, processedMidi;
     };
 
     struct MidiInOp final : public NodeOp
@@ -956,6 +1617,12 @@ private:
             if (! bypass)
                 g.midiOut.addEvents (midi, 0, audio.getNumSamples(), 0);
         }
+
+        void addResources (ParallelRenderSchedule::JobResources& r) const override
+        {
+            NodeOp::addResources (r);
+            r.write (ParallelRenderSchedule::Resource::graphMidiOutput());
+        }
     };
 
     struct AudioInOp final : public NodeOp
@@ -984,9 +1651,105 @@ private:
             for (int i = jmin (g.audioOut.getNumChannels(), audio.getNumChannels()); --i >= 0;)
                 g.audioOut.addFrom (i, 0, audio, i, 0, audio.getNumSamples());
         }
+
+        void addResources (ParallelRenderSchedule::JobResources& r) const override
+        {
+            NodeOp::addResources (r);
+            r.write (ParallelRenderSchedule::Resource::graphAudioOutput());
+        }
+    };
+
+    /*  Wraps a node op, and reports the time it takes to the node.
+        These are only created while node timing is enabled.
+    */
+    struct TimedOp final : public RenderOp
+    {
+        explicit TimedOp (std::unique_ptr<NodeOp> op)
+            : inner (std::move (op)),
+              ticksToMs (1000.0 / (double) Time::getHighResolutionTicksPerSecond()) {}
+
+        void prepare (FloatType* const* renderBuffer, MidiBuffer* buffers) override
+        {
+            inner->prepare (renderBuffer, buffers);
+        }
+
+        void process (const Context& c) override
+        {
+            const auto start = Time::getHighResolutionTicks();
+            inner->process (c);
+            const auto elapsed = Time::getHighResolutionTicks() - start;
+
+            inner->node->registerProcessTime ((double) elapsed * ticksToMs, c.numSamples);
+        }
+
+        void addResources (ParallelRenderSchedule::JobResources& r) const override
+        {
+            inner->addResources (r);
+        }
+
+        bool endsJob() const override { return inner->endsJob(); }
+
+        std::unique_ptr<NodeOp> inner;
+        const double ticksToMs;
+    };
+
+    //==============================================================================
+    /*  Runs the render ops on a GraphRenderThreadPool, one job per node. */
+    class ParallelRenderer final : public GraphRenderThreadPool::Task
+    {
+    public:
+        explicit ParallelRenderer (const std::vector<std::unique_ptr<RenderOp>>& renderOps)
+        {
+            ParallelRenderSchedule::JobResources resources;
+
+            for (const auto& op : renderOps)
+            {
+                ops.push_back (op.get());
+                op->addResources (resources);
+
+                if (op->endsJob() || ops.size() == renderOps.size())
+                {
+                    schedule.addJob (std::exchange (resources, {}));
+                    jobEnds.push_back (ops.size());
+                }
+            }
+
+            schedule.prepare();
+        }
+
+        void perform (GraphRenderThreadPool& pool, const Context& c) noexcept
+        {
+            context = &c;
+            schedule.reset();
+            pool.perform (*this);
+            context = nullptr;
+        }
+
+        void runAvailableJobs() noexcept override
+        {
+            schedule.runAvailableJobs ([this] (int job)
+            {
+                const auto begin = job == 0 ? 0 : jobEnds[(size_t) job - 1];
+
+                for (auto i = begin; i < jobEnds[(size_t) job]; ++i)
+                    ops[i]->process (*context);
+            });
+        }
+
+        bool isFinished() const noexcept override
+        {
+            return schedule.isFinished();
+        }
+
+    private:
+        std::vector<RenderOp*> ops;
+        std::vector<size_t> jobEnds;
+        ParallelRenderSchedule schedule;
+        const Context* context = nullptr;
     };
 
     std::vector<std::unique_ptr<RenderOp>> renderOps;
+    std::unique_ptr<ParallelRenderer> parallelRenderer;
 };
 
 //==============================================================================
@@ -1011,16 +1774,17 @@ public:
     static constexpr auto midiChannelIndex = AudioProcessorGraph::midiChannelIndex;
 
     template <typename FloatType>
-    static SequenceAndLatency build (const Nodes& n, const Connections& c)
+    static SequenceAndLatency build (const Nodes& n, const Connections& c, bool timeNodes)
     {
         GraphRenderSequence<FloatType> sequence;
-        const RenderSequenceBuilder builder (n, c, sequence);
+        const RenderSequenceBuilder builder (n, c, sequence, timeNodes);
         return { std::move (sequence), builder.totalLatency };
     }
 
 private:
     //==============================================================================
     const Array<Node*> orderedNodes;
+    const bool timeNodes;
 
     struct AssignedBuffer
     {
@@ -1202,26 +1966,36 @@ private:
             }
         }
 
+        // All the remaining sources are summed in a single op once any delays have been applied
+        std::vector<int> buffersToMix, delayBuffers;
+        auto bufferHoldsFirstSource = true;
+
         if (reusableInputIndex < 0)
         {
-            // can't re-use any of our input chans, so get a new one and copy everything into it..
+            // can't re-use any of our input chans, so get a new one and mix everything into it..
             bufIndex = getFreeBuffer (audioBuffers);
             jassert (bufIndex != 0);
 
             audioBuffers.getReference (bufIndex).setAssignedToNonExistentNode();
 
             auto srcIndex = getBufferContaining (*sources.begin());
-
-            if (srcIndex < 0)
-                sequence.addClearChannelOp (bufIndex);  // if not found, this is probably a feedback loop
-            else
-                sequence.addCopyChannelOp (srcIndex, bufIndex);
-
             reusableInputIndex = 0;
             auto nodeDelay = getNodeDelay (sources.begin()->nodeID);
 
-            if (nodeDelay < maxLatency)
+            if (srcIndex >= 0 && nodeDelay < maxLatency)
+            {
+                // the source is needed elsewhere, so it must be delayed in our own buffer
+                sequence.addCopyChannelOp (srcIndex, bufIndex);
                 sequence.addDelayChannelOp (bufIndex, maxLatency - nodeDelay);
+            }
+            else
+            {
+                // if not found, this is probably a feedback loop
+                if (srcIndex >= 0)
+                    buffersToMix.push_back (srcIndex);
+
+                bufferHoldsFirstSource = false;
+            }
         }
 
         {
@@ -1245,13 +2019,18 @@ private:
                             else // buffer is reused elsewhere, can't be delayed
                             {
                                 auto bufferToDelay = getFreeBuffer (audioBuffers);
+
+                                // keep this buffer to ourselves until the mix has been done
+                                audioBuffers.getReference (bufferToDelay).setAssignedToNonExistentNode();
+                                delayBuffers.push_back (bufferToDelay);
+
                                 sequence.addCopyChannelOp (srcIndex, bufferToDelay);
                                 sequence.addDelayChannelOp (bufferToDelay, maxLatency - nodeDelay);
                                 srcIndex = bufferToDelay;
                             }
                         }
 
-                        sequence.addAddChannelOp (srcIndex, bufIndex);
+                        buffersToMix.push_back (srcIndex);
                     }
                 }
 
@@ -1259,6 +2038,11 @@ private:
             }
         }
 
+        sequence.addMixChannelOp (buffersToMix, bufIndex, bufferHoldsFirstSource);
+
+        for (auto index : delayBuffers)
+            audioBuffers.getReference (index).setFree();
+
         return bufIndex;
     }
 
@@ -1420,7 +2204,7 @@ private:
         if (numOuts == 0)
             totalLatency = jmax (totalLatency, thisNodeLatency);
 
-        sequence.addProcessOp (node, audioChannelsToUse, totalChans, midiBufferToUse);
+        sequence.addProcessOp (node, audioChannelsToUse, totalChans, midiBufferToUse, timeNodes);
     }
 
     //==============================================================================
@@ -1466,27 +2250,18 @@ private:
         if (orderedNodes.size() <= stepIndexToSearchFrom)
             return false;
 
-        if (c.isSourceConnectedToDestinationNodeIgnoringChannel (output,
-                                                                 orderedNodes.getUnchecked (stepIndexToSearchFrom)->nodeID,
-                                                                 inputChannelOfIndexToIgnore))
-        {
-            return true;
-        }
-
-        return std::any_of (orderedNodes.begin() + stepIndexToSearchFrom + 1, orderedNodes.end(), [&] (const auto* node)
-        {
-            return c.isSourceConnectedToDestinationNodeIgnoringChannel (output, node->nodeID, -1);
-        });
+        return c.isSourceNeededFromStep (output, stepIndexToSearchFrom, inputChannelOfIndexToIgnore);
     }
 
     template <typename RenderSequence>
-    RenderSequenceBuilder (const Nodes& n, const Connections& c, RenderSequence& sequence)
-        : orderedNodes (createOrderedNodeList (n, c))
+    RenderSequenceBuilder (const Nodes& n, const Connections& c, RenderSequence& sequence, bool shouldTimeNodes)
+        : orderedNodes (createOrderedNodeList (n, c)),
+          timeNodes (shouldTimeNodes)
     {
         audioBuffers.add (AssignedBuffer::createReadOnlyEmpty()); // first buffer is read-only zeros
         midiBuffers .add (AssignedBuffer::createReadOnlyEmpty());
 
-        const auto reversed = c.getDestinationsForSources();
+        const auto reversed = c.getDestinationsForSources (orderedNodes);
 
         for (int i = 0; i < orderedNodes.size(); ++i)
         {
@@ -1512,18 +2287,27 @@ class RenderSequence
 public:
     using AudioGraphIOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
 
-    RenderSequence (const PrepareSettings s, const Nodes& n, const Connections& c)
-        : RenderSequence (s, s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
-                                ? RenderSequenceBuilder::build<float>  (n, c)
-                                : RenderSequenceBuilder::build<double> (n, c))
+    RenderSequence (const PrepareSettings s,
+                    const Nodes& n,
+                    const Connections& c,
+                    std::shared_ptr<GraphRenderThreadPool> pool,
+                    bool timeNodes)
+        : RenderSequence (s,
+                          s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
+                              ? RenderSequenceBuilder::build<float>  (n, c, timeNodes)
+                              : RenderSequenceBuilder::build<double> (n, c, timeNodes),
+                          std::move (pool))
     {
     }
 
     template <typename FloatType>
-    void process (AudioBuffer<FloatType>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
+    void process (AudioBuffer<FloatType>& audio,
+                  MidiBuffer& midi,
+                  AudioPlayHead* playHead,
+                  const BlockParameterEvents& parameterEvents)
     {
         if (auto* s = std::get_if<GraphRenderSequence<FloatType>> (&sequence.sequence))
-            s->perform (audio, midi, playHead);
+            s->perform (audio, midi, playHead, parameterEvents, threadPool.get());
         else
             jassertfalse; // Not prepared for this audio format!
     }
@@ -1540,14 +2324,24 @@ private:
         jassertfalse;
     }
 
-    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built)
-        : settings (s), sequence (std::move (built))
+    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built, std::shared_ptr<GraphRenderThreadPool> pool)
+        : settings (s), sequence (std::move (built)), threadPool (std::move (pool))
     {
-        visitRenderSequence (*this, [&] (auto& seq) { seq.prepareBuffers (settings.blockSize); });
+        visitRenderSequence (*this, [&] (auto& seq)
+        {
+            seq.prepareBuffers (settings.blockSize);
+
+            if (threadPool != nullptr)
+                seq.prepareParallelRendering();
+        });
     }
 
     PrepareSettings settings;
     SequenceAndLatency sequence;
+
+    // Shared between all sequences built with the same number of render threads. Sequences are
+    // always destroyed on the main thread, so the workers are never stopped by the audio thread.
+    std::shared_ptr<GraphRenderThreadPool> threadPool;
 };
 
 //==============================================================================
@@ -1640,32 +2434,109 @@ public:
     /*  Call from the audio thread only. */
     void updateAudioThreadState()
     {
-        const SpinLock::ScopedTryLockType lock (mutex);
+        const SpinLock::ScopedTryLockType lock (mutex);
+
+        if (lock.isLocked() && isNew)
+        {
+            // Swap pointers rather than assigning to avoid calling delete here
+            std::swap (mainThreadState, audioThreadState);
+            isNew = false;
+        }
+    }
+
+    /*  Call from the audio thread only. */
+    RenderSequence* getAudioThreadState() const { return audioThreadState.get(); }
+
+private:
+    void timerCallback() override
+    {
+        const SpinLock::ScopedLockType lock (mutex);
+
+        if (! isNew)
+            mainThreadState.reset();
+    }
+
+    SpinLock mutex;
+    std::unique_ptr<RenderSequence> mainThreadState, audioThreadState;
+    bool isNew = false;
+};
+
+//==============================================================================
+AudioProcessorGraph::Node::TimingStats AudioProcessorGraph::Node::getTimingStats() const noexcept
+{
+    if (timing.resetRequested)
+        return {};
+
+    TimingStats result;
+    result.minimumMs         = timing.minimumMs;
+    result.maximumMs         = timing.maximumMs;
+    result.averageMs         = timing.averageMs;
+    result.averageLoad       = timing.averageLoad;
+    result.numBlocks         = timing.numBlocks;
+    result.numDeadlineMisses = timing.numDeadlineMisses;
+    return result;
+}
+
+void AudioProcessorGraph::Node::resetTimingStats() noexcept
+{
+    // The rendering thread owns the statistics, so it will clear them next time it
+    // registers a block
+    timing.resetRequested = true;
+}
+
+void AudioProcessorGraph::Node::registerProcessTime (double milliseconds, int numSamples) noexcept
+{
+    const auto sampleRate = processor->getSampleRate();
+
+    if (sampleRate <= 0.0 || numSamples <= 0)
+        return;
+
+    const auto blockMs = 1000.0 * numSamples / sampleRate;
+    const auto load = milliseconds / blockMs;
+    const auto numBlocks = timing.resetRequested.exchange (false) ? 0 : timing.numBlocks.load();
+
+    if (numBlocks == 0)
+    {
+        timing.minimumMs = timing.maximumMs = timing.averageMs = milliseconds;
+        timing.averageLoad = load;
+        timing.numDeadlineMisses = 0;
+
+        timing.windowMinimumMs = timing.windowMaximumMs = timing.previousMinimumMs = timing.previousMaximumMs = milliseconds;
+        timing.windowElapsedMs = 0.0;
+    }
+    else
+    {
+        // Same smoothing as AudioProcessLoadMeasurer
+        const auto filterAmount = 0.2;
+        const auto averageMs = timing.averageMs.load();
+        const auto averageLoad = timing.averageLoad.load();
 
-        if (lock.isLocked() && isNew)
+        if (timing.windowElapsedMs >= TimingState::windowMs)
         {
-            // Swap pointers rather than assigning to avoid calling delete here
-            std::swap (mainThreadState, audioThreadState);
-            isNew = false;
+            timing.previousMinimumMs = timing.windowMinimumMs;
+            timing.previousMaximumMs = timing.windowMaximumMs;
+            timing.windowMinimumMs = timing.windowMaximumMs = milliseconds;
+            timing.windowElapsedMs = 0.0;
+        }
+        else
+        {
+            timing.windowMinimumMs = jmin (timing.windowMinimumMs, milliseconds);
+            timing.windowMaximumMs = jmax (timing.windowMaximumMs, milliseconds);
         }
-    }
 
-    /*  Call from the audio thread only. */
-    RenderSequence* getAudioThreadState() const { return audioThreadState.get(); }
+        timing.minimumMs = jmin (timing.windowMinimumMs, timing.previousMinimumMs);
+        timing.maximumMs = jmax (timing.windowMaximumMs, timing.previousMaximumMs);
+        timing.averageMs = averageMs + filterAmount * (milliseconds - averageMs);
+        timing.averageLoad = averageLoad + filterAmount * (load - averageLoad);
+    }
 
-private:
-    void timerCallback() override
-    {
-        const SpinLock::ScopedLockType lock (mutex);
+    timing.windowElapsedMs += blockMs;
 
-        if (! isNew)
-            mainThreadState.reset();
-    }
+    if (milliseconds > blockMs)
+        ++timing.numDeadlineMisses;
 
-    SpinLock mutex;
-    std::unique_ptr<RenderSequence> mainThreadState, audioThreadState;
-    bool isNew = false;
-};
+    timing.numBlocks = numBlocks + 1;
+}
 
 //==============================================================================
 AudioProcessorGraph::Connection::Connection (NodeAndChannel src, NodeAndChannel dst) noexcept
@@ -1868,9 +2739,64 @@ public:
             n->getProcessor()->setNonRealtime (isProcessingNonRealtime);
     }
 
+    void setNumRenderThreads (int numThreads)
+    {
+        numThreads = jmax (0, numThreads);
+
+        if (numThreads == getNumRenderThreads())
+            return;
+
+        renderThreadPool = numThreads > 0 ? std::make_shared<GraphRenderThreadPool> (numThreads)
+                                          : nullptr;
+
+        // The topology hasn't changed, but the sequence must be rebuilt to pick up the new pool
+        lastBuiltSequence.reset();
+        rebuild (UpdateKind::sync);
+    }
+
+    int getNumRenderThreads() const noexcept
+    {
+        return renderThreadPool != nullptr ? renderThreadPool->getNumThreads() : 0;
+    }
+
+    void setNodeTimingEnabled (bool shouldTimeNodes)
+    {
+        if (std::exchange (nodeTimingEnabled, shouldTimeNodes) == shouldTimeNodes)
+            return;
+
+        lastBuiltSequence.reset();
+        rebuild (UpdateKind::sync);
+    }
+
+    bool isNodeTimingEnabled() const noexcept
+    {
+        return nodeTimingEnabled;
+    }
+
+    void setMinimumSubBlockSize (int numSamples)
+    {
+        minimumSubBlockSize = jmax (1, numSamples);
+    }
+
+    int getMinimumSubBlockSize() const noexcept
+    {
+        return minimumSubBlockSize;
+    }
+
     template <typename Value>
-    void processBlock (AudioBuffer<Value>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
+    void processBlock (AudioBuffer<Value>& audio,
+                       MidiBuffer& midi,
+                       AudioPlayHead* playHead,
+                       Span<const ParameterEvent> parameterEvents = {})
     {
+        JUCE_TRACE_SCOPE ("audio", "AudioProcessorGraph::processBlock");
+
+        // Parameter events must be sorted by sample position
+        jassert (std::is_sorted (parameterEvents.begin(), parameterEvents.end(), [] (const auto& a, const auto& b)
+        {
+            return a.samplePosition < b.samplePosition;
+        }));
+
         renderSequenceExchange.updateAudioThreadState();
 
         if (renderSequenceExchange.getAudioThreadState() == nullptr && MessageManager::getInstance()->isThisTheMessageThread())
@@ -1890,7 +2816,7 @@ public:
         // Only process if the graph has the correct blockSize, sampleRate etc.
         if (state != nullptr && state->getSettings() == nodeStates.getLastRequestedSettings())
         {
-            state->process (audio, midi, playHead);
+            state->process (audio, midi, playHead, { parameterEvents, 0, minimumSubBlockSize.load() });
         }
         else
         {
@@ -1926,7 +2852,7 @@ private:
 
             if (std::exchange (lastBuiltSequence, newSignature) != newSignature)
             {
-                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections);
+                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections, renderThreadPool, nodeTimingEnabled);
                 owner->setLatencySamples (sequence->getLatencySamples());
                 renderSequenceExchange.set (std::move (sequence));
             }
@@ -1945,6 +2871,9 @@ private:
     RenderSequenceExchange renderSequenceExchange;
     NodeID lastNodeID;
     std::optional<RenderSequenceSignature> lastBuiltSequence;
+    std::shared_ptr<GraphRenderThreadPool> renderThreadPool;
+    bool nodeTimingEnabled = false;
+    std::atomic<int> minimumSubBlockSize { 32 };
     LockingAsyncUpdater updater { [this] { handleAsyncUpdate(); } };
 };
 
@@ -1962,6 +2891,22 @@ void AudioProcessorGraph::setStateInformation (const void*, int)    {}
 
 void AudioProcessorGraph::processBlock (AudioBuffer<float>&  audio, MidiBuffer& midi)                       { return pimpl->processBlock (audio, midi, getPlayHead()); }
 void AudioProcessorGraph::processBlock (AudioBuffer<double>& audio, MidiBuffer& midi)                       { return pimpl->processBlock (audio, midi, getPlayHead()); }
+void AudioProcessorGraph::setMinimumSubBlockSize (int numSamples)                                           { return pimpl->setMinimumSubBlockSize (numSamples); }
+int AudioProcessorGraph::getMinimumSubBlockSize() const noexcept                                            { return pimpl->getMinimumSubBlockSize(); }
+
+void AudioProcessorGraph::processBlockWithParameterEvents (AudioBuffer<float>& audio,
+                                                           MidiBuffer& midi,
+                                                           Span<const ParameterEvent> parameterEvents)
+{
+    pimpl->processBlock (audio, midi, getPlayHead(), parameterEvents);
+}
+
+void AudioProcessorGraph::processBlockWithParameterEvents (AudioBuffer<double>& audio,
+                                                           MidiBuffer& midi,
+                                                           Span<const ParameterEvent> parameterEvents)
+{
+    pimpl->processBlock (audio, midi, getPlayHead(), parameterEvents);
+}
 std::vector<AudioProcessorGraph::Connection> AudioProcessorGraph::getConnections() const                    { return pimpl->getConnections(); }
 bool AudioProcessorGraph::addConnection (const Connection& c, UpdateKind updateKind)                        { return pimpl->addConnection (c, updateKind); }
 bool AudioProcessorGraph::removeConnection (const Connection& c, UpdateKind updateKind)                     { return pimpl->removeConnection (c, updateKind); }
@@ -1974,6 +2919,10 @@ void AudioProcessorGraph::releaseResources()
 bool AudioProcessorGraph::removeIllegalConnections (UpdateKind updateKind)                                  { return pimpl->removeIllegalConnections (updateKind); }
 void AudioProcessorGraph::rebuild()                                                                         { return pimpl->rebuild (UpdateKind::sync); }
 void AudioProcessorGraph::reset()                                                                           { return pimpl->reset(); }
+void AudioProcessorGraph::setNumRenderThreads (int numThreads)                                              { return pimpl->setNumRenderThreads (numThreads); }
+int AudioProcessorGraph::getNumRenderThreads() const noexcept                                               { return pimpl->getNumRenderThreads(); }
+void AudioProcessorGraph::setNodeTimingEnabled (bool shouldTimeNodes)                                       { return pimpl->setNodeTimingEnabled (shouldTimeNodes); }
+bool AudioProcessorGraph::isNodeTimingEnabled() const noexcept                                              { return pimpl->isNodeTimingEnabled(); }
 bool AudioProcessorGraph::canConnect (const Connection& c) const                                            { return pimpl->canConnect (c); }
 bool AudioProcessorGraph::isConnected (const Connection& c) const noexcept                                  { return pimpl->isConnected (c); }
 bool AudioProcessorGraph::isConnected (NodeID a, NodeID b) const noexcept                                   { return pimpl->isConnected (a, b); }
@@ -2294,9 +3243,353 @@ public:
             // this graph, so we just want to make sure that we finish the test without timing out.
             logMessage ("render sequence built in " + String (duration) + " ms");
         }
+
+        beginTest ("inputs with several sources receive the sum of all sources");
+        {
+            constexpr auto blockSize = 600;
+            const std::vector<float> gains { 0.5f, 1.0f, 2.0f, -0.25f, 3.0f };
+
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+            const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+            const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+            for (const auto gain : gains)
+            {
+                const auto node = graph.addNode (std::make_unique<GainProcessor> (gain))->nodeID;
+
+                for (auto channel = 0; channel < 2; ++channel)
+                {
+                    expect (graph.addConnection ({ { input, channel }, { node, channel } }));
+                    expect (graph.addConnection ({ { node, channel }, { output, channel } }));
+                }
+            }
+
+            graph.prepareToPlay (44100.0, blockSize);
+
+            AudioBuffer<float> buffer (2, blockSize);
+
+            for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (auto sample = 0; sample < buffer.getNumSamples(); ++sample)
+                    buffer.setSample (channel, sample, (float) (sample % 17) - (float) channel);
+
+            const auto original = buffer;
+            MidiBuffer midi;
+            graph.processBlock (buffer, midi);
+
+            const auto totalGain = std::accumulate (gains.begin(), gains.end(), 0.0f);
+            auto maxError = 0.0f;
+
+            for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (auto sample = 0; sample < buffer.getNumSamples(); ++sample)
+                    maxError = jmax (maxError, std::abs (buffer.getSample (channel, sample) - original.getSample (channel, sample) * totalGain));
+
+            expectLessThan (maxError, 1.0e-4f);
+        }
+
+        beginTest ("several delayed sources that are needed elsewhere are mixed correctly");
+        {
+            constexpr auto blockSize = 256;
+
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+            const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+            const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+            // The source with the most latency is added first, so that the mix starts with it and
+            // the other two sources both have to be copied into scratch buffers to be delayed
+            struct Source { float gain; int latency; };
+            const std::vector<Source> sources { { 1.0f, 30 }, { 0.5f, 0 }, { -2.0f, 10 } };
+
+            const auto mixer = graph.addNode (std::make_unique<GainProcessor> (1.0f))->nodeID;
+            const auto sink  = graph.addNode (BasicProcessor::make (BasicProcessor::getInputOnlyProperties(), MidiIn::no, MidiOut::no))->nodeID;
+
+            for (const auto& source : sources)
+            {
+                const auto node = graph.addNode (std::make_unique<GainProcessor> (source.gain));
+                node->getProcessor()->setLatencySamples (source.latency);
+
+                expect (graph.addConnection ({ { input, 0 }, { node->nodeID, 0 } }));
+                expect (graph.addConnection ({ { node->nodeID, 0 }, { mixer, 0 } }));
+                expect (graph.addConnection ({ { node->nodeID, 0 }, { sink, 0 } }));
+            }
+
+            // Makes sure that the sink is rendered after the mixer, so the sources are still
+            // needed when the mixer's input is built
+            expect (graph.addConnection ({ { mixer, 1 }, { sink, 1 } }));
+            expect (graph.addConnection ({ { mixer, 0 }, { output, 0 } }));
+
+            graph.prepareToPlay (44100.0, blockSize);
+
+            AudioBuffer<float> buffer (2, blockSize);
+            buffer.clear();
+
+            for (auto sample = 0; sample < blockSize; ++sample)
+                buffer.setSample (0, sample, (float) (sample % 23) - 11.0f);
+
+            const auto original = buffer;
+            MidiBuffer midi;
+            graph.processBlock (buffer, midi);
+
+            auto maxError = 0.0f;
+
+            for (auto sample = 0; sample < blockSize; ++sample)
+            {
+                auto expected = 0.0f;
+
+                for (const auto& source : sources)
+                {
+                    const auto delayed = sample - (30 - source.latency);
+
+                    if (delayed >= 0)
+                        expected += source.gain * original.getSample (0, delayed);
+                }
+
+                maxError = jmax (maxError, std::abs (buffer.getSample (0, sample) - expected));
+            }
+
+            expectLessThan (maxError, 1.0e-4f);
+        }
+
+        beginTest ("node timing statistics are only gathered when enabled");
+        {
+            constexpr auto blockSize = 32;
+
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+            const auto node = graph.addNode (std::make_unique<GainProcessor> (0.5f));
+            graph.prepareToPlay (44100.0, blockSize);
+
+            AudioBuffer<float> buffer (2, blockSize);
+            MidiBuffer midi;
+
+            const auto processBlocks = [&] (int numBlocks)
+            {
+                for (auto i = 0; i < numBlocks; ++i)
+                    graph.processBlock (buffer, midi);
+            };
+
+            processBlocks (4);
+            expect (! graph.isNodeTimingEnabled());
+            expectEquals (node->getTimingStats().numBlocks, 0);
+
+            graph.setNodeTimingEnabled (true);
+            processBlocks (10);
+
+            const auto stats = node->getTimingStats();
+            expectEquals (stats.numBlocks, 10);
+            expect (stats.minimumMs <= stats.maximumMs);
+            expect (stats.minimumMs <= stats.averageMs && stats.averageMs <= stats.maximumMs);
+            expect (stats.numDeadlineMisses <= stats.numBlocks);
+
+            node->resetTimingStats();
+            expectEquals (node->getTimingStats().numBlocks, 0);
+
+            processBlocks (3);
+            expectEquals (node->getTimingStats().numBlocks, 3);
+
+            graph.setNodeTimingEnabled (false);
+            processBlocks (3);
+            expectEquals (node->getTimingStats().numBlocks, 3);
+        }
+
+        beginTest ("node timing minimum and maximum follow recent blocks");
+        {
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (2, 2, 44100.0, 441);
+            const auto node = graph.addNode (std::make_unique<GainProcessor> (0.5f));
+            graph.prepareToPlay (44100.0, 441);
+
+            // Each block holds 10 ms of audio
+            node->registerProcessTime (5.0, 441);
+            node->registerProcessTime (0.5, 441);
+
+            for (auto i = 0; i < 50; ++i)
+                node->registerProcessTime (1.0, 441);
+
+            expectEquals (node->getTimingStats().minimumMs, 0.5);
+            expectEquals (node->getTimingStats().maximumMs, 5.0);
+
+            for (auto i = 0; i < 300; ++i)
+                node->registerProcessTime (1.0, 441);
+
+            const auto stats = node->getTimingStats();
+            expectEquals (stats.minimumMs, 1.0);
+            expectEquals (stats.maximumMs, 1.0);
+            expectEquals (stats.numBlocks, 352);
+            expectEquals (stats.numDeadlineMisses, 0);
+        }
+
+        beginTest ("parallel rendering produces the same output as serial rendering");
+        {
+            const auto render = [this] (int numRenderThreads)
+            {
+                constexpr auto blockSize = 64;
+
+                AudioProcessorGraph graph;
+                graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+                graph.setNumRenderThreads (numRenderThreads);
+
+                using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+                const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+                const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+                constexpr auto numChains = 16;
+                constexpr auto chainLength = 4;
+
+                for (auto chain = 0; chain < numChains; ++chain)
+                {
+                    auto previous = input;
+
+                    for (auto link = 0; link < chainLength; ++link)
+                    {
+                        const auto gain = 1.0f + (float) (chain * chainLength + link) * 0.01f;
+                        const auto node = graph.addNode (std::make_unique<GainProcessor> (gain))->nodeID;
+
+                        for (auto channel = 0; channel < 2; ++channel)
+                            expect (graph.addConnection ({ { previous, channel }, { node, channel } }));
+
+                        previous = node;
+                    }
+
+                    // Every chain is mixed into the output, so the output node depends on all of them
+                    for (auto channel = 0; channel < 2; ++channel)
+                        expect (graph.addConnection ({ { previous, channel }, { output, 1 - channel } }));
+                }
+
+                graph.prepareToPlay (44100.0, blockSize);
+
+                AudioBuffer<float> result (2, blockSize * 8);
+
+                for (auto channel = 0; channel < result.getNumChannels(); ++channel)
+                    for (auto sample = 0; sample < result.getNumSamples(); ++sample)
+                        result.setSample (channel, sample, (float) std::sin (sample * 0.05 + channel));
+
+                for (auto start = 0; start < result.getNumSamples(); start += blockSize)
+                {
+                    AudioBuffer<float> block (result.getArrayOfWritePointers(), 2, start, blockSize);
+                    MidiBuffer midi;
+                    graph.processBlock (block, midi);
+                }
+
+                return result;
+            };
+
+            const auto serial = render (0);
+
+            for (auto numThreads : { 1, 3 })
+            {
+                const auto parallel = render (numThreads);
+                auto maxDifference = 0.0f;
+
+                for (auto channel = 0; channel < serial.getNumChannels(); ++channel)
+                    for (auto sample = 0; sample < serial.getNumSamples(); ++sample)
+                        maxDifference = jmax (maxDifference, std::abs (serial.getSample (channel, sample) - parallel.getSample (channel, sample)));
+
+                expect (serial.getMagnitude (0, serial.getNumSamples()) > 0.0f);
+                expectEquals (maxDifference, 0.0f);
+            }
+        }
+
+        beginTest ("parameter events are sample-accurate on nodes that split blocks");
+        {
+            constexpr auto blockSize = 256;
+
+            using Event = AudioProcessorGraph::ParameterEvent;
+            using NodeID = AudioProcessorGraph::NodeID;
+
+            const auto render = [] (bool split, const auto& makeEvents)
+            {
+                AudioProcessorGraph graph;
+                graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+                graph.setMinimumSubBlockSize (32);
+
+                using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+                const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+                const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+                const auto node   = graph.addNode (std::make_unique<ParameterGainProcessor>());
+                node->setSplitsBlocksAtParameterEvents (split);
+
+                for (auto channel = 0; channel < 2; ++channel)
+                {
+                    graph.addConnection ({ { input, channel }, { node->nodeID, channel } });
+                    graph.addConnection ({ { node->nodeID, channel }, { output, channel } });
+                }
+
+                graph.prepareToPlay (44100.0, blockSize);
+
+                const std::vector<Event> events = makeEvents (node->nodeID);
+
+                AudioBuffer<float> buffer (2, blockSize);
+
+                for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    FloatVectorOperations::fill (buffer.getWritePointer (channel), 1.0f, blockSize);
+
+                MidiBuffer midi;
+                graph.processBlockWithParameterEvents (buffer, midi, events);
+
+                return buffer;
+            };
+
+            const auto expectGain = [this] (const AudioBuffer<float>& buffer, int start, int end, float gain)
+            {
+                for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    for (auto sample = start; sample < end; ++sample)
+                        if (! exactlyEqual (buffer.getSample (channel, sample), gain))
+                            return expect (false, "Unexpected gain at sample " + String (sample));
+            };
+
+            // The second event is too close to the first to get its own sub-block
+            const auto closeEvents = [] (NodeID node)
+            {
+                return std::vector<Event> { Event { node, 0, 0.5f, 100 },
+                                            Event { node, 0, 0.25f, 110 },
+                                            Event { NodeID { 1000 }, 0, 1.0f, 150 },
+                                            Event { node, 0, 0.0f, 200 } };
+            };
+
+            const auto splitResult = render (true, closeEvents);
+            expectGain (splitResult, 0, 100, 1.0f);
+            expectGain (splitResult, 100, 200, 0.25f);
+            expectGain (splitResult, 200, blockSize, 0.0f);
+
+            const auto unsplitResult = render (false, closeEvents);
+            expectGain (unsplitResult, 0, blockSize, 0.0f);
+
+            // The last event is too close to the end of the block, so it should move back to the
+            // start of a final sub-block of the minimum size
+            const auto lateEvents = [] (NodeID node)
+            {
+                return std::vector<Event> { Event { node, 0, 0.5f, 100 },
+                                            Event { node, 0, 0.25f, 240 } };
+            };
+
+            const auto lateResult = render (true, lateEvents);
+            expectGain (lateResult, 0, 100, 1.0f);
+            expectGain (lateResult, 100, blockSize - 32, 0.5f);
+            expectGain (lateResult, blockSize - 32, blockSize, 0.25f);
+
+            // Two sub-blocks of the minimum size don't fit after this event, so the late event
+            // moves to the start of the sub-block that it's in
+            const auto crowdedEvents = [] (NodeID node)
+            {
+                return std::vector<Event> { Event { node, 0, 0.5f, 200 },
+                                            Event { node, 0, 0.25f, 240 } };
+            };
+
+            const auto crowdedResult = render (true, crowdedEvents);
+            expectGain (crowdedResult, 0, 200, 1.0f);
+            expectGain (crowdedResult, 200, blockSize, 0.25f);
+        }
     }
 
 private:
+    friend class AudioProcessorGraphBenchmark;
+
     enum class MidiIn  { no, yes };
     enum class MidiOut { no, yes };
 
@@ -2357,10 +3650,134 @@ private:
         MidiIn midiIn;
         MidiOut midiOut;
     };
+
+    class GainProcessor final : public AudioProcessor
+    {
+    public:
+        explicit GainProcessor (float g)
+            : AudioProcessor (BasicProcessor::getStereoProperties()), gain (g) {}
+
+        const String getName() const override                         { return "Gain Processor"; }
+        double getTailLengthSeconds() const override                  { return {}; }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return {}; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return {}; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (juce::MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+        void processBlock (AudioBuffer<float>& b, MidiBuffer&) override { b.applyGain (gain); }
+
+        using AudioProcessor::processBlock;
+
+    private:
+        float gain = 1.0f;
+    };
+
+    class ParameterGainProcessor final : public AudioProcessor
+    {
+    public:
+        ParameterGainProcessor()
+            : AudioProcessor (BasicProcessor::getStereoProperties())
+        {
+            addParameter (gain = new AudioParameterFloat ("gain", "Gain", 0.0f, 1.0f, 1.0f));
+        }
+
+        const String getName() const override                         { return "Parameter Gain Processor"; }
+        double getTailLengthSeconds() const override                  { return {}; }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return {}; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return {}; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (juce::MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+        void processBlock (AudioBuffer<float>& b, MidiBuffer&) override { b.applyGain (gain->get()); }
+
+        using AudioProcessor::processBlock;
+
+    private:
+        AudioParameterFloat* gain = nullptr;
+    };
 };
 
 static AudioProcessorGraphTests audioProcessorGraphTests;
 
+//==============================================================================
+class AudioProcessorGraphBenchmark final : public Benchmark
+{
+public:
+    AudioProcessorGraphBenchmark()
+        : Benchmark ("AudioProcessorGraph", UnitTestCategories::audioProcessors) {}
+
+    void runBenchmark() override
+    {
+        using Tests = AudioProcessorGraphTests;
+        const auto midiChannel = AudioProcessorGraph::midiChannelIndex;
+
+        for (const auto numNodes : { 64, 128, 256, 512 })
+        {
+            AudioProcessorGraph graph;
+
+            std::vector<AudioProcessorGraph::NodeID> nodeIDs;
+
+            for (auto i = 0; i < numNodes; ++i)
+            {
+                nodeIDs.push_back (graph.addNode (Tests::BasicProcessor::make (Tests::BasicProcessor::getStereoProperties(),
+                                                                               Tests::MidiIn::yes,
+                                                                               Tests::MidiOut::yes),
+                                                  std::nullopt,
+                                                  AudioProcessorGraph::UpdateKind::none)->nodeID);
+            }
+
+            // Chains of eight nodes, all mixed into the last node
+            for (auto i = 0; i < numNodes - 1; ++i)
+            {
+                const auto source = nodeIDs[(size_t) i];
+                const auto dest = i % 8 == 7 ? nodeIDs.back() : nodeIDs[(size_t) i + 1];
+
+                for (auto channel = 0; channel < 2; ++channel)
+                    graph.addConnection ({ { source, channel }, { dest, channel } }, AudioProcessorGraph::UpdateKind::none);
+
+                graph.addConnection ({ { source, midiChannel }, { dest, midiChannel } }, AudioProcessorGraph::UpdateKind::none);
+            }
+
+            graph.prepareToPlay (44100.0, 512);
+
+            const AudioProcessorGraph::Connection toggled { { nodeIDs[1], 0 }, { nodeIDs[(size_t) numNodes / 2], 1 } };
+            const auto caseSuffix = " (" + String (numNodes) + " nodes)";
+            auto isConnected = false;
+
+            measure ("Rebuild after a connection change" + caseSuffix, [&]
+            {
+                isConnected = ! isConnected;
+
+                if (isConnected)
+                    graph.addConnection (toggled);
+                else
+                    graph.removeConnection (toggled);
+            });
+
+            // The topology is unchanged, so these should be skipped
+            measure ("No-op rebuild" + caseSuffix, [&] { graph.rebuild(); });
+        }
+    }
+};
+
+static AudioProcessorGraphBenchmark audioProcessorGraphBenchmark;
+
 #endif
 
 } // namespace juce
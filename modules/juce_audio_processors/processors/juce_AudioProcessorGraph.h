@@ -68,6 +68,26 @@ public:
         bool operator<  (const NodeID& other) const noexcept    { return uid <  other.uid; }
     };
 
+    /** A change to the value of one of a node's parameters, at a particular sample position
+        within a block.
+
+        @see processBlockWithParameterEvents
+    */
+    struct ParameterEvent
+    {
+        /** The node whose parameter should change. */
+        NodeID nodeID;
+
+        /** The index of the parameter in the node processor's getParameters() array. */
+        int parameterIndex = 0;
+
+        /** The new normalised value of the parameter. */
+        float value = 0.0f;
+
+        /** The sample position within the block at which the change should take effect. */
+        int samplePosition = 0;
+    };
+
     //==============================================================================
     /** A special index that represents the midi channel of a node.
 
@@ -145,6 +165,53 @@ public:
             bypassed = shouldBeBypassed;
         }
 
+        //==============================================================================
+        /** Statistics about the time taken to process this node.
+
+            @see getTimingStats, AudioProcessorGraph::setNodeTimingEnabled
+        */
+        struct TimingStats
+        {
+            /** The shortest and longest times taken to process a block, in milliseconds.
+
+                These only cover the most recent blocks, between one and two seconds of audio,
+                so that they follow changes in the node's behaviour rather than holding on to
+                an outlier forever.
+            */
+            double minimumMs = 0.0, maximumMs = 0.0;
+
+            /** A smoothed average of the time taken to process a block, in milliseconds. */
+            double averageMs = 0.0;
+
+            /** A smoothed average of the processing time as a proportion of the duration of
+                the audio being processed.
+            */
+            double averageLoad = 0.0;
+
+            /** The number of blocks that have been timed. */
+            int numBlocks = 0;
+
+            /** The number of blocks for which this node alone took longer to process than the
+                duration of the audio in the block.
+            */
+            int numDeadlineMisses = 0;
+        };
+
+        /** Returns the timing statistics gathered for this node since they were last reset.
+
+            Statistics are only gathered while AudioProcessorGraph::setNodeTimingEnabled() is
+            turned on. This may be called from any thread.
+
+            @see resetTimingStats
+        */
+        TimingStats getTimingStats() const noexcept;
+
+        /** Clears the timing statistics. This may be called from any thread.
+
+            @see getTimingStats
+        */
+        void resetTimingStats() noexcept;
+
         //==============================================================================
         /** A convenient typedef for referring to a pointer to a node object. */
         using Ptr = ReferenceCountedObjectPtr<Node>;
@@ -157,6 +224,23 @@ public:
         */
         bool userRequestedBypass() const { return bypassed; }
 
+        /** Sets whether the graph should split this node's blocks at parameter changes.
+
+            When this is enabled, the parameter changes passed to
+            AudioProcessorGraph::processBlockWithParameterEvents() take effect at the sample
+            where they occur, by processing the node in several smaller blocks. Otherwise,
+            all of the changes in a block are applied before the node processes that block.
+
+            Only enable this for processors that behave correctly when their blocks are split,
+            and don't rely on a constant block size.
+
+            @see AudioProcessorGraph::setMinimumSubBlockSize
+        */
+        void setSplitsBlocksAtParameterEvents (bool shouldSplit) noexcept   { splitAtParameterEvents = shouldSplit; }
+
+        /** Returns true if setSplitsBlocksAtParameterEvents (true) was called on this node. */
+        bool splitsBlocksAtParameterEvents() const noexcept                 { return splitAtParameterEvents; }
+
         /** @internal
 
             To create a new node, use AudioProcessorGraph::addNode.
@@ -167,10 +251,32 @@ public:
             jassert (processor != nullptr);
         }
 
+        /** @internal
+
+            Called by the graph on the rendering thread, after processing a block.
+        */
+        void registerProcessTime (double milliseconds, int numSamples) noexcept;
+
     private:
         //==============================================================================
+        /*  Only written by the thread that renders the node, so that the statistics can be
+            updated without locking.
+        */
+        struct TimingState
+        {
+            std::atomic<double> minimumMs { 0.0 }, maximumMs { 0.0 }, averageMs { 0.0 }, averageLoad { 0.0 };
+            std::atomic<int> numBlocks { 0 }, numDeadlineMisses { 0 };
+            std::atomic<bool> resetRequested { false };
+
+            // The minimum and maximum are taken over the current and previous windows
+            static constexpr double windowMs = 1000.0;
+            double windowMinimumMs = 0.0, windowMaximumMs = 0.0, previousMinimumMs = 0.0, previousMaximumMs = 0.0;
+            double windowElapsedMs = 0.0;
+        };
+
         std::unique_ptr<AudioProcessor> processor;
-        std::atomic<bool> bypassed { false };
+        std::atomic<bool> bypassed { false }, splitAtParameterEvents { false };
+        TimingState timing;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Node)
     };
@@ -323,6 +429,92 @@ public:
     */
     void rebuild();
 
+    //==============================================================================
+    /** Sets the number of worker threads that will help to render this graph.
+
+        By default (and when numThreads is 0) the whole graph is rendered on the thread that
+        calls processBlock(). If numThreads is greater than zero, the graph will start that
+        many real-time worker threads, and nodes that don't depend on one another will be
+        processed concurrently, with the processBlock() thread also taking part. Processing
+        only returns once every node (including the audio and MIDI output nodes) has finished.
+
+        The workers don't lock or allocate while rendering. While a block is being rendered they
+        spin, looking for nodes that are ready to be processed, and once it has finished they go
+        to sleep until the next block starts. Because they keep their cores busy for the whole
+        of each block, there is little point in using more threads than there are spare cores.
+
+        You should only enable this if all of the processors in the graph can safely have their
+        processBlock() methods called at the same time as one another.
+
+        This will rebuild the graph, and should be called from the message thread.
+
+        @see getNumRenderThreads
+    */
+    void setNumRenderThreads (int numThreads);
+
+    /** Returns the number of worker threads set with setNumRenderThreads().
+
+        @see setNumRenderThreads
+    */
+    int getNumRenderThreads() const noexcept;
+
+    /** Enables or disables measuring the time each node takes to process.
+
+        When this is enabled, the graph records how long every node takes to render each block,
+        and the results can be read with Node::getTimingStats(). Timing is off by default, in
+        which case the render sequence contains no timing code at all.
+
+        This will rebuild the graph, and should be called from the message thread.
+
+        @see isNodeTimingEnabled, Node::getTimingStats
+    */
+    void setNodeTimingEnabled (bool shouldTimeNodes);
+
+    /** Returns true if node timing has been enabled with setNodeTimingEnabled().
+
+        @see setNodeTimingEnabled
+    */
+    bool isNodeTimingEnabled() const noexcept;
+
+    //==============================================================================
+    /** Renders a block, applying a set of parameter changes at the sample positions where
+        they occur.
+
+        The events must be sorted by samplePosition, and each position should be within the
+        block. Nodes that have had Node::setSplitsBlocksAtParameterEvents() enabled are
+        processed in sub-blocks so that each change is sample-accurate; other nodes apply
+        all of their changes before processing the block.
+
+        Events for unknown nodes or parameter indices are ignored.
+
+        @see setMinimumSubBlockSize
+    */
+    void processBlockWithParameterEvents (AudioBuffer<float>& audio,
+                                          MidiBuffer& midi,
+                                          Span<const ParameterEvent> parameterEvents);
+
+    /** Renders a block, applying a set of parameter changes at the sample positions where
+        they occur.
+
+        @see processBlockWithParameterEvents
+    */
+    void processBlockWithParameterEvents (AudioBuffer<double>& audio,
+                                          MidiBuffer& midi,
+                                          Span<const ParameterEvent> parameterEvents);
+
+    /** Sets the smallest number of samples that a node will be asked to process when its
+        blocks are split at parameter changes.
+
+        Changes that are closer together than this are moved earlier, to the start of the
+        sub-block that contains them. The default is 32 samples.
+
+        @see processBlockWithParameterEvents, Node::setSplitsBlocksAtParameterEvents
+    */
+    void setMinimumSubBlockSize (int numSamples);
+
+    /** Returns the value set with setMinimumSubBlockSize(). */
+    int getMinimumSubBlockSize() const noexcept;
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
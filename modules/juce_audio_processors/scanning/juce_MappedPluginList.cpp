@@ -0,0 +1,590 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  All values are stored little-endian. The file starts with a header of 32-bit fields,
+    followed by a fixed-size record for each type, the sorted indexes, the blacklist, and
+    finally a table of strings, each stored as a 32-bit byte count followed by UTF-8 data.
+
+    Records and indexes refer to strings by their offset in the string table. Each index
+    entry is a pair of a string offset and a type index, sorted by the string's bytes, so
+    that lookups can use a binary search without creating any Strings.
+*/
+struct MappedPluginList::Layout
+{
+    static constexpr uint32 magic   = 0x434c504a; // "JPLC"
+    static constexpr uint32 version = 1;
+
+    enum Index
+    {
+        identifierIndex,
+        manufacturerIndex,
+        categoryIndex,
+        numIndices
+    };
+
+    enum HeaderField
+    {
+        magicField,
+        versionField,
+        numTypesField,
+        recordsOffsetField,
+        numBlacklistedField,
+        blacklistOffsetField,
+        stringsOffsetField,
+        stringsSizeField,
+        firstIndexField,
+        numHeaderFields = firstIndexField + 2 * numIndices
+    };
+
+    static constexpr size_t headerSize = numHeaderFields * sizeof (uint32);
+
+    enum RecordString
+    {
+        nameString,
+        descriptiveNameString,
+        formatNameString,
+        categoryString,
+        manufacturerString,
+        versionString,
+        fileOrIdentifierString,
+        numRecordStrings
+    };
+
+    static constexpr size_t deprecatedUidOffset      = numRecordStrings * sizeof (uint32);
+    static constexpr size_t uniqueIdOffset           = deprecatedUidOffset + 4;
+    static constexpr size_t numInputsOffset          = uniqueIdOffset + 4;
+    static constexpr size_t numOutputsOffset         = numInputsOffset + 4;
+    static constexpr size_t lastFileModTimeOffset    = numOutputsOffset + 4;
+    static constexpr size_t lastInfoUpdateTimeOffset = lastFileModTimeOffset + 8;
+    static constexpr size_t flagsOffset              = lastInfoUpdateTimeOffset + 8;
+    static constexpr size_t recordSize               = flagsOffset + 4;
+
+    static constexpr size_t indexEntrySize = 2 * sizeof (uint32);
+
+    enum Flags : uint32
+    {
+        isInstrumentFlag       = 1 << 0,
+        hasSharedContainerFlag = 1 << 1,
+        hasARAExtensionFlag    = 1 << 2
+    };
+
+    /*  Identifier strings are matched by their suffix, which is made from the hash of the
+        file or identifier and one of the plugin's IDs (see PluginDescription::matchesIdentifierString).
+    */
+    static String getIdentifierKey (const PluginDescription& desc, int uid)
+    {
+        return getPluginDescSuffix (desc, uid).toLowerCase();
+    }
+
+    static String getIdentifierKey (const String& identifierString)
+    {
+        const auto uidPart  = identifierString.fromLastOccurrenceOf ("-", true, false);
+        const auto hashPart = identifierString.dropLastCharacters (uidPart.length())
+                                              .fromLastOccurrenceOf ("-", true, false);
+        return (hashPart + uidPart).toLowerCase();
+    }
+};
+
+//==============================================================================
+MappedPluginList::MappedPluginList (const File& file)
+    : mappedFile (std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly))
+{
+    data = static_cast<const uint8*> (mappedFile->getData());
+    size = mappedFile->getSize();
+    validate();
+}
+
+MappedPluginList::MappedPluginList (const void* dataToUse, size_t numBytes)
+    : data (static_cast<const uint8*> (dataToUse)), size (numBytes)
+{
+    validate();
+}
+
+MappedPluginList::~MappedPluginList() = default;
+
+void MappedPluginList::validate()
+{
+    valid = false;
+
+    if (data == nullptr || size < Layout::headerSize
+         || readInt (Layout::magicField * 4) != Layout::magic
+         || readInt (Layout::versionField * 4) != Layout::version)
+        return;
+
+    const auto fitsInData = [this] (uint64 offset, uint64 numBytes)
+    {
+        return offset <= size && numBytes <= size - offset;
+    };
+
+    const auto field = [this] (int f) { return (uint64) readInt ((size_t) f * 4); };
+
+    if (! fitsInData (field (Layout::recordsOffsetField), field (Layout::numTypesField) * Layout::recordSize)
+         || ! fitsInData (field (Layout::blacklistOffsetField), field (Layout::numBlacklistedField) * 4)
+         || ! fitsInData (field (Layout::stringsOffsetField), field (Layout::stringsSizeField))
+         || field (Layout::numTypesField) > (uint64) std::numeric_limits<int>::max())
+        return;
+
+    for (int i = 0; i < Layout::numIndices; ++i)
+    {
+        const auto indexField = Layout::firstIndexField + 2 * i;
+
+        if (! fitsInData (field (indexField), field (indexField + 1) * Layout::indexEntrySize))
+            return;
+    }
+
+    valid = true;
+}
+
+uint32 MappedPluginList::readInt (size_t offset) const noexcept
+{
+    jassert (offset + 4 <= size);
+    return ByteOrder::littleEndianInt (data + offset);
+}
+
+int64 MappedPluginList::readInt64 (size_t offset) const noexcept
+{
+    jassert (offset + 8 <= size);
+    return (int64) ByteOrder::littleEndianInt64 (data + offset);
+}
+
+std::string_view MappedPluginList::readStringBytes (uint32 stringOffset) const noexcept
+{
+    const auto tableStart = (size_t) readInt (Layout::stringsOffsetField * 4);
+    const auto tableSize  = (size_t) readInt (Layout::stringsSizeField * 4);
+
+    if ((uint64) stringOffset + 4 > tableSize)
+        return {};
+
+    const auto numBytes = (size_t) readInt (tableStart + stringOffset);
+
+    if ((uint64) stringOffset + 4 + numBytes > tableSize)
+        return {};
+
+    return { reinterpret_cast<const char*> (data + tableStart + stringOffset + 4), numBytes };
+}
+
+String MappedPluginList::readString (uint32 stringOffset) const
+{
+    const auto bytes = readStringBytes (stringOffset);
+    return String::fromUTF8 (bytes.data(), (int) bytes.size());
+}
+
+//==============================================================================
+int MappedPluginList::getNumTypes() const noexcept
+{
+    return valid ? (int) readInt (Layout::numTypesField * 4) : 0;
+}
+
+PluginDescription MappedPluginList::getType (int index) const
+{
+    if (! isPositiveAndBelow (index, getNumTypes()))
+    {
+        jassertfalse;
+        return {};
+    }
+
+    const auto record = (size_t) readInt (Layout::recordsOffsetField * 4) + (size_t) index * Layout::recordSize;
+    const auto string = [&] (Layout::RecordString s) { return readString (readInt (record + (size_t) s * 4)); };
+    const auto flags = readInt (record + Layout::flagsOffset);
+
+    PluginDescription desc;
+    desc.name                = string (Layout::nameString);
+    desc.descriptiveName     = string (Layout::descriptiveNameString);
+    desc.pluginFormatName    = string (Layout::formatNameString);
+    desc.category            = string (Layout::categoryString);
+    desc.manufacturerName    = string (Layout::manufacturerString);
+    desc.version             = string (Layout::versionString);
+    desc.fileOrIdentifier    = string (Layout::fileOrIdentifierString);
+    desc.deprecatedUid       = (int) readInt (record + Layout::deprecatedUidOffset);
+    desc.uniqueId            = (int) readInt (record + Layout::uniqueIdOffset);
+    desc.numInputChannels    = (int) readInt (record + Layout::numInputsOffset);
+    desc.numOutputChannels   = (int) readInt (record + Layout::numOutputsOffset);
+    desc.lastFileModTime     = Time (readInt64 (record + Layout::lastFileModTimeOffset));
+    desc.lastInfoUpdateTime  = Time (readInt64 (record + Layout::lastInfoUpdateTimeOffset));
+    desc.isInstrument        = (flags & Layout::isInstrumentFlag) != 0;
+    desc.hasSharedContainer  = (flags & Layout::hasSharedContainerFlag) != 0;
+    desc.hasARAExtension     = (flags & Layout::hasARAExtensionFlag) != 0;
+    return desc;
+}
+
+Array<int> MappedPluginList::findInIndex (int indexNumber, const String& key) const
+{
+    Array<int> result;
+
+    if (! valid)
+        return result;
+
+    const auto indexField = Layout::firstIndexField + 2 * indexNumber;
+    const auto indexStart = (size_t) readInt ((size_t) indexField * 4);
+    const auto numEntries = (size_t) readInt ((size_t) indexField * 4 + 4);
+    const auto numTypes = (uint32) getNumTypes();
+
+    const auto keyAt = [&] (size_t entry) { return readStringBytes (readInt (indexStart + entry * Layout::indexEntrySize)); };
+
+    const auto keyBytes = key.toStdString();
+    const std::string_view keyView { keyBytes };
+
+    // Binary search for the first entry that isn't less than the key
+    size_t first = 0, count = numEntries;
+
+    while (count > 0)
+    {
+        const auto step = count / 2;
+
+        if (keyAt (first + step) < keyView)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    for (auto entry = first; entry < numEntries && keyAt (entry) == keyView; ++entry)
+    {
+        const auto typeIndex = readInt (indexStart + entry * Layout::indexEntrySize + 4);
+
+        if (typeIndex < numTypes)
+            result.add ((int) typeIndex);
+    }
+
+    return result;
+}
+
+std::unique_ptr<PluginDescription> MappedPluginList::getTypeForIdentifierString (const String& identifierString) const
+{
+    const auto indices = findInIndex (Layout::identifierIndex, Layout::getIdentifierKey (identifierString));
+
+    if (indices.isEmpty())
+        return {};
+
+    return std::make_unique<PluginDescription> (getType (indices.getFirst()));
+}
+
+Array<int> MappedPluginList::getIndicesForManufacturer (const String& manufacturerName) const
+{
+    return findInIndex (Layout::manufacturerIndex, manufacturerName);
+}
+
+Array<int> MappedPluginList::getIndicesForCategory (const String& category) const
+{
+    return findInIndex (Layout::categoryIndex, category);
+}
+
+StringArray MappedPluginList::getBlacklistedFiles() const
+{
+    StringArray result;
+
+    if (! valid)
+        return result;
+
+    const auto blacklistStart = (size_t) readInt (Layout::blacklistOffsetField * 4);
+    const auto numBlacklisted = (size_t) readInt (Layout::numBlacklistedField * 4);
+
+    for (size_t i = 0; i < numBlacklisted; ++i)
+        result.add (readString (readInt (blacklistStart + i * 4)));
+
+    return result;
+}
+
+void MappedPluginList::restoreTo (KnownPluginList& list) const
+{
+    list.clear();
+    list.clearBlacklistedFiles();
+
+    // KnownPluginList::addType() inserts at the start, so this keeps the original order
+    for (int i = getNumTypes(); --i >= 0;)
+        list.addType (getType (i));
+
+    for (const auto& file : getBlacklistedFiles())
+        list.addToBlacklist (file);
+}
+
+//==============================================================================
+bool MappedPluginList::write (const KnownPluginList& list, OutputStream& stream)
+{
+    const auto types = list.getTypes();
+    const auto& blacklist = list.getBlacklistedFiles();
+
+    MemoryOutputStream strings;
+    std::map<String, uint32> stringOffsets;
+
+    const auto addString = [&] (const String& s)
+    {
+        const auto iter = stringOffsets.find (s);
+
+        if (iter != stringOffsets.end())
+            return iter->second;
+
+        const auto offset = (uint32) strings.getDataSize();
+        const auto numBytes = s.getNumBytesAsUTF8();
+        strings.writeInt ((int) numBytes);
+        strings.write (s.toRawUTF8(), numBytes);
+        stringOffsets.emplace (s, offset);
+        return offset;
+    };
+
+    struct IndexEntry
+    {
+        std::string key;
+        uint32 stringOffset, typeIndex;
+
+        bool operator< (const IndexEntry& other) const
+        {
+            return std::tie (key, typeIndex) < std::tie (other.key, other.typeIndex);
+        }
+    };
+
+    std::vector<IndexEntry> indexes[Layout::numIndices];
+
+    const auto addIndexEntry = [&] (Layout::Index index, const String& key, int typeIndex)
+    {
+        indexes[index].push_back ({ key.toStdString(), addString (key), (uint32) typeIndex });
+    };
+
+    MemoryOutputStream records;
+
+    for (const auto [typeIndex, desc] : enumerate (types))
+    {
+        for (const auto* s : { &desc.name, &desc.descriptiveName, &desc.pluginFormatName, &desc.category,
+                               &desc.manufacturerName, &desc.version, &desc.fileOrIdentifier })
+            records.writeInt ((int) addString (*s));
+
+        records.writeInt (desc.deprecatedUid);
+        records.writeInt (desc.uniqueId);
+        records.writeInt (desc.numInputChannels);
+        records.writeInt (desc.numOutputChannels);
+        records.writeInt64 (desc.lastFileModTime.toMilliseconds());
+        records.writeInt64 (desc.lastInfoUpdateTime.toMilliseconds());
+        records.writeInt ((int) ((desc.isInstrument       ? Layout::isInstrumentFlag       : 0u)
+                               | (desc.hasSharedContainer ? Layout::hasSharedContainerFlag : 0u)
+                               | (desc.hasARAExtension    ? Layout::hasARAExtensionFlag    : 0u)));
+
+        const auto index = (int) typeIndex;
+        addIndexEntry (Layout::identifierIndex, Layout::getIdentifierKey (desc, desc.uniqueId), index);
+
+        if (desc.deprecatedUid != desc.uniqueId)
+            addIndexEntry (Layout::identifierIndex, Layout::getIdentifierKey (desc, desc.deprecatedUid), index);
+
+        addIndexEntry (Layout::manufacturerIndex, desc.manufacturerName, index);
+        addIndexEntry (Layout::categoryIndex, desc.category, index);
+    }
+
+    std::vector<uint32> blacklistOffsets;
+
+    for (const auto& file : blacklist)
+        blacklistOffsets.push_back (addString (file));
+
+    for (auto& index : indexes)
+        std::sort (index.begin(), index.end());
+
+    const auto recordsOffset = Layout::headerSize;
+    auto nextOffset = recordsOffset + records.getDataSize();
+
+    uint32 header[Layout::numHeaderFields] {};
+
+    for (int i = 0; i < Layout::numIndices; ++i)
+    {
+        header[Layout::firstIndexField + 2 * i]     = (uint32) nextOffset;
+        header[Layout::firstIndexField + 2 * i + 1] = (uint32) indexes[i].size();
+        nextOffset += indexes[i].size() * Layout::indexEntrySize;
+    }
+
+    header[Layout::magicField]           = Layout::magic;
+    header[Layout::versionField]         = Layout::version;
+    header[Layout::numTypesField]        = (uint32) types.size();
+    header[Layout::recordsOffsetField]   = (uint32) recordsOffset;
+    header[Layout::numBlacklistedField]  = (uint32) blacklistOffsets.size();
+    header[Layout::blacklistOffsetField] = (uint32) nextOffset;
+    header[Layout::stringsOffsetField]   = (uint32) (nextOffset + blacklistOffsets.size() * 4);
+    header[Layout::stringsSizeField]     = (uint32) strings.getDataSize();
+
+    // The offsets are only 32 bits wide
+    if ((uint64) header[Layout::stringsOffsetField] + strings.getDataSize() > std::numeric_limits<uint32>::max())
+        return false;
+
+    bool ok = true;
+
+    for (const auto field : header)
+        ok = ok && stream.writeInt ((int) field);
+
+    ok = ok && stream.write (records.getData(), records.getDataSize());
+
+    for (const auto& index : indexes)
+        for (const auto& entry : index)
+            ok = ok && stream.writeInt ((int) entry.stringOffset) && stream.writeInt ((int) entry.typeIndex);
+
+    for (const auto offset : blacklistOffsets)
+        ok = ok && stream.writeInt ((int) offset);
+
+    return ok && stream.write (strings.getData(), strings.getDataSize());
+}
+
+bool MappedPluginList::writeToFile (const KnownPluginList& list, const File& file)
+{
+    TemporaryFile temp (file);
+
+    {
+        FileOutputStream stream (temp.getFile());
+
+        if (! stream.openedOk() || ! write (list, stream))
+            return false;
+
+        stream.flush();
+
+        if (stream.getStatus().failed())
+            return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MappedPluginListTests final : public UnitTest
+{
+public:
+    MappedPluginListTests()
+        : UnitTest ("MappedPluginList", UnitTestCategories::audioProcessors)
+    {}
+
+    void runTest() override
+    {
+        KnownPluginList list;
+
+        for (const auto& [typeName, typeManufacturer, typeCategory] : { std::tuple { "Delay",   "Acme",    "Fx" },
+                                                                        std::tuple { "Reverb",  "Acme",    "Fx" },
+                                                                        std::tuple { "Synth",   "Example", "Synth" },
+                                                                        std::tuple { "Phaser",  "Example", "Fx" } })
+        {
+            PluginDescription desc;
+            desc.name = typeName;
+            desc.descriptiveName = String (typeName) + " plug-in";
+            desc.pluginFormatName = "VST3";
+            desc.manufacturerName = typeManufacturer;
+            desc.category = typeCategory;
+            desc.version = "1.0";
+            desc.fileOrIdentifier = "/plugins/" + String (typeName) + ".vst3";
+            desc.uniqueId = (int) String (typeName).hashCode();
+            desc.deprecatedUid = desc.uniqueId + 1;
+            desc.isInstrument = String (typeCategory) == "Synth";
+            desc.numOutputChannels = 2;
+            desc.lastFileModTime = Time (1234567890123);
+            list.addType (desc);
+        }
+
+        list.addToBlacklist ("/plugins/Crashy.vst3");
+
+        MemoryOutputStream stream;
+
+        beginTest ("all fields of all types can be read back");
+        {
+            expect (MappedPluginList::write (list, stream));
+
+            MappedPluginList mapped (stream.getData(), stream.getDataSize());
+            expect (mapped.isValid());
+            expectEquals (mapped.getNumTypes(), list.getNumTypes());
+
+            const auto types = list.getTypes();
+
+            for (const auto [i, original] : enumerate (types))
+            {
+                const auto type = mapped.getType ((int) i);
+                expect (type.isDuplicateOf (original));
+                expect (type.createXml()->isEquivalentTo (original.createXml().get(), false));
+            }
+
+            expect (mapped.getBlacklistedFiles() == list.getBlacklistedFiles());
+        }
+
+        beginTest ("types can be found without reading the whole list");
+        {
+            MappedPluginList mapped (stream.getData(), stream.getDataSize());
+
+            for (const auto& original : list.getTypes())
+            {
+                const auto found = mapped.getTypeForIdentifierString (original.createIdentifierString().toUpperCase());
+                expect (found != nullptr && found->isDuplicateOf (original));
+            }
+
+            expect (mapped.getTypeForIdentifierString ("VST3-Missing-0-0") == nullptr);
+
+            const auto namesOf = [&] (const Array<int>& indices)
+            {
+                StringArray names;
+
+                for (auto index : indices)
+                    names.add (mapped.getType (index).name);
+
+                names.sort (false);
+                return names;
+            };
+
+            expect (namesOf (mapped.getIndicesForManufacturer ("Acme")) == StringArray { "Delay", "Reverb" });
+            expect (namesOf (mapped.getIndicesForCategory ("Fx")) == StringArray { "Delay", "Phaser", "Reverb" });
+            expect (mapped.getIndicesForManufacturer ("acme").isEmpty());
+        }
+
+        beginTest ("a list can be restored from a file");
+        {
+            const TemporaryFile temp (".bin");
+            expect (MappedPluginList::writeToFile (list, temp.getFile()));
+
+            MappedPluginList mapped (temp.getFile());
+            expect (mapped.isValid());
+
+            KnownPluginList restored;
+            mapped.restoreTo (restored);
+            expect (restored.createXml()->isEquivalentTo (list.createXml().get(), false));
+        }
+
+        beginTest ("truncated or incompatible data is rejected");
+        {
+            MappedPluginList truncated (stream.getData(), stream.getDataSize() - 1);
+            expect (! truncated.isValid());
+            expectEquals (truncated.getNumTypes(), 0);
+            expect (truncated.getIndicesForCategory ("Fx").isEmpty());
+
+            MemoryBlock copy (stream.getData(), stream.getDataSize());
+            copy[4] = (char) (copy[4] + 1);
+            expect (! MappedPluginList (copy.getData(), copy.getSize()).isValid());
+
+            expect (! MappedPluginList (File()).isValid());
+        }
+    }
+};
+
+static MappedPluginListTests mappedPluginListTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A read-only view of a list of plug-in descriptions that has been stored in a
+    compact binary format.
+
+    Loading a KnownPluginList from XML means parsing the whole document and creating
+    every PluginDescription up-front. The binary format written by write() can instead
+    be memory-mapped, and descriptions are only created when they're asked for, so
+    opening a list of thousands of plug-ins costs little more than mapping the file.
+
+    Lookups by identifier string, manufacturer and category use sorted indexes stored
+    in the file, so they don't need to visit every entry.
+
+    The format is versioned; files written by an incompatible version, or that are
+    truncated or corrupt, will produce a view for which isValid() returns false.
+
+    @code
+    MappedPluginList::writeToFile (knownPluginList, cacheFile);
+
+    MappedPluginList cache (cacheFile);
+
+    if (cache.isValid())
+        for (auto index : cache.getIndicesForManufacturer ("Acme"))
+            DBG (cache.getType (index).name);
+    @endcode
+
+    @see KnownPluginList
+
+    @tags{Audio}
+*/
+class JUCE_API  MappedPluginList
+{
+public:
+    //==============================================================================
+    /** Memory-maps a file that was written by writeToFile(). */
+    explicit MappedPluginList (const File& file);
+
+    /** Creates a view of some data that was written by write().
+
+        The data isn't copied, so it must stay valid for the lifetime of this object.
+    */
+    MappedPluginList (const void* data, size_t numBytes);
+
+    /** Destructor. */
+    ~MappedPluginList();
+
+    //==============================================================================
+    /** Returns true if the data is a complete list in a format that this version
+        understands. All other methods behave as if the list is empty if this is false.
+    */
+    bool isValid() const noexcept                           { return valid; }
+
+    /** Returns the number of plug-in descriptions in the list. */
+    int getNumTypes() const noexcept;
+
+    /** Creates the description at the given index. */
+    PluginDescription getType (int index) const;
+
+    /** Looks for a description that matches an identifier string.
+
+        This matches types in the same way as KnownPluginList::getTypeForIdentifierString().
+    */
+    std::unique_ptr<PluginDescription> getTypeForIdentifierString (const String& identifierString) const;
+
+    /** Returns the indices of all the types with this manufacturer name.
+        The match is exact and case-sensitive.
+    */
+    Array<int> getIndicesForManufacturer (const String& manufacturerName) const;
+
+    /** Returns the indices of all the types in this category.
+        The match is exact and case-sensitive.
+    */
+    Array<int> getIndicesForCategory (const String& category) const;
+
+    /** Returns the list of blacklisted files or identifiers that were stored with the list. */
+    StringArray getBlacklistedFiles() const;
+
+    /** Replaces the contents of a KnownPluginList with the contents of this list.
+
+        This creates every description, so it's only worth using if you need a complete
+        KnownPluginList rather than a few lookups.
+    */
+    void restoreTo (KnownPluginList& list) const;
+
+    //==============================================================================
+    /** Writes the types and blacklist of a KnownPluginList to a stream in the binary format.
+        Returns false if the stream couldn't be written.
+    */
+    static bool write (const KnownPluginList& list, OutputStream& stream);
+
+    /** Writes a KnownPluginList to a file in the binary format, replacing it if it exists.
+        Returns false if the file couldn't be written.
+    */
+    static bool writeToFile (const KnownPluginList& list, const File& file);
+
+private:
+    //==============================================================================
+    struct Layout;
+
+    uint32 readInt (size_t offset) const noexcept;
+    int64 readInt64 (size_t offset) const noexcept;
+    String readString (uint32 stringOffset) const;
+    std::string_view readStringBytes (uint32 stringOffset) const noexcept;
+    Array<int> findInIndex (int indexNumber, const String& key) const;
+    void validate();
+
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    const uint8* data = nullptr;
+    size_t size = 0;
+    bool valid = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MappedPluginList)
+};
+
+} // namespace juce
@@ -94,21 +94,35 @@ bool PluginDirectoryScanner::scanNextFile (bool dontRescanIfAlreadyInList,
             nameOfPluginBeingScanned = format.getNameOfPluginFromIdentifier (file);
 
             OwnedArray<PluginDescription> typesFound;
-
-            // Add this plugin to the end of the dead-man's pedal list in case it crashes...
-            auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
-            crashedPlugins.removeString (file);
-            crashedPlugins.add (file);
-            setDeadMansPedalFile (crashedPlugins);
-
-            list.scanAndAddFile (file, dontRescanIfAlreadyInList, typesFound, format);
-
-            // Managed to load without crashing, so remove it from the dead-man's-pedal..
-            crashedPlugins.removeString (file);
-            setDeadMansPedalFile (crashedPlugins);
+            const auto useCache = dontRescanIfAlreadyInList && cache != nullptr;
+
+            if (useCache
+                && ! list.getBlacklistedFiles().contains (file)
+                && cache->getCachedTypes (format.getName(), file, typesFound))
+            {
+                for (auto* type : typesFound)
+                    list.addType (*type);
+            }
+            else
+            {
+                // Add this plugin to the end of the dead-man's pedal list in case it crashes...
+                addToDeadMansPedal (file);
+
+                list.scanAndAddFile (file, dontRescanIfAlreadyInList, typesFound, format);
+
+                // Managed to load without crashing, so remove it from the dead-man's-pedal..
+                removeFromDeadMansPedal (file);
+
+                // A blacklisted or cancelled scan doesn't tell us anything about the file
+                if (useCache && ! list.getBlacklistedFiles().contains (file) && ! wasScanCancelled())
+                    cache->storeTypes (format.getName(), file, typesFound);
+            }
 
             if (typesFound.size() == 0 && ! list.getBlacklistedFiles().contains (file))
+            {
+                const ScopedLock sl (failedFilesLock);
                 failedFiles.add (file);
+            }
         }
     }
 
@@ -122,6 +136,31 @@ bool PluginDirectoryScanner::skipNextFile()
     return --nextIndex > 0;
 }
 
+void PluginDirectoryScanner::addToDeadMansPedal (const String& file)
+{
+    const ScopedLock sl (deadMansPedalLock);
+    auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
+    crashedPlugins.removeString (file);
+    crashedPlugins.add (file);
+    setDeadMansPedalFile (crashedPlugins);
+}
+
+void PluginDirectoryScanner::removeFromDeadMansPedal (const String& file)
+{
+    const ScopedLock sl (deadMansPedalLock);
+    auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
+    crashedPlugins.removeString (file);
+    setDeadMansPedalFile (crashedPlugins);
+}
+
+bool PluginDirectoryScanner::wasScanCancelled()
+{
+    if (auto* job = ThreadPoolJob::getCurrentThreadPoolJob())
+        return job->shouldExit();
+
+    return false;
+}
+
 void PluginDirectoryScanner::setDeadMansPedalFile (const StringArray& newContents)
 {
     if (deadMansPedalFile.getFullPathName().isNotEmpty())
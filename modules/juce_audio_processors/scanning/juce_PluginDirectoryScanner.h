@@ -79,6 +79,15 @@ public:
     */
     void setFilesOrIdentifiersToScan (const StringArray& filesOrIdentifiersToScan);
 
+    /** Sets a cache that will be used to avoid loading files that haven't changed since
+        they were last scanned.
+
+        When dontRescanIfAlreadyInList is true, scanNextFile() will use the cached result
+        for a file if there is a valid one, and will store the result of each new scan in
+        the cache. The cache must outlive this scanner. Pass nullptr to stop using a cache.
+    */
+    void setScanCache (PluginScanCache* cacheToUse) noexcept        { cache = cacheToUse; }
+
     /** Tries the next likely-looking file.
 
         If dontRescanIfAlreadyInList is true, then the file will only be loaded and
@@ -88,6 +97,9 @@ public:
         The nameOfPluginBeingScanned will be updated to the name of the plugin being
         scanned before the scan starts.
 
+        This may be called from several threads at once, in which case each call will
+        scan a different file.
+
         Returns false when there are no more files to try.
     */
     bool scanNextFile (bool dontRescanIfAlreadyInList,
@@ -111,6 +123,9 @@ public:
 
     /** This returns a list of all the filenames of things that looked like being
         a plugin file, but which failed to open for some reason.
+
+        If scanNextFile() is being called from other threads, only call this once they
+        have all finished.
     */
     const StringArray& getFailedFiles() const noexcept              { return failedFiles; }
 
@@ -125,12 +140,17 @@ private:
     StringArray filesOrIdentifiersToScan;
     File deadMansPedalFile;
     StringArray failedFiles;
+    PluginScanCache* cache = nullptr;
+    CriticalSection failedFilesLock, deadMansPedalLock;
     Atomic<int> nextIndex;
     std::atomic<float> progress { 0.0f };
     const bool allowAsync;
 
     void updateProgress();
     void setDeadMansPedalFile (const StringArray& newContents);
+    void addToDeadMansPedal (const String& file);
+    void removeFromDeadMansPedal (const String& file);
+    static bool wasScanCancelled();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginDirectoryScanner)
 };
@@ -208,6 +208,11 @@ void PluginListComponent::setNumberOfThreadsForScanning (int num)
     numThreads = num;
 }
 
+void PluginListComponent::setScanCache (PluginScanCache* cacheToUse)
+{
+    scanCache = cacheToUse;
+}
+
 void PluginListComponent::resized()
 {
     auto r = getLocalBounds().reduced (2);
@@ -290,7 +295,13 @@ PopupMenu PluginListComponent::createOptionsMenu()
 {
     PopupMenu menu;
     menu.addItem (PopupMenu::Item (TRANS ("Clear list"))
-                    .setAction ([this] { list.clear(); }));
+                    .setAction ([this]
+                                {
+                                    list.clear();
+
+                                    if (scanCache != nullptr)
+                                        scanCache->clear();
+                                }));
 
     menu.addSeparator();
 
@@ -536,6 +547,7 @@ private:
 
         scanner.reset (new PluginDirectoryScanner (owner.list, formatToScan, pathList.getPath(),
                                                    true, owner.deadMansPedalFile, allowAsync));
+        scanner->setScanCache (owner.scanCache);
 
         if (! filesOrIdentifiersToScan.isEmpty())
         {
@@ -669,6 +681,9 @@ void PluginListComponent::scanFinished (const StringArray& failedFiles,
 
     currentScanner.reset(); // mustn't delete this before using the failed files array
 
+    if (onScanFinished != nullptr)
+        onScanFinished();
+
     if (! warnings.isEmpty())
     {
         auto options = MessageBoxOptions::makeOptionsOk (MessageBoxIconType::InfoIcon,
@@ -76,6 +76,18 @@ public:
      be zero (it is one by default). */
     void setNumberOfThreadsForScanning (int numThreads);
 
+    /** Sets a cache that will be used to skip files that haven't changed since they
+        were last scanned. The cache must outlive this component, or be reset to nullptr.
+        The "Clear list" option also clears the cache.
+        @see PluginScanCache
+    */
+    void setScanCache (PluginScanCache* cacheToUse);
+
+    /** This is called on the message thread when a scan has finished, e.g. so that
+        the scan cache can be saved.
+    */
+    std::function<void()> onScanFinished;
+
     /** Returns the last search path stored in a given properties file for the specified format. */
     static FileSearchPath getLastSearchPath (PropertiesFile&, AudioPluginFormat&);
 
@@ -123,6 +135,7 @@ private:
     String dialogTitle, dialogText;
     bool allowAsync;
     int numThreads;
+    PluginScanCache* scanCache = nullptr;
 
     class TableModel;
     std::unique_ptr<TableListBoxModel> tableModel;
@@ -0,0 +1,259 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+std::optional<PluginScanCache::FileStamp> PluginScanCache::FileStamp::forIdentifier (const String& fileOrIdentifier)
+{
+    if (! File::isAbsolutePath (fileOrIdentifier))
+        return {};
+
+    const File file (fileOrIdentifier);
+
+    if (! file.exists())
+        return {};
+
+    FileStamp stamp { file.getSize(), file.getLastModificationTime().toMilliseconds() };
+
+    // The binary inside a bundle can change without the bundle folder's own timestamp
+    // being updated, so the stamp of a bundle covers everything inside it.
+    if (file.isDirectory())
+    {
+        for (const auto& entry : RangedDirectoryIterator (file, true, "*", File::findFiles))
+        {
+            stamp.size += entry.getFileSize();
+            stamp.modificationTime = jmax (stamp.modificationTime, entry.getModificationTime().toMilliseconds());
+        }
+    }
+
+    return stamp;
+}
+
+String PluginScanCache::makeKey (const String& formatName, const String& fileOrIdentifier)
+{
+    return formatName + ":" + fileOrIdentifier;
+}
+
+bool PluginScanCache::getCachedTypes (const String& formatName,
+                                      const String& fileOrIdentifier,
+                                      OwnedArray<PluginDescription>& result) const
+{
+    const auto stamp = FileStamp::forIdentifier (fileOrIdentifier);
+
+    if (! stamp.has_value())
+        return false;
+
+    const ScopedLock sl (lock);
+    const auto iter = entries.find (makeKey (formatName, fileOrIdentifier));
+
+    if (iter == entries.end() || ! (iter->second.stamp == *stamp))
+        return false;
+
+    for (const auto& type : iter->second.types)
+        result.add (new PluginDescription (type));
+
+    return true;
+}
+
+void PluginScanCache::storeTypes (const String& formatName,
+                                  const String& fileOrIdentifier,
+                                  const OwnedArray<PluginDescription>& types)
+{
+    if (types.isEmpty())
+    {
+        removeFile (formatName, fileOrIdentifier);
+        return;
+    }
+
+    const auto stamp = FileStamp::forIdentifier (fileOrIdentifier);
+
+    if (! stamp.has_value())
+        return;
+
+    Entry entry { *stamp, {} };
+
+    for (const auto* type : types)
+        if (type != nullptr)
+            entry.types.push_back (*type);
+
+    const ScopedLock sl (lock);
+    entries[makeKey (formatName, fileOrIdentifier)] = std::move (entry);
+}
+
+void PluginScanCache::removeFile (const String& formatName, const String& fileOrIdentifier)
+{
+    const ScopedLock sl (lock);
+    entries.erase (makeKey (formatName, fileOrIdentifier));
+}
+
+void PluginScanCache::clear()
+{
+    const ScopedLock sl (lock);
+    entries.clear();
+}
+
+int PluginScanCache::getNumEntries() const
+{
+    const ScopedLock sl (lock);
+    return (int) entries.size();
+}
+
+//==============================================================================
+std::unique_ptr<XmlElement> PluginScanCache::createXml() const
+{
+    auto e = std::make_unique<XmlElement> ("PLUGINSCANCACHE");
+
+    const ScopedLock sl (lock);
+
+    for (const auto& [key, entry] : entries)
+    {
+        auto* file = e->createNewChildElement ("FILE");
+        file->setAttribute ("key", key);
+        file->setAttribute ("size", String (entry.stamp.size));
+        file->setAttribute ("modified", String (entry.stamp.modificationTime));
+
+        for (const auto& type : entry.types)
+            file->addChildElement (type.createXml().release());
+    }
+
+    return e;
+}
+
+void PluginScanCache::recreateFromXml (const XmlElement& xml)
+{
+    const ScopedLock sl (lock);
+    entries.clear();
+
+    if (! xml.hasTagName ("PLUGINSCANCACHE"))
+        return;
+
+    for (auto* file : xml.getChildWithTagNameIterator ("FILE"))
+    {
+        Entry entry { { file->getStringAttribute ("size").getLargeIntValue(),
+                        file->getStringAttribute ("modified").getLargeIntValue() }, {} };
+
+        for (auto* e : file->getChildIterator())
+        {
+            PluginDescription type;
+
+            if (type.loadFromXml (*e))
+                entry.types.push_back (type);
+        }
+
+        entries[file->getStringAttribute ("key")] = std::move (entry);
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PluginScanCacheTests final : public UnitTest
+{
+public:
+    PluginScanCacheTests()
+        : UnitTest ("PluginScanCache", UnitTestCategories::audioProcessors)
+    {}
+
+    void runTest() override
+    {
+        const TemporaryFile temp (".plugin");
+        const auto path = temp.getFile().getFullPathName();
+        temp.getFile().replaceWithText ("plugin");
+
+        OwnedArray<PluginDescription> found;
+        found.add (new PluginDescription());
+        found.getFirst()->name = "Test Plugin";
+        found.getFirst()->fileOrIdentifier = path;
+
+        beginTest ("results are only returned for unchanged files");
+        {
+            PluginScanCache cache;
+            OwnedArray<PluginDescription> result;
+            expect (! cache.getCachedTypes ("VST3", path, result));
+
+            cache.storeTypes ("VST3", path, found);
+            expect (cache.getCachedTypes ("VST3", path, result));
+            expectEquals (result.size(), 1);
+            expectEquals (result.getFirst()->name, String ("Test Plugin"));
+
+            result.clear();
+            expect (! cache.getCachedTypes ("LV2", path, result));
+
+            expect (temp.getFile().appendText ("changed"));
+            expect (! cache.getCachedTypes ("VST3", path, result));
+            expect (result.isEmpty());
+        }
+
+        beginTest ("files without plug-ins are not remembered");
+        {
+            PluginScanCache cache;
+            cache.storeTypes ("VST3", path, found);
+            cache.storeTypes ("VST3", path, {});
+            expectEquals (cache.getNumEntries(), 0);
+
+            OwnedArray<PluginDescription> result;
+            expect (! cache.getCachedTypes ("VST3", path, result));
+        }
+
+        beginTest ("the cache can be cleared");
+        {
+            PluginScanCache cache;
+            cache.storeTypes ("VST3", path, found);
+            expectEquals (cache.getNumEntries(), 1);
+
+            cache.clear();
+            expectEquals (cache.getNumEntries(), 0);
+        }
+
+        beginTest ("identifiers that aren't files are not cached");
+        {
+            PluginScanCache cache;
+            cache.storeTypes ("AudioUnit", "AudioUnit:Effects/aufx,dely,appl", found);
+            expectEquals (cache.getNumEntries(), 0);
+        }
+
+        beginTest ("the cache can be restored from xml");
+        {
+            PluginScanCache cache;
+            cache.storeTypes ("VST3", path, found);
+
+            PluginScanCache restored;
+            restored.recreateFromXml (*cache.createXml());
+
+            OwnedArray<PluginDescription> result;
+            expect (restored.getCachedTypes ("VST3", path, result));
+            expectEquals (result.size(), 1);
+            expectEquals (result.getFirst()->name, String ("Test Plugin"));
+        }
+    }
+};
+
+static PluginScanCacheTests pluginScanCacheTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Remembers the results of scanning plug-in files, so that files which haven't
+    changed since they were last scanned don't need to be loaded again.
+
+    Each entry is keyed by the format name and file path, and is only considered
+    valid while the file's size and modification time are the same as when it was
+    scanned. Files in which no plug-ins were found aren't remembered, because the
+    scan may have failed for reasons that have nothing to do with the file itself.
+
+    Only identifiers that refer to existing files or bundles can be cached; for other
+    identifiers (e.g. AudioUnit IDs), getCachedTypes() will always return false.
+
+    All methods are thread-safe, so a single cache can be shared by several threads
+    that are scanning at the same time.
+
+    @see PluginDirectoryScanner::setScanCache
+
+    @tags{Audio}
+*/
+class JUCE_API  PluginScanCache
+{
+public:
+    //==============================================================================
+    PluginScanCache() = default;
+
+    //==============================================================================
+    /** Looks for a valid cached result for a file.
+
+        If the file was previously scanned with the given format, and it hasn't changed
+        since, this adds copies of the types that were found to the result array and
+        returns true. Otherwise, it returns false and leaves the array unchanged.
+    */
+    bool getCachedTypes (const String& formatName,
+                         const String& fileOrIdentifier,
+                         OwnedArray<PluginDescription>& result) const;
+
+    /** Stores the result of scanning a file.
+
+        If the types array is empty, any previous result for the file is removed instead.
+        This does nothing if the identifier doesn't refer to an existing file.
+    */
+    void storeTypes (const String& formatName,
+                     const String& fileOrIdentifier,
+                     const OwnedArray<PluginDescription>& types);
+
+    /** Removes any cached result for a file. */
+    void removeFile (const String& formatName, const String& fileOrIdentifier);
+
+    /** Removes all cached results. */
+    void clear();
+
+    /** Returns the number of files that have cached results. */
+    int getNumEntries() const;
+
+    //==============================================================================
+    /** Creates some XML that can be used to store the state of this cache. */
+    std::unique_ptr<XmlElement> createXml() const;
+
+    /** Recreates the state of this cache from its stored XML format. */
+    void recreateFromXml (const XmlElement& xml);
+
+private:
+    //==============================================================================
+    struct FileStamp
+    {
+        int64 size = 0;
+        int64 modificationTime = 0;
+
+        bool operator== (const FileStamp& other) const noexcept
+        {
+            return size == other.size && modificationTime == other.modificationTime;
+        }
+
+        static std::optional<FileStamp> forIdentifier (const String& fileOrIdentifier);
+    };
+
+    struct Entry
+    {
+        FileStamp stamp;
+        std::vector<PluginDescription> types;
+    };
+
+    static String makeKey (const String& formatName, const String& fileOrIdentifier);
+
+    CriticalSection lock;
+    std::map<String, Entry> entries;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScanCache)
+};
+
+} // namespace juce
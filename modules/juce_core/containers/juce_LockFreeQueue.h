@@ -0,0 +1,332 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#ifndef DOXYGEN
+namespace detail
+{
+
+/*  The storage and producer side shared by the lock-free queues.
+
+    Each slot has a sequence number, which tells the threads whose turn it is to use
+    the slot. A producer may write to a slot when its sequence number equals the
+    producer's position, and a consumer may read it once the sequence number is one
+    more than the consumer's position. The two positions live on separate cache lines
+    so that producers and consumers don't keep invalidating each other's caches.
+*/
+template <typename ElementType>
+class LockFreeQueueBase
+{
+    // Elements are moved in and out of slots that other threads are waiting for, so if a
+    // move could throw, a slot might never be handed over and the queue would stall
+    static_assert (std::is_nothrow_move_constructible_v<ElementType> && std::is_nothrow_move_assignable_v<ElementType>,
+                   "The queue's element type must have non-throwing move operations");
+
+public:
+    explicit LockFreeQueueBase (int minCapacity)
+        : capacity ((size_t) nextPowerOfTwo (jmax (2, minCapacity))),
+          mask (capacity - 1),
+          slots (new Slot[capacity])
+    {
+        for (size_t i = 0; i < capacity; ++i)
+            slots[i].sequence.store (i, std::memory_order_relaxed);
+    }
+
+    ~LockFreeQueueBase()
+    {
+        // Destroy any elements that were never read
+        for (auto pos = readPosition.value.load(); pos != writePosition.value.load(); ++pos)
+            slots[pos & mask].get()->~ElementType();
+    }
+
+    int getCapacity() const noexcept        { return (int) capacity; }
+
+    int getApproximateNumItems() const noexcept
+    {
+        const auto read = readPosition.value.load (std::memory_order_relaxed);
+        const auto written = writePosition.value.load (std::memory_order_relaxed);
+        return (int) jlimit ((ptrdiff_t) 0, (ptrdiff_t) capacity, (ptrdiff_t) (written - read));
+    }
+
+    template <typename... Args>
+    bool emplace (Args&&... args) noexcept (std::is_nothrow_constructible_v<ElementType, Args...>)
+    {
+        if constexpr (std::is_nothrow_constructible_v<ElementType, Args...>)
+        {
+            return emplaceWithoutThrowing (std::forward<Args> (args)...);
+        }
+        else
+        {
+            // Once a slot has been claimed, the consumers will wait for it to be filled, so
+            // the element has to be constructed beforehand in case its constructor throws
+            return emplaceWithoutThrowing (ElementType (std::forward<Args> (args)...));
+        }
+    }
+
+protected:
+    static constexpr size_t cacheLineSize = 64;
+
+    struct Slot
+    {
+        ElementType* get() noexcept         { return std::launder (reinterpret_cast<ElementType*> (storage)); }
+
+        std::atomic<size_t> sequence;
+        alignas (ElementType) char storage[sizeof (ElementType)];
+    };
+
+    struct alignas (cacheLineSize) Position
+    {
+        std::atomic<size_t> value { 0 };
+    };
+
+    template <typename... Args>
+    bool emplaceWithoutThrowing (Args&&... args) noexcept
+    {
+        static_assert (std::is_nothrow_constructible_v<ElementType, Args...>);
+
+        auto pos = writePosition.value.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& slot = slots[pos & mask];
+            const auto sequence = slot.sequence.load (std::memory_order_acquire);
+            const auto difference = (ptrdiff_t) (sequence - pos);
+
+            if (difference == 0)
+            {
+                // On success, this thread owns the slot. Otherwise pos is updated to the
+                // latest write position, and we try again.
+                if (writePosition.value.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                {
+                    new (slot.storage) ElementType (std::forward<Args> (args)...);
+                    slot.sequence.store (pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false; // The consumers haven't finished with this slot, so the queue is full
+            }
+            else
+            {
+                pos = writePosition.value.load (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void take (Slot& slot, size_t pos, ElementType& result) noexcept
+    {
+        auto* element = slot.get();
+        result = std::move (*element);
+        element->~ElementType();
+
+        // Hand the slot back to the producers for their next lap around the buffer
+        slot.sequence.store (pos + capacity, std::memory_order_release);
+    }
+
+    const size_t capacity, mask;
+    std::unique_ptr<Slot[]> slots;
+    Position writePosition, readPosition;
+};
+
+} // namespace detail
+#endif
+
+//==============================================================================
+/**
+    A bounded, lock-free queue that any number of threads may push to and pop from
+    at the same time.
+
+    This is useful when several threads need to send messages to several others,
+    e.g. a pool of workers that take jobs from a number of different sources,
+    without wrapping a FIFO in a lock.
+
+    push() and pop() never block, and never allocate. Instead, they just return false
+    if the queue is full or empty. Each call normally completes with a single
+    compare-and-swap, and only has to retry if another thread took the same slot first.
+
+    The capacity is rounded up to a power of two. ElementType must have a move constructor
+    and a move assignment operator that don't throw, and it's best if they don't allocate.
+    If an element's constructor throws when it's pushed, the queue is left unchanged.
+
+    @see MPSCQueue, AbstractFifo
+
+    @tags{Core}
+*/
+template <typename ElementType>
+class MPMCQueue  : private detail::LockFreeQueueBase<ElementType>
+{
+    using Base = detail::LockFreeQueueBase<ElementType>;
+
+public:
+    /** Creates a queue that can hold at least the given number of elements. */
+    explicit MPMCQueue (int minCapacity) : Base (minCapacity) {}
+
+    /** Adds an element to the queue, returning false if the queue is full.
+
+        This may be called from any thread.
+    */
+    bool push (const ElementType& element)          { return Base::emplace (element); }
+
+    /** Moves an element into the queue, returning false if the queue is full.
+
+        This may be called from any thread.
+    */
+    bool push (ElementType&& element)               { return Base::emplace (std::move (element)); }
+
+    /** Constructs an element in the queue, returning false if the queue is full.
+
+        This may be called from any thread.
+    */
+    template <typename... Args>
+    bool emplace (Args&&... args)                   { return Base::emplace (std::forward<Args> (args)...); }
+
+    /** Moves the oldest element in the queue into the result, returning false if the
+        queue is empty.
+
+        This may be called from any thread.
+    */
+    bool pop (ElementType& result) noexcept
+    {
+        auto pos = this->readPosition.value.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& slot = this->slots[pos & this->mask];
+            const auto sequence = slot.sequence.load (std::memory_order_acquire);
+            const auto difference = (ptrdiff_t) (sequence - (pos + 1));
+
+            if (difference == 0)
+            {
+                if (this->readPosition.value.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                {
+                    this->take (slot, pos, result);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = this->readPosition.value.load (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** Returns the maximum number of elements that the queue can hold. */
+    using Base::getCapacity;
+
+    /** Returns the number of elements in the queue.
+
+        While other threads are using the queue, this can only be a rough guide.
+    */
+    using Base::getApproximateNumItems;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE (MPMCQueue)
+};
+
+//==============================================================================
+/**
+    A bounded, lock-free queue that any number of threads may push to, but only one
+    thread may pop from.
+
+    This suits the common case of several threads (e.g. MIDI input, OSC and the UI)
+    sending messages to the audio thread. Because only one thread reads from the queue,
+    pop() is wait-free: it always completes in a fixed number of steps, regardless of
+    what the other threads are doing. push() is lock-free, and behaves the same as
+    MPMCQueue::push().
+
+    The capacity is rounded up to a power of two. ElementType must have a move constructor
+    and a move assignment operator that don't throw, and it's best if they don't allocate.
+    If an element's constructor throws when it's pushed, the queue is left unchanged.
+
+    @see MPMCQueue, AbstractFifo
+
+    @tags{Core}
+*/
+template <typename ElementType>
+class MPSCQueue  : private detail::LockFreeQueueBase<ElementType>
+{
+    using Base = detail::LockFreeQueueBase<ElementType>;
+
+public:
+    /** Creates a queue that can hold at least the given number of elements. */
+    explicit MPSCQueue (int minCapacity) : Base (minCapacity) {}
+
+    /** Adds an element to the queue, returning false if the queue is full.
+
+        This may be called from any thread.
+    */
+    bool push (const ElementType& element)          { return Base::emplace (element); }
+
+    /** Moves an element into the queue, returning false if the queue is full.
+
+        This may be called from any thread.
+    */
+    bool push (ElementType&& element)               { return Base::emplace (std::move (element)); }
+
+    /** Constructs an element in the queue, returning false if the queue is full.
+
+        This may be called from any thread.
+    */
+    template <typename... Args>
+    bool emplace (Args&&... args)                   { return Base::emplace (std::forward<Args> (args)...); }
+
+    /** Moves the oldest element in the queue into the result, returning false if the
+        queue is empty.
+
+        This must only ever be called by one thread at a time.
+    */
+    bool pop (ElementType& result) noexcept
+    {
+        const auto pos = this->readPosition.value.load (std::memory_order_relaxed);
+        auto& slot = this->slots[pos & this->mask];
+
+        // If a producer has claimed this slot but not finished writing to it yet, this
+        // reports that the queue is empty rather than waiting for it
+        if (slot.sequence.load (std::memory_order_acquire) != pos + 1)
+            return false;
+
+        this->readPosition.value.store (pos + 1, std::memory_order_relaxed);
+        this->take (slot, pos, result);
+        return true;
+    }
+
+    /** Returns the maximum number of elements that the queue can hold. */
+    using Base::getCapacity;
+
+    /** Returns the number of elements in the queue.
+
+        While other threads are using the queue, this can only be a rough guide.
+    */
+    using Base::getApproximateNumItems;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE (MPSCQueue)
+};
+
+} // namespace juce
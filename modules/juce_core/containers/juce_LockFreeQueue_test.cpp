@@ -0,0 +1,275 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_ALLOCATION_HOOKS
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE const UnitTestAllocationChecker checker (*this)
+#else
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
+#endif
+
+namespace juce
+{
+
+class LockFreeQueueTests  : public UnitTest
+{
+public:
+    LockFreeQueueTests()
+        : UnitTest ("LockFreeQueue", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("The capacity is rounded up to a power of two");
+        {
+            expectEquals (MPMCQueue<int> (0).getCapacity(), 2);
+            expectEquals (MPMCQueue<int> (5).getCapacity(), 8);
+            expectEquals (MPSCQueue<int> (64).getCapacity(), 64);
+            expectEquals (MPSCQueue<int> (65).getCapacity(), 128);
+        }
+
+        runSingleThreadedTests<MPMCQueue> ("MPMCQueue");
+        runSingleThreadedTests<MPSCQueue> ("MPSCQueue");
+
+        beginTest ("MPMCQueue stress test");
+        {
+            for (const auto queueSize : { 2, 16, 1024 })
+            {
+                MPMCQueue<Message> queue (queueSize);
+                runStressTest (queue, 4, 4);
+            }
+        }
+
+        beginTest ("MPSCQueue stress test");
+        {
+            for (const auto queueSize : { 2, 16, 1024 })
+            {
+                MPSCQueue<Message> queue (queueSize);
+                runStressTest (queue, 4, 1);
+            }
+        }
+    }
+
+private:
+    template <template <typename> class Queue>
+    void runSingleThreadedTests (const String& queueName)
+    {
+        beginTest (queueName + " returns elements in the order they were added");
+        {
+            Queue<int> queue (8);
+
+            // Go around the buffer a few times, to check that the slots get reused
+            for (int lap = 0; lap < 3; ++lap)
+            {
+                for (int i = 0; i < queue.getCapacity(); ++i)
+                    expect (queue.push (i));
+
+                expect (! queue.push (-1));
+                expectEquals (queue.getApproximateNumItems(), queue.getCapacity());
+
+                for (int i = 0; i < queue.getCapacity(); ++i)
+                {
+                    int result = -1;
+                    expect (queue.pop (result));
+                    expectEquals (result, i);
+                }
+
+                int result = -1;
+                expect (! queue.pop (result));
+                expectEquals (result, -1);
+                expectEquals (queue.getApproximateNumItems(), 0);
+            }
+        }
+
+        beginTest (queueName + " doesn't allocate when pushing or popping");
+        {
+            Queue<int> queue (16);
+
+            JUCE_FAIL_ON_ALLOCATION_IN_SCOPE;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                int result = 0;
+                expect (queue.push (i));
+                expect (queue.pop (result));
+                expectEquals (result, i);
+            }
+        }
+
+        beginTest (queueName + " can hold move-only types");
+        {
+            Queue<std::unique_ptr<int>> queue (4);
+
+            expect (queue.push (std::make_unique<int> (1)));
+            expect (queue.emplace (new int (2)));
+
+            std::unique_ptr<int> result;
+            expect (queue.pop (result));
+            expectEquals (*result, 1);
+            expect (queue.pop (result));
+            expectEquals (*result, 2);
+        }
+
+        beginTest (queueName + " is left unchanged if an element's constructor throws");
+        {
+            Queue<ThrowOnNegative> queue (4);
+
+            expect (queue.emplace (1));
+
+            bool threw = false;
+
+            try
+            {
+                queue.emplace (-1);
+            }
+            catch (const std::invalid_argument&)
+            {
+                threw = true;
+            }
+
+            expect (threw);
+            expect (queue.emplace (2));
+
+            ThrowOnNegative result;
+            expect (queue.pop (result));
+            expectEquals (result.value, 1);
+            expect (queue.pop (result));
+            expectEquals (result.value, 2);
+            expect (! queue.pop (result));
+        }
+
+        beginTest (queueName + " destroys any remaining elements");
+        {
+            auto counter = std::make_shared<int> (0);
+
+            {
+                Queue<std::shared_ptr<int>> queue (8);
+
+                for (int i = 0; i < 5; ++i)
+                    queue.push (counter);
+
+                std::shared_ptr<int> result;
+                queue.pop (result);
+                result.reset();
+
+                expectEquals ((int) counter.use_count(), 5);
+            }
+
+            expectEquals ((int) counter.use_count(), 1);
+        }
+    }
+
+    struct Message
+    {
+        int producer = -1, index = -1;
+    };
+
+    struct ThrowOnNegative
+    {
+        ThrowOnNegative() = default;
+
+        explicit ThrowOnNegative (int v) : value (v)
+        {
+            if (v < 0)
+                throw std::invalid_argument ("negative value");
+        }
+
+        int value = 0;
+    };
+
+    template <typename Queue>
+    void runStressTest (Queue& queue, int numProducers, int numConsumers)
+    {
+        constexpr int numMessagesPerProducer = 20000;
+
+        std::vector<std::vector<std::atomic<int>>> numTimesReceived;
+
+        for (int i = 0; i < numProducers; ++i)
+            numTimesReceived.emplace_back ((size_t) numMessagesPerProducer);
+
+        std::atomic<int> numReceived { 0 }, numOutOfOrder { 0 };
+        const auto numMessages = numProducers * numMessagesPerProducer;
+
+        std::vector<std::thread> threads;
+
+        for (int producer = 0; producer < numProducers; ++producer)
+        {
+            threads.emplace_back ([&queue, producer]
+            {
+                for (int i = 0; i < numMessagesPerProducer; ++i)
+                    while (! queue.push ({ producer, i }))
+                        std::this_thread::yield();
+            });
+        }
+
+        for (int consumer = 0; consumer < numConsumers; ++consumer)
+        {
+            threads.emplace_back ([&, numProducers]
+            {
+                // Each consumer should see the messages from any one producer in the order
+                // they were sent, even though other consumers take some of them
+                std::vector<int> lastIndexFromProducer ((size_t) numProducers, -1);
+
+                while (numReceived.load() < numMessages)
+                {
+                    Message message;
+
+                    if (! queue.pop (message))
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    auto& lastIndex = lastIndexFromProducer[(size_t) message.producer];
+
+                    if (message.index <= lastIndex)
+                        ++numOutOfOrder;
+
+                    lastIndex = message.index;
+                    ++numTimesReceived[(size_t) message.producer][(size_t) message.index];
+                    ++numReceived;
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        expectEquals (numReceived.load(), numMessages);
+        expectEquals (numOutOfOrder.load(), 0);
+        expectEquals (queue.getApproximateNumItems(), 0);
+
+        int numDeliveredOnce = 0;
+
+        for (auto& counts : numTimesReceived)
+            for (auto& count : counts)
+                if (count.load() == 1)
+                    ++numDeliveredOnce;
+
+        expectEquals (numDeliveredOnce, numMessages);
+    }
+};
+
+static LockFreeQueueTests lockFreeQueueTests;
+
+} // namespace juce
+
+#undef JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
@@ -70,6 +70,7 @@
   #include <sys/errno.h>
   #include <unistd.h>
   #include <netinet/in.h>
+  #include <semaphore.h>
  #endif
 
  #if JUCE_WASM
@@ -80,6 +81,7 @@
   #include <unistd.h>
   #include <netinet/in.h>
   #include <sys/stat.h>
+  #include <semaphore.h>
  #endif
 
  #if JUCE_LINUX || JUCE_BSD
@@ -142,6 +144,7 @@
 #include "maths/juce_Random.cpp"
 #include "memory/juce_MemoryBlock.cpp"
 #include "memory/juce_AllocationHooks.cpp"
+#include "memory/juce_RealtimeMemoryPool.cpp"
 #include "misc/juce_RuntimePermissions.cpp"
 #include "misc/juce_Result.cpp"
 #include "misc/juce_Uuid.cpp"
@@ -171,11 +174,14 @@
 #include "threads/juce_ReadWriteLock.cpp"
 #include "threads/juce_Thread.cpp"
 #include "threads/juce_ThreadPool.cpp"
+#include "threads/juce_TaskScheduler.cpp"
 #include "threads/juce_TimeSliceThread.cpp"
 #include "time/juce_PerformanceCounter.cpp"
 #include "time/juce_RelativeTime.cpp"
 #include "time/juce_Time.cpp"
+#include "time/juce_Tracing.cpp"
 #include "unit_tests/juce_UnitTest.cpp"
+#include "unit_tests/juce_Benchmark.cpp"
 #include "containers/juce_Variant.cpp"
 #include "javascript/juce_JSON.cpp"
 #include "javascript/juce_JSONUtils.cpp"
@@ -268,6 +274,7 @@
 #include "native/juce_AndroidDocument_android.cpp"
 #include "threads/juce_HighResolutionTimer.cpp"
 #include "threads/juce_WaitableEvent.cpp"
+#include "threads/juce_LightweightSemaphore.cpp"
 #include "network/juce_URL.cpp"
 
 #if ! JUCE_WASM
@@ -284,6 +291,7 @@
  #include "maths/juce_MathsFunctions_test.cpp"
  #include "misc/juce_EnumHelpers_test.cpp"
  #include "containers/juce_FixedSizeFunction_test.cpp"
+ #include "containers/juce_LockFreeQueue_test.cpp"
  #include "javascript/juce_JSONSerialisation_test.cpp"
  #include "memory/juce_SharedResourcePointer_test.cpp"
  #if JUCE_MAC || JUCE_IOS
@@ -186,6 +186,24 @@
  #define JUCE_ENABLE_ALLOCATION_HOOKS 0
 #endif
 
+/** Config: JUCE_ENABLE_REALTIME_MEMORY_POOL
+    If enabled, a RealtimeMemoryPool::ScopedUse will make the HeapBlocks on its thread (and so
+    Arrays, MemoryBlocks, AudioBuffers etc.) take their memory from a RealtimeMemoryPool. This
+    makes every HeapBlock allocation a little slower and larger, so it's disabled by default.
+*/
+#ifndef JUCE_ENABLE_REALTIME_MEMORY_POOL
+ #define JUCE_ENABLE_REALTIME_MEMORY_POOL 0
+#endif
+
+/** Config: JUCE_ENABLE_TRACING
+    If enabled, the JUCE_TRACE_SCOPE, JUCE_TRACE_COUNTER and JUCE_TRACE_FLOW macros will record
+    events, which the Tracer class can write out for chrome://tracing or Perfetto. When this is
+    disabled, the macros and the Tracer class are removed completely.
+*/
+#ifndef JUCE_ENABLE_TRACING
+ #define JUCE_ENABLE_TRACING 0
+#endif
+
 #ifndef JUCE_STRING_UTF_TYPE
  #define JUCE_STRING_UTF_TYPE 8
 #endif
@@ -268,6 +286,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "containers/juce_SparseSet.h"
 #include "containers/juce_AbstractFifo.h"
 #include "containers/juce_SingleThreadedAbstractFifo.h"
+#include "containers/juce_LockFreeQueue.h"
 #include "text/juce_NewLine.h"
 #include "text/juce_StringPool.h"
 #include "text/juce_Identifier.h"
@@ -325,10 +344,12 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "threads/juce_Process.h"
 #include "threads/juce_SpinLock.h"
 #include "threads/juce_WaitableEvent.h"
+#include "threads/juce_LightweightSemaphore.h"
 #include "threads/juce_Thread.h"
 #include "threads/juce_HighResolutionTimer.h"
 #include "threads/juce_ThreadLocalValue.h"
 #include "threads/juce_ThreadPool.h"
+#include "threads/juce_TaskScheduler.h"
 #include "threads/juce_TimeSliceThread.h"
 #include "threads/juce_ReadWriteLock.h"
 #include "threads/juce_ScopedReadLock.h"
@@ -341,7 +362,9 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "network/juce_WebInputStream.h"
 #include "streams/juce_URLInputSource.h"
 #include "time/juce_PerformanceCounter.h"
+#include "time/juce_Tracing.h"
 #include "unit_tests/juce_UnitTest.h"
+#include "unit_tests/juce_Benchmark.h"
 #include "xml/juce_XmlDocument.h"
 #include "xml/juce_XmlElement.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
@@ -350,6 +373,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "containers/juce_PropertySet.h"
 #include "memory/juce_SharedResourcePointer.h"
 #include "memory/juce_AllocationHooks.h"
+#include "memory/juce_RealtimeMemoryPool.h"
 #include "memory/juce_Reservoir.h"
 #include "files/juce_AndroidDocument.h"
 #include "streams/juce_AndroidDocumentInputSource.h"
@@ -25,14 +25,37 @@
 namespace juce
 {
 
+// Calling the listeners may allocate, which would bring us back into
+// notifyAllocationHooksForThread(), so this is set while they're being called
+static thread_local bool isNotifyingAllocationHooks = false;
+
 static AllocationHooks& getAllocationHooksForThread()
 {
-    thread_local AllocationHooks hooks;
-    return hooks;
+    struct HooksForThread
+    {
+        // A thread may still allocate after its hooks have been destroyed
+        ~HooksForThread() { isNotifyingAllocationHooks = true; }
+
+        AllocationHooks hooks;
+    };
+
+    thread_local HooksForThread hooksForThread;
+    return hooksForThread.hooks;
 }
 
 void notifyAllocationHooksForThread()
 {
+    if (isNotifyingAllocationHooks)
+        return;
+
+    const ScopedValueSetter<bool> setter (isNotifyingAllocationHooks, true);
+
+    // A RealtimeMemoryPool::ScopedUse is told about these directly rather than being
+    // a listener, because adding a listener may allocate, and scopes are created on
+    // audio threads
+    if (auto* scope = RealtimeMemoryPool::ScopedUse::getCurrent())
+        scope->heapWasUsed();
+
     getAllocationHooksForThread().listenerList.call ([] (AllocationHooks::Listener& l)
     {
         l.newOrDeleteCalled();
@@ -34,6 +34,26 @@ namespace HeapBlockHelper
 }
 #endif
 
+#ifndef DOXYGEN
+namespace HeapBlockHelper
+{
+   #if JUCE_ENABLE_REALTIME_MEMORY_POOL
+    // These use the current thread's RealtimeMemoryPool::ScopedUse if there is one,
+    // and the system heap otherwise. The memory they return starts with a tag saying
+    // where it came from, so it must only be released with freeMemory().
+    JUCE_API void* JUCE_CALLTYPE mallocMemory (size_t numBytes);
+    JUCE_API void* JUCE_CALLTYPE callocMemory (size_t numElements, size_t elementSize);
+    JUCE_API void* JUCE_CALLTYPE reallocMemory (void* data, size_t newNumBytes);
+    JUCE_API void JUCE_CALLTYPE freeMemory (void* data) noexcept;
+   #else
+    inline void* mallocMemory (size_t numBytes)                             { return std::malloc (numBytes); }
+    inline void* callocMemory (size_t numElements, size_t elementSize)      { return std::calloc (numElements, elementSize); }
+    inline void* reallocMemory (void* data, size_t newNumBytes)             { return std::realloc (data, newNumBytes); }
+    inline void freeMemory (void* data) noexcept                            { std::free (data); }
+   #endif
+}
+#endif
+
 //==============================================================================
 /**
     Very simple container class to hold a pointer to some data on the heap.
@@ -78,7 +98,11 @@ namespace HeapBlockHelper
     then a failed allocation will just leave the heapblock with a null pointer (assuming
     that the system's malloc() function doesn't throw).
 
-    @see Array, OwnedArray, MemoryBlock
+    When JUCE_ENABLE_REALTIME_MEMORY_POOL is turned on, and the current thread has a
+    RealtimeMemoryPool::ScopedUse, the memory is taken from that pool instead of the
+    system heap.
+
+    @see Array, OwnedArray, MemoryBlock, RealtimeMemoryPool
 
     @tags{Core}
 */
@@ -130,7 +154,7 @@ public:
     */
     ~HeapBlock()
     {
-        std::free (data);
+        HeapBlockHelper::freeMemory (data);
     }
 
     /** Move constructor */
@@ -248,7 +272,7 @@ public:
     template <typename SizeType>
     void malloc (SizeType newNumElements, size_t elementSize = sizeof (ElementType))
     {
-        std::free (data);
+        HeapBlockHelper::freeMemory (data);
         data = mallocWrapper (static_cast<size_t> (newNumElements) * elementSize);
     }
 
@@ -258,7 +282,7 @@ public:
     template <typename SizeType>
     void calloc (SizeType newNumElements, const size_t elementSize = sizeof (ElementType))
     {
-        std::free (data);
+        HeapBlockHelper::freeMemory (data);
         data = callocWrapper (static_cast<size_t> (newNumElements), elementSize);
     }
 
@@ -269,7 +293,7 @@ public:
     template <typename SizeType>
     void allocate (SizeType newNumElements, bool initialiseToZero)
     {
-        std::free (data);
+        HeapBlockHelper::freeMemory (data);
         data = initialiseToZero ? callocWrapper (static_cast<size_t> (newNumElements), sizeof (ElementType))
                                 : mallocWrapper (static_cast<size_t> (newNumElements) * sizeof (ElementType));
     }
@@ -290,7 +314,7 @@ public:
     */
     void free() noexcept
     {
-        std::free (data);
+        HeapBlockHelper::freeMemory (data);
         data = nullptr;
     }
 
@@ -339,17 +363,17 @@ private:
 
     static ElementType* mallocWrapper (size_t size)
     {
-        return wrapper (size, [size] { return std::malloc (size); });
+        return wrapper (size, [size] { return HeapBlockHelper::mallocMemory (size); });
     }
 
     static ElementType* callocWrapper (size_t num, size_t size)
     {
-        return wrapper (num * size, [num, size] { return std::calloc (num, size); });
+        return wrapper (num * size, [num, size] { return HeapBlockHelper::callocMemory (num, size); });
     }
 
     static ElementType* reallocWrapper (void* ptr, size_t newSize)
     {
-        return wrapper (newSize, [ptr, newSize] { return std::realloc (ptr, newSize); });
+        return wrapper (newSize, [ptr, newSize] { return HeapBlockHelper::reallocMemory (ptr, newSize); });
     }
 
     template <class OtherElementType, bool otherThrowOnFailure>
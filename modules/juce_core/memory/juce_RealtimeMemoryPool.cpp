@@ -0,0 +1,872 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace RealtimeMemoryPoolHelpers
+{
+    constexpr int getLog2 (size_t n)    { return n <= 1 ? 0 : 1 + getLog2 (n / 2); }
+
+    // Every block starts with a header, and has a payload that is a multiple of
+    // this size. A free block keeps its free-list links at the start of its payload,
+    // so the payload has to be at least big enough to hold them.
+    constexpr size_t granularity = jmax ((size_t) 16, alignof (std::max_align_t));
+    constexpr int granularityLog2 = getLog2 (granularity);
+    constexpr size_t headerSize = granularity;
+    constexpr size_t minBlockSize = granularity;
+    constexpr size_t freeFlag = 1;
+
+    static_assert (isPowerOfTwo (granularity));
+    static_assert (minBlockSize >= 2 * sizeof (void*));
+
+    constexpr size_t roundUp (size_t n, size_t alignment) noexcept
+    {
+        return (n + alignment - 1) & ~(alignment - 1);
+    }
+
+    static int getHighestSetBit (size_t n) noexcept
+    {
+        if constexpr (sizeof (size_t) > 4)
+            if ((n >> 32) != 0)
+                return 32 + findHighestSetBit ((uint32) (n >> 32));
+
+        return findHighestSetBit ((uint32) n);
+    }
+
+    static int getLowestSetBit (uint32 n) noexcept
+    {
+        return findHighestSetBit (n & (~n + 1));
+    }
+
+   #if JUCE_ENABLE_REALTIME_MEMORY_POOL
+    //==============================================================================
+    // Each HeapBlock allocation starts with a tag that holds the pool it came from,
+    // or nullptr if it came from the system heap, so that it can be freed on any
+    // thread without having to search for its pool
+    constexpr size_t tagSize = roundUp (sizeof (RealtimeMemoryPool*), alignof (std::max_align_t));
+
+    static void* addTag (void* block, RealtimeMemoryPool* pool) noexcept
+    {
+        if (block == nullptr)
+            return nullptr;
+
+        *static_cast<RealtimeMemoryPool**> (block) = pool;
+        return static_cast<char*> (block) + tagSize;
+    }
+
+    static void* getTaggedBlock (void* data) noexcept
+    {
+        return static_cast<char*> (data) - tagSize;
+    }
+
+    static RealtimeMemoryPool* getTaggedPool (void* data) noexcept
+    {
+        return *static_cast<RealtimeMemoryPool**> (getTaggedBlock (data));
+    }
+
+    static bool isTooLargeToTag (size_t numBytes) noexcept
+    {
+        return numBytes > std::numeric_limits<size_t>::max() - tagSize;
+    }
+   #endif
+
+    static RealtimeMemoryPool::ScopedUse*& getCurrentScopeForThread() noexcept
+    {
+        thread_local RealtimeMemoryPool::ScopedUse* currentScope = nullptr;
+        return currentScope;
+    }
+}
+
+//==============================================================================
+struct RealtimeMemoryPool::Block
+{
+    size_t getSize() const noexcept             { return sizeAndFlags & ~RealtimeMemoryPoolHelpers::freeFlag; }
+    bool isFree() const noexcept                { return (sizeAndFlags & RealtimeMemoryPoolHelpers::freeFlag) != 0; }
+    void setSize (size_t newSize) noexcept      { sizeAndFlags = newSize | (sizeAndFlags & RealtimeMemoryPoolHelpers::freeFlag); }
+    void setFree (bool shouldBeFree) noexcept   { sizeAndFlags = getSize() | (shouldBeFree ? RealtimeMemoryPoolHelpers::freeFlag : 0); }
+
+    char* getPayload() noexcept                 { return reinterpret_cast<char*> (this) + RealtimeMemoryPoolHelpers::headerSize; }
+    Block* getNext() noexcept                   { return reinterpret_cast<Block*> (getPayload() + getSize()); }
+
+    Block*& getNextFree() noexcept              { return reinterpret_cast<Block**> (getPayload())[0]; }
+    Block*& getPreviousFree() noexcept          { return reinterpret_cast<Block**> (getPayload())[1]; }
+
+    static Block* fromPayload (const void* payload) noexcept
+    {
+        return reinterpret_cast<Block*> (static_cast<char*> (const_cast<void*> (payload)) - RealtimeMemoryPoolHelpers::headerSize);
+    }
+
+    Block* previous;        // The block immediately before this one in memory
+    size_t sizeAndFlags;    // The payload size, with the free flag in the lowest bit
+};
+
+//==============================================================================
+RealtimeMemoryPool::RealtimeMemoryPool (size_t numBytes)
+{
+    using namespace RealtimeMemoryPoolHelpers;
+
+    static_assert (sizeof (Block) <= headerSize);
+
+    memory = std::malloc (numBytes);
+
+    if (memory == nullptr)
+    {
+        jassertfalse;
+        return;
+    }
+
+    // Writing to every page makes the OS map them in now, rather than on the audio thread
+    zeromem (memory, numBytes);
+
+    start = snapPointerToAlignment (static_cast<char*> (memory), granularity);
+    const auto numUsableBytes = (numBytes - (size_t) (start - static_cast<char*> (memory))) & ~(granularity - 1);
+
+    // Leave room for the first block's header and for a header at the end, which
+    // marks the end of the last block
+    if (numUsableBytes < 2 * headerSize + minBlockSize)
+    {
+        jassertfalse; // This pool is too small to be any use!
+        return;
+    }
+
+    capacity = jmin (numUsableBytes - 2 * headerSize, getMaxBlockSize());
+    end = start + capacity + 2 * headerSize;
+
+    auto* first = reinterpret_cast<Block*> (start);
+    first->previous = nullptr;
+    first->sizeAndFlags = capacity;
+
+    auto* endMarker = first->getNext();
+    endMarker->previous = first;
+    endMarker->sizeAndFlags = 0;
+
+    insertFreeBlock (first);
+}
+
+RealtimeMemoryPool::~RealtimeMemoryPool()
+{
+    // Something is still using memory from this pool!
+    jassert (getNumBytesAllocated() == 0);
+
+    std::free (memory);
+}
+
+size_t RealtimeMemoryPool::getMaxBlockSize() noexcept
+{
+    using namespace RealtimeMemoryPoolHelpers;
+
+    // The largest size that fits in the last first-level list
+    constexpr auto limit = ((uint64) 1 << (numSecondLevelListsLog2 + granularityLog2 + numFirstLevelLists - 1)) - granularity;
+    return (size_t) jmin ((uint64) std::numeric_limits<size_t>::max() & ~(uint64) (granularity - 1), limit);
+}
+
+//==============================================================================
+void* RealtimeMemoryPool::allocate (size_t numBytes, size_t alignment) noexcept
+{
+    using namespace RealtimeMemoryPoolHelpers;
+
+    jassert (isPowerOfTwo (alignment));
+
+    if (numBytes == 0 || numBytes > getMaxBlockSize())
+        return nullptr;
+
+    const SpinLock::ScopedLockType sl (lock);
+    return allocateLocked (roundUp (jmax (numBytes, minBlockSize), granularity), jmax (alignment, granularity));
+}
+
+void* RealtimeMemoryPool::reallocate (void* block, size_t newNumBytes) noexcept
+{
+    using namespace RealtimeMemoryPoolHelpers;
+
+    if (block == nullptr)
+        return allocate (newNumBytes);
+
+    if (newNumBytes == 0)
+    {
+        deallocate (block);
+        return nullptr;
+    }
+
+    if (newNumBytes > getMaxBlockSize())
+        return nullptr;
+
+    jassert (owns (block));
+
+    const auto newSize = roundUp (jmax (newNumBytes, minBlockSize), granularity);
+    const SpinLock::ScopedLockType sl (lock);
+
+    auto* header = Block::fromPayload (block);
+    const auto oldSize = header->getSize();
+
+    if (newSize > oldSize)
+    {
+        auto* next = header->getNext();
+
+        // If the next block is free and big enough, the block can grow in place.
+        // Otherwise, it has to move.
+        if (! next->isFree() || oldSize + headerSize + next->getSize() < newSize)
+        {
+            auto* result = allocateLocked (newSize, granularity);
+
+            if (result != nullptr)
+            {
+                memcpy (result, block, oldSize);
+                deallocateLocked (header);
+            }
+
+            return result;
+        }
+
+        removeFreeBlock (next);
+        header->setSize (oldSize + headerSize + next->getSize());
+        header->getNext()->previous = header;
+    }
+
+    if (header->getSize() >= newSize + headerSize + minBlockSize)
+        insertFreeBlock (mergeWithNeighbours (splitBlock (header, newSize)));
+
+    numBytesAllocated += header->getSize();
+    numBytesAllocated -= oldSize;
+    return block;
+}
+
+void RealtimeMemoryPool::deallocate (void* block) noexcept
+{
+    if (block == nullptr)
+        return;
+
+    jassert (owns (block)); // This block didn't come from this pool!
+
+    const SpinLock::ScopedLockType sl (lock);
+    deallocateLocked (Block::fromPayload (block));
+}
+
+bool RealtimeMemoryPool::owns (const void* block) const noexcept
+{
+    const auto address = (pointer_sized_uint) block;
+    return address >= (pointer_sized_uint) start && address < (pointer_sized_uint) end;
+}
+
+size_t RealtimeMemoryPool::getBlockSize (const void* block) noexcept
+{
+    return Block::fromPayload (block)->getSize();
+}
+
+size_t RealtimeMemoryPool::getNumBytesNeededFor (size_t numBytes) noexcept
+{
+    using namespace RealtimeMemoryPoolHelpers;
+    return roundUp (jmax (numBytes, minBlockSize), granularity) + headerSize;
+}
+
+//==============================================================================
+void RealtimeMemoryPool::getListIndices (size_t size, int& firstLevel, int& secondLevel) noexcept
+{
+    using namespace RealtimeMemoryPoolHelpers;
+
+    constexpr auto smallBlockSize = granularity << numSecondLevelListsLog2;
+
+    // Small blocks all share the first first-level list, with one second-level list
+    // for each size. Above that, each first-level list covers a power of two, and the
+    // second-level lists divide it up linearly.
+    if (size < smallBlockSize)
+    {
+        firstLevel = 0;
+        secondLevel = (int) (size >> granularityLog2);
+        return;
+    }
+
+    const auto highestBit = getHighestSetBit (size);
+    firstLevel = highestBit - (numSecondLevelListsLog2 + granularityLog2 - 1);
+    secondLevel = (int) (size >> (highestBit - numSecondLevelListsLog2)) ^ numSecondLevelLists;
+}
+
+RealtimeMemoryPool::Block* RealtimeMemoryPool::findFreeBlock (size_t size) noexcept
+{
+    using namespace RealtimeMemoryPoolHelpers;
+
+    // Round the size up to the start of the next list, so that any block in the list
+    // that we find will be big enough
+    if (size >= (granularity << numSecondLevelListsLog2))
+        size += ((size_t) 1 << (getHighestSetBit (size) - numSecondLevelListsLog2)) - 1;
+
+    int firstLevel, secondLevel;
+    getListIndices (size, firstLevel, secondLevel);
+
+    if (firstLevel >= numFirstLevelLists)
+        return nullptr;
+
+    auto secondLevelMap = secondLevelMaps[firstLevel] & (~(uint32) 0 << secondLevel);
+
+    if (secondLevelMap == 0)
+    {
+        const auto firstLevelMapAbove = firstLevel + 1 < numFirstLevelLists ? firstLevelMap & (~(uint32) 0 << (firstLevel + 1))
+                                                                            : 0;
+
+        if (firstLevelMapAbove == 0)
+            return nullptr;
+
+        firstLevel = getLowestSetBit (firstLevelMapAbove);
+        secondLevelMap = secondLevelMaps[firstLevel];
+    }
+
+    auto* block = freeLists[firstLevel][getLowestSetBit (secondLevelMap)];
+    jassert (block != nullptr && block->isFree());
+
+    removeFreeBlock (block);
+    return block;
+}
+
+void RealtimeMemoryPool::insertFreeBlock (Block* block) noexcept
+{
+    int firstLevel, secondLevel;
+    getListIndices (block->getSize(), firstLevel, secondLevel);
+
+    auto*& head = freeLists[firstLevel][secondLevel];
+
+    block->getNextFree() = head;
+    block->getPreviousFree() = nullptr;
+
+    if (head != nullptr)
+        head->getPreviousFree() = block;
+
+    head = block;
+    block->setFree (true);
+
+    firstLevelMap |= (uint32) 1 << firstLevel;
+    secondLevelMaps[firstLevel] |= (uint32) 1 << secondLevel;
+}
+
+void RealtimeMemoryPool::removeFreeBlock (Block* block) noexcept
+{
+    int firstLevel, secondLevel;
+    getListIndices (block->getSize(), firstLevel, secondLevel);
+
+    auto* next = block->getNextFree();
+    auto* previous = block->getPreviousFree();
+
+    if (next != nullptr)
+        next->getPreviousFree() = previous;
+
+    if (previous != nullptr)
+    {
+        previous->getNextFree() = next;
+        return;
+    }
+
+    freeLists[firstLevel][secondLevel] = next;
+
+    if (next == nullptr)
+    {
+        secondLevelMaps[firstLevel] &= ~((uint32) 1 << secondLevel);
+
+        if (secondLevelMaps[firstLevel] == 0)
+            firstLevelMap &= ~((uint32) 1 << firstLevel);
+    }
+}
+
+RealtimeMemoryPool::Block* RealtimeMemoryPool::splitBlock (Block* block, size_t size) noexcept
+{
+    using namespace RealtimeMemoryPoolHelpers;
+
+    auto* remainder = reinterpret_cast<Block*> (block->getPayload() + size);
+    remainder->previous = block;
+    remainder->sizeAndFlags = block->getSize() - size - headerSize;
+
+    block->setSize (size);
+    remainder->getNext()->previous = remainder;
+    return remainder;
+}
+
+RealtimeMemoryPool::Block* RealtimeMemoryPool::mergeWithNeighbours (Block* block) noexcept
+{
+    using namespace RealtimeMemoryPoolHelpers;
+
+    // The block at the end of the pool is never free, so we'll never go past it
+    auto* next = block->getNext();
+
+    if (next->isFree())
+    {
+        removeFreeBlock (next);
+        block->setSize (block->getSize() + headerSize + next->getSize());
+        block->getNext()->previous = block;
+    }
+
+    auto* previous = block->previous;
+
+    if (previous != nullptr && previous->isFree())
+    {
+        removeFreeBlock (previous);
+        previous->setSize (previous->getSize() + headerSize + block->getSize());
+        previous->getNext()->previous = previous;
+        block = previous;
+    }
+
+    return block;
+}
+
+void* RealtimeMemoryPool::allocateLocked (size_t size, size_t alignment) noexcept
+{
+    using namespace RealtimeMemoryPoolHelpers;
+
+    // To align the block, we may need to split off a free block in front of it,
+    // so we have to look for a block with enough room for that too
+    const auto needsAligning = alignment > granularity;
+    const auto searchSize = needsAligning ? size + alignment + headerSize + minBlockSize : size;
+
+    if (searchSize > getMaxBlockSize())
+        return nullptr;
+
+    auto* block = findFreeBlock (searchSize);
+
+    if (block == nullptr)
+        return nullptr;
+
+    if (needsAligning)
+    {
+        const auto payload = (pointer_sized_uint) block->getPayload();
+        auto gap = (size_t) (roundUp (payload, alignment) - payload);
+
+        if (gap != 0 && gap < headerSize + minBlockSize)
+            gap += alignment;
+
+        if (gap != 0)
+        {
+            auto* aligned = splitBlock (block, gap - headerSize);
+            insertFreeBlock (block);
+            block = aligned;
+        }
+    }
+
+    // Blocks in the free lists never have free neighbours, so the remainder doesn't
+    // need merging
+    if (block->getSize() >= size + headerSize + minBlockSize)
+        insertFreeBlock (splitBlock (block, size));
+
+    block->setFree (false);
+    numBytesAllocated += block->getSize();
+    return block->getPayload();
+}
+
+void RealtimeMemoryPool::deallocateLocked (Block* block) noexcept
+{
+    jassert (! block->isFree()); // This block has already been freed!
+
+    numBytesAllocated -= block->getSize();
+    insertFreeBlock (mergeWithNeighbours (block));
+}
+
+//==============================================================================
+RealtimeMemoryPool::ScopedUse::ScopedUse (RealtimeMemoryPool& poolToUse)
+    : pool (poolToUse),
+      previous (RealtimeMemoryPoolHelpers::getCurrentScopeForThread())
+{
+    RealtimeMemoryPoolHelpers::getCurrentScopeForThread() = this;
+}
+
+RealtimeMemoryPool::ScopedUse::~ScopedUse()
+{
+    RealtimeMemoryPoolHelpers::getCurrentScopeForThread() = previous;
+
+   #if JUCE_ENABLE_ALLOCATION_HOOKS
+    // Something used the system heap on a thread that was marked as real-time. That
+    // could either be a call to new or delete, or a HeapBlock that didn't fit in the
+    // pool. Set a breakpoint in heapWasUsed() to find out where it happened.
+    jassert (numHeapCalls == 0);
+   #endif
+}
+
+RealtimeMemoryPool::ScopedUse* RealtimeMemoryPool::ScopedUse::getCurrent() noexcept
+{
+    return RealtimeMemoryPoolHelpers::getCurrentScopeForThread();
+}
+
+#if JUCE_ENABLE_REALTIME_MEMORY_POOL
+void* RealtimeMemoryPool::ScopedUse::allocate (size_t numBytes, bool clear) noexcept
+{
+    using namespace RealtimeMemoryPoolHelpers;
+
+    if (isTooLargeToTag (numBytes))
+        return nullptr;
+
+    if (auto* block = pool.allocate (numBytes + tagSize))
+    {
+        auto* result = addTag (block, &pool);
+
+        if (clear)
+            zeromem (result, numBytes);
+
+        return result;
+    }
+
+    heapWasUsed();
+    return addTag (clear ? std::calloc (1, numBytes + tagSize) : std::malloc (numBytes + tagSize), nullptr);
+}
+#endif
+
+void RealtimeMemoryPool::ScopedUse::heapWasUsed() noexcept
+{
+   #if JUCE_ENABLE_ALLOCATION_HOOKS
+    ++numHeapCalls;
+   #endif
+}
+
+//==============================================================================
+#if JUCE_ENABLE_REALTIME_MEMORY_POOL
+namespace HeapBlockHelper
+{
+    void* JUCE_CALLTYPE mallocMemory (size_t numBytes)
+    {
+        using namespace RealtimeMemoryPoolHelpers;
+
+        if (auto* scope = RealtimeMemoryPool::ScopedUse::getCurrent())
+            return scope->allocate (numBytes, false);
+
+        if (isTooLargeToTag (numBytes))
+            return nullptr;
+
+        return addTag (std::malloc (numBytes + tagSize), nullptr);
+    }
+
+    void* JUCE_CALLTYPE callocMemory (size_t numElements, size_t elementSize)
+    {
+        using namespace RealtimeMemoryPoolHelpers;
+
+        if (elementSize != 0 && numElements > std::numeric_limits<size_t>::max() / elementSize)
+            return nullptr;
+
+        const auto numBytes = numElements * elementSize;
+
+        if (auto* scope = RealtimeMemoryPool::ScopedUse::getCurrent())
+            return scope->allocate (numBytes, true);
+
+        if (isTooLargeToTag (numBytes))
+            return nullptr;
+
+        return addTag (std::calloc (1, numBytes + tagSize), nullptr);
+    }
+
+    void* JUCE_CALLTYPE reallocMemory (void* data, size_t newNumBytes)
+    {
+        using namespace RealtimeMemoryPoolHelpers;
+
+        if (data == nullptr)
+            return mallocMemory (newNumBytes);
+
+        if (isTooLargeToTag (newNumBytes))
+            return nullptr;
+
+        auto* scope = RealtimeMemoryPool::ScopedUse::getCurrent();
+        auto* block = getTaggedBlock (data);
+
+        if (auto* pool = getTaggedPool (data))
+        {
+            // The tag is copied along with the data if the block moves
+            if (auto* result = pool->reallocate (block, newNumBytes + tagSize))
+                return static_cast<char*> (result) + tagSize;
+
+            // The pool is full, so the data has to move to the heap
+            auto* result = scope != nullptr ? scope->allocate (newNumBytes, false)
+                                            : addTag (std::malloc (newNumBytes + tagSize), nullptr);
+
+            if (result != nullptr)
+            {
+                memcpy (result, data, jmin (newNumBytes, RealtimeMemoryPool::getBlockSize (block) - tagSize));
+                pool->deallocate (block);
+            }
+
+            return result;
+        }
+
+        if (scope != nullptr)
+            scope->heapWasUsed();
+
+        return addTag (std::realloc (block, newNumBytes + tagSize), nullptr);
+    }
+
+    void JUCE_CALLTYPE freeMemory (void* data) noexcept
+    {
+        using namespace RealtimeMemoryPoolHelpers;
+
+        if (data == nullptr)
+            return;
+
+        auto* block = getTaggedBlock (data);
+
+        if (auto* pool = getTaggedPool (data))
+        {
+            pool->deallocate (block);
+            return;
+        }
+
+        if (auto* scope = RealtimeMemoryPool::ScopedUse::getCurrent())
+            scope->heapWasUsed();
+
+        std::free (block);
+    }
+}
+#endif
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class RealtimeMemoryPoolTests  : public UnitTest
+{
+public:
+    RealtimeMemoryPoolTests()
+        : UnitTest ("RealtimeMemoryPool", UnitTestCategories::memory)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Blocks are aligned and don't overlap");
+        {
+            RealtimeMemoryPool pool (1 << 16);
+            auto random = getRandom();
+
+            struct Allocation
+            {
+                uint8* data;
+                size_t size;
+                uint8 value;
+            };
+
+            std::vector<Allocation> allocations;
+            allocations.reserve (1000);
+
+            for (int i = 0; i < 10000; ++i)
+            {
+                if (allocations.size() < 1000 && random.nextInt (3) != 0)
+                {
+                    const auto size = (size_t) random.nextInt (random.nextBool() ? 64 : 2048) + 1;
+                    const auto alignment = (size_t) 1 << random.nextInt (8);
+
+                    if (auto* data = static_cast<uint8*> (pool.allocate (size, alignment)))
+                    {
+                        expect (((pointer_sized_uint) data & (jmax (alignment, alignof (std::max_align_t)) - 1)) == 0);
+                        expect (RealtimeMemoryPool::getBlockSize (data) >= size);
+
+                        const auto value = (uint8) random.nextInt (256);
+                        memset (data, value, size);
+                        allocations.push_back ({ data, size, value });
+                    }
+                }
+                else if (! allocations.empty())
+                {
+                    const auto index = (size_t) random.nextInt ((int) allocations.size());
+                    const auto allocation = allocations[index];
+                    allocations.erase (allocations.begin() + (ptrdiff_t) index);
+
+                    expect (std::all_of (allocation.data, allocation.data + allocation.size,
+                                         [&] (auto x) { return x == allocation.value; }));
+
+                    pool.deallocate (allocation.data);
+                }
+            }
+
+            for (const auto& allocation : allocations)
+                pool.deallocate (allocation.data);
+
+            expect (pool.getNumBytesAllocated() == 0);
+
+            // Once everything has been freed, all of the blocks should have merged back together
+            auto* large = pool.allocate (pool.getCapacity() * 3 / 4);
+            expect (large != nullptr);
+            pool.deallocate (large);
+        }
+
+        beginTest ("Allocation fails when the pool is full");
+        {
+            RealtimeMemoryPool pool (4096);
+
+            expect (pool.allocate (pool.getCapacity() + 1) == nullptr);
+            expect (pool.allocate (0) == nullptr);
+
+            std::vector<void*> blocks;
+
+            while (auto* block = pool.allocate (100))
+                blocks.push_back (block);
+
+            expect (! blocks.empty());
+            expect (blocks.size() >= pool.getCapacity() / RealtimeMemoryPool::getNumBytesNeededFor (100));
+
+            for (auto* block : blocks)
+                pool.deallocate (block);
+
+            expect (pool.getNumBytesAllocated() == 0);
+        }
+
+        beginTest ("Reallocating keeps the contents");
+        {
+            RealtimeMemoryPool pool (1 << 16);
+
+            auto* data = static_cast<uint8*> (pool.allocate (100));
+
+            for (int i = 0; i < 100; ++i)
+                data[i] = (uint8) i;
+
+            auto* blocker = pool.allocate (16);
+
+            // The next block is in use, so this has to move
+            auto* moved = static_cast<uint8*> (pool.reallocate (data, 1000));
+            expect (moved != nullptr && moved != data);
+
+            pool.deallocate (blocker);
+
+            // This can grow in place, because the following memory is free
+            auto* grown = static_cast<uint8*> (pool.reallocate (moved, 4000));
+            expect (grown == moved);
+
+            auto* shrunk = static_cast<uint8*> (pool.reallocate (grown, 50));
+            expect (shrunk == grown);
+
+            bool contentsMatch = true;
+
+            for (int i = 0; i < 50; ++i)
+                contentsMatch = contentsMatch && shrunk[i] == (uint8) i;
+
+            expect (contentsMatch);
+            expect (pool.reallocate (shrunk, 0) == nullptr);
+            expect (pool.getNumBytesAllocated() == 0);
+        }
+
+       #if JUCE_ENABLE_REALTIME_MEMORY_POOL
+        beginTest ("HeapBlocks use the pool inside a ScopedUse");
+        {
+            RealtimeMemoryPool pool (1 << 16);
+            HeapBlock<float> outside (16);
+            Array<int> array;
+
+            {
+                const RealtimeMemoryPool::ScopedUse scope (pool);
+                expect (RealtimeMemoryPool::ScopedUse::getCurrent() == &scope);
+
+                HeapBlock<float> inside (256, true);
+                expect (pool.owns (inside.get()));
+                expect (! pool.owns (outside.get()));
+                expect (exactlyEqual (inside[255], 0.0f));
+
+                for (int i = 0; i < 1000; ++i)
+                    array.add (i);
+
+                expect (pool.owns (array.begin()));
+                expectEquals (scope.getNumHeapCalls(), 0);
+            }
+
+            expect (RealtimeMemoryPool::ScopedUse::getCurrent() == nullptr);
+            expect (pool.getNumBytesAllocated() > 0);
+
+            // Memory from the pool goes back to it, even outside the scope
+            array.clearQuick();
+            array.minimiseStorageOverheads();
+            expect (pool.getNumBytesAllocated() == 0);
+        }
+
+        beginTest ("HeapBlocks go back to the pool that they came from");
+        {
+            HeapBlock<int> first, second;
+            auto other = std::make_unique<RealtimeMemoryPool> (1 << 12);
+
+            {
+                RealtimeMemoryPool pool (1 << 12);
+
+                {
+                    const RealtimeMemoryPool::ScopedUse outerScope (pool);
+                    first.malloc (16);
+
+                    const RealtimeMemoryPool::ScopedUse innerScope (*other);
+                    second.malloc (16);
+                }
+
+                expect (pool.owns (first.get()));
+                expect (other->owns (second.get()));
+
+                second.free();
+                expect (other->getNumBytesAllocated() == 0);
+                expect (pool.getNumBytesAllocated() > 0);
+
+                // Freeing memory only touches the pool that it came from
+                other.reset();
+                first.free();
+                expect (pool.getNumBytesAllocated() == 0);
+            }
+        }
+
+        beginTest ("HeapBlocks move to the heap if the pool is full");
+        {
+            RealtimeMemoryPool pool (1024);
+            HeapBlock<char> block;
+
+            {
+                const RealtimeMemoryPool::ScopedUse scope (pool);
+                block.malloc (512);
+            }
+
+            expect (pool.owns (block.get()));
+
+            for (int i = 0; i < 512; ++i)
+                block[i] = (char) i;
+
+            block.realloc (4096);
+            expect (block != nullptr && ! pool.owns (block.get()));
+            expect (pool.getNumBytesAllocated() == 0);
+            expect (block[511] == (char) 511);
+        }
+       #else
+        beginTest ("HeapBlocks use the system heap inside a ScopedUse");
+        {
+            RealtimeMemoryPool pool (1 << 16);
+            const RealtimeMemoryPool::ScopedUse scope (pool);
+            expect (RealtimeMemoryPool::ScopedUse::getCurrent() == &scope);
+
+            HeapBlock<float> block (256);
+            expect (! pool.owns (block.get()));
+            expect (pool.getNumBytesAllocated() == 0);
+        }
+       #endif
+
+        beginTest ("RealtimeAllocator works with standard containers");
+        {
+            RealtimeMemoryPool pool (1 << 16);
+
+            {
+                std::vector<double, RealtimeAllocator<double>> vector ((RealtimeAllocator<double> (pool)));
+                vector.resize (100, 1.0);
+                expect (pool.owns (vector.data()));
+
+                std::map<int, String, std::less<>, RealtimeAllocator<std::pair<const int, String>>> map ((RealtimeAllocator<std::pair<const int, String>> (pool)));
+                map[1] = "one";
+                map[2] = "two";
+                expect (map.size() == 2);
+            }
+
+            expect (pool.getNumBytesAllocated() == 0);
+        }
+    }
+};
+
+static RealtimeMemoryPoolTests realtimeMemoryPoolTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,281 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A block of memory, allocated up-front, that can be shared out without calling
+    the system allocator.
+
+    The system's malloc and free may take locks, or ask the OS for more pages, so
+    they can take an unpredictable amount of time. That makes them unsafe to call on
+    an audio thread. A RealtimeMemoryPool hands out pieces of its own block instead,
+    using the two-level segregated fit (TLSF) algorithm: allocate() and deallocate()
+    take a constant amount of time, whatever the sizes involved and however many
+    blocks are in use.
+
+    You can call allocate() and deallocate() directly, or use a RealtimeAllocator with
+    a standard container. If JUCE_ENABLE_REALTIME_MEMORY_POOL is turned on, you can also
+    create a ScopedUse, which makes all of the HeapBlocks on the current thread (and so
+    Arrays, MemoryBlocks, AudioBuffers etc.) take their memory from the pool.
+
+    @code
+    RealtimeMemoryPool pool (1 << 20);
+
+    void audioCallback()
+    {
+        const RealtimeMemoryPool::ScopedUse scope (pool);
+
+        Array<float> temp;
+        temp.resize (512); // comes from the pool, not the system heap
+    }
+    @endcode
+
+    It's fine to allocate and deallocate from different threads, but the pool
+    must outlive all of the memory that it has handed out.
+
+    @see RealtimeAllocator, HeapBlock
+
+    @tags{Core}
+*/
+class JUCE_API  RealtimeMemoryPool
+{
+public:
+    //==============================================================================
+    /** Creates a pool that can hand out up to the given number of bytes.
+
+        The memory is allocated and touched here, so that the OS has to provide
+        the pages up-front.
+    */
+    explicit RealtimeMemoryPool (size_t numBytes);
+
+    /** Destructor.
+
+        All of the memory that the pool handed out must have been deallocated
+        before this is called.
+    */
+    ~RealtimeMemoryPool();
+
+    //==============================================================================
+    /** Returns a block of at least the given size, or nullptr if the pool hasn't
+        got a large enough free block.
+
+        The alignment must be a power of two. The memory will always be aligned to
+        at least alignof (std::max_align_t).
+
+        This takes a constant amount of time.
+    */
+    void* allocate (size_t numBytes, size_t alignment = alignof (std::max_align_t)) noexcept;
+
+    /** Resizes a block that was returned by allocate(), keeping as much of its
+        contents as will fit.
+
+        If the block can't be resized, this returns nullptr, and the original block
+        is left unchanged. Passing nullptr is the same as calling allocate(), and
+        passing a size of zero is the same as calling deallocate().
+
+        If the block has to move, its new position only has the default alignment.
+    */
+    void* reallocate (void* block, size_t newNumBytes) noexcept;
+
+    /** Returns a block to the pool.
+
+        The block must have been returned by allocate() or reallocate(). Passing
+        nullptr does nothing. This takes a constant amount of time.
+    */
+    void deallocate (void* block) noexcept;
+
+    /** Returns true if the given pointer lies within this pool's memory. */
+    bool owns (const void* block) const noexcept;
+
+    /** Returns the number of bytes that can be used in a block that was returned
+        by allocate() or reallocate(). This may be more than was asked for.
+    */
+    static size_t getBlockSize (const void* block) noexcept;
+
+    /** Returns the number of bytes that a block of the given size uses, including
+        the pool's own bookkeeping.
+    */
+    static size_t getNumBytesNeededFor (size_t numBytes) noexcept;
+
+    /** Returns the total number of bytes that the pool can hand out. */
+    size_t getCapacity() const noexcept             { return capacity; }
+
+    /** Returns the number of bytes that are currently allocated. */
+    size_t getNumBytesAllocated() const noexcept    { return numBytesAllocated.load (std::memory_order_relaxed); }
+
+    //==============================================================================
+    /**
+        Makes the HeapBlocks on the current thread take their memory from a pool,
+        for as long as this object exists. This only happens when
+        JUCE_ENABLE_REALTIME_MEMORY_POOL is turned on; otherwise HeapBlocks always use
+        the system heap.
+
+        This also marks the thread as real-time. When JUCE_ENABLE_ALLOCATION_HOOKS
+        is turned on, the scope counts every call to new or delete made on the thread,
+        along with any HeapBlock allocation that the pool was too full to satisfy, and
+        debug builds will assert when the scope ends if there were any.
+
+        HeapBlocks that already held memory from the system heap keep using it when
+        they are resized, and memory from the pool may be freed on any thread.
+
+        The memory that a HeapBlock takes from the pool stays in the pool until the
+        HeapBlock frees it, even after the scope has ended. So anything that grows inside
+        the scope, such as an Array that outlives it, must be freed or deleted before the
+        pool is. Otherwise it will try to give its memory back to a pool that no longer
+        exists.
+
+        Scopes may be nested, in which case the innermost one is used.
+    */
+    class JUCE_API  ScopedUse
+    {
+    public:
+        /** Routes the current thread's HeapBlock allocations to the given pool. */
+        explicit ScopedUse (RealtimeMemoryPool& pool);
+
+        /** Restores the previous scope, if there was one. */
+        ~ScopedUse();
+
+        /** Returns the pool that this scope uses. */
+        RealtimeMemoryPool& getPool() const noexcept    { return pool; }
+
+        /** Returns the number of times that this thread has used the system heap
+            while the scope existed.
+
+            This is only counted when JUCE_ENABLE_ALLOCATION_HOOKS is turned on,
+            and will always be zero otherwise.
+        */
+        int getNumHeapCalls() const noexcept            { return numHeapCalls; }
+
+        /** Returns the innermost scope on the current thread, or nullptr if there
+            isn't one.
+        */
+        static ScopedUse* getCurrent() noexcept;
+
+       #if JUCE_ENABLE_REALTIME_MEMORY_POOL
+        /** @internal */
+        void* allocate (size_t numBytes, bool clear) noexcept;
+       #endif
+        /** @internal */
+        void heapWasUsed() noexcept;
+
+    private:
+        RealtimeMemoryPool& pool;
+        ScopedUse* const previous;
+        int numHeapCalls = 0;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedUse)
+    };
+
+private:
+    //==============================================================================
+    struct Block;
+
+    static size_t getMaxBlockSize() noexcept;
+    static void getListIndices (size_t, int&, int&) noexcept;
+
+    Block* findFreeBlock (size_t) noexcept;
+    void insertFreeBlock (Block*) noexcept;
+    void removeFreeBlock (Block*) noexcept;
+    Block* splitBlock (Block*, size_t) noexcept;
+    Block* mergeWithNeighbours (Block*) noexcept;
+    void* allocateLocked (size_t, size_t) noexcept;
+    void deallocateLocked (Block*) noexcept;
+
+    static constexpr int numFirstLevelLists = 32, numSecondLevelListsLog2 = 5,
+                         numSecondLevelLists = 1 << numSecondLevelListsLog2;
+
+    void* memory = nullptr;
+    char* start = nullptr;
+    char* end = nullptr;
+    size_t capacity = 0;
+    std::atomic<size_t> numBytesAllocated { 0 };
+    SpinLock lock;
+
+    uint32 firstLevelMap = 0;
+    uint32 secondLevelMaps[numFirstLevelLists] = {};
+    Block* freeLists[numFirstLevelLists][numSecondLevelLists] = {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeMemoryPool)
+};
+
+//==============================================================================
+/**
+    A standard-library allocator that takes its memory from a RealtimeMemoryPool.
+
+    This lets you use std::vector, std::map etc. on an audio thread. If the pool is
+    full, it throws std::bad_alloc, just like std::allocator.
+
+    @code
+    std::vector<float, RealtimeAllocator<float>> samples (RealtimeAllocator<float> (pool));
+    @endcode
+
+    @see RealtimeMemoryPool
+
+    @tags{Core}
+*/
+template <typename ElementType>
+class RealtimeAllocator
+{
+public:
+    using value_type = ElementType;
+
+    /** Creates an allocator that uses the given pool. */
+    explicit RealtimeAllocator (RealtimeMemoryPool& poolToUse) noexcept : pool (&poolToUse) {}
+
+    /** Creates an allocator for a different type that uses the same pool. */
+    template <typename OtherType>
+    RealtimeAllocator (const RealtimeAllocator<OtherType>& other) noexcept : pool (&other.getPool()) {}
+
+    /** Allocates space for the given number of elements. */
+    ElementType* allocate (size_t numElements)
+    {
+        if (auto* result = pool->allocate (numElements * sizeof (ElementType), jmax (alignof (ElementType), alignof (std::max_align_t))))
+            return static_cast<ElementType*> (result);
+
+       #if JUCE_EXCEPTIONS_DISABLED
+        jassertfalse; // The pool isn't big enough!
+        return nullptr;
+       #else
+        throw std::bad_alloc();
+       #endif
+    }
+
+    /** Returns some elements' space to the pool. */
+    void deallocate (ElementType* elements, size_t) noexcept   { pool->deallocate (elements); }
+
+    /** Returns the pool that this allocator uses. */
+    RealtimeMemoryPool& getPool() const noexcept                { return *pool; }
+
+    template <typename OtherType>
+    bool operator== (const RealtimeAllocator<OtherType>& other) const noexcept  { return pool == &other.getPool(); }
+
+    template <typename OtherType>
+    bool operator!= (const RealtimeAllocator<OtherType>& other) const noexcept  { return pool != &other.getPool(); }
+
+private:
+    RealtimeMemoryPool* pool;
+};
+
+} // namespace juce
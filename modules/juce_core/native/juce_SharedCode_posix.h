@@ -890,12 +890,16 @@ public:
     {
         const auto isRealtime = rt.hasValue();
 
+        const auto realtimeScheduler = isRealtime && rt->getSchedulingPolicy() == Thread::RealtimeOptions::SchedulingPolicy::fifo
+                                     ? SCHED_FIFO
+                                     : SCHED_RR;
+
         const auto priority = [&]
         {
             if (isRealtime)
             {
-                const auto min = jmax (0, sched_get_priority_min (SCHED_RR));
-                const auto max = jmax (1, sched_get_priority_max (SCHED_RR));
+                const auto min = jmax (0, sched_get_priority_min (realtimeScheduler));
+                const auto max = jmax (1, sched_get_priority_max (realtimeScheduler));
 
                 return jmap (rt->getPriority(), 0, 10, min, max);
             }
@@ -932,7 +936,7 @@ public:
         #elif JUCE_LINUX
          const auto backgroundSched = prio == Thread::Priority::background ? SCHED_IDLE
                                                                            : SCHED_OTHER;
-         const auto scheduler = isRealtime ? SCHED_RR : backgroundSched;
+         const auto scheduler = isRealtime ? realtimeScheduler : backgroundSched;
         #else
          const auto scheduler = 0;
         #endif
@@ -1056,6 +1060,123 @@ void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask ([[maybe_unused]] uint32
    #endif
 }
 
+static uint32 getCurrentThreadAffinityMask()
+{
+    uint32 result = 0;
+
+   #if SUPPORT_AFFINITIES && (JUCE_ANDROID || ((! (JUCE_LINUX || JUCE_BSD)) || ((__GLIBC__ * 1000 + __GLIBC_MINOR__) >= 2004)))
+    cpu_set_t affinity;
+    CPU_ZERO (&affinity);
+
+    #if JUCE_ANDROID
+     const auto status = sched_getaffinity (gettid(), sizeof (cpu_set_t), &affinity);
+    #else
+     const auto status = pthread_getaffinity_np (pthread_self(), sizeof (cpu_set_t), &affinity);
+    #endif
+
+    if (status == 0)
+    {
+        for (int i = 0; i < 32; ++i)
+        {
+            JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wsign-conversion")
+            if (CPU_ISSET ((size_t) i, &affinity))
+                result |= (uint32) (1 << i);
+            JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+        }
+    }
+   #endif
+
+    return result;
+}
+
+// Returns the number of bytes between the caller's frame and the end of its thread's stack
+static std::optional<size_t> getCurrentThreadFreeStackSpace()
+{
+    char* stackBottom = nullptr;
+
+   #if JUCE_LINUX || JUCE_ANDROID
+    pthread_attr_t attr;
+
+    if (pthread_getattr_np (pthread_self(), &attr) != 0)
+        return {};
+
+    void* stackAddress = nullptr;
+    size_t stackSize = 0;
+    const auto status = pthread_attr_getstack (&attr, &stackAddress, &stackSize);
+    pthread_attr_destroy (&attr);
+
+    if (status != 0)
+        return {};
+
+    stackBottom = static_cast<char*> (stackAddress);
+   #elif JUCE_MAC || JUCE_IOS
+    stackBottom = static_cast<char*> (pthread_get_stackaddr_np (pthread_self())) - pthread_get_stacksize_np (pthread_self());
+   #else
+    return {};
+   #endif
+
+    char marker = 0;
+    return (size_t) jmax ((pointer_sized_int) 0, (pointer_sized_int) (&marker - stackBottom));
+}
+
+static bool lockProcessMemory()
+{
+   #if JUCE_LINUX || JUCE_BSD
+    // With MCL_FUTURE, any allocation that would take the process over its memory-lock
+    // limit will fail, so only lock the memory if that can't happen
+    rlimit limit;
+
+    if (geteuid() != 0 && (getrlimit (RLIMIT_MEMLOCK, &limit) != 0 || limit.rlim_cur != RLIM_INFINITY))
+        return false;
+
+    return mlockall (MCL_CURRENT | MCL_FUTURE) == 0;
+   #else
+    return false;
+   #endif
+}
+
+Thread::RealtimeStatus JUCE_CALLTYPE Thread::applyRealtimeOptionsToCurrentThread (const RealtimeOptions& options)
+{
+    RealtimeStatus status;
+
+   #if JUCE_LINUX || JUCE_BSD
+    if (options.schedulingRequested)
+    {
+        const auto requested = PosixSchedulerPriority::getNativeSchedulerAndPriority (options, {});
+        const sched_param param { requested.getPriority() };
+        pthread_setschedparam (pthread_self(), requested.getScheduler(), &param);
+    }
+   #endif
+
+    if (options.getMemoryLocking())
+        status.memoryLocked = lockProcessMemory();
+
+   #if SUPPORT_AFFINITIES
+    if (options.getAffinityMask() != 0)
+        setCurrentThreadAffinityMask (options.getAffinityMask());
+   #endif
+
+    const auto current = PosixSchedulerPriority::findCurrentSchedulerAndPriority();
+
+    if (current.getScheduler() == SCHED_FIFO)
+        status.schedulingPolicy = RealtimeOptions::SchedulingPolicy::fifo;
+    else if (current.getScheduler() == SCHED_RR)
+        status.schedulingPolicy = RealtimeOptions::SchedulingPolicy::roundRobin;
+
+    status.nativePriority = current.getPriority();
+    status.affinityMask = getCurrentThreadAffinityMask();
+
+    // Leave some headroom for the code that will run after the stack has been touched
+    constexpr size_t stackHeadroom = 64 * 1024;
+    auto numBytesToPrefault = options.getStackPrefaultBytes();
+
+    if (const auto freeSpace = getCurrentThreadFreeStackSpace())
+        numBytesToPrefault = jmin (numBytesToPrefault, *freeSpace > stackHeadroom ? *freeSpace - stackHeadroom : 0);
+
+    status.numStackBytesPrefaulted = prefaultCurrentThreadStack (numBytesToPrefault);
+    return status;
+}
+
 //==============================================================================
 #if ! JUCE_WASM
 bool DynamicLibrary::open (const String& name)
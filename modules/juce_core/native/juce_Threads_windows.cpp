@@ -172,6 +172,31 @@ void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (const uint32 affinityMa
     SetThreadAffinityMask (GetCurrentThread(), affinityMask);
 }
 
+Thread::RealtimeStatus JUCE_CALLTYPE Thread::applyRealtimeOptionsToCurrentThread (const RealtimeOptions& options)
+{
+    RealtimeStatus status;
+
+    if (const auto mask = options.getAffinityMask(); mask != 0)
+        status.affinityMask = SetThreadAffinityMask (GetCurrentThread(), mask) != 0 ? mask : 0;
+
+    status.nativePriority = GetThreadPriority (GetCurrentThread());
+
+    // The stack is reserved from the allocation base up to the current frame, and the last
+    // few pages of that are guard pages, so leave some headroom above them
+    constexpr size_t stackHeadroom = 64 * 1024;
+    MEMORY_BASIC_INFORMATION info;
+    auto numBytesToPrefault = options.getStackPrefaultBytes();
+
+    if (VirtualQuery (&info, &info, sizeof (info)) != 0)
+    {
+        const auto freeSpace = (size_t) (reinterpret_cast<char*> (&info) - static_cast<char*> (info.AllocationBase));
+        numBytesToPrefault = jmin (numBytesToPrefault, freeSpace > stackHeadroom ? freeSpace - stackHeadroom : 0);
+    }
+
+    status.numStackBytesPrefaulted = prefaultCurrentThreadStack (numBytesToPrefault);
+    return status;
+}
+
 //==============================================================================
 struct SleepEvent
 {
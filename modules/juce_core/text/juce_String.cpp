@@ -2962,6 +2962,45 @@ public:
 
 static StringTests stringUnitTests;
 
+//==============================================================================
+class StringBenchmark final : public Benchmark
+{
+public:
+    StringBenchmark()
+        : Benchmark ("String class", UnitTestCategories::text)
+    {}
+
+    void runBenchmark() override
+    {
+        const String shortText ("The quick brown fox");
+        const String longText (String::repeatedString ("The quick brown fox jumps over the lazy dog. ", 100));
+        const String numberText ("-123456789");
+
+        measure ("construct from literal",  [] { doNotOptimise (String ("The quick brown fox jumps over the lazy dog")); });
+        measure ("copy",                    [&] { doNotOptimise (String (longText)); });
+        measure ("concatenate",             [&] { doNotOptimise (shortText + " jumps over " + shortText); });
+        measure ("append integers",         []
+        {
+            String s;
+
+            for (int i = 0; i < 32; ++i)
+                s << i << ',';
+
+            doNotOptimise (s);
+        }, 32);
+
+        measure ("compare",                 [&] { doNotOptimise (longText.compare (longText + "!")); }, longText.length());
+        measure ("indexOf",                 [&] { doNotOptimise (longText.indexOf ("lazy cat")); }, longText.length());
+        measure ("replace",                 [&] { doNotOptimise (longText.replace ("fox", "cat")); }, longText.length());
+        measure ("toUpperCase",             [&] { doNotOptimise (longText.toUpperCase()); }, longText.length());
+        measure ("hashCode",                [&] { doNotOptimise (longText.hashCode64()); }, longText.length());
+        measure ("getIntValue",             [&] { doNotOptimise (numberText.getIntValue()); });
+        measure ("toUTF16",                 [&] { doNotOptimise (longText.toUTF16()); }, longText.length());
+    }
+};
+
+static StringBenchmark stringBenchmark;
+
 #endif
 
 } // namespace juce
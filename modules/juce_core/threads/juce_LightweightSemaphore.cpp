@@ -0,0 +1,238 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_WINDOWS
+struct LightweightSemaphore::NativeSemaphore
+{
+    NativeSemaphore()   : handle (CreateSemaphoreW (nullptr, 0, std::numeric_limits<LONG>::max(), nullptr)) {}
+    ~NativeSemaphore()  { CloseHandle (handle); }
+
+    bool wait (int timeOutMilliseconds) noexcept
+    {
+        return WaitForSingleObject (handle, timeOutMilliseconds < 0 ? INFINITE : (DWORD) timeOutMilliseconds) == WAIT_OBJECT_0;
+    }
+
+    void signal (int num) noexcept      { ReleaseSemaphore (handle, (LONG) num, nullptr); }
+
+    HANDLE handle;
+};
+
+#elif JUCE_MAC || JUCE_IOS
+struct LightweightSemaphore::NativeSemaphore
+{
+    NativeSemaphore()   : semaphore (dispatch_semaphore_create (0)) {}
+    ~NativeSemaphore()  { dispatch_release (semaphore); }
+
+    bool wait (int timeOutMilliseconds) noexcept
+    {
+        const auto timeout = timeOutMilliseconds < 0 ? DISPATCH_TIME_FOREVER
+                                                     : dispatch_time (DISPATCH_TIME_NOW, (int64_t) timeOutMilliseconds * 1000000);
+        return dispatch_semaphore_wait (semaphore, timeout) == 0;
+    }
+
+    void signal (int num) noexcept
+    {
+        while (--num >= 0)
+            dispatch_semaphore_signal (semaphore);
+    }
+
+    dispatch_semaphore_t semaphore;
+};
+
+#else
+struct LightweightSemaphore::NativeSemaphore
+{
+    NativeSemaphore()   { sem_init (&semaphore, 0, 0); }
+    ~NativeSemaphore()  { sem_destroy (&semaphore); }
+
+    bool wait (int timeOutMilliseconds) noexcept
+    {
+        if (timeOutMilliseconds < 0)
+        {
+            while (sem_wait (&semaphore) != 0)
+                if (errno != EINTR)
+                    return false;
+
+            return true;
+        }
+
+        if (timeOutMilliseconds == 0)
+            return sem_trywait (&semaphore) == 0;
+
+        timespec deadline;
+        clock_gettime (CLOCK_REALTIME, &deadline);
+
+        const auto nanoseconds = (int64) deadline.tv_nsec + (int64) timeOutMilliseconds * 1000000;
+        deadline.tv_sec += (time_t) (nanoseconds / 1000000000);
+        deadline.tv_nsec = (long) (nanoseconds % 1000000000);
+
+        while (sem_timedwait (&semaphore, &deadline) != 0)
+            if (errno != EINTR)
+                return false;
+
+        return true;
+    }
+
+    void signal (int num) noexcept
+    {
+        while (--num >= 0)
+            sem_post (&semaphore);
+    }
+
+    sem_t semaphore;
+};
+#endif
+
+//==============================================================================
+LightweightSemaphore::LightweightSemaphore (int initialCount)
+    : native (std::make_unique<NativeSemaphore>()), count (initialCount)
+{
+    jassert (initialCount >= 0);
+}
+
+LightweightSemaphore::~LightweightSemaphore() = default;
+
+bool LightweightSemaphore::tryWait() noexcept
+{
+    auto oldCount = count.load (std::memory_order_relaxed);
+
+    while (oldCount > 0)
+        if (count.compare_exchange_weak (oldCount, oldCount - 1, std::memory_order_acquire, std::memory_order_relaxed))
+            return true;
+
+    return false;
+}
+
+bool LightweightSemaphore::wait (int timeOutMilliseconds) noexcept
+{
+    if (tryWait())
+        return true;
+
+    if (count.fetch_sub (1, std::memory_order_acquire) > 0)
+        return true;
+
+    if (timeOutMilliseconds != 0 && native->wait (timeOutMilliseconds))
+        return true;
+
+    // The wait timed out, so take back the decrement. If the count has become
+    // non-negative in the meantime, a signal() has already been sent to the native
+    // semaphore on this thread's behalf, and that has to be consumed instead.
+    for (;;)
+    {
+        auto oldCount = count.load (std::memory_order_relaxed);
+
+        if (oldCount >= 0 && native->wait (0))
+            return true;
+
+        if (oldCount < 0 && count.compare_exchange_strong (oldCount, oldCount + 1, std::memory_order_relaxed))
+            return false;
+    }
+}
+
+void LightweightSemaphore::signal (int numToSignal) noexcept
+{
+    jassert (numToSignal >= 0);
+
+    const auto oldCount = count.fetch_add (numToSignal, std::memory_order_release);
+    const auto numToRelease = jmin (numToSignal, -oldCount);
+
+    if (numToRelease > 0)
+        native->signal (numToRelease);
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class LightweightSemaphoreTests final : public UnitTest
+{
+public:
+    LightweightSemaphoreTests()
+        : UnitTest ("LightweightSemaphore", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("The count is decremented without waiting when it's positive");
+        {
+            LightweightSemaphore semaphore (2);
+
+            expect (semaphore.tryWait());
+            expect (semaphore.wait (0));
+            expect (! semaphore.tryWait());
+            expect (! semaphore.wait (10));
+
+            semaphore.signal();
+            expect (semaphore.wait (0));
+        }
+
+        beginTest ("A timed-out wait leaves the count unchanged");
+        {
+            LightweightSemaphore semaphore;
+
+            expect (! semaphore.wait (5));
+            semaphore.signal();
+            expect (semaphore.tryWait());
+            expect (! semaphore.tryWait());
+        }
+
+        beginTest ("Signals wake waiting threads");
+        {
+            constexpr int numThreads = 4, numIterations = 2000;
+
+            LightweightSemaphore semaphore;
+            std::atomic<int> numWoken { 0 };
+            std::vector<std::thread> threads;
+
+            for (int i = 0; i < numThreads; ++i)
+            {
+                threads.emplace_back ([&]
+                {
+                    for (int j = 0; j < numIterations; ++j)
+                    {
+                        // Alternate between short timeouts and waiting forever, to exercise
+                        // the timeout path while signals are arriving
+                        while (! semaphore.wait ((j % 2) == 0 ? 1 : -1)) {}
+                        numWoken.fetch_add (1);
+                    }
+                });
+            }
+
+            for (int i = 0; i < numThreads * numIterations; ++i)
+                semaphore.signal();
+
+            for (auto& thread : threads)
+                thread.join();
+
+            expectEquals (numWoken.load(), numThreads * numIterations);
+            expect (! semaphore.tryWait());
+        }
+    }
+};
+
+static LightweightSemaphoreTests lightweightSemaphoreTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A counting semaphore that can be signalled from a real-time thread.
+
+    Unlike WaitableEvent, signal() never takes a lock: it only touches an atomic
+    counter, and calls into the OS semaphore when a thread is actually waiting.
+    This makes it a good way for an audio thread to wake up worker threads which
+    are sleeping until there's work to do.
+
+    @tags{Core}
+*/
+class JUCE_API  LightweightSemaphore
+{
+public:
+    //==============================================================================
+    /** Creates a semaphore with the given initial count. */
+    explicit LightweightSemaphore (int initialCount = 0);
+
+    /** Destructor. Nothing must be waiting on the semaphore when it's deleted. */
+    ~LightweightSemaphore();
+
+    //==============================================================================
+    /** Decrements the count, waiting for it to become positive first if necessary.
+
+        @param timeOutMilliseconds  the maximum time to wait, in milliseconds. A negative
+                                    value will cause it to wait forever.
+
+        @returns    true if the count was decremented, false if the timeout expired first.
+    */
+    bool wait (int timeOutMilliseconds = -1) noexcept;
+
+    /** Decrements the count if it's positive, without waiting.
+
+        @returns    true if the count was decremented.
+    */
+    bool tryWait() noexcept;
+
+    /** Increments the count, waking up to that many waiting threads.
+
+        This is lock-free, and safe to call from a real-time thread.
+    */
+    void signal (int numToSignal = 1) noexcept;
+
+private:
+    //==============================================================================
+    struct NativeSemaphore;
+
+    std::unique_ptr<NativeSemaphore> native;
+
+    // When negative, this is the number of threads waiting on the native semaphore
+    std::atomic<int> count;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LightweightSemaphore)
+};
+
+} // namespace juce
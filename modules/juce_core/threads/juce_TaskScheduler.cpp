@@ -0,0 +1,714 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct TaskScheduler::Task::Node
+{
+    Node (TaskGroup& g, Function&& f) noexcept
+        : function (std::move (f)), group (g) {}
+
+    void addReference() noexcept            { ++refCount; }
+    void release() noexcept                 { if (--refCount == 0) delete this; }
+
+    Function function;
+    TaskGroup& group;
+
+    // One reference is held by the scheduler until the task has finished, and
+    // one by each Task object that refers to it
+    std::atomic<int> refCount { 1 };
+
+    // The number of unfinished dependencies, plus one while the task is being added
+    std::atomic<int> numBlockers { 1 };
+
+    SpinLock successorLock;
+    std::vector<Node*> successors;
+    std::atomic<bool> finished { false };
+
+    JUCE_DECLARE_NON_COPYABLE (Node)
+};
+
+/*  The tasks that the current thread is running, innermost first. A thread can be in the
+    middle of several tasks at once, because it runs other tasks while waiting for a group.
+*/
+struct RunningTask
+{
+    const TaskScheduler::TaskGroup* group;
+    RunningTask* outer;
+
+    // The call to TaskGroup::wait() that this task is blocked in, if any
+    const void* blockedIn = nullptr;
+};
+
+static thread_local RunningTask* runningTasks = nullptr;
+
+//==============================================================================
+TaskScheduler::Task::Task() noexcept = default;
+
+TaskScheduler::Task::Task (Node* n) noexcept : node (n)
+{
+    if (node != nullptr)
+        node->addReference();
+}
+
+TaskScheduler::Task::Task (const Task& other) noexcept : Task (other.node) {}
+
+TaskScheduler::Task::Task (Task&& other) noexcept
+    : node (std::exchange (other.node, nullptr))
+{
+}
+
+TaskScheduler::Task& TaskScheduler::Task::operator= (const Task& other) noexcept
+{
+    Task copy (other);
+    std::swap (node, copy.node);
+    return *this;
+}
+
+TaskScheduler::Task& TaskScheduler::Task::operator= (Task&& other) noexcept
+{
+    Task moved (std::move (other));
+    std::swap (node, moved.node);
+    return *this;
+}
+
+TaskScheduler::Task::~Task()
+{
+    if (node != nullptr)
+        node->release();
+}
+
+bool TaskScheduler::Task::isFinished() const noexcept
+{
+    return node != nullptr && node->finished.load();
+}
+
+TaskScheduler::Task TaskScheduler::Task::then (Function function) const
+{
+    // You can only add a continuation to a valid task!
+    jassert (node != nullptr);
+
+    return node->group.run (std::move (function), { *this });
+}
+
+//==============================================================================
+TaskScheduler::TaskGroup::TaskGroup (TaskScheduler& s) : owner (s) {}
+
+TaskScheduler::TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+TaskScheduler::Task TaskScheduler::TaskGroup::run (Function function)
+{
+    return owner.addTask (*this, std::move (function), {});
+}
+
+TaskScheduler::Task TaskScheduler::TaskGroup::run (Function function, Span<const Task> dependencies)
+{
+    return owner.addTask (*this, std::move (function), dependencies);
+}
+
+TaskScheduler::Task TaskScheduler::TaskGroup::run (Function function, std::initializer_list<Task> dependencies)
+{
+    return owner.addTask (*this, std::move (function), Span<const Task> (dependencies.begin(), dependencies.size()));
+}
+
+void TaskScheduler::TaskGroup::wait()
+{
+    const auto isRunningOneOfOurTasks = [this]
+    {
+        for (auto* running = runningTasks; running != nullptr; running = running->outer)
+            if (running->group == this)
+                return true;
+
+        return false;
+    };
+
+    // A thread that isn't part-way through one of the group's tasks waits for all of them
+    if (! isRunningOneOfOurTasks())
+    {
+        const int numToIgnore = 0;
+        owner.waitUntilFinished (numUnfinishedTasks, numToIgnore, finishedLock, finishedEvent);
+        return;
+    }
+
+    // The group's tasks that this thread is part-way through running can't finish until
+    // this returns, so they mustn't be waited for. Tasks on other threads may be stuck
+    // waiting for the group in the same way, so the group keeps count of all of them.
+    const auto updateBlockedTasks = [this] (const void* oldCall, const void* newCall, int delta)
+    {
+        int numChanged = 0;
+
+        for (auto* running = runningTasks; running != nullptr; running = running->outer)
+        {
+            if (running->group == this && running->blockedIn == oldCall)
+            {
+                running->blockedIn = newCall;
+                ++numChanged;
+            }
+        }
+
+        const SpinLock::ScopedLockType sl (finishedLock);
+        numBlockedTasks += delta * numChanged;
+    };
+
+    const auto* thisCall = &updateBlockedTasks;
+    updateBlockedTasks (nullptr, thisCall, 1);
+    owner.waitUntilFinished (numUnfinishedTasks, numBlockedTasks, finishedLock, finishedEvent);
+    updateBlockedTasks (thisCall, nullptr, -1);
+}
+
+//==============================================================================
+class TaskScheduler::Worker final : public Thread
+{
+public:
+    Worker (TaskScheduler& s, const String& name, size_t stackSize)
+        : Thread (name, stackSize), owner (s)
+    {
+    }
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        wakeEvent.signal();
+        stopThread (-1);
+    }
+
+    void run() override
+    {
+        currentWorker = this;
+
+        while (! threadShouldExit())
+        {
+            if (owner.runNextTask (this))
+                continue;
+
+            {
+                const SpinLock::ScopedLockType sl (owner.sleepingWorkersLock);
+                owner.sleepingWorkers.push_back (this);
+                ++owner.numSleepingWorkers;
+            }
+
+            // A task may have been queued after this thread looked for one, but before
+            // it was added to the list of sleepers, in which case nobody will wake it
+            if (owner.numQueuedTasks.load() == 0 && ! threadShouldExit())
+                wakeEvent.wait (-1);
+
+            const SpinLock::ScopedLockType sl (owner.sleepingWorkersLock);
+            const auto it = std::find (owner.sleepingWorkers.begin(), owner.sleepingWorkers.end(), this);
+
+            if (it != owner.sleepingWorkers.end())
+            {
+                owner.sleepingWorkers.erase (it);
+                --owner.numSleepingWorkers;
+            }
+        }
+
+        currentWorker = nullptr;
+    }
+
+    TaskScheduler& owner;
+    SpinLock tasksLock;
+    std::deque<Task::Node*> tasks;
+    WaitableEvent wakeEvent;
+    size_t nextVictim = 0;
+
+    static thread_local Worker* currentWorker;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+thread_local TaskScheduler::Worker* TaskScheduler::Worker::currentWorker = nullptr;
+
+//==============================================================================
+TaskScheduler::TaskScheduler (ThreadPoolOptions options)
+{
+    // not much point having a scheduler without any threads!
+    jassert (options.numberOfThreads > 0);
+
+    for (int i = jmax (1, options.numberOfThreads); --i >= 0;)
+        workers.push_back (std::make_unique<Worker> (*this, options.threadName, options.threadStackSizeBytes));
+
+    for (auto& worker : workers)
+        worker->startThread (options.desiredThreadPriority);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    // The task groups should have been deleted before the scheduler, so this will
+    // only find tasks if a group is still alive on another thread
+    const int numToIgnore = 0;
+    waitUntilFinished (numUnfinishedTasks, numToIgnore, finishedLock, finishedEvent);
+    workers.clear();
+}
+
+int TaskScheduler::getNumThreads() const noexcept
+{
+    return (int) workers.size();
+}
+
+TaskScheduler::Worker* TaskScheduler::getCurrentWorker() const noexcept
+{
+    auto* worker = Worker::currentWorker;
+    return worker != nullptr && &worker->owner == this ? worker : nullptr;
+}
+
+TaskScheduler::Task TaskScheduler::addTask (TaskGroup& group, Function function, Span<const Task> dependencies)
+{
+    // A task group can only run tasks on the scheduler that it was created with
+    jassert (&group.owner == this);
+
+    auto* node = new Task::Node (group, std::move (function));
+    Task result (node);
+
+    ++group.numUnfinishedTasks;
+    ++numUnfinishedTasks;
+
+    for (const auto& dependency : dependencies)
+    {
+        if (dependency.node == nullptr)
+            continue;
+
+        const SpinLock::ScopedLockType sl (dependency.node->successorLock);
+
+        if (! dependency.node->finished.load())
+        {
+            dependency.node->successors.push_back (node);
+            ++node->numBlockers;
+        }
+    }
+
+    if (--node->numBlockers == 0)
+        schedule (node);
+
+    return result;
+}
+
+void TaskScheduler::schedule (Task::Node* node)
+{
+    // Tasks created by a worker go to the back of its own queue, where it'll find them
+    // first. Other threads' tasks are shared between all the workers.
+    if (auto* worker = getCurrentWorker())
+    {
+        const SpinLock::ScopedLockType sl (worker->tasksLock);
+        worker->tasks.push_back (node);
+    }
+    else
+    {
+        const SpinLock::ScopedLockType sl (injectedTasksLock);
+        injectedTasks.push_back (node);
+    }
+
+    ++numQueuedTasks;
+    wakeSleepingWorker();
+}
+
+void TaskScheduler::wakeSleepingWorker()
+{
+    if (numSleepingWorkers.load() == 0)
+        return;
+
+    Worker* worker = nullptr;
+
+    {
+        const SpinLock::ScopedLockType sl (sleepingWorkersLock);
+
+        if (sleepingWorkers.empty())
+            return;
+
+        worker = sleepingWorkers.back();
+        sleepingWorkers.pop_back();
+        --numSleepingWorkers;
+    }
+
+    worker->wakeEvent.signal();
+}
+
+TaskScheduler::Task::Node* TaskScheduler::findTask (Worker* worker)
+{
+    if (numQueuedTasks.load() == 0)
+        return nullptr;
+
+    const auto takeTask = [this] (SpinLock& lock, std::deque<Task::Node*>& queue, bool fromBack) -> Task::Node*
+    {
+        const SpinLock::ScopedLockType sl (lock);
+
+        if (queue.empty())
+            return nullptr;
+
+        Task::Node* node = nullptr;
+
+        if (fromBack)
+        {
+            node = queue.back();
+            queue.pop_back();
+        }
+        else
+        {
+            node = queue.front();
+            queue.pop_front();
+        }
+
+        --numQueuedTasks;
+        return node;
+    };
+
+    // The most recently added task is the most likely to still be in the cache
+    if (worker != nullptr)
+        if (auto* node = takeTask (worker->tasksLock, worker->tasks, true))
+            return node;
+
+    if (auto* node = takeTask (injectedTasksLock, injectedTasks, false))
+        return node;
+
+    // Steal the oldest task from another worker, starting at a different one each time
+    // so that the thieves don't all queue up on the first worker's lock
+    const auto numWorkers = workers.size();
+    const auto start = worker != nullptr ? worker->nextVictim++ : (size_t) 0;
+
+    for (size_t i = 0; i < numWorkers; ++i)
+    {
+        auto& victim = *workers[(start + i) % numWorkers];
+
+        if (&victim != worker)
+            if (auto* node = takeTask (victim.tasksLock, victim.tasks, false))
+                return node;
+    }
+
+    return nullptr;
+}
+
+bool TaskScheduler::runNextTask (Worker* worker)
+{
+    auto* node = findTask (worker);
+
+    if (node == nullptr)
+        return false;
+
+    // If there's more work queued, get another thread started on it
+    if (numQueuedTasks.load() > 0)
+        wakeSleepingWorker();
+
+    {
+        RunningTask running { &node->group, runningTasks };
+        const ScopedValueSetter<RunningTask*> setter (runningTasks, &running);
+        node->function();
+    }
+
+    finishTask (node);
+    return true;
+}
+
+void TaskScheduler::finishTask (Task::Node* node)
+{
+    std::vector<Task::Node*> successors;
+
+    {
+        const SpinLock::ScopedLockType sl (node->successorLock);
+        node->finished = true;
+        std::swap (successors, node->successors);
+    }
+
+    for (auto* successor : successors)
+        if (--successor->numBlockers == 0)
+            schedule (successor);
+
+    auto& group = node->group;
+
+    // Any objects captured by the function should be destroyed before anyone waiting
+    // for the group is told that it's finished
+    node->function = nullptr;
+    node->release();
+
+    const auto decrement = [] (std::atomic<int>& counter, const int& numToIgnore, SpinLock& lock, WaitableEvent& event)
+    {
+        // The lock makes sure that the waiting thread can't return and delete the event
+        // while it's still being signalled. It also guards numToIgnore, so that mustn't be
+        // read until the lock is held.
+        const SpinLock::ScopedLockType sl (lock);
+
+        if (--counter <= numToIgnore)
+            event.signal();
+    };
+
+    const int noTasks = 0;
+    decrement (group.numUnfinishedTasks, group.numBlockedTasks, group.finishedLock, group.finishedEvent);
+    decrement (numUnfinishedTasks, noTasks, finishedLock, finishedEvent);
+}
+
+void TaskScheduler::waitUntilFinished (const std::atomic<int>& counter, const int& numToIgnore, SpinLock& lock, WaitableEvent& event)
+{
+    auto* worker = getCurrentWorker();
+
+    for (;;)
+    {
+        {
+            // numToIgnore only changes, and the counter only goes down, while the lock is
+            // held, so if this check passes then it was true at that moment
+            const SpinLock::ScopedLockType sl (lock);
+
+            if (counter.load() <= numToIgnore)
+                return;
+        }
+
+        // While waiting, help to run any tasks, including those from other groups
+        if (! runNextTask (worker))
+            event.wait (5);
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TaskSchedulerTests final : public UnitTest
+{
+public:
+    TaskSchedulerTests() : UnitTest ("TaskScheduler", UnitTestCategories::threads) {}
+
+    void runTest() override
+    {
+        TaskScheduler scheduler (ThreadPoolOptions{}.withThreadName ("TaskScheduler test")
+                                                    .withNumberOfThreads (4));
+
+        beginTest ("All of a group's tasks have run when wait returns");
+        {
+            std::atomic<int> count { 0 };
+            TaskScheduler::TaskGroup group (scheduler);
+
+            for (int i = 0; i < 10000; ++i)
+                group.run ([&count] { ++count; });
+
+            group.wait();
+            expectEquals (count.load(), 10000);
+            expect (group.isFinished());
+        }
+
+        beginTest ("Tasks can add more tasks to their own group");
+        {
+            std::atomic<int> count { 0 };
+            TaskScheduler::TaskGroup group (scheduler);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                group.run ([&]
+                {
+                    for (int j = 0; j < 100; ++j)
+                        group.run ([&count] { ++count; });
+                });
+            }
+
+            group.wait();
+            expectEquals (count.load(), 10000);
+        }
+
+        beginTest ("Tasks can wait for other groups");
+        {
+            std::atomic<int> count { 0 };
+            TaskScheduler::TaskGroup outer (scheduler);
+
+            for (int i = 0; i < 16; ++i)
+            {
+                outer.run ([&]
+                {
+                    TaskScheduler::TaskGroup inner (scheduler);
+
+                    for (int j = 0; j < 100; ++j)
+                        inner.run ([&count] { ++count; });
+
+                    inner.wait();
+                    count += 1000;
+                });
+            }
+
+            outer.wait();
+            expectEquals (count.load(), 16 * 1100);
+        }
+
+        beginTest ("Tasks can wait for their own group");
+        {
+            std::atomic<int> count { 0 }, numWaitsFinished { 0 };
+            TaskScheduler::TaskGroup group (scheduler);
+
+            for (int i = 0; i < 16; ++i)
+            {
+                group.run ([&]
+                {
+                    for (int j = 0; j < 100; ++j)
+                        group.run ([&count] { ++count; });
+
+                    // This can't wait for itself, or for the other tasks that are waiting,
+                    // so it only waits for the rest
+                    group.wait();
+                    expect (count.load() >= 100);
+                    ++numWaitsFinished;
+                });
+            }
+
+            // This isn't one of the group's tasks, so it waits for all of them
+            group.wait();
+            expectEquals (count.load(), 1600);
+            expectEquals (numWaitsFinished.load(), 16);
+        }
+
+        beginTest ("Tasks don't start until their dependencies have finished");
+        {
+            TaskScheduler::TaskGroup group (scheduler);
+            std::atomic<int> numFirstFinished { 0 }, numFinishedWhenSecondStarted { -1 };
+            std::atomic<bool> continuationRanLast { false };
+
+            const auto first = [&]
+            {
+                Thread::sleep (10);
+                ++numFirstFinished;
+            };
+
+            const auto a = group.run (first);
+            const auto b = group.run (first);
+            const auto c = group.run ([&] { numFinishedWhenSecondStarted = numFirstFinished.load(); }, { a, b });
+            c.then ([&] { continuationRanLast = c.isFinished() && a.isFinished(); });
+
+            group.wait();
+            expectEquals (numFinishedWhenSecondStarted.load(), 2);
+            expect (continuationRanLast.load());
+        }
+
+        beginTest ("Finished and invalid dependencies are ignored");
+        {
+            TaskScheduler::TaskGroup group (scheduler);
+            const auto finished = group.run ([] {});
+            group.wait();
+            expect (finished.isFinished());
+
+            std::atomic<bool> ran { false };
+            group.run ([&] { ran = true; }, { finished, TaskScheduler::Task() });
+            group.wait();
+            expect (ran.load());
+        }
+
+        beginTest ("A chain of continuations runs in order");
+        {
+            TaskScheduler::TaskGroup group (scheduler);
+            std::vector<int> order;
+
+            auto task = group.run ([&] { order.push_back (0); });
+
+            for (int i = 1; i < 100; ++i)
+                task = task.then ([&order, i] { order.push_back (i); });
+
+            group.wait();
+
+            expectEquals ((int) order.size(), 100);
+
+            for (int i = 0; i < (int) order.size(); ++i)
+                expectEquals (order[(size_t) i], i);
+        }
+
+        beginTest ("A diamond of dependencies runs each task once");
+        {
+            TaskScheduler::TaskGroup group (scheduler);
+            std::atomic<int> sum { 0 }, sumSeenByLast { 0 };
+
+            const auto top = group.run ([&] { sum += 1; });
+            std::vector<TaskScheduler::Task> middle;
+
+            for (int i = 0; i < 50; ++i)
+                middle.push_back (top.then ([&] { sum += 10; }));
+
+            group.run ([&] { sumSeenByLast = sum.load(); }, middle);
+            group.wait();
+
+            expectEquals (sumSeenByLast.load(), 501);
+        }
+    }
+};
+
+static TaskSchedulerTests taskSchedulerTests;
+
+//==============================================================================
+class TaskSchedulerBenchmark final : public Benchmark
+{
+public:
+    TaskSchedulerBenchmark() : Benchmark ("TaskScheduler", UnitTestCategories::threads) {}
+
+    void runBenchmark() override
+    {
+        const auto options = ThreadPoolOptions{}.withThreadName ("Benchmark");
+        constexpr int numTasks = 1000;
+        std::atomic<int64> total { 0 };
+
+        const auto work = [&total] (int i)
+        {
+            int64 x = i;
+
+            for (int j = 0; j < 100; ++j)
+                x = (x * 31 + j) % 1000003;
+
+            total += x;
+        };
+
+        {
+            ThreadPool pool (options);
+
+            measure ("ThreadPool", [&]
+            {
+                for (int i = 0; i < numTasks; ++i)
+                    pool.addJob ([&work, i] { work (i); });
+
+                while (pool.getNumJobs() > 0)
+                    Thread::yield();
+            }, numTasks);
+        }
+
+        TaskScheduler scheduler (options);
+
+        const auto addTasks = [&] (TaskScheduler::TaskGroup& group)
+        {
+            for (int i = 0; i < numTasks; ++i)
+                group.run ([&work, i] { work (i); });
+        };
+
+        measure ("TaskScheduler, tasks added by the caller", [&]
+        {
+            TaskScheduler::TaskGroup group (scheduler);
+            addTasks (group);
+            group.wait();
+        }, numTasks);
+
+        measure ("TaskScheduler, tasks added by a task", [&]
+        {
+            TaskScheduler::TaskGroup group (scheduler);
+            group.run ([&] { addTasks (group); });
+            group.wait();
+        }, numTasks);
+
+        doNotOptimise (total.load());
+    }
+};
+
+static TaskSchedulerBenchmark taskSchedulerBenchmark;
+
+#endif
+
+} // namespace juce
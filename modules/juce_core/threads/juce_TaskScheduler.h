@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A set of threads that run large numbers of small tasks.
+
+    Unlike a ThreadPool, which keeps all of its jobs in one locked list, each of
+    the scheduler's threads has its own queue of tasks. A thread adds the tasks
+    that it creates to its own queue, and when that runs out, it steals tasks from
+    the other threads' queues. This keeps the threads from contending over a single
+    lock, so it works well for thousands of tasks that only take microseconds each.
+
+    Tasks are plain function objects, which are added to a TaskGroup. A group can
+    wait for all of its tasks to finish, and a task can be made to wait for other
+    tasks to finish before it starts, either with TaskGroup::run() or Task::then().
+
+    @code
+    TaskScheduler scheduler;
+    TaskScheduler::TaskGroup group (scheduler);
+
+    auto load = group.run ([&] { loadFile(); });
+    auto analyse = load.then ([&] { analyseFile(); });
+    group.run ([&] { drawThumbnail(); }, { load, analyse });
+
+    group.wait();
+    @endcode
+
+    @see ThreadPool
+
+    @tags{Core}
+*/
+class JUCE_API  TaskScheduler
+{
+public:
+    //==============================================================================
+    /** The largest function object that a task can hold, in bytes. */
+    static constexpr size_t maxFunctionSize = 64;
+
+    /** The type of function that a task runs.
+
+        This stores the function object inside the task, so that adding a task only
+        needs a single allocation. If a lambda captures too much to fit, you'll get a
+        compile error, and will need to capture a pointer to the data instead.
+    */
+    using Function = FixedSizeFunction<maxFunctionSize, void()>;
+
+    //==============================================================================
+    /** Creates a scheduler and starts its threads.
+
+        The options' thread name, number of threads, stack size and priority are used.
+    */
+    explicit TaskScheduler (ThreadPoolOptions options = {});
+
+    /** Destructor.
+
+        This waits for all of the tasks to finish before stopping the threads.
+    */
+    ~TaskScheduler();
+
+    /** Returns the number of threads that run the tasks. */
+    int getNumThreads() const noexcept;
+
+    //==============================================================================
+    class TaskGroup;
+
+    /**
+        A reference to a task that has been added to a TaskGroup.
+
+        This can be used to check whether the task has finished, and to make other
+        tasks wait for it. It's fine to let this go out of scope before the task runs.
+    */
+    class JUCE_API  Task
+    {
+    public:
+        /** Creates an invalid task. */
+        Task() noexcept;
+
+        /** Creates another reference to the same task. */
+        Task (const Task&) noexcept;
+
+        /** Creates another reference to the same task. */
+        Task& operator= (const Task&) noexcept;
+
+        /** Move constructor. */
+        Task (Task&&) noexcept;
+
+        /** Move assignment operator. */
+        Task& operator= (Task&&) noexcept;
+
+        /** Destructor. */
+        ~Task();
+
+        /** Returns true if this refers to a task. */
+        bool isValid() const noexcept           { return node != nullptr; }
+
+        /** Returns true if the task has finished running. */
+        bool isFinished() const noexcept;
+
+        /** Adds a task to the same group, which will run when this task has finished.
+
+            The task's group must still exist when this is called.
+        */
+        Task then (Function function) const;
+
+    private:
+        struct Node;
+        friend class TaskScheduler;
+        friend class TaskGroup;
+
+        explicit Task (Node*) noexcept;
+
+        Node* node = nullptr;
+    };
+
+    //==============================================================================
+    /**
+        A set of tasks that can be waited for together.
+
+        The group must outlive its tasks, so the destructor waits for them to finish.
+    */
+    class JUCE_API  TaskGroup
+    {
+    public:
+        /** Creates a group whose tasks will be run by the given scheduler. */
+        explicit TaskGroup (TaskScheduler& scheduler);
+
+        /** Destructor. This waits for all of the group's tasks to finish. */
+        ~TaskGroup();
+
+        /** Adds a task that will be run as soon as a thread is free. */
+        Task run (Function function);
+
+        /** Adds a task that will be run when all of the given tasks have finished.
+
+            The dependencies may belong to any group of the same scheduler, and any
+            invalid or finished tasks are ignored.
+        */
+        Task run (Function function, Span<const Task> dependencies);
+
+        /** Adds a task that will be run when all of the given tasks have finished. */
+        Task run (Function function, std::initializer_list<Task> dependencies);
+
+        /** Waits until all of the group's tasks, including any that get added while
+            waiting, have finished.
+
+            Rather than just blocking, the calling thread will help to run tasks while
+            it waits. This means that it's fine to call this from inside a task. If that
+            task belongs to this group, it can't finish until this returns, so it isn't
+            waited for. Neither are any of the group's other tasks that are themselves
+            waiting for the group; this waits for all of the rest.
+        */
+        void wait();
+
+        /** Returns true if none of the group's tasks are waiting or running. */
+        bool isFinished() const noexcept        { return numUnfinishedTasks.load() == 0; }
+
+        /** Returns the scheduler that runs this group's tasks. */
+        TaskScheduler& getScheduler() const noexcept   { return owner; }
+
+    private:
+        friend class TaskScheduler;
+
+        TaskScheduler& owner;
+        std::atomic<int> numUnfinishedTasks { 0 };
+        int numBlockedTasks = 0; // the tasks that are waiting for this group, guarded by finishedLock
+        SpinLock finishedLock;
+        WaitableEvent finishedEvent;
+
+        JUCE_DECLARE_NON_COPYABLE (TaskGroup)
+    };
+
+private:
+    //==============================================================================
+    class Worker;
+
+    Task addTask (TaskGroup&, Function, Span<const Task> dependencies);
+    void schedule (Task::Node*);
+    void finishTask (Task::Node*);
+    Task::Node* findTask (Worker*);
+    bool runNextTask (Worker*);
+    Worker* getCurrentWorker() const noexcept;
+    void wakeSleepingWorker();
+    void waitUntilFinished (const std::atomic<int>& counter, const int& numToIgnore, SpinLock&, WaitableEvent&);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    SpinLock injectedTasksLock, sleepingWorkersLock, finishedLock;
+    std::deque<Task::Node*> injectedTasks;
+    std::vector<Worker*> sleepingWorkers;
+    std::atomic<int> numQueuedTasks { 0 }, numSleepingWorkers { 0 }, numUnfinishedTasks { 0 };
+    WaitableEvent finishedEvent;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TaskScheduler)
+};
+
+} // namespace juce
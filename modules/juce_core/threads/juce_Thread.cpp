@@ -90,8 +90,22 @@ void Thread::threadEntryPoint()
     {
         jassert (getCurrentThreadId() == threadId);
 
-        if (affinityMask != 0)
+        if (realtimeOptions.has_value())
+        {
+            auto options = *realtimeOptions;
+
+            if (options.getAffinityMask() == 0)
+                options = options.withAffinityMask (affinityMask);
+
+            const auto status = applyRealtimeOptionsToCurrentThread (options);
+
+            const SpinLock::ScopedLockType sl (realtimeStatusLock);
+            realtimeStatus = status;
+        }
+        else if (affinityMask != 0)
+        {
             setCurrentThreadAffinityMask (affinityMask);
+        }
 
         try
         {
@@ -103,6 +117,11 @@ void Thread::threadEntryPoint()
         }
     }
 
+    {
+        const SpinLock::ScopedLockType sl (realtimeStatusLock);
+        realtimeStatus.reset();
+    }
+
     currentThreadHolder->value.releaseCurrentThreadStorage();
 
     // Once closeThreadHandle is called this class may be deleted by a different
@@ -279,6 +298,30 @@ bool Thread::isRealtime() const
     return realtimeOptions.has_value();
 }
 
+std::optional<Thread::RealtimeStatus> Thread::getRealtimeStatus() const
+{
+    const SpinLock::ScopedLockType sl (realtimeStatusLock);
+    return realtimeStatus;
+}
+
+// Writes to the given amount of stack below the caller's frame, so that its pages will
+// already be mapped when a realtime thread's stack grows into them
+static size_t prefaultCurrentThreadStack (size_t numBytes)
+{
+    if (numBytes == 0)
+        return 0;
+
+    auto* stack = static_cast<volatile char*> (alloca (numBytes));
+    constexpr size_t pageSize = 4096;
+
+    // Windows only commits a thread's stack one page at a time, so the pages must be
+    // touched in order, starting with the one nearest to the current frame
+    for (auto offset = numBytes; offset > 0; offset -= jmin (offset, pageSize))
+        stack[offset - 1] = 0;
+
+    return numBytes;
+}
+
 void Thread::setAffinityMask (const uint32 newAffinityMask)
 {
     affinityMask = newAffinityMask;
@@ -534,6 +577,111 @@ private:
 
 ThreadLocalValueUnitTest threadLocalValueUnitTest;
 
+//==============================================================================
+class RealtimeThreadUnitTest final : public UnitTest
+{
+public:
+    RealtimeThreadUnitTest()
+        : UnitTest ("Realtime threads", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Options can be configured");
+        {
+            const auto options = Thread::RealtimeOptions{}.withSchedulingPolicy (Thread::RealtimeOptions::SchedulingPolicy::fifo)
+                                                          .withAffinityMask (0x5)
+                                                          .withMemoryLocking (true)
+                                                          .withStackPrefaultBytes (1024);
+
+            expect (options.getSchedulingPolicy() == Thread::RealtimeOptions::SchedulingPolicy::fifo);
+            expect (options.getAffinityMask() == 0x5);
+            expect (options.getMemoryLocking());
+            expectEquals (options.getStackPrefaultBytes(), (size_t) 1024);
+
+            const Thread::RealtimeOptions defaults;
+            expect (defaults.getSchedulingPolicy() == Thread::RealtimeOptions::SchedulingPolicy::roundRobin);
+            expect (defaults.getAffinityMask() == 0);
+            expect (! defaults.getMemoryLocking());
+            expectEquals (defaults.getStackPrefaultBytes(), (size_t) 0);
+        }
+
+        beginTest ("Applying options to the current thread reports what took effect");
+        {
+            std::optional<Thread::RealtimeStatus> initialStatus, status;
+            WaitableEvent finished;
+
+            Thread::launch ([&]
+            {
+                initialStatus = Thread::applyRealtimeOptionsToCurrentThread ({});
+
+                const auto lowestCore = initialStatus->affinityMask & (~initialStatus->affinityMask + 1);
+                status = Thread::applyRealtimeOptionsToCurrentThread (Thread::RealtimeOptions{}.withAffinityMask (lowestCore)
+                                                                                               .withStackPrefaultBytes (128 * 1024));
+                finished.signal();
+            });
+
+            expect (finished.wait (10000));
+            expectEquals (initialStatus->numStackBytesPrefaulted, (size_t) 0);
+            expect (! status->memoryLocked);
+
+            // No priority or policy was requested, so the thread's scheduling is left alone
+            expect (! initialStatus->schedulingPolicy.has_value());
+            expect (! status->schedulingPolicy.has_value());
+
+           #if JUCE_LINUX
+            expect (initialStatus->affinityMask != 0);
+            expect (status->affinityMask == (initialStatus->affinityMask & (~initialStatus->affinityMask + 1)));
+            expectEquals (status->numStackBytesPrefaulted, (size_t) 128 * 1024);
+           #endif
+        }
+
+        beginTest ("Threads report their realtime status while running");
+        {
+            StatusThread normalThread;
+            expect (normalThread.startThread());
+            expect (normalThread.finished.wait (10000));
+            expect (! normalThread.statusWhileRunning.has_value());
+            normalThread.stopThread (-1);
+
+            StatusThread realtimeThread;
+
+            // The OS may not give this process permission to create realtime threads
+            if (realtimeThread.startRealtimeThread (Thread::RealtimeOptions{}.withSchedulingPolicy (Thread::RealtimeOptions::SchedulingPolicy::fifo)
+                                                                             .withStackPrefaultBytes (16 * 1024)))
+            {
+                expect (realtimeThread.finished.wait (10000));
+                expect (realtimeThread.statusWhileRunning.has_value());
+                expectEquals (realtimeThread.statusWhileRunning->numStackBytesPrefaulted, (size_t) 16 * 1024);
+
+               #if JUCE_LINUX || JUCE_BSD
+                expect (realtimeThread.statusWhileRunning->schedulingPolicy == Thread::RealtimeOptions::SchedulingPolicy::fifo);
+               #endif
+
+                realtimeThread.stopThread (-1);
+                expect (! realtimeThread.getRealtimeStatus().has_value());
+            }
+        }
+    }
+
+private:
+    struct StatusThread final : public Thread
+    {
+        StatusThread() : Thread ("Realtime status test") {}
+
+        void run() override
+        {
+            statusWhileRunning = getRealtimeStatus();
+            finished.signal();
+        }
+
+        std::optional<RealtimeStatus> statusWhileRunning;
+        WaitableEvent finished;
+    };
+};
+
+static RealtimeThreadUnitTest realtimeThreadUnitTest;
+
 #endif
 
 } // namespace juce
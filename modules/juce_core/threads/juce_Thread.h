@@ -84,7 +84,8 @@ public:
         [[nodiscard]] RealtimeOptions withPriority (int newPriority) const
         {
             jassert (isPositiveAndNotGreaterThan (newPriority, 10));
-            return withMember (*this, &RealtimeOptions::priority, juce::jlimit (0, 10, newPriority));
+            return withMember (withMember (*this, &RealtimeOptions::priority, juce::jlimit (0, 10, newPriority)),
+                               &RealtimeOptions::schedulingRequested, true);
         }
 
         /** Specify the expected amount of processing time required each time the thread wakes up.
@@ -158,6 +159,71 @@ public:
             return withPeriodMs (1'000.0 / newPeriodHz);
         }
 
+        /** The scheduling policies that a realtime thread can use. */
+        enum class SchedulingPolicy
+        {
+            roundRobin, /**< Threads with the same priority take turns to run (SCHED_RR). */
+            fifo        /**< The thread runs until it blocks or yields, even if other threads
+                             with the same priority are waiting (SCHED_FIFO). */
+        };
+
+        /** Specify the scheduling policy used by the thread.
+
+            The default is SchedulingPolicy::roundRobin.
+
+            Only used by Linux/BSD.
+
+            @see getSchedulingPolicy, withPriority
+        */
+        [[nodiscard]] RealtimeOptions withSchedulingPolicy (SchedulingPolicy newPolicy) const
+        {
+            return withMember (withMember (*this, &RealtimeOptions::schedulingPolicy, newPolicy),
+                               &RealtimeOptions::schedulingRequested, true);
+        }
+
+        /** Restricts the thread to a set of CPU cores.
+
+            Each bit of the mask enables a core, so e.g. 0x3 lets the thread run on the
+            first two cores. A value of 0 (the default) leaves the thread free to run on
+            any core, unless setAffinityMask() has been used.
+
+            @see getAffinityMask, Thread::setAffinityMask
+        */
+        [[nodiscard]] RealtimeOptions withAffinityMask (uint32 newAffinityMask) const
+        {
+            return withMember (*this, &RealtimeOptions::affinityMask, newAffinityMask);
+        }
+
+        /** If enabled, all of the process's current and future memory will be locked into
+            RAM before the thread starts running, so that it will never have to wait for
+            pages to be swapped back in.
+
+            Note that this affects the whole process. Because any allocation that takes the
+            process over its memory-lock limit would then fail, the memory will only be locked
+            if the process is running as root, or its limit (RLIMIT_MEMLOCK) is unlimited.
+
+            Only used by Linux/BSD.
+
+            @see getMemoryLocking, withStackPrefaultBytes
+        */
+        [[nodiscard]] RealtimeOptions withMemoryLocking (bool shouldLockMemory) const
+        {
+            return withMember (*this, &RealtimeOptions::memoryLocking, shouldLockMemory);
+        }
+
+        /** Specify a number of bytes of stack that the thread should write to before
+            calling run(), so that the thread doesn't page-fault later on when its stack
+            first grows to this size.
+
+            The amount will be limited to the space available on the thread's stack.
+
+            @see getStackPrefaultBytes, withMemoryLocking
+        */
+        [[nodiscard]] RealtimeOptions withStackPrefaultBytes (size_t numBytes) const
+        {
+            return withMember (*this, &RealtimeOptions::stackPrefaultBytes, numBytes);
+        }
+
         /** Returns a value with a range of 0-10, where 10 is the highest priority.
 
             @see withPriority
@@ -197,11 +263,84 @@ public:
             return periodMs;
         }
 
+        /** Returns the scheduling policy used by the thread.
+
+            @see withSchedulingPolicy
+        */
+        [[nodiscard]] SchedulingPolicy getSchedulingPolicy() const
+        {
+            return schedulingPolicy;
+        }
+
+        /** Returns the set of cores that the thread may run on, or 0 if it isn't restricted.
+
+            @see withAffinityMask
+        */
+        [[nodiscard]] uint32 getAffinityMask() const
+        {
+            return affinityMask;
+        }
+
+        /** Returns true if the process's memory should be locked before the thread starts.
+
+            @see withMemoryLocking
+        */
+        [[nodiscard]] bool getMemoryLocking() const
+        {
+            return memoryLocking;
+        }
+
+        /** Returns the number of bytes of stack that the thread will touch before calling run().
+
+            @see withStackPrefaultBytes
+        */
+        [[nodiscard]] size_t getStackPrefaultBytes() const
+        {
+            return stackPrefaultBytes;
+        }
+
     private:
+        friend class Thread;
+
         int priority { 5 };
         std::optional<double> processingTimeMs;
         std::optional<double> maximumProcessingTimeMs;
         std::optional<double> periodMs{};
+        SchedulingPolicy schedulingPolicy = SchedulingPolicy::roundRobin;
+        uint32 affinityMask = 0;
+        bool memoryLocking = false;
+        size_t stackPrefaultBytes = 0;
+
+        // True if withPriority() or withSchedulingPolicy() was used
+        bool schedulingRequested = false;
+    };
+
+    //==============================================================================
+    /** Describes the realtime settings that are actually in effect for a thread.
+
+        These can differ from the RealtimeOptions that were requested, e.g. if the OS
+        refused to lock the process's memory, or limited the thread's priority.
+
+        @see getRealtimeStatus, applyRealtimeOptionsToCurrentThread
+    */
+    struct RealtimeStatus
+    {
+        /** The thread's scheduling policy, or nullopt if it isn't using a realtime
+            policy, or the platform doesn't have one.
+        */
+        std::optional<RealtimeOptions::SchedulingPolicy> schedulingPolicy;
+
+        /** The thread's priority, as a value native to the OS. */
+        int nativePriority = 0;
+
+        /** The set of cores that the thread may run on, or 0 if this isn't known. */
+        uint32 affinityMask = 0;
+
+        /** True if the process's memory was locked into RAM. */
+        bool memoryLocked = false;
+
+        /** The number of bytes of the thread's stack that were touched before it ran. */
+        size_t numStackBytesPrefaulted = 0;
     };
 
     //==============================================================================
@@ -416,6 +555,31 @@ public:
     /** Returns true if this Thread represents a realtime thread. */
     bool isRealtime() const;
 
+    /** Returns the realtime settings that were applied when this thread was started.
+
+        This returns nullopt if the thread wasn't started with startRealtimeThread(),
+        or if it hasn't yet got as far as calling run(). It can be called from any thread.
+
+        @see RealtimeStatus, startRealtimeThread
+    */
+    std::optional<RealtimeStatus> getRealtimeStatus() const;
+
+    /** Applies some realtime options to the thread that calls this method, and returns
+        the settings that actually took effect.
+
+        This is useful for threads that weren't created by a Thread object, e.g. the
+        callback threads of audio drivers. Threads started with startRealtimeThread()
+        will already have had their options applied.
+
+        The thread's scheduling policy and priority are only changed if the options were
+        given a priority or a policy with withPriority() or withSchedulingPolicy(), so
+        that e.g. just setting an affinity won't override a priority that the driver
+        has already chosen.
+
+        @see startRealtimeThread, getRealtimeStatus
+    */
+    static RealtimeStatus JUCE_CALLTYPE applyRealtimeOptionsToCurrentThread (const RealtimeOptions& options);
+
     //==============================================================================
     /** Sets the affinity mask for the thread.
 
@@ -584,6 +748,8 @@ private:
     std::atomic<void*> threadHandle { nullptr };
     std::atomic<ThreadID> threadId { nullptr };
     std::optional<RealtimeOptions> realtimeOptions = {};
+    std::optional<RealtimeStatus> realtimeStatus;
+    mutable SpinLock realtimeStatusLock;
     CriticalSection startStopLock;
     WaitableEvent startSuspensionEvent, defaultEvent;
     size_t threadStackSize;
@@ -145,6 +145,9 @@ void ThreadPool::addJob (ThreadPoolJob* job, bool deleteJobWhenFinished)
         {
             const ScopedLock sl (lock);
             jobs.add (job);
+
+            JUCE_TRACE_FLOW_BEGIN ("threads", "ThreadPoolJob", (pointer_sized_int) job);
+            JUCE_TRACE_COUNTER ("threads", "ThreadPool jobs", jobs.size());
         }
 
         for (auto* t : threads)
@@ -374,6 +377,8 @@ bool ThreadPool::runNextJob (ThreadPoolThread& thread)
 
         try
         {
+            JUCE_TRACE_SCOPE ("threads", "ThreadPoolJob::runJob");
+            JUCE_TRACE_FLOW_END ("threads", "ThreadPoolJob", (pointer_sized_int) job);
             result = job->runJob();
         }
         catch (...)
@@ -0,0 +1,741 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_TRACING
+
+namespace juce
+{
+
+namespace TracingHelpers
+{
+    struct Event
+    {
+        int64 ticks;
+        const char* category;
+        const char* name;
+        double value;
+        uint64 id;
+        Tracer::EventType type;
+    };
+
+    struct ThreadEvents
+    {
+        int index;
+        String name;
+        std::vector<Event> events;
+    };
+
+    // A thread may still record events after its buffer has been released, so this
+    // is set when that happens
+    static thread_local bool threadHasFinished = false;
+}
+
+//==============================================================================
+struct Tracer::ThreadBuffer
+{
+    ThreadBuffer (int capacity, int threadIndex, const String& threadName)
+        : fifo (capacity), events ((size_t) capacity), index (threadIndex), name (threadName)
+    {}
+
+    // Called only by the thread that owns the buffer
+    void push (const TracingHelpers::Event& event) noexcept
+    {
+        const auto writer = fifo.write (1);
+
+        if (writer.blockSize1 == 0)
+        {
+            ++numDropped;
+            return;
+        }
+
+        events[(size_t) writer.startIndex1] = event;
+    }
+
+    // Called with the State's lock held
+    void collect()
+    {
+        fifo.read (fifo.getNumReady()).forEach ([this] (int i) { collected.push_back (events[(size_t) i]); });
+    }
+
+    AbstractFifo fifo;
+    std::vector<TracingHelpers::Event> events, collected;
+    std::atomic<int> numDropped { 0 };
+    const int index;
+    String name;
+};
+
+//==============================================================================
+struct Tracer::State  : private Thread
+{
+    State() : Thread ("JUCE Tracer") {}
+    ~State() override   { stopThread (1000); }
+
+    void startCollecting()  { startThread (Priority::low); }
+    void stopCollecting()   { stopThread (1000); collect(); }
+
+    void collect()
+    {
+        const ScopedLock sl (lock);
+
+        for (auto& buffer : buffers)
+            buffer->collect();
+    }
+
+    // Returns nullptr once the current thread's buffer has been released
+    ThreadBuffer* getBufferForCurrentThread()
+    {
+        struct BufferForThread
+        {
+            ~BufferForThread()
+            {
+                TracingHelpers::threadHasFinished = true;
+
+                if (buffer != nullptr)
+                    state->releaseBuffer (buffer);
+            }
+
+            State* state = nullptr;
+            ThreadBuffer* buffer = nullptr;
+        };
+
+        if (TracingHelpers::threadHasFinished)
+            return nullptr;
+
+        thread_local BufferForThread bufferForThisThread;
+
+        if (bufferForThisThread.buffer == nullptr)
+        {
+            const ScopedLock sl (lock);
+
+            const auto index = nextThreadIndex++;
+            auto* thread = Thread::getCurrentThread();
+            const auto name = thread != nullptr ? thread->getThreadName() : "Thread " + String (index);
+
+            buffers.push_back (std::make_unique<ThreadBuffer> (numEventsPerThread.load(), index, name));
+            bufferForThisThread.state = this;
+            bufferForThisThread.buffer = buffers.back().get();
+        }
+
+        return bufferForThisThread.buffer;
+    }
+
+    // Called when a thread finishes. Its events are kept, but its buffer is freed.
+    void releaseBuffer (ThreadBuffer* buffer)
+    {
+        const ScopedLock sl (lock);
+
+        buffer->collect();
+
+        if (! buffer->collected.empty())
+            finishedThreads.push_back ({ buffer->index, buffer->name, std::move (buffer->collected) });
+
+        numDroppedByFinishedThreads += buffer->numDropped.load();
+
+        buffers.erase (std::find_if (buffers.begin(), buffers.end(), [buffer] (const auto& b) { return b.get() == buffer; }));
+    }
+
+    std::vector<TracingHelpers::ThreadEvents> getAllEvents()
+    {
+        collect();
+
+        const ScopedLock sl (lock);
+        auto result = finishedThreads;
+
+        for (auto& buffer : buffers)
+            if (! buffer->collected.empty())
+                result.push_back ({ buffer->index, buffer->name, buffer->collected });
+
+        std::sort (result.begin(), result.end(), [] (const auto& a, const auto& b) { return a.index < b.index; });
+        return result;
+    }
+
+    std::atomic<bool> recording { false };
+    std::atomic<int> numEventsPerThread { 16384 };
+    std::atomic<uint64> nextFlowId { 1 };
+    std::atomic<int64> startTicks { 0 };
+
+    CriticalSection lock;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::vector<TracingHelpers::ThreadEvents> finishedThreads;
+    int numDroppedByFinishedThreads = 0;
+    int nextThreadIndex = 1;
+
+private:
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            collect();
+            wait (50);
+        }
+    }
+};
+
+Tracer::State& Tracer::getState()
+{
+    static State state;
+    return state;
+}
+
+//==============================================================================
+void Tracer::start (int numEventsPerThread)
+{
+    jassert (numEventsPerThread > 1);
+
+    auto& state = getState();
+    stop();
+    clear();
+
+    state.numEventsPerThread = numEventsPerThread;
+    state.startTicks = Time::getHighResolutionTicks();
+    state.recording = true;
+    state.startCollecting();
+}
+
+void Tracer::stop()
+{
+    auto& state = getState();
+
+    if (state.recording.exchange (false))
+        state.stopCollecting();
+}
+
+bool Tracer::isRecording() noexcept
+{
+    return getState().recording.load (std::memory_order_relaxed);
+}
+
+void Tracer::clear()
+{
+    auto& state = getState();
+    state.collect();
+
+    const ScopedLock sl (state.lock);
+
+    state.finishedThreads = {};
+    state.numDroppedByFinishedThreads = 0;
+
+    for (auto& buffer : state.buffers)
+    {
+        buffer->collected = {};
+        buffer->numDropped = 0;
+    }
+}
+
+int Tracer::getNumDroppedEvents() noexcept
+{
+    auto& state = getState();
+    const ScopedLock sl (state.lock);
+
+    auto total = state.numDroppedByFinishedThreads;
+
+    for (auto& buffer : state.buffers)
+        total += buffer->numDropped.load();
+
+    return total;
+}
+
+void Tracer::setCurrentThreadName (const String& name)
+{
+    auto& state = getState();
+
+    if (auto* buffer = state.getBufferForCurrentThread())
+    {
+        const ScopedLock sl (state.lock);
+        buffer->name = name;
+    }
+}
+
+uint64 Tracer::getNextFlowId() noexcept
+{
+    return getState().nextFlowId++;
+}
+
+void Tracer::record (EventType type, const char* category, const char* name, double value, uint64 id) noexcept
+{
+    auto& state = getState();
+
+    // Ends are always recorded, so that scopes that were open when recording
+    // stopped are still closed
+    if (! state.recording.load (std::memory_order_relaxed) && type != EventType::end)
+        return;
+
+    if (auto* buffer = state.getBufferForCurrentThread())
+        buffer->push ({ Time::getHighResolutionTicks(), category, name, value, id, type });
+}
+
+//==============================================================================
+namespace TracingHelpers
+{
+    static constexpr int processId = 1;
+
+    static String quoted (const char* text)
+    {
+        return "\"" + JSON::escapeString (text != nullptr ? text : "") + "\"";
+    }
+
+    static void writeChromeJson (OutputStream& out, const std::vector<ThreadEvents>& threads, int64 startTicks)
+    {
+        const auto ticksPerMicrosecond = (double) Time::getHighResolutionTicksPerSecond() / 1.0e6;
+        auto isFirstEvent = true;
+
+        const auto writeEvent = [&] (const String& json)
+        {
+            out << (isFirstEvent ? "\n" : ",\n") << json;
+            isFirstEvent = false;
+        };
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        writeEvent ("{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" + String (processId)
+                      + ",\"args\":{\"name\":" + quoted (File::getSpecialLocation (File::currentExecutableFile).getFileNameWithoutExtension().toRawUTF8()) + "}}");
+
+        for (const auto& thread : threads)
+        {
+            const auto ids = ",\"pid\":" + String (processId) + ",\"tid\":" + String (thread.index);
+
+            writeEvent ("{\"ph\":\"M\",\"name\":\"thread_name\"" + ids
+                          + ",\"args\":{\"name\":\"" + JSON::escapeString (thread.name) + "\"}}");
+
+            for (const auto& event : thread.events)
+            {
+                const auto ts = ",\"ts\":" + String ((double) (event.ticks - startTicks) / ticksPerMicrosecond, 3);
+                const auto names = ",\"name\":" + quoted (event.name) + ",\"cat\":" + quoted (event.category);
+
+                switch (event.type)
+                {
+                    case Tracer::EventType::begin:
+                        writeEvent ("{\"ph\":\"B\"" + names + ts + ids + "}");
+                        break;
+
+                    case Tracer::EventType::end:
+                        writeEvent ("{\"ph\":\"E\"" + ts + ids + "}");
+                        break;
+
+                    case Tracer::EventType::instant:
+                        writeEvent ("{\"ph\":\"i\",\"s\":\"t\"" + names + ts + ids + "}");
+                        break;
+
+                    case Tracer::EventType::counter:
+                        writeEvent ("{\"ph\":\"C\"" + names + ts + ids + ",\"args\":{\"value\":" + String (event.value) + "}}");
+                        break;
+
+                    case Tracer::EventType::flowBegin:
+                    case Tracer::EventType::flowStep:
+                    case Tracer::EventType::flowEnd:
+                    {
+                        // Flow events have to be attached to a slice, so each one gets an
+                        // empty slice of its own
+                        const auto phase = event.type == Tracer::EventType::flowBegin ? "s"
+                                         : event.type == Tracer::EventType::flowStep  ? "t"
+                                                                                      : "f";
+
+                        writeEvent ("{\"ph\":\"X\",\"dur\":0" + names + ts + ids + "}");
+                        writeEvent ("{\"ph\":\"" + String (phase) + "\",\"bp\":\"e\",\"id\":" + String (event.id)
+                                      + names + ts + ids + "}");
+                        break;
+                    }
+                }
+            }
+        }
+
+        out << "\n]}\n";
+    }
+
+    //==============================================================================
+    // Just enough of the protobuf wire format to write Perfetto's trace packets
+    struct ProtoWriter
+    {
+        enum WireType { varint = 0, fixed64 = 1, lengthDelimited = 2 };
+
+        void writeVarint (uint64 value)
+        {
+            while (value >= 0x80)
+            {
+                out.writeByte ((char) ((value & 0x7f) | 0x80));
+                value >>= 7;
+            }
+
+            out.writeByte ((char) value);
+        }
+
+        void writeTag (int field, WireType wireType)                { writeVarint ((uint64) ((field << 3) | wireType)); }
+        void writeUInt (int field, uint64 value)                    { writeTag (field, varint); writeVarint (value); }
+        void writeFixed64 (int field, uint64 value)                 { writeTag (field, fixed64); out.writeInt64 ((int64) value); }
+
+        void writeDouble (int field, double value)
+        {
+            uint64 bits;
+            static_assert (sizeof (bits) == sizeof (value));
+            memcpy (&bits, &value, sizeof (bits));
+            writeFixed64 (field, bits);
+        }
+
+        void writeString (int field, const String& text)
+        {
+            writeTag (field, lengthDelimited);
+            writeVarint ((uint64) text.getNumBytesAsUTF8());
+            out.write (text.toRawUTF8(), text.getNumBytesAsUTF8());
+        }
+
+        void writeMessage (int field, const ProtoWriter& message)
+        {
+            writeTag (field, lengthDelimited);
+            writeVarint ((uint64) message.out.getDataSize());
+            out.write (message.out.getData(), message.out.getDataSize());
+        }
+
+        MemoryOutputStream out;
+    };
+
+    // Field numbers from Perfetto's protos/perfetto/trace/trace_packet.proto and friends
+    namespace Perfetto
+    {
+        enum TraceField         { packet = 1 };
+        enum PacketField        { timestamp = 8, trustedPacketSequenceId = 10, trackEvent = 11, sequenceFlags = 13, trackDescriptor = 60 };
+        enum DescriptorField    { uuid = 1, name = 2, process = 3, thread = 4, parentUuid = 5, counter = 8 };
+        enum ProcessField       { processPid = 1 };
+        enum ThreadField        { threadPid = 1, threadTid = 2, threadName = 5 };
+        enum EventField         { type = 9, trackUuid = 11, categories = 22, eventName = 23, doubleCounterValue = 44, flowIds = 47, terminatingFlowIds = 48 };
+        enum EventType          { sliceBegin = 1, sliceEnd = 2, instant = 3, counterValue = 4 };
+        enum SequenceFlags      { incrementalStateCleared = 1, needsIncrementalState = 2 };
+    }
+
+    static void writePerfettoProtobuf (OutputStream& out, const std::vector<ThreadEvents>& threads, int64 startTicks)
+    {
+        using namespace Perfetto;
+
+        const auto ticksPerNanosecond = (double) Time::getHighResolutionTicksPerSecond() / 1.0e9;
+        constexpr uint64 processUuid = 1;
+
+        const auto writePacket = [&out] (const ProtoWriter& packetData)
+        {
+            ProtoWriter trace;
+            trace.writeMessage (packet, packetData);
+            out.write (trace.out.getData(), trace.out.getDataSize());
+        };
+
+        {
+            ProtoWriter processDescriptor, descriptor, packetData;
+            processDescriptor.writeUInt (processPid, (uint64) processId);
+            descriptor.writeUInt (uuid, processUuid);
+            descriptor.writeMessage (process, processDescriptor);
+            packetData.writeMessage (trackDescriptor, descriptor);
+            writePacket (packetData);
+        }
+
+        // Each counter gets a track of its own, which we identify by the address of its name
+        std::map<const char*, uint64> counterTracks;
+
+        for (const auto& thread : threads)
+        {
+            const auto sequenceId = (uint64) thread.index;
+            const auto threadUuid = processUuid + sequenceId;
+
+            {
+                ProtoWriter threadDescriptor, descriptor, packetData;
+                threadDescriptor.writeUInt (threadPid, (uint64) processId);
+                threadDescriptor.writeUInt (threadTid, (uint64) thread.index);
+                threadDescriptor.writeString (threadName, thread.name);
+
+                descriptor.writeUInt (uuid, threadUuid);
+                descriptor.writeMessage (Perfetto::thread, threadDescriptor);
+
+                packetData.writeMessage (trackDescriptor, descriptor);
+                packetData.writeUInt (trustedPacketSequenceId, sequenceId);
+                packetData.writeUInt (sequenceFlags, incrementalStateCleared);
+                writePacket (packetData);
+            }
+
+            for (const auto& event : thread.events)
+            {
+                auto track = threadUuid;
+
+                if (event.type == Tracer::EventType::counter)
+                {
+                    auto [iter, isNew] = counterTracks.emplace (event.name, (uint64) (1u << 16) + counterTracks.size());
+
+                    if (isNew)
+                    {
+                        ProtoWriter descriptor, packetData;
+                        descriptor.writeUInt (uuid, iter->second);
+                        descriptor.writeUInt (parentUuid, processUuid);
+                        descriptor.writeString (name, event.name);
+                        descriptor.writeMessage (counter, {});
+                        packetData.writeMessage (trackDescriptor, descriptor);
+                        writePacket (packetData);
+                    }
+
+                    track = iter->second;
+                }
+
+                ProtoWriter trackEventData, packetData;
+
+                switch (event.type)
+                {
+                    case Tracer::EventType::begin:      trackEventData.writeUInt (type, sliceBegin);   break;
+                    case Tracer::EventType::end:        trackEventData.writeUInt (type, sliceEnd);     break;
+                    case Tracer::EventType::counter:    trackEventData.writeUInt (type, counterValue); break;
+
+                    case Tracer::EventType::instant:
+                    case Tracer::EventType::flowBegin:
+                    case Tracer::EventType::flowStep:
+                    case Tracer::EventType::flowEnd:    trackEventData.writeUInt (type, instant);      break;
+                }
+
+                trackEventData.writeUInt (trackUuid, track);
+
+                if (event.category != nullptr)
+                    trackEventData.writeString (categories, event.category);
+
+                if (event.name != nullptr && event.type != Tracer::EventType::counter)
+                    trackEventData.writeString (eventName, event.name);
+
+                if (event.type == Tracer::EventType::counter)
+                    trackEventData.writeDouble (doubleCounterValue, event.value);
+                else if (event.type == Tracer::EventType::flowBegin || event.type == Tracer::EventType::flowStep)
+                    trackEventData.writeFixed64 (flowIds, event.id);
+                else if (event.type == Tracer::EventType::flowEnd)
+                    trackEventData.writeFixed64 (terminatingFlowIds, event.id);
+
+                packetData.writeUInt (timestamp, (uint64) jmax (0.0, (double) (event.ticks - startTicks) / ticksPerNanosecond));
+                packetData.writeMessage (trackEvent, trackEventData);
+                packetData.writeUInt (trustedPacketSequenceId, sequenceId);
+                packetData.writeUInt (sequenceFlags, needsIncrementalState);
+                writePacket (packetData);
+            }
+        }
+    }
+}
+
+void Tracer::writeTo (OutputStream& output, Format format)
+{
+    auto& state = getState();
+    const auto threads = state.getAllEvents();
+
+    if (format == Format::chromeJson)
+        TracingHelpers::writeChromeJson (output, threads, state.startTicks);
+    else
+        TracingHelpers::writePerfettoProtobuf (output, threads, state.startTicks);
+
+    output.flush();
+}
+
+bool Tracer::writeToFile (const File& file, Format format)
+{
+    FileOutputStream out (file);
+
+    if (! out.openedOk())
+        return false;
+
+    out.setPosition (0);
+    out.truncate();
+
+    writeTo (out, format);
+    return out.getStatus().wasOk();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TracerTests  : public UnitTest
+{
+public:
+    TracerTests()
+        : UnitTest ("Tracer", UnitTestCategories::time)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Events from different threads are written as Chrome JSON");
+        {
+            recordSomeEvents();
+
+            MemoryOutputStream out;
+            Tracer::writeTo (out, Tracer::Format::chromeJson);
+
+            const auto parsed = JSON::parse (out.toString());
+            const auto* events = parsed["traceEvents"].getArray();
+            expect (events != nullptr);
+
+            if (events == nullptr)
+                return;
+
+            const auto countEvents = [&] (const String& phase, const String& eventName)
+            {
+                return (int) std::count_if (events->begin(), events->end(), [&] (const var& event)
+                {
+                    return event["ph"] == phase && event["name"] == eventName;
+                });
+            };
+
+            expectEquals (countEvents ("B", "outer"), 2);
+            expectEquals (countEvents ("B", "inner"), 2);
+            expectEquals (countEvents ("C", "counter"), 2);
+            expectEquals (countEvents ("s", "flow"), 1);
+            expectEquals (countEvents ("f", "flow"), 1);
+            expectEquals (countEvents ("i", "instant"), 0);
+
+            const auto hasThreadName = std::any_of (events->begin(), events->end(), [] (const var& event)
+            {
+                return event["ph"] == "M" && event["args"]["name"] == "Tracer test thread";
+            });
+
+            expect (hasThreadName);
+        }
+
+        beginTest ("Events are written as Perfetto protobuf");
+        {
+            recordSomeEvents();
+
+            MemoryOutputStream out;
+            Tracer::writeTo (out, Tracer::Format::perfettoProtobuf);
+
+            // The trace should be a sequence of length-delimited packets in field 1
+            MemoryInputStream in (out.getData(), out.getDataSize(), false);
+            int numPackets = 0;
+            bool isValid = true;
+
+            while (! in.isExhausted() && isValid)
+            {
+                isValid = readVarint (in) == ((1 << 3) | 2);
+                const auto length = (int64) readVarint (in);
+                isValid = isValid && length > 0 && in.getPosition() + length <= in.getTotalLength();
+                in.skipNextBytes (length);
+                ++numPackets;
+            }
+
+            expect (isValid);
+
+            // At least a process, two threads with their descriptors and events, and a counter track
+            expectGreaterOrEqual (numPackets, 1 + 2 * (1 + 6) + 1);
+
+            // The protobuf isn't text, so search its bytes for the thread's name
+            const auto* data = static_cast<const char*> (out.getData());
+            const String threadName ("Tracer test thread");
+            const auto* nameStart = threadName.toRawUTF8();
+
+            expect (std::search (data, data + out.getDataSize(), nameStart, nameStart + threadName.getNumBytesAsUTF8()) != data + out.getDataSize());
+        }
+
+        beginTest ("Clearing discards the events of threads that have finished");
+        {
+            recordSomeEvents();
+            Tracer::clear();
+
+            MemoryOutputStream out;
+            Tracer::writeTo (out, Tracer::Format::chromeJson);
+            expect (! out.toString().contains ("outer"));
+        }
+
+        beginTest ("Nothing is recorded while stopped");
+        {
+            Tracer::start();
+            Tracer::stop();
+
+            JUCE_TRACE_INSTANT ("test", "instant");
+
+            MemoryOutputStream out;
+            Tracer::writeTo (out, Tracer::Format::chromeJson);
+            expect (! out.toString().contains ("instant"));
+        }
+
+        beginTest ("Events are dropped when a thread's buffer is full");
+        {
+            Tracer::start (8);
+
+            std::thread ([]
+            {
+                for (int i = 0; i < 100; ++i)
+                    JUCE_TRACE_INSTANT ("test", "instant");
+            }).join();
+
+            Tracer::stop();
+            expectGreaterThan (Tracer::getNumDroppedEvents(), 0);
+        }
+    }
+
+private:
+    static void recordSomeEvents()
+    {
+        Tracer::start();
+
+        const auto flow = Tracer::getNextFlowId();
+
+        const auto work = [flow] (bool isFirst)
+        {
+            JUCE_TRACE_SCOPE ("test", "outer");
+            JUCE_TRACE_COUNTER ("test", "counter", isFirst ? 1 : 2);
+
+            if (isFirst)
+            {
+                JUCE_TRACE_FLOW_BEGIN ("test", "flow", flow);
+            }
+            else
+            {
+                JUCE_TRACE_FLOW_END ("test", "flow", flow);
+            }
+
+            JUCE_TRACE_SCOPE ("test", "inner");
+            Thread::sleep (1);
+        };
+
+        WaitableEvent finished;
+
+        Thread::launch ([&]
+        {
+            Tracer::setCurrentThreadName ("Tracer test thread");
+            work (true);
+            finished.signal();
+        });
+
+        std::thread ([&] { work (false); }).join();
+        finished.wait();
+
+        Tracer::stop();
+    }
+
+    static uint64 readVarint (InputStream& in)
+    {
+        uint64 result = 0;
+
+        for (int shift = 0; shift < 64 && ! in.isExhausted(); shift += 7)
+        {
+            const auto byte = (uint8) in.readByte();
+            result |= (uint64) (byte & 0x7f) << shift;
+
+            if ((byte & 0x80) == 0)
+                break;
+        }
+
+        return result;
+    }
+};
+
+static TracerTests tracerTests;
+
+#endif
+
+} // namespace juce
+
+#endif
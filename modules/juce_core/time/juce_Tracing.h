@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_TRACING
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Records a timeline of events from all of the threads in the app, which can be
+    viewed in chrome://tracing or https://ui.perfetto.dev.
+
+    You don't normally use this class directly to record events. Instead, use the
+    JUCE_TRACE_SCOPE, JUCE_TRACE_COUNTER and JUCE_TRACE_FLOW macros, which compile to
+    nothing unless JUCE_ENABLE_TRACING is turned on. JUCE's message loop, timers,
+    thread pools, component painting and AudioProcessorGraph rendering already
+    use them.
+
+    @code
+    Tracer::start();
+
+    // ... do some work ...
+
+    Tracer::stop();
+    Tracer::writeToFile (File ("~/trace.json"), Tracer::Format::chromeJson);
+    @endcode
+
+    Each thread writes its events into its own lock-free ring buffer, so recording
+    an event never blocks, allocates or makes a system call. This means it's safe
+    to do on the audio thread. The only exception is the first event on each thread,
+    which allocates that thread's buffer. A background thread collects the events
+    from the buffers while recording. If a thread's buffer fills up before they're
+    collected, further events from the thread are dropped. When a thread finishes,
+    its buffer is freed, but the events that it recorded are kept until clear() is
+    called.
+
+    Event names and categories aren't copied, so they must be string literals, or
+    some other strings that will outlive the trace.
+
+    @tags{Core}
+*/
+class JUCE_API  Tracer
+{
+public:
+    //==============================================================================
+    /** The file formats that a trace can be written in. */
+    enum class Format
+    {
+        chromeJson,         /**< The JSON trace event format, which chrome://tracing and Perfetto can read. */
+        perfettoProtobuf    /**< Perfetto's native protobuf format, which is much more compact. */
+    };
+
+    /** Starts recording events.
+
+        The first time a thread records an event, a buffer is allocated for it which
+        can hold the given number of events. Each event takes around 40 bytes.
+    */
+    static void start (int numEventsPerThread = 16384);
+
+    /** Stops recording events.
+
+        The events that were recorded are kept until clear() or start() is called.
+    */
+    static void stop();
+
+    /** Returns true if events are being recorded. */
+    static bool isRecording() noexcept;
+
+    /** Discards all of the events that have been recorded. */
+    static void clear();
+
+    /** Writes the events that have been recorded to a stream. */
+    static void writeTo (OutputStream& output, Format format);
+
+    /** Writes the events that have been recorded to a file, replacing its contents.
+        Returns false if the file couldn't be written.
+    */
+    static bool writeToFile (const File& file, Format format);
+
+    /** Returns the number of events that were dropped because a thread's buffer was full. */
+    static int getNumDroppedEvents() noexcept;
+
+    //==============================================================================
+    /** Sets the name that the current thread is shown with in the trace.
+
+        By default, juce::Thread objects use their own names, and other threads are
+        numbered.
+    */
+    static void setCurrentThreadName (const String& name);
+
+    /** Returns a new ID for a flow event. */
+    static uint64 getNextFlowId() noexcept;
+
+    //==============================================================================
+    /** @internal */
+    enum class EventType : uint8
+    {
+        begin, end, instant, counter, flowBegin, flowStep, flowEnd
+    };
+
+    /** @internal */
+    static void record (EventType type, const char* category, const char* name, double value = 0.0, uint64 id = 0) noexcept;
+
+    /** @internal */
+    class ScopedEvent
+    {
+    public:
+        ScopedEvent (const char* eventCategory, const char* eventName) noexcept
+            : isActive (isRecording())
+        {
+            if (isActive)
+                record (EventType::begin, eventCategory, eventName);
+        }
+
+        ~ScopedEvent() noexcept
+        {
+            if (isActive)
+                record (EventType::end, nullptr, nullptr);
+        }
+
+    private:
+        const bool isActive;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedEvent)
+        JUCE_PREVENT_HEAP_ALLOCATION
+    };
+
+private:
+    struct ThreadBuffer;
+    struct State;
+
+    static State& getState();
+};
+
+} // namespace juce
+
+//==============================================================================
+/** Records the time spent between this point and the end of the current scope.
+
+    The category and name must be string literals.
+*/
+#define JUCE_TRACE_SCOPE(category, name) \
+    const juce::Tracer::ScopedEvent JUCE_JOIN_MACRO (juceTraceScope_, __LINE__) (category, name)
+
+/** Records a single point in time. */
+#define JUCE_TRACE_INSTANT(category, name) \
+    JUCE_BLOCK_WITH_FORCED_SEMICOLON (juce::Tracer::record (juce::Tracer::EventType::instant, category, name);)
+
+/** Records the value of a counter, which is shown as a graph. */
+#define JUCE_TRACE_COUNTER(category, name, value) \
+    JUCE_BLOCK_WITH_FORCED_SEMICOLON (juce::Tracer::record (juce::Tracer::EventType::counter, category, name, (double) (value));)
+
+/** Starts a flow, which draws an arrow between events that are related, even if
+    they happen on different threads. The id should come from Tracer::getNextFlowId(),
+    or be some other unique number, such as the address of an object.
+*/
+#define JUCE_TRACE_FLOW_BEGIN(category, name, id) \
+    JUCE_BLOCK_WITH_FORCED_SEMICOLON (juce::Tracer::record (juce::Tracer::EventType::flowBegin, category, name, 0.0, (juce::uint64) (id));)
+
+/** Adds a step to a flow that was started with JUCE_TRACE_FLOW_BEGIN. */
+#define JUCE_TRACE_FLOW_STEP(category, name, id) \
+    JUCE_BLOCK_WITH_FORCED_SEMICOLON (juce::Tracer::record (juce::Tracer::EventType::flowStep, category, name, 0.0, (juce::uint64) (id));)
+
+/** Ends a flow that was started with JUCE_TRACE_FLOW_BEGIN. */
+#define JUCE_TRACE_FLOW_END(category, name, id) \
+    JUCE_BLOCK_WITH_FORCED_SEMICOLON (juce::Tracer::record (juce::Tracer::EventType::flowEnd, category, name, 0.0, (juce::uint64) (id));)
+
+#else
+
+#define JUCE_TRACE_SCOPE(category, name)
+#define JUCE_TRACE_INSTANT(category, name)
+#define JUCE_TRACE_COUNTER(category, name, value)
+#define JUCE_TRACE_FLOW_BEGIN(category, name, id)
+#define JUCE_TRACE_FLOW_STEP(category, name, id)
+#define JUCE_TRACE_FLOW_END(category, name, id)
+
+#endif
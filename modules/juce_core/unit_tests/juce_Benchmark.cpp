@@ -0,0 +1,497 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+Benchmark::Benchmark (const String& nm, const String& ctg)
+    : name (nm), category (ctg)
+{
+    getAllBenchmarks().add (this);
+}
+
+Benchmark::~Benchmark()
+{
+    getAllBenchmarks().removeFirstMatchingValue (this);
+}
+
+Array<Benchmark*>& Benchmark::getAllBenchmarks()
+{
+    static Array<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+Array<Benchmark*> Benchmark::getBenchmarksInCategory (const String& category)
+{
+    if (category.isEmpty())
+        return getAllBenchmarks();
+
+    Array<Benchmark*> benchmarks;
+
+    for (auto* b : getAllBenchmarks())
+        if (b->getCategory() == category)
+            benchmarks.add (b);
+
+    return benchmarks;
+}
+
+StringArray Benchmark::getAllCategories()
+{
+    StringArray categories;
+
+    for (auto* b : getAllBenchmarks())
+        if (b->getCategory().isNotEmpty())
+            categories.addIfNotAlreadyThere (b->getCategory());
+
+    return categories;
+}
+
+void Benchmark::initialise()  {}
+void Benchmark::shutdown()    {}
+
+void Benchmark::performBenchmark (BenchmarkRunner* const newRunner)
+{
+    jassert (newRunner != nullptr);
+    runner = newRunner;
+
+    initialise();
+    runBenchmark();
+    shutdown();
+
+    runner = nullptr;
+}
+
+void Benchmark::logMessage (const String& message)
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    runner->logMessage (message);
+}
+
+int64 Benchmark::getCPUCycleCount() noexcept
+{
+   #if JUCE_INTEL && JUCE_MSVC
+    return (int64) __rdtsc();
+   #elif JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+    return (int64) __builtin_ia32_rdtsc();
+   #else
+    return 0;
+   #endif
+}
+
+bool Benchmark::isCPUCycleCounterAvailable() noexcept
+{
+   #if JUCE_INTEL && (JUCE_MSVC || JUCE_GCC || JUCE_CLANG)
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+//==============================================================================
+namespace BenchmarkHelpers
+{
+    static double getMedian (std::vector<double> values)
+    {
+        if (values.empty())
+            return 0.0;
+
+        std::sort (values.begin(), values.end());
+        const auto middle = values.size() / 2;
+
+        return (values.size() & 1) != 0 ? values[middle]
+                                        : (values[middle - 1] + values[middle]) * 0.5;
+    }
+
+    static String formatNanoseconds (double ns)
+    {
+        if (ns >= 1.0e9)  return String (ns * 1.0e-9, 3) + " s";
+        if (ns >= 1.0e6)  return String (ns * 1.0e-6, 3) + " ms";
+        if (ns >= 1.0e3)  return String (ns * 1.0e-3, 3) + " us";
+
+        return String (ns, 2) + " ns";
+    }
+
+    static String formatRate (double itemsPerSecond)
+    {
+        if (itemsPerSecond >= 1.0e9)  return String (itemsPerSecond * 1.0e-9, 2) + " G";
+        if (itemsPerSecond >= 1.0e6)  return String (itemsPerSecond * 1.0e-6, 2) + " M";
+        if (itemsPerSecond >= 1.0e3)  return String (itemsPerSecond * 1.0e-3, 2) + " k";
+
+        return String (itemsPerSecond, 2) + " ";
+    }
+
+    static String escapeCSV (const String& text)
+    {
+        if (! text.containsAnyOf (",\"\r\n"))
+            return text;
+
+        return text.replace ("\"", "\"\"").quoted();
+    }
+}
+
+double Benchmark::measureBatches (const String& caseName, const std::function<void (int64)>& runBatch, int64 numItemsPerCall)
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    const auto& options = runner->getOptions();
+    const auto ticksPerSecond = (double) Time::getHighResolutionTicksPerSecond();
+    const auto minSampleSeconds = jmax (1.0e-6, options.minimumSampleTime.inSeconds());
+    const auto warmUpEnd = Time::getMillisecondCounterHiRes() + options.warmUpTime.inMilliseconds();
+
+    // Run the function until the warm-up time has passed, scaling up the number of
+    // calls in each batch until a batch takes at least the minimum sample time
+    int64 numCalls = 1;
+
+    for (;;)
+    {
+        const auto start = Time::getHighResolutionTicks();
+        runBatch (numCalls);
+        const auto seconds = (double) (Time::getHighResolutionTicks() - start) / ticksPerSecond;
+
+        if (runner->shouldAbortBenchmarks())
+            return 0.0;
+
+        if (seconds < minSampleSeconds)
+        {
+            // Aim slightly past the target, but don't grow so quickly that one unusually
+            // fast batch makes the samples far longer than they need to be
+            const auto scale = seconds > 0.0 ? jlimit (2.0, 10.0, 1.2 * minSampleSeconds / seconds) : 10.0;
+            numCalls = (int64) std::ceil ((double) numCalls * scale);
+            continue;
+        }
+
+        if (Time::getMillisecondCounterHiRes() >= warmUpEnd)
+            break;
+    }
+
+    std::vector<double> nanoseconds, cycles;
+
+    for (int i = 0; i < jmax (1, options.numSamples); ++i)
+    {
+        if (runner->shouldAbortBenchmarks())
+            return 0.0;
+
+        const auto startCycles = getCPUCycleCount();
+        const auto startTicks = Time::getHighResolutionTicks();
+        runBatch (numCalls);
+        const auto endTicks = Time::getHighResolutionTicks();
+        const auto endCycles = getCPUCycleCount();
+
+        nanoseconds.push_back ((double) (endTicks - startTicks) * 1.0e9 / ticksPerSecond / (double) numCalls);
+        cycles.push_back ((double) (endCycles - startCycles) / (double) numCalls);
+    }
+
+    BenchmarkRunner::Result result;
+    result.benchmarkName = name;
+    result.caseName = caseName;
+    result.category = category;
+    result.numSamples = (int) nanoseconds.size();
+    result.numCallsPerSample = numCalls;
+    result.numItemsPerCall = numItemsPerCall;
+
+    const auto minmax = std::minmax_element (nanoseconds.begin(), nanoseconds.end());
+    result.minNanoseconds = *minmax.first;
+    result.maxNanoseconds = *minmax.second;
+    result.medianNanoseconds = BenchmarkHelpers::getMedian (nanoseconds);
+    result.meanNanoseconds = std::accumulate (nanoseconds.begin(), nanoseconds.end(), 0.0) / (double) nanoseconds.size();
+
+    if (nanoseconds.size() > 1)
+    {
+        auto sumOfSquares = 0.0;
+
+        for (auto ns : nanoseconds)
+            sumOfSquares += (ns - result.meanNanoseconds) * (ns - result.meanNanoseconds);
+
+        result.standardDeviationNanoseconds = std::sqrt (sumOfSquares / (double) (nanoseconds.size() - 1));
+    }
+
+    if (isCPUCycleCounterAvailable())
+        result.medianCycles = BenchmarkHelpers::getMedian (cycles);
+
+    runner->addResult (result);
+    return result.medianNanoseconds;
+}
+
+//==============================================================================
+BenchmarkRunner::BenchmarkRunner (BenchmarkOptions optionsToUse)
+    : options (std::move (optionsToUse))
+{
+}
+
+BenchmarkRunner::~BenchmarkRunner() {}
+
+int BenchmarkRunner::getNumResults() const noexcept
+{
+    return results.size();
+}
+
+const BenchmarkRunner::Result* BenchmarkRunner::getResult (int index) const noexcept
+{
+    return results[index];
+}
+
+void BenchmarkRunner::resultsUpdated()
+{
+}
+
+void BenchmarkRunner::runBenchmarks (const Array<Benchmark*>& benchmarks)
+{
+    results.clear();
+    resultsUpdated();
+
+    for (auto* b : benchmarks)
+    {
+        if (shouldAbortBenchmarks())
+            break;
+
+        currentBenchmark = b;
+        logMessage ("-----------------------------------------------------------------");
+        logMessage ("Running benchmarks in: " + b->getName());
+
+       #if JUCE_EXCEPTIONS_DISABLED
+        b->performBenchmark (this);
+       #else
+        try
+        {
+            b->performBenchmark (this);
+        }
+        catch (...)
+        {
+            logMessage ("!!! An unhandled exception was thrown!");
+        }
+       #endif
+    }
+
+    currentBenchmark = nullptr;
+}
+
+void BenchmarkRunner::runAllBenchmarks()
+{
+    runBenchmarks (Benchmark::getAllBenchmarks());
+}
+
+void BenchmarkRunner::runBenchmarksInCategory (const String& category)
+{
+    runBenchmarks (Benchmark::getBenchmarksInCategory (category));
+}
+
+void BenchmarkRunner::logMessage (const String& message)
+{
+    Logger::writeToLog (message);
+}
+
+bool BenchmarkRunner::shouldAbortBenchmarks()
+{
+    return false;
+}
+
+void BenchmarkRunner::addResult (const Result& result)
+{
+    String message;
+    message << result.benchmarkName << " / " << result.caseName << ": "
+            << BenchmarkHelpers::formatNanoseconds (result.medianNanoseconds)
+            << " (+/- " << BenchmarkHelpers::formatNanoseconds (result.standardDeviationNanoseconds) << ")";
+
+    if (result.medianCycles >= 0.0)
+        message << ", " << String (result.medianCycles, 1) << " cycles";
+
+    if (result.numItemsPerCall > 1)
+        message << ", " << BenchmarkHelpers::formatRate (result.getItemsPerSecond()) << "items/s";
+
+    logMessage (message);
+
+    results.add (new Result (result));
+    resultsUpdated();
+}
+
+void BenchmarkRunner::writeResults (OutputStream& output, Format format) const
+{
+    if (format == Format::csv)
+    {
+        output << "benchmark,case,category,samples,callsPerSample,itemsPerCall,meanNs,medianNs,minNs,maxNs,stdDevNs,medianCycles,itemsPerSecond" << newLine;
+
+        for (auto* r : results)
+        {
+            output << BenchmarkHelpers::escapeCSV (r->benchmarkName) << ','
+                   << BenchmarkHelpers::escapeCSV (r->caseName) << ','
+                   << BenchmarkHelpers::escapeCSV (r->category) << ','
+                   << r->numSamples << ',' << r->numCallsPerSample << ',' << r->numItemsPerCall;
+
+            for (auto value : { r->meanNanoseconds, r->medianNanoseconds, r->minNanoseconds, r->maxNanoseconds,
+                                r->standardDeviationNanoseconds, r->medianCycles, r->getItemsPerSecond() })
+                output << ',' << String (value, 3);
+
+            output << newLine;
+        }
+
+        return;
+    }
+
+    DynamicObject::Ptr machine (new DynamicObject());
+    machine->setProperty ("os", SystemStats::getOperatingSystemName());
+    machine->setProperty ("cpuVendor", SystemStats::getCpuVendor());
+    machine->setProperty ("cpuModel", SystemStats::getCpuModel());
+    machine->setProperty ("cpuSpeedMHz", SystemStats::getCpuSpeedInMegahertz());
+    machine->setProperty ("numCpus", SystemStats::getNumCpus());
+    machine->setProperty ("numPhysicalCpus", SystemStats::getNumPhysicalCpus());
+
+    DynamicObject::Ptr settings (new DynamicObject());
+    settings->setProperty ("warmUpSeconds", options.warmUpTime.inSeconds());
+    settings->setProperty ("minimumSampleSeconds", options.minimumSampleTime.inSeconds());
+    settings->setProperty ("numSamples", options.numSamples);
+
+    Array<var> resultList;
+
+    for (auto* r : results)
+    {
+        DynamicObject::Ptr obj (new DynamicObject());
+        obj->setProperty ("benchmark", r->benchmarkName);
+        obj->setProperty ("case", r->caseName);
+        obj->setProperty ("category", r->category);
+        obj->setProperty ("samples", r->numSamples);
+        obj->setProperty ("callsPerSample", r->numCallsPerSample);
+        obj->setProperty ("itemsPerCall", r->numItemsPerCall);
+        obj->setProperty ("meanNs", r->meanNanoseconds);
+        obj->setProperty ("medianNs", r->medianNanoseconds);
+        obj->setProperty ("minNs", r->minNanoseconds);
+        obj->setProperty ("maxNs", r->maxNanoseconds);
+        obj->setProperty ("stdDevNs", r->standardDeviationNanoseconds);
+
+        if (r->medianCycles >= 0.0)
+            obj->setProperty ("medianCycles", r->medianCycles);
+
+        obj->setProperty ("itemsPerSecond", r->getItemsPerSecond());
+        resultList.add (obj.get());
+    }
+
+    DynamicObject::Ptr root (new DynamicObject());
+    root->setProperty ("juceVersion", SystemStats::getJUCEVersion());
+    root->setProperty ("time", Time::getCurrentTime().toISO8601 (true));
+   #if JUCE_DEBUG
+    root->setProperty ("debugBuild", true);
+   #else
+    root->setProperty ("debugBuild", false);
+   #endif
+    root->setProperty ("machine", machine.get());
+    root->setProperty ("settings", settings.get());
+    root->setProperty ("results", resultList);
+
+    JSON::writeToStream (output, root.get());
+    output << newLine;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class BenchmarkTests  : public UnitTest
+{
+public:
+    BenchmarkTests()
+        : UnitTest ("Benchmark", UnitTestCategories::time)
+    {}
+
+    void runTest() override
+    {
+        struct SumBenchmark  : public Benchmark
+        {
+            SumBenchmark() : Benchmark ("Sum", "BenchmarkTests") {}
+
+            void runBenchmark() override
+            {
+                std::vector<int> values (256, 1);
+
+                measure ("accumulate", [&]
+                {
+                    doNotOptimise (std::accumulate (values.begin(), values.end(), 0));
+                }, (int64) values.size());
+
+                measure ("nothing", [] {});
+            }
+        };
+
+        struct QuietRunner  : public BenchmarkRunner
+        {
+            using BenchmarkRunner::BenchmarkRunner;
+            void logMessage (const String&) override {}
+        };
+
+        SumBenchmark benchmark;
+
+        QuietRunner benchmarkRunner (BenchmarkOptions().withWarmUpTime (RelativeTime::milliseconds (5))
+                                                       .withMinimumSampleTime (RelativeTime::milliseconds (1))
+                                                       .withNumSamples (5));
+
+        beginTest ("Benchmarks are registered by category");
+        {
+            expect (Benchmark::getAllBenchmarks().contains (&benchmark));
+            expect (Benchmark::getAllCategories().contains ("BenchmarkTests"));
+            expectEquals (Benchmark::getBenchmarksInCategory ("BenchmarkTests").size(), 1);
+        }
+
+        beginTest ("Each measurement produces a result");
+        {
+            benchmarkRunner.runBenchmarksInCategory ("BenchmarkTests");
+
+            expectEquals (benchmarkRunner.getNumResults(), 2);
+
+            if (const auto* result = benchmarkRunner.getResult (0))
+            {
+                expectEquals (result->caseName, String ("accumulate"));
+                expectEquals (result->numSamples, 5);
+                expect (result->numCallsPerSample > 1);
+                expect (result->minNanoseconds > 0.0);
+                expect (result->minNanoseconds <= result->medianNanoseconds);
+                expect (result->medianNanoseconds <= result->maxNanoseconds);
+                expect (result->getItemsPerSecond() > 0.0);
+                expect (Benchmark::isCPUCycleCounterAvailable() == (result->medianCycles >= 0.0));
+            }
+        }
+
+        beginTest ("Results can be written as JSON and CSV");
+        {
+            MemoryOutputStream json;
+            benchmarkRunner.writeResults (json, BenchmarkRunner::Format::json);
+
+            const auto parsed = JSON::parse (json.toString());
+            expectEquals (parsed["results"].size(), 2);
+            expectEquals (parsed["results"][1]["case"].toString(), String ("nothing"));
+            expect (parsed["machine"]["numCpus"].isInt());
+
+            MemoryOutputStream csv;
+            benchmarkRunner.writeResults (csv, BenchmarkRunner::Format::csv);
+
+            const auto lines = StringArray::fromLines (csv.toString().trim());
+            expectEquals (lines.size(), 3);
+            expect (lines[1].startsWith ("Sum,accumulate,BenchmarkTests,5,"));
+        }
+    }
+};
+
+static BenchmarkTests benchmarkTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,328 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class BenchmarkRunner;
+
+//==============================================================================
+/**
+    This is a base class for classes that measure how long some code takes to run.
+
+    A Benchmark works in the same way as a UnitTest: you create a static instance
+    of your subclass, and a BenchmarkRunner will find it and call its runBenchmark()
+    method, in which you call measure() for each piece of code that you want to time.
+
+    @code
+    class StringBenchmark  : public Benchmark
+    {
+    public:
+        StringBenchmark()  : Benchmark ("String", UnitTestCategories::text) {}
+
+        void runBenchmark() override
+        {
+            const String text ("the quick brown fox");
+
+            measure ("toUpperCase", [&] { doNotOptimise (text.toUpperCase()); });
+            measure ("indexOf",     [&] { doNotOptimise (text.indexOf ("fox")); });
+        }
+    };
+
+    static StringBenchmark benchmark;
+    @endcode
+
+    Each call to measure() runs the function for a short warm-up period, during which
+    it also works out how many times to call the function so that each timed sample
+    lasts long enough to measure accurately. It then takes a number of samples and
+    hands the runner a summary of their statistics.
+
+    @see BenchmarkRunner, UnitTest
+
+    @tags{Core}
+*/
+class JUCE_API  Benchmark
+{
+public:
+    //==============================================================================
+    /** Creates a benchmark with the given name and optionally places it in a category. */
+    explicit Benchmark (const String& name, const String& category = String());
+
+    /** Destructor. */
+    virtual ~Benchmark();
+
+    /** Returns the name of the benchmark. */
+    const String& getName() const noexcept       { return name; }
+
+    /** Returns the category of the benchmark. */
+    const String& getCategory() const noexcept   { return category; }
+
+    /** Runs the benchmark, using the specified BenchmarkRunner.
+        You shouldn't need to call this method directly - use
+        BenchmarkRunner::runBenchmarks() instead.
+    */
+    void performBenchmark (BenchmarkRunner* runner);
+
+    /** Returns the set of all Benchmark objects that currently exist. */
+    static Array<Benchmark*>& getAllBenchmarks();
+
+    /** Returns the set of Benchmarks in a specified category. */
+    static Array<Benchmark*> getBenchmarksInCategory (const String& category);
+
+    /** Returns a StringArray containing all of the categories of Benchmarks that have been registered. */
+    static StringArray getAllCategories();
+
+    //==============================================================================
+    /** You can optionally implement this method to set up your benchmark.
+        This method will be called before runBenchmark().
+    */
+    virtual void initialise();
+
+    /** You can optionally implement this method to clear up after your benchmark has
+        been run. This method will be called after runBenchmark() has returned.
+    */
+    virtual void shutdown();
+
+    /** Implement this method in your subclass to call measure() for each piece of
+        code that you want to time.
+    */
+    virtual void runBenchmark() = 0;
+
+    //==============================================================================
+    /** Times a function, and adds the result to the runner's list of results.
+
+        The function is called many times, so it should do the same amount of work
+        on each call. If each call processes a number of items, such as samples or
+        characters, pass the number in so that the throughput can be reported.
+
+        Returns the median time that each call took, in nanoseconds, or zero if the
+        benchmarks were aborted.
+
+        This can only be called from within your runBenchmark() method.
+    */
+    template <typename Function>
+    double measure (const String& caseName, Function&& function, int64 numItemsPerCall = 1)
+    {
+        return measureBatches (caseName, [&function] (int64 numCalls)
+        {
+            for (int64 i = 0; i < numCalls; ++i)
+                function();
+        }, numItemsPerCall);
+    }
+
+    /** Stops the compiler from optimising away a value that would otherwise be unused. */
+    template <typename Type>
+    static void doNotOptimise (Type&& value) noexcept
+    {
+       #if JUCE_GCC || JUCE_CLANG
+        asm volatile ("" : : "m" (value) : "memory");
+       #else
+        static volatile const void* sink;
+        sink = &value;
+       #endif
+    }
+
+    /** Writes a message to the benchmark log.
+        This can only be called from within your runBenchmark() method.
+    */
+    void logMessage (const String& message);
+
+    //==============================================================================
+    /** Returns the value of the CPU's cycle counter, or zero if it can't be read.
+
+        On Intel machines this is the time-stamp counter, which on most modern CPUs
+        ticks at a constant rate, whatever the current clock speed.
+    */
+    static int64 getCPUCycleCount() noexcept;
+
+    /** Returns true if getCPUCycleCount() can be used on this machine. */
+    static bool isCPUCycleCounterAvailable() noexcept;
+
+private:
+    //==============================================================================
+    double measureBatches (const String&, const std::function<void (int64)>&, int64);
+
+    const String name, category;
+    BenchmarkRunner* runner = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (Benchmark)
+};
+
+//==============================================================================
+/**
+    The settings that a BenchmarkRunner uses for each measurement.
+
+    @see BenchmarkRunner
+
+    @tags{Core}
+*/
+struct BenchmarkOptions
+{
+    /** The length of time to run a function before timing it, so that caches are
+        warm and the CPU has reached its normal clock speed.
+    */
+    [[nodiscard]] BenchmarkOptions withWarmUpTime (RelativeTime newWarmUpTime) const
+    {
+        return withMember (*this, &BenchmarkOptions::warmUpTime, newWarmUpTime);
+    }
+
+    /** The minimum length of each timed sample. Fast functions are called repeatedly
+        until each sample takes at least this long.
+    */
+    [[nodiscard]] BenchmarkOptions withMinimumSampleTime (RelativeTime newMinimumSampleTime) const
+    {
+        return withMember (*this, &BenchmarkOptions::minimumSampleTime, newMinimumSampleTime);
+    }
+
+    /** The number of timed samples to take, from which the statistics are calculated. */
+    [[nodiscard]] BenchmarkOptions withNumSamples (int newNumSamples) const
+    {
+        return withMember (*this, &BenchmarkOptions::numSamples, newNumSamples);
+    }
+
+    RelativeTime warmUpTime { RelativeTime::milliseconds (100) };
+    RelativeTime minimumSampleTime { RelativeTime::milliseconds (10) };
+    int numSamples { 15 };
+};
+
+//==============================================================================
+/**
+    Runs a set of benchmarks, and collects their results.
+
+    By using a subclass of BenchmarkRunner, you can intercept logging messages and
+    perform custom behaviour when each benchmark completes.
+
+    @see Benchmark
+
+    @tags{Core}
+*/
+class JUCE_API  BenchmarkRunner
+{
+public:
+    //==============================================================================
+    /** Creates a runner that will use the given settings. */
+    explicit BenchmarkRunner (BenchmarkOptions options = {});
+
+    /** Destructor. */
+    virtual ~BenchmarkRunner();
+
+    /** Runs a set of benchmarks, one after another. */
+    void runBenchmarks (const Array<Benchmark*>& benchmarks);
+
+    /** Runs all the Benchmark objects that currently exist. */
+    void runAllBenchmarks();
+
+    /** Runs all the Benchmark objects within a specified category. */
+    void runBenchmarksInCategory (const String& category);
+
+    /** Returns the settings that the runner uses. */
+    const BenchmarkOptions& getOptions() const noexcept     { return options; }
+
+    //==============================================================================
+    /** Contains the results of one call to Benchmark::measure().
+
+        All of the times are per call of the measured function.
+    */
+    struct Result
+    {
+        /** The name of the Benchmark object. */
+        String benchmarkName;
+
+        /** The name that was passed to Benchmark::measure(). */
+        String caseName;
+
+        /** The category of the Benchmark object. */
+        String category;
+
+        /** The number of timed samples. */
+        int numSamples = 0;
+
+        /** The number of times the function was called in each sample. */
+        int64 numCallsPerSample = 0;
+
+        /** The number of items that each call processed. */
+        int64 numItemsPerCall = 1;
+
+        /** Statistics of the time each call took, in nanoseconds. */
+        double meanNanoseconds = 0.0, medianNanoseconds = 0.0, minNanoseconds = 0.0,
+               maxNanoseconds = 0.0, standardDeviationNanoseconds = 0.0;
+
+        /** The median number of CPU cycles each call took, or -1 if the cycle counter
+            isn't available.
+        */
+        double medianCycles = -1.0;
+
+        /** The number of items processed per second, based on the median time. */
+        double getItemsPerSecond() const noexcept
+        {
+            return medianNanoseconds > 0.0 ? (double) numItemsPerCall * 1.0e9 / medianNanoseconds : 0.0;
+        }
+    };
+
+    /** Returns the number of results that have been collected. */
+    int getNumResults() const noexcept;
+
+    /** Returns one of the results that have been collected. */
+    const Result* getResult (int index) const noexcept;
+
+    //==============================================================================
+    /** The formats that the results can be written in. */
+    enum class Format
+    {
+        json,   /**< A JSON object which also describes the machine, for comparing runs over time. */
+        csv     /**< Comma-separated values, with one row per result. */
+    };
+
+    /** Writes all of the results to a stream. */
+    void writeResults (OutputStream& output, Format format) const;
+
+protected:
+    /** Called when a new result has been added.
+        You can override this to perform some sort of behaviour when results are added.
+    */
+    virtual void resultsUpdated();
+
+    /** Logs a message about the current progress.
+        By default this just writes the message to the Logger class, but you could override
+        this to do something else with the data.
+    */
+    virtual void logMessage (const String& message);
+
+    /** This can be overridden to let the runner know that it should abort the benchmarks
+        as soon as possible, e.g. because the thread needs to stop.
+    */
+    virtual bool shouldAbortBenchmarks();
+
+private:
+    //==============================================================================
+    friend class Benchmark;
+
+    void addResult (const Result&);
+
+    const BenchmarkOptions options;
+    Benchmark* currentBenchmark = nullptr;
+    OwnedArray<Result, CriticalSection> results;
+
+    JUCE_DECLARE_NON_COPYABLE (BenchmarkRunner)
+};
+
+} // namespace juce
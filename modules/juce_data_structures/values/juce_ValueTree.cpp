@@ -1252,6 +1252,52 @@ public:
 
 static ValueTreeTests valueTreeTests;
 
+//==============================================================================
+class ValueTreeBenchmark final : public Benchmark
+{
+public:
+    ValueTreeBenchmark()
+        : Benchmark ("ValueTrees", UnitTestCategories::values)
+    {}
+
+    void runBenchmark() override
+    {
+        static const Identifier nodeType ("Node"), idProperty ("id"), valueProperty ("value");
+        constexpr int numChildren = 100;
+
+        ValueTree tree (nodeType);
+
+        for (int i = 0; i < numChildren; ++i)
+            tree.appendChild (ValueTree (nodeType, { { idProperty, i }, { valueProperty, "child " + String (i) } }), nullptr);
+
+        const auto lastChildId = numChildren - 1;
+
+        measure ("setProperty",             [&] { tree.setProperty (valueProperty, 1.0, nullptr); });
+        measure ("getProperty",             [&] { doNotOptimise (tree.getProperty (valueProperty)); });
+        measure ("getChildWithProperty",    [&] { doNotOptimise (tree.getChildWithProperty (idProperty, lastChildId)); }, numChildren);
+
+        measure ("appendChild and removeChild", [&]
+        {
+            tree.appendChild (ValueTree (nodeType), nullptr);
+            tree.removeChild (numChildren, nullptr);
+        });
+
+        measure ("createCopy",              [&] { doNotOptimise (tree.createCopy()); }, numChildren);
+
+        MemoryOutputStream stream;
+
+        measure ("writeToStream",           [&]
+        {
+            stream.reset();
+            tree.writeToStream (stream);
+        }, numChildren);
+
+        measure ("readFromData",            [&] { doNotOptimise (ValueTree::readFromData (stream.getData(), stream.getDataSize())); }, numChildren);
+    }
+};
+
+static ValueTreeBenchmark valueTreeBenchmark;
+
 #endif
 
 } // namespace juce
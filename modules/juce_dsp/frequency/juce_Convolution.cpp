@@ -144,6 +144,56 @@ ConvolutionMessageQueue::ConvolutionMessageQueue (ConvolutionMessageQueue&&) noe
 ConvolutionMessageQueue& ConvolutionMessageQueue::operator= (ConvolutionMessageQueue&&) noexcept = default;
 
 //==============================================================================
+// After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls.
+static void prepareForConvolution (float* samples, size_t fftSize) noexcept
+{
+    auto FFTSizeDiv2 = fftSize / 2;
+
+    for (size_t i = 0; i < FFTSizeDiv2; i++)
+        samples[i] = samples[i << 1];
+
+    samples[FFTSizeDiv2] = 0;
+
+    for (size_t i = 1; i < FFTSizeDiv2; i++)
+        samples[i + FFTSizeDiv2] = -samples[((fftSize - i) << 1) + 1];
+}
+
+// Does the convolution operation itself only on half of the frequency domain samples.
+static void convolutionProcessingAndAccumulate (const float* input, const float* impulse, float* output, size_t fftSize) noexcept
+{
+    auto FFTSizeDiv2 = fftSize / 2;
+
+    FloatVectorOperations::addWithMultiply      (output, input, impulse, static_cast<int> (FFTSizeDiv2));
+    FloatVectorOperations::subtractWithMultiply (output, &(input[FFTSizeDiv2]), &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+
+    FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), input, &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+    FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), &(input[FFTSizeDiv2]), impulse, static_cast<int> (FFTSizeDiv2));
+
+    output[fftSize] += input[fftSize] * impulse[fftSize];
+}
+
+// Undoes the re-organization of samples from the function prepareForConvolution.
+// Then takes the conjugate of the frequency domain first half of samples to fill the
+// second half, so that the inverse transform will return real samples in the time domain.
+static void updateSymmetricFrequencyDomainData (float* samples, size_t fftSize) noexcept
+{
+    auto FFTSizeDiv2 = fftSize / 2;
+
+    for (size_t i = 1; i < FFTSizeDiv2; i++)
+    {
+        samples[(fftSize - i) << 1] = samples[i];
+        samples[((fftSize - i) << 1) + 1] = -samples[FFTSizeDiv2 + i];
+    }
+
+    samples[1] = 0.f;
+
+    for (size_t i = 1; i < FFTSizeDiv2; i++)
+    {
+        samples[i << 1] = samples[(fftSize - i) << 1];
+        samples[(i << 1) + 1] = -samples[((fftSize - i) << 1) + 1];
+    }
+}
+
 struct ConvolutionEngine
 {
     ConvolutionEngine (const float* samples,
@@ -195,7 +245,7 @@ struct ConvolutionEngine
                                          static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
 
             FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
-            prepareForConvolution (impulseResponse);
+            prepareForConvolution (impulseResponse, fftSize);
 
             currentPtr += (fftSize - blockSize);
         }
@@ -240,7 +290,7 @@ struct ConvolutionEngine
             FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
 
             fftObject->performRealOnlyForwardTransform (inputSegmentData);
-            prepareForConvolution (inputSegmentData);
+            prepareForConvolution (inputSegmentData, fftSize);
 
             // Complex multiplication
             if (inputDataWasEmpty)
@@ -258,7 +308,8 @@ struct ConvolutionEngine
 
                     convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
                                                         buffersImpulseSegments[i].getWritePointer (0),
-                                                        outputTempData);
+                                                        outputTempData,
+                                                        fftSize);
                 }
             }
 
@@ -266,9 +317,10 @@ struct ConvolutionEngine
 
             convolutionProcessingAndAccumulate (inputSegmentData,
                                                 buffersImpulseSegments.front().getWritePointer (0),
-                                                outputData);
+                                                outputData,
+                                                fftSize);
 
-            updateSymmetricFrequencyDomainData (outputData);
+            updateSymmetricFrequencyDomainData (outputData, fftSize);
             fftObject->performRealOnlyInverseTransform (outputData);
 
             // Add overlap
@@ -328,7 +380,7 @@ struct ConvolutionEngine
                 FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
 
                 fftObject->performRealOnlyForwardTransform (inputSegmentData);
-                prepareForConvolution (inputSegmentData);
+                prepareForConvolution (inputSegmentData, fftSize);
 
                 // Complex multiplication
                 FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
@@ -344,16 +396,18 @@ struct ConvolutionEngine
 
                     convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
                                                         buffersImpulseSegments[i].getWritePointer (0),
-                                                        outputTempData);
+                                                        outputTempData,
+                                                        fftSize);
                 }
 
                 FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
 
                 convolutionProcessingAndAccumulate (inputSegmentData,
                                                     buffersImpulseSegments.front().getWritePointer (0),
-                                                    outputData);
+                                                    outputData,
+                                                    fftSize);
 
-                updateSymmetricFrequencyDomainData (outputData);
+                updateSymmetricFrequencyDomainData (outputData, fftSize);
                 fftObject->performRealOnlyInverseTransform (outputData);
 
                 // Add overlap
@@ -375,66 +429,450 @@ struct ConvolutionEngine
         }
     }
 
-    // After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls.
-    void prepareForConvolution (float *samples) noexcept
+    //==============================================================================
+    const size_t blockSize;
+    const size_t fftSize;
+    const std::unique_ptr<FFT> fftObject;
+    const size_t numSegments;
+    const size_t numInputSegments;
+    size_t currentSegment = 0, inputDataPos = 0;
+
+    AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
+    std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
+};
+
+//==============================================================================
+// The background threads that compute the tail partitions of non-uniform
+// convolutions. A single pool is shared by every Convolution in the process.
+// Engines register themselves as job sources, and whenever a worker is free
+// it runs the pending job with the earliest deadline, from whichever source
+// that job belongs to.
+class ConvolutionTailThreadPool
+{
+public:
+    struct JobSource
+    {
+        virtual ~JobSource() = default;
+
+        // Returns the deadline of the most urgent pending job, in high-resolution
+        // ticks, or the largest possible value if there's nothing to do.
+        virtual int64 getEarliestDeadline() const noexcept = 0;
+
+        // Runs the most urgent pending job. Returns false if there wasn't one.
+        virtual bool runMostUrgentJob() noexcept = 0;
+    };
+
+    ConvolutionTailThreadPool()
+    {
+        const auto numWorkers = jlimit (1, maxNumWorkers, SystemStats::getNumCpus() - 1);
+
+        for (auto i = 0; i < numWorkers; ++i)
+        {
+            auto worker = std::make_unique<Worker> (*this, i);
+
+            if (! worker->startRealtimeThread (Thread::RealtimeOptions{}.withPriority (5)))
+                worker->startThread (Thread::Priority::high);
+
+            workers.push_back (std::move (worker));
+        }
+    }
+
+    ~ConvolutionTailThreadPool()
     {
-        auto FFTSizeDiv2 = fftSize / 2;
+        for (auto& worker : workers)
+            worker->signalThreadShouldExit();
+
+        wakeUp.signal ((int) workers.size());
 
-        for (size_t i = 0; i < FFTSizeDiv2; i++)
-            samples[i] = samples[i << 1];
+        for (auto& worker : workers)
+            worker->stopThread (-1);
+    }
+
+    // Returns false if the pool can't take any more sources, in which case the
+    // source will have to run all of its jobs itself.
+    bool addSource (JobSource& source)
+    {
+        const SpinLock::ScopedLockType lock (registrationLock);
 
-        samples[FFTSizeDiv2] = 0;
+        for (size_t i = 0; i < slots.size(); ++i)
+        {
+            if (slots[i].source.load() == nullptr)
+            {
+                slots[i].source.store (&source);
+                numSlotsInUse.store (jmax (numSlotsInUse.load(), (int) i + 1));
+                return true;
+            }
+        }
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
-            samples[i + FFTSizeDiv2] = -samples[((fftSize - i) << 1) + 1];
+        return false;
     }
 
-    // Does the convolution operation itself only on half of the frequency domain samples.
-    void convolutionProcessingAndAccumulate (const float *input, const float *impulse, float *output)
+    // Once this returns, no worker will touch the source again.
+    void removeSource (JobSource& source)
     {
-        auto FFTSizeDiv2 = fftSize / 2;
+        const SpinLock::ScopedLockType lock (registrationLock);
+
+        for (auto& slot : slots)
+        {
+            if (slot.source.load() != &source)
+                continue;
 
-        FloatVectorOperations::addWithMultiply      (output, input, impulse, static_cast<int> (FFTSizeDiv2));
-        FloatVectorOperations::subtractWithMultiply (output, &(input[FFTSizeDiv2]), &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+            slot.source.store (nullptr);
 
-        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), input, &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
-        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), &(input[FFTSizeDiv2]), impulse, static_cast<int> (FFTSizeDiv2));
+            while (slot.numUsers.load() != 0)
+                Thread::yield();
+        }
+    }
 
-        output[fftSize] += input[fftSize] * impulse[fftSize];
+    // Called from the audio thread after posting a job. Wakes a single worker,
+    // if any of them are asleep. This never takes a lock.
+    void notifyWorker() noexcept
+    {
+        if (numSleepingWorkers.load() > 0)
+            wakeUp.signal();
     }
 
-    // Undoes the re-organization of samples from the function prepareForConvolution.
-    // Then takes the conjugate of the frequency domain first half of samples to fill the
-    // second half, so that the inverse transform will return real samples in the time domain.
-    void updateSymmetricFrequencyDomainData (float* samples) noexcept
+private:
+    class Worker final : public Thread
     {
-        auto FFTSizeDiv2 = fftSize / 2;
+    public:
+        Worker (ConvolutionTailThreadPool& p, int index)
+            : Thread ("Convolution tail thread " + String (index + 1)), pool (p) {}
+
+        ~Worker() override
+        {
+            stopThread (-1);
+        }
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
+        void run() override
         {
-            samples[(fftSize - i) << 1] = samples[i];
-            samples[((fftSize - i) << 1) + 1] = -samples[FFTSizeDiv2 + i];
+            while (! threadShouldExit())
+            {
+                if (pool.runMostUrgentJob())
+                    continue;
+
+                pool.numSleepingWorkers.fetch_add (1);
+
+                // Re-check after announcing that we're about to sleep, so that a job
+                // posted in the meantime can't be missed. If the audio thread signals for
+                // a worker that then doesn't wait, the next wait returns straight away.
+                if (! pool.runMostUrgentJob())
+                    pool.wakeUp.wait (100);
+
+                pool.numSleepingWorkers.fetch_sub (1);
+            }
         }
 
-        samples[1] = 0.f;
+    private:
+        ConvolutionTailThreadPool& pool;
+    };
+
+    struct Slot
+    {
+        std::atomic<JobSource*> source { nullptr };
+        std::atomic<int> numUsers { 0 };
+    };
+
+    bool runMostUrgentJob() noexcept
+    {
+        Slot* bestSlot = nullptr;
+        JobSource* bestSource = nullptr;
+        auto bestDeadline = std::numeric_limits<int64>::max();
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
+        // Each slot is marked as in use before its source is read, so that
+        // removeSource() can wait for us to finish with it
+        for (auto i = 0, numSlots = numSlotsInUse.load(); i < numSlots; ++i)
         {
-            samples[i << 1] = samples[(fftSize - i) << 1];
-            samples[(i << 1) + 1] = -samples[((fftSize - i) << 1) + 1];
+            auto& slot = slots[(size_t) i];
+            slot.numUsers.fetch_add (1);
+
+            if (auto* source = slot.source.load())
+            {
+                if (const auto deadline = source->getEarliestDeadline(); deadline < bestDeadline)
+                {
+                    if (bestSlot != nullptr)
+                        bestSlot->numUsers.fetch_sub (1);
+
+                    bestSlot = &slot;
+                    bestSource = source;
+                    bestDeadline = deadline;
+                    continue;
+                }
+            }
+
+            slot.numUsers.fetch_sub (1);
         }
+
+        if (bestSlot == nullptr)
+            return false;
+
+        const auto result = bestSource->runMostUrgentJob();
+        bestSlot->numUsers.fetch_sub (1);
+        return result;
     }
 
-    //==============================================================================
-    const size_t blockSize;
-    const size_t fftSize;
-    const std::unique_ptr<FFT> fftObject;
-    const size_t numSegments;
-    const size_t numInputSegments;
-    size_t currentSegment = 0, inputDataPos = 0;
+    static constexpr int maxNumWorkers = 4;
 
-    AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
-    std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::array<Slot, 128> slots;
+    std::atomic<int> numSlotsInUse { 0 }, numSleepingWorkers { 0 };
+    SpinLock registrationLock;
+    LightweightSemaphore wakeUp;
+
+    JUCE_DECLARE_NON_COPYABLE (ConvolutionTailThreadPool)
+};
+
+//==============================================================================
+// Convolves with everything after the head of an impulse response, using
+// partitions that double in size up to a maximum, with two partitions of each
+// size. Every partition starts at least two partitions into the impulse
+// response, so its output isn't needed until one whole partition after its
+// input is complete. That gap is the deadline by which a background thread
+// has to finish the job.
+//
+// The audio thread only collects input, mixes finished outputs and posts new
+// jobs. Workers skip jobs that they don't expect to finish before they're due.
+// If a job still hasn't been started when its output is due, the audio thread
+// runs it itself, so the result is the same whether or not the workers keep up.
+class NonUniformTail final : private ConvolutionTailThreadPool::JobSource
+{
+public:
+    NonUniformTail (const AudioBuffer<float>& buf,
+                    int numChannels,
+                    int firstPartitionSizeIn,
+                    double sampleRate)
+        : firstPartitionSize (firstPartitionSizeIn),
+          ticksPerSample ((double) Time::getHighResolutionTicksPerSecond() / sampleRate)
+    {
+        jassert (isPowerOfTwo (firstPartitionSize));
+
+        const auto irSize = buf.getNumSamples();
+
+        for (auto size = firstPartitionSize, start = 2 * firstPartitionSize; start < irSize; start += 2 * size, size *= 2)
+        {
+            const auto isLast = size >= maxPartitionSize || start + 2 * size >= irSize;
+            const auto length = isLast ? irSize - start : 2 * size;
+
+            for (auto channel = 0; channel < numChannels; ++channel)
+                jobs.push_back (std::make_unique<Job> (buf.getReadPointer (jmin (buf.getNumChannels() - 1, channel), start),
+                                                       length,
+                                                       size,
+                                                       channel));
+
+            if (isLast)
+                break;
+        }
+
+        isRegistered = pool->addSource (*this);
+    }
+
+    ~NonUniformTail() override
+    {
+        if (isRegistered)
+            pool->removeSource (*this);
+    }
+
+    void reset()
+    {
+        for (const auto& job : jobs)
+        {
+            job->cancel();
+            job->reset();
+        }
+
+        position = 0;
+    }
+
+    // Writes the output of the tail to the output block, which must not be the
+    // same as the input block.
+    void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
+    {
+        const auto numChannels = jmin (input.getNumChannels(), output.getNumChannels());
+        const auto numSamples  = jmin (input.getNumSamples(), output.getNumSamples());
+
+        output.clear();
+
+        for (size_t done = 0; done < numSamples;)
+        {
+            // Process up to the end of the current smallest partition, so that
+            // partitions can only ever finish at the end of a chunk
+            const auto offset = static_cast<size_t> (position & (firstPartitionSize - 1));
+            const auto num = jmin (numSamples - done, static_cast<size_t> (firstPartitionSize) - offset);
+
+            for (const auto& job : jobs)
+            {
+                const auto channel = static_cast<size_t> (job->channel);
+
+                if (channel >= numChannels)
+                    continue;
+
+                const auto jobOffset = static_cast<size_t> (position & (job->partitionSize - 1));
+
+                FloatVectorOperations::copy (job->nextInput.data() + jobOffset,
+                                             input.getChannelPointer (channel) + done,
+                                             static_cast<int> (num));
+
+                FloatVectorOperations::add (output.getChannelPointer (channel) + done,
+                                            job->currentOutput.data() + jobOffset,
+                                            static_cast<int> (num));
+            }
+
+            position += static_cast<int64> (num);
+            done += num;
+
+            for (const auto& job : jobs)
+                if (static_cast<size_t> (job->channel) < numChannels && (position & (job->partitionSize - 1)) == 0)
+                    startNextPartition (*job);
+        }
+    }
+
+private:
+    struct Job
+    {
+        enum class State { idle, pending, running, done };
+
+        Job (const float* samples, int numSamples, int partitionSizeIn, int channelIn)
+            : engine (samples, static_cast<size_t> (numSamples), static_cast<size_t> (partitionSizeIn)),
+              partitionSize (partitionSizeIn),
+              channel (channelIn),
+              nextInput     (static_cast<size_t> (partitionSize)),
+              currentOutput (static_cast<size_t> (partitionSize)),
+              jobInput      (static_cast<size_t> (partitionSize)),
+              jobOutput     (static_cast<size_t> (partitionSize))
+        {}
+
+        // Returns true if the caller is now responsible for running the job.
+        bool claim() noexcept
+        {
+            auto expected = State::pending;
+            return state.compare_exchange_strong (expected, State::running);
+        }
+
+        void run() noexcept
+        {
+            const auto startTicks = Time::getHighResolutionTicks();
+            engine.processSamples (jobInput.data(), jobOutput.data(), jobInput.size());
+            lastRunTicks.store (Time::getHighResolutionTicks() - startTicks, std::memory_order_relaxed);
+
+            state.store (State::done, std::memory_order_release);
+        }
+
+        // Workers only start a job if it's pending, and they expect to finish it well
+        // before it's due. Anything later than that is left for the audio thread, so
+        // that it rarely has to wait for a worker.
+        bool canBeStartedByWorker (int64 nowTicks) const noexcept
+        {
+            return state.load (std::memory_order_acquire) == State::pending
+                && nowTicks + 2 * lastRunTicks.load (std::memory_order_relaxed) < deadline.load (std::memory_order_relaxed);
+        }
+
+        // Runs the job on this thread if nobody else has started it yet, and
+        // otherwise waits for the thread that did to finish.
+        void finish() noexcept
+        {
+            if (claim())
+                run();
+
+            waitWhileRunning();
+        }
+
+        // Makes sure that the job isn't pending or in progress on another thread.
+        void cancel() noexcept
+        {
+            if (claim())
+                state.store (State::idle);
+
+            waitWhileRunning();
+        }
+
+        // Workers don't start jobs that they don't expect to finish before they're due,
+        // so this only has to wait if a worker was held up after starting one, e.g. by
+        // being preempted.
+        void waitWhileRunning() const noexcept
+        {
+            while (state.load (std::memory_order_acquire) == State::running)
+                Thread::yield();
+        }
+
+        void reset()
+        {
+            engine.reset();
+
+            for (auto* buffer : { &nextInput, &jobInput, &jobOutput, &currentOutput })
+                std::fill (buffer->begin(), buffer->end(), 0.0f);
+
+            state.store (State::idle);
+        }
+
+        ConvolutionEngine engine;
+        const int partitionSize;
+        const int channel;
+
+        // Only the audio thread touches these
+        std::vector<float> nextInput, currentOutput;
+
+        // Only the thread that claimed the job touches these while it's running
+        std::vector<float> jobInput, jobOutput;
+
+        std::atomic<int64> deadline { 0 }, lastRunTicks { 0 };
+        std::atomic<State> state { State::idle };
+    };
+
+    void startNextPartition (Job& job) noexcept
+    {
+        // The previous job is due now. If no worker has picked it up yet, we'll
+        // have to do it ourselves.
+        job.finish();
+
+        std::swap (job.currentOutput, job.jobOutput);
+        std::swap (job.nextInput, job.jobInput);
+
+        const auto due = Time::getHighResolutionTicks() + (int64) (ticksPerSample * job.partitionSize);
+        job.deadline.store (due, std::memory_order_relaxed);
+        job.state.store (Job::State::pending, std::memory_order_release);
+
+        if (isRegistered)
+            pool->notifyWorker();
+    }
+
+    int64 getEarliestDeadline() const noexcept override
+    {
+        const auto now = Time::getHighResolutionTicks();
+        auto result = std::numeric_limits<int64>::max();
+
+        for (const auto& job : jobs)
+            if (job->canBeStartedByWorker (now))
+                result = jmin (result, job->deadline.load (std::memory_order_relaxed));
+
+        return result;
+    }
+
+    bool runMostUrgentJob() noexcept override
+    {
+        const auto now = Time::getHighResolutionTicks();
+        Job* mostUrgent = nullptr;
+
+        for (const auto& job : jobs)
+            if (job->canBeStartedByWorker (now))
+                if (mostUrgent == nullptr || job->deadline.load (std::memory_order_relaxed) < mostUrgent->deadline.load (std::memory_order_relaxed))
+                    mostUrgent = job.get();
+
+        if (mostUrgent == nullptr || ! mostUrgent->claim())
+            return false;
+
+        mostUrgent->run();
+        return true;
+    }
+
+    static constexpr int maxPartitionSize = 16384;
+
+    std::vector<std::unique_ptr<Job>> jobs;
+    const int firstPartitionSize;
+    const double ticksPerSample;
+    int64 position = 0;
+
+    SharedResourcePointer<ConvolutionTailThreadPool> pool;
+    bool isRegistered = false;
 };
 
 //==============================================================================
@@ -445,8 +883,9 @@ public:
                         int maxBlockSize,
                         int maxBufferSize,
                         Convolution::NonUniform headSizeIn,
-                        bool isZeroDelayIn)
-        : tailBuffer (1, maxBlockSize),
+                        bool isZeroDelayIn,
+                        double sampleRate)
+        : tailBuffer (2, maxBlockSize),
           latency (isZeroDelayIn ? 0 : maxBufferSize),
           irSize (buf.getNumSamples()),
           blockSize (maxBlockSize),
@@ -466,6 +905,19 @@ public:
             for (int i = 0; i < numChannels; ++i)
                 head.emplace_back (makeEngine (i, 0, buf.getNumSamples(), static_cast<uint32> (maxBufferSize)));
         }
+        else if (isZeroDelay)
+        {
+            // The head is always at least two blocks long, so that each of the tail
+            // partitions has at least a whole block in which to be computed
+            const auto firstTailPartitionSize = jmax (headSizeIn.headSizeInSamples / 2, nextPowerOfTwo (maxBlockSize));
+            const auto size = jmin (buf.getNumSamples(), 2 * firstTailPartitionSize);
+
+            for (int i = 0; i < numChannels; ++i)
+                head.emplace_back (makeEngine (i, 0, size, static_cast<uint32> (maxBufferSize)));
+
+            if (size != buf.getNumSamples())
+                threadedTail = std::make_unique<NonUniformTail> (buf, numChannels, firstTailPartitionSize, sampleRate);
+        }
         else
         {
             const auto size = jmin (buf.getNumSamples(), headSizeIn.headSizeInSamples);
@@ -488,6 +940,9 @@ public:
 
         for (const auto& e : tail)
             e->reset();
+
+        if (threadedTail != nullptr)
+            threadedTail->reset();
     }
 
     void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
@@ -495,49 +950,292 @@ public:
         const auto numChannels = jmin (head.size(), input.getNumChannels(), output.getNumChannels());
         const auto numSamples  = jmin (input.getNumSamples(), output.getNumSamples());
 
-        const AudioBlock<float> fullTailBlock (tailBuffer);
-        const auto tailBlock = fullTailBlock.getSubBlock (0, (size_t) numSamples);
+        const AudioBlock<float> fullTailBlock (tailBuffer);
+        const auto tailBlock = fullTailBlock.getSubBlock (0, (size_t) numSamples);
+
+        const auto isUniform = tail.empty();
+
+        if (threadedTail != nullptr)
+        {
+            auto threadedTailBlock = tailBlock.getSubsetChannelBlock (0, numChannels);
+            threadedTail->processSamples (input.getSubsetChannelBlock (0, numChannels), threadedTailBlock);
+        }
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            if (! isUniform)
+                tail[channel]->processSamplesWithAddedLatency (input.getChannelPointer (channel),
+                                                               tailBlock.getChannelPointer (0),
+                                                               numSamples);
+
+            if (isZeroDelay)
+                head[channel]->processSamples (input.getChannelPointer (channel),
+                                               output.getChannelPointer (channel),
+                                               numSamples);
+            else
+                head[channel]->processSamplesWithAddedLatency (input.getChannelPointer (channel),
+                                                               output.getChannelPointer (channel),
+                                                               numSamples);
+
+            if (! isUniform)
+                output.getSingleChannelBlock (channel) += tailBlock.getSingleChannelBlock (0);
+
+            if (threadedTail != nullptr)
+                output.getSingleChannelBlock (channel) += tailBlock.getSingleChannelBlock (channel);
+        }
+
+        const auto numOutputChannels = output.getNumChannels();
+
+        for (auto i = numChannels; i < numOutputChannels; ++i)
+            output.getSingleChannelBlock (i).copyFrom (output.getSingleChannelBlock (0));
+    }
+
+    int getIRSize() const noexcept     { return irSize; }
+    int getLatency() const noexcept    { return latency; }
+    int getBlockSize() const noexcept  { return blockSize; }
+
+private:
+    std::vector<std::unique_ptr<ConvolutionEngine>> head, tail;
+    std::unique_ptr<NonUniformTail> threadedTail;
+    AudioBuffer<float> tailBuffer;
+
+    const int latency;
+    const int irSize;
+    const int blockSize;
+    const bool isZeroDelay;
+};
+
+//==============================================================================
+// Convolves each of a number of inputs with its own impulse response for each
+// of a number of outputs, and sums the results at each output.
+//
+// This uses the same zero latency, uniform partitioned algorithm as
+// ConvolutionEngine, but each block of each input is transformed just once,
+// and the products for all of the inputs are accumulated in the frequency
+// domain, so that there is only one inverse transform per output.
+class MatrixConvolutionEngine
+{
+public:
+    // The impulse response for input i and output o is in channel (o * numInputs + i)
+    MatrixConvolutionEngine (const AudioBuffer<float>& buf, int numInputsIn, size_t maxBlockSize)
+        : numInputs  (static_cast<size_t> (numInputsIn)),
+          numOutputs (static_cast<size_t> (buf.getNumChannels() / numInputsIn)),
+          irSize (buf.getNumSamples()),
+          blockSize ((size_t) nextPowerOfTwo ((int) maxBlockSize)),
+          fftSize (blockSize > 128 ? 2 * blockSize : 4 * blockSize),
+          fftObject (std::make_unique<FFT> (roundToInt (std::log2 (fftSize)))),
+          numSegments ((size_t) buf.getNumSamples() / (fftSize - blockSize) + 1u),
+          numInputSegments ((blockSize > 128 ? numSegments : 3 * numSegments)),
+          bufferInput      (static_cast<int> (numInputs),  static_cast<int> (fftSize)),
+          bufferOutput     (static_cast<int> (numOutputs), static_cast<int> (fftSize * 2)),
+          bufferTempOutput (static_cast<int> (numOutputs), static_cast<int> (fftSize * 2)),
+          bufferOverlap    (static_cast<int> (numOutputs), static_cast<int> (fftSize)),
+          inputSegments    (static_cast<int> (numInputs * numInputSegments), static_cast<int> (fftSize * 2)),
+          impulseSegments  (static_cast<int> (numOutputs * numInputs * numSegments), static_cast<int> (fftSize * 2)),
+          inputSegmentPointers (numInputs),
+          outputPointers (numOutputs)
+    {
+        jassert (numInputsIn > 0 && buf.getNumChannels() % numInputsIn == 0);
+
+        impulseSegments.clear();
+
+        for (size_t output = 0; output < numOutputs; ++output)
+        {
+            for (size_t input = 0; input < numInputs; ++input)
+            {
+                const auto* samples = buf.getReadPointer (static_cast<int> (output * numInputs + input));
+                size_t currentPtr = 0;
+
+                for (size_t segment = 0; segment < numSegments; ++segment)
+                {
+                    auto* impulseResponse = impulseSegments.getWritePointer (getImpulseSegmentIndex (output, input, segment));
+
+                    FloatVectorOperations::copy (impulseResponse,
+                                                 samples + currentPtr,
+                                                 static_cast<int> (jmin (fftSize - blockSize, (size_t) irSize - currentPtr)));
+
+                    currentPtr += (fftSize - blockSize);
+                }
+            }
+        }
+
+        std::vector<float*> impulsePointers;
+
+        for (auto i = 0; i < impulseSegments.getNumChannels(); ++i)
+            impulsePointers.push_back (impulseSegments.getWritePointer (i));
+
+        fftObject->performRealOnlyForwardTransform (impulsePointers.data(), (int) impulsePointers.size());
+
+        for (auto* impulseResponse : impulsePointers)
+            prepareForConvolution (impulseResponse, fftSize);
+
+        reset();
+    }
+
+    void reset()
+    {
+        bufferInput.clear();
+        bufferOverlap.clear();
+        bufferTempOutput.clear();
+        bufferOutput.clear();
+        inputSegments.clear();
+
+        currentSegment = 0;
+        inputDataPos = 0;
+    }
+
+    // The input and output blocks may be the same. Missing inputs are treated
+    // as silent, and any output channels beyond the number of outputs in the
+    // matrix are cleared.
+    void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
+    {
+        const auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
+        const auto numInputChannels  = jmin (input.getNumChannels(), numInputs);
+        const auto numOutputChannels = jmin (output.getNumChannels(), numOutputs);
+        const auto indexStep = numInputSegments / numSegments;
+
+        size_t numSamplesProcessed = 0;
+
+        while (numSamplesProcessed < numSamples)
+        {
+            const bool inputDataWasEmpty = (inputDataPos == 0);
+            const auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize - inputDataPos);
+
+            // All of the inputs are read before any outputs are written, so the
+            // blocks can alias
+            for (size_t channel = 0; channel < numInputs; ++channel)
+            {
+                auto* inputData = bufferInput.getWritePointer (static_cast<int> (channel));
+
+                if (channel < numInputChannels)
+                    FloatVectorOperations::copy (inputData + inputDataPos,
+                                                 input.getChannelPointer (channel) + numSamplesProcessed,
+                                                 static_cast<int> (numSamplesToProcess));
+
+                inputSegmentPointers[channel] = getInputSegment (channel, currentSegment);
+                FloatVectorOperations::copy (inputSegmentPointers[channel], inputData, static_cast<int> (fftSize));
+            }
+
+            fftObject->performRealOnlyForwardTransform (inputSegmentPointers.data(), static_cast<int> (numInputs));
+
+            for (auto* inputSegmentData : inputSegmentPointers)
+                prepareForConvolution (inputSegmentData, fftSize);
+
+            // The contributions of the earlier blocks only change once per block
+            if (inputDataWasEmpty)
+            {
+                for (size_t channel = 0; channel < numOutputs; ++channel)
+                {
+                    auto* outputTempData = bufferTempOutput.getWritePointer (static_cast<int> (channel));
+                    FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
+
+                    for (size_t inputChannel = 0; inputChannel < numInputs; ++inputChannel)
+                    {
+                        auto index = currentSegment;
+
+                        for (size_t i = 1; i < numSegments; ++i)
+                        {
+                            index += indexStep;
+
+                            if (index >= numInputSegments)
+                                index -= numInputSegments;
+
+                            convolutionProcessingAndAccumulate (getInputSegment (inputChannel, index),
+                                                                getImpulseSegment (channel, inputChannel, i),
+                                                                outputTempData,
+                                                                fftSize);
+                        }
+                    }
+                }
+            }
+
+            for (size_t channel = 0; channel < numOutputs; ++channel)
+            {
+                auto* outputData = bufferOutput.getWritePointer (static_cast<int> (channel));
+                FloatVectorOperations::copy (outputData, bufferTempOutput.getReadPointer (static_cast<int> (channel)), static_cast<int> (fftSize + 1));
+
+                for (size_t inputChannel = 0; inputChannel < numInputs; ++inputChannel)
+                    convolutionProcessingAndAccumulate (inputSegmentPointers[inputChannel],
+                                                        getImpulseSegment (channel, inputChannel, 0),
+                                                        outputData,
+                                                        fftSize);
+
+                updateSymmetricFrequencyDomainData (outputData, fftSize);
+                outputPointers[channel] = outputData;
+            }
+
+            fftObject->performRealOnlyInverseTransform (outputPointers.data(), static_cast<int> (numOutputs));
+
+            // Add overlap
+            for (size_t channel = 0; channel < numOutputChannels; ++channel)
+                FloatVectorOperations::add (output.getChannelPointer (channel) + numSamplesProcessed,
+                                            outputPointers[channel] + inputDataPos,
+                                            bufferOverlap.getReadPointer (static_cast<int> (channel), static_cast<int> (inputDataPos)),
+                                            static_cast<int> (numSamplesToProcess));
+
+            inputDataPos += numSamplesToProcess;
+
+            if (inputDataPos == blockSize)
+            {
+                // Input buffers are empty again now
+                bufferInput.clear();
+                inputDataPos = 0;
 
-        const auto isUniform = tail.empty();
+                for (size_t channel = 0; channel < numOutputs; ++channel)
+                {
+                    auto* outputData  = outputPointers[channel];
+                    auto* overlapData = bufferOverlap.getWritePointer (static_cast<int> (channel));
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
-        {
-            if (! isUniform)
-                tail[channel]->processSamplesWithAddedLatency (input.getChannelPointer (channel),
-                                                               tailBlock.getChannelPointer (0),
-                                                               numSamples);
+                    // Extra step for segSize > blockSize
+                    FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (fftSize - 2 * blockSize));
 
-            if (isZeroDelay)
-                head[channel]->processSamples (input.getChannelPointer (channel),
-                                               output.getChannelPointer (channel),
-                                               numSamples);
-            else
-                head[channel]->processSamplesWithAddedLatency (input.getChannelPointer (channel),
-                                                               output.getChannelPointer (channel),
-                                                               numSamples);
+                    // Save the overlap
+                    FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
+                }
 
-            if (! isUniform)
-                output.getSingleChannelBlock (channel) += tailBlock;
-        }
+                currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
+            }
 
-        const auto numOutputChannels = output.getNumChannels();
+            numSamplesProcessed += numSamplesToProcess;
+        }
 
-        for (auto i = numChannels; i < numOutputChannels; ++i)
-            output.getSingleChannelBlock (i).copyFrom (output.getSingleChannelBlock (0));
+        for (auto channel = numOutputChannels; channel < output.getNumChannels(); ++channel)
+            output.getSingleChannelBlock (channel).clear();
     }
 
-    int getIRSize() const noexcept     { return irSize; }
-    int getLatency() const noexcept    { return latency; }
-    int getBlockSize() const noexcept  { return blockSize; }
+    int getNumInputs() const noexcept   { return static_cast<int> (numInputs); }
+    int getNumOutputs() const noexcept  { return static_cast<int> (numOutputs); }
+    int getIRSize() const noexcept      { return irSize; }
 
 private:
-    std::vector<std::unique_ptr<ConvolutionEngine>> head, tail;
-    AudioBuffer<float> tailBuffer;
+    float* getInputSegment (size_t input, size_t segment) noexcept
+    {
+        return inputSegments.getWritePointer (static_cast<int> (input * numInputSegments + segment));
+    }
 
-    const int latency;
+    int getImpulseSegmentIndex (size_t output, size_t input, size_t segment) const noexcept
+    {
+        return static_cast<int> ((output * numInputs + input) * numSegments + segment);
+    }
+
+    const float* getImpulseSegment (size_t output, size_t input, size_t segment) const noexcept
+    {
+        return impulseSegments.getReadPointer (getImpulseSegmentIndex (output, input, segment));
+    }
+
+    //==============================================================================
+    const size_t numInputs, numOutputs;
     const int irSize;
-    const int blockSize;
-    const bool isZeroDelay;
+    const size_t blockSize;
+    const size_t fftSize;
+    const std::unique_ptr<FFT> fftObject;
+    const size_t numSegments;
+    const size_t numInputSegments;
+    size_t currentSegment = 0, inputDataPos = 0;
+
+    AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
+    AudioBuffer<float> inputSegments, impulseSegments;
+    std::vector<float*> inputSegmentPointers, outputPointers;
 };
 
 static AudioBuffer<float> fixNumChannels (const AudioBuffer<float>& buf, Convolution::Stereo stereo)
@@ -675,7 +1373,7 @@ public:
         ptr = std::move (p);
     }
 
-    std::unique_ptr<MultichannelEngine> get()
+    std::unique_ptr<Element> get()
     {
         const SpinLock::ScopedTryLockType lock (mutex);
         return lock.isLocked() ? std::move (ptr) : nullptr;
@@ -790,7 +1488,8 @@ private:
                                                      processSpec.maximumBlockSize,
                                                      maxBufferSize,
                                                      headSize,
-                                                     shouldBeZeroLatency);
+                                                     shouldBeZeroLatency,
+                                                     processSpec.sampleRate);
     }
 
     static AudioBuffer<float> makeImpulseBuffer()
@@ -1126,6 +1825,236 @@ private:
     CrossoverMixer mixer;
 };
 
+//==============================================================================
+// Builds matrix convolution engines on the background thread. This works in
+// the same way as ConvolutionEngineQueue, with the engine factory folded in.
+class MatrixConvolutionEngineQueue final : public std::enable_shared_from_this<MatrixConvolutionEngineQueue>
+{
+public:
+    explicit MatrixConvolutionEngineQueue (BackgroundMessageQueue& queue)
+        : messageQueue (queue) {}
+
+    void loadImpulseResponses (AudioBuffer<float>&& buffer,
+                               double sr,
+                               int numInputs,
+                               Convolution::Trim trim,
+                               Convolution::Normalise normalise)
+    {
+        callLater ([b = std::move (buffer), sr, numInputs, trim, normalise] (MatrixConvolutionEngineQueue& q) mutable
+        {
+            q.setImpulseResponses ({ std::move (b), sr }, numInputs, trim, normalise);
+        });
+    }
+
+    // It is safe to call this method simultaneously with other public
+    // member functions.
+    void prepare (const ProcessSpec& spec)
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        processSpec = spec;
+
+        engine.set (makeEngine());
+    }
+
+    // Call this regularly to try to resend any pending message.
+    void postPendingCommand()
+    {
+        if (pendingCommand == nullptr)
+            return;
+
+        if (messageQueue.push (pendingCommand))
+            pendingCommand = nullptr;
+    }
+
+    std::unique_ptr<MatrixConvolutionEngine> getEngine() { return engine.get(); }
+
+private:
+    void setImpulseResponses (BufferWithSampleRate&& buf,
+                              int numInputs,
+                              Convolution::Trim trim,
+                              Convolution::Normalise normalise)
+    {
+        // The buffer must contain at least one whole row of the matrix
+        jassert (isPositiveAndNotGreaterThan (numInputs, buf.buffer.getNumChannels()));
+
+        if (! isPositiveAndNotGreaterThan (numInputs, buf.buffer.getNumChannels()))
+            return;
+
+        const std::lock_guard<std::mutex> lock (mutex);
+        wantsNormalise = normalise;
+        originalSampleRate = buf.sampleRate;
+        matrixInputs = numInputs;
+
+        impulseResponse = [&]
+        {
+            // Any channels that don't make up a whole row of the matrix are ignored
+            const auto numChannels = (buf.buffer.getNumChannels() / numInputs) * numInputs;
+            AudioBuffer<float> corrected (numChannels, jmax (1, buf.buffer.getNumSamples()));
+            corrected.clear();
+
+            for (auto channel = 0; channel != numChannels; ++channel)
+                corrected.copyFrom (channel, 0, buf.buffer, channel, 0, buf.buffer.getNumSamples());
+
+            return trim == Convolution::Trim::yes ? trimImpulseResponse (corrected) : corrected;
+        }();
+
+        engine.set (makeEngine());
+    }
+
+    std::unique_ptr<MatrixConvolutionEngine> makeEngine()
+    {
+        // Until some impulse responses have been loaded, each input is passed
+        // straight through to the corresponding output
+        if (impulseResponse.getNumChannels() == 0)
+        {
+            const auto numChannels = jmax (1, (int) processSpec.numChannels);
+            AudioBuffer<float> identity (numChannels * numChannels, 1);
+            identity.clear();
+
+            for (auto channel = 0; channel != numChannels; ++channel)
+                identity.setSample (channel * numChannels + channel, 0, 1.0f);
+
+            return std::make_unique<MatrixConvolutionEngine> (identity, numChannels, processSpec.maximumBlockSize);
+        }
+
+        auto resampled = resampleImpulseResponse (impulseResponse, originalSampleRate, processSpec.sampleRate);
+
+        if (wantsNormalise == Convolution::Normalise::yes)
+            normaliseImpulseResponse (resampled);
+        else
+            resampled.applyGain ((float) (originalSampleRate / processSpec.sampleRate));
+
+        return std::make_unique<MatrixConvolutionEngine> (resampled, matrixInputs, processSpec.maximumBlockSize);
+    }
+
+    template <typename Fn>
+    void callLater (Fn&& fn)
+    {
+        // If there was already a pending command (because the queue was full) we'll end up deleting it here.
+        pendingCommand = [weak = weakFromThis(), callback = std::forward<Fn> (fn)]() mutable
+        {
+            if (auto t = weak.lock())
+                callback (*t);
+        };
+
+        postPendingCommand();
+    }
+
+    std::weak_ptr<MatrixConvolutionEngineQueue> weakFromThis() { return shared_from_this(); }
+
+    BackgroundMessageQueue& messageQueue;
+    BackgroundMessageQueue::IncomingCommand pendingCommand;
+
+    ProcessSpec processSpec { 44100.0, 128, 2 };
+    AudioBuffer<float> impulseResponse;
+    double originalSampleRate = processSpec.sampleRate;
+    int matrixInputs = 1;
+    Convolution::Normalise wantsNormalise = Convolution::Normalise::no;
+
+    TryLockedPtr<MatrixConvolutionEngine> engine;
+
+    mutable std::mutex mutex;
+};
+
+class MatrixConvolution::Impl
+{
+public:
+    explicit Impl (OptionalQueue&& queue)
+        : messageQueue (std::move (queue)),
+          engineQueue (std::make_shared<MatrixConvolutionEngineQueue> (*messageQueue->pimpl))
+    {}
+
+    void reset()
+    {
+        mixer.reset();
+
+        if (currentEngine != nullptr)
+            currentEngine->reset();
+
+        destroyPreviousEngine();
+    }
+
+    void prepare (const ProcessSpec& spec)
+    {
+        messageQueue->pimpl->popAll();
+        mixer.prepare (spec);
+        engineQueue->prepare (spec);
+        maxNumChannels = spec.numChannels;
+
+        if (auto newEngine = engineQueue->getEngine())
+            currentEngine = std::move (newEngine);
+
+        previousEngine = nullptr;
+        jassert (currentEngine != nullptr);
+    }
+
+    void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
+    {
+        // The ProcessSpec passed to prepare() must allow for all of the output channels
+        jassert (output.getNumChannels() <= maxNumChannels);
+
+        engineQueue->postPendingCommand();
+
+        if (previousEngine == nullptr)
+            installPendingEngine();
+
+        auto outputToUse = output.getSubsetChannelBlock (0, jmin (output.getNumChannels(), (size_t) maxNumChannels));
+
+        mixer.processSamples (input,
+                              outputToUse,
+                              [this] (const AudioBlock<const float>& in, AudioBlock<float>& out)
+                              {
+                                  currentEngine->processSamples (in, out);
+                              },
+                              [this] (const AudioBlock<const float>& in, AudioBlock<float>& out)
+                              {
+                                  if (previousEngine != nullptr)
+                                      previousEngine->processSamples (in, out);
+                                  else
+                                      out.copyFrom (in);
+                              },
+                              [this] { destroyPreviousEngine(); });
+    }
+
+    int getNumInputs() const      { return currentEngine != nullptr ? currentEngine->getNumInputs()  : 0; }
+    int getNumOutputs() const     { return currentEngine != nullptr ? currentEngine->getNumOutputs() : 0; }
+    int getCurrentIRSize() const  { return currentEngine != nullptr ? currentEngine->getIRSize()     : 0; }
+
+    void loadImpulseResponses (AudioBuffer<float>&& buffer,
+                               double originalSampleRate,
+                               int numInputs,
+                               Convolution::Trim trim,
+                               Convolution::Normalise normalise)
+    {
+        engineQueue->loadImpulseResponses (std::move (buffer), originalSampleRate, numInputs, trim, normalise);
+    }
+
+private:
+    void destroyPreviousEngine()
+    {
+        // If the queue is full, we'll destroy this straight away
+        BackgroundMessageQueue::IncomingCommand command = [p = std::move (previousEngine)]() mutable { p = nullptr; };
+        messageQueue->pimpl->push (command);
+    }
+
+    void installPendingEngine()
+    {
+        if (auto newEngine = engineQueue->getEngine())
+        {
+            destroyPreviousEngine();
+            previousEngine = std::move (currentEngine);
+            currentEngine = std::move (newEngine);
+            mixer.beginTransition();
+        }
+    }
+
+    OptionalQueue messageQueue;
+    std::shared_ptr<MatrixConvolutionEngineQueue> engineQueue;
+    std::unique_ptr<MatrixConvolutionEngine> previousEngine, currentEngine;
+    CrossoverMixer mixer;
+    uint32 maxNumChannels = 0;
+};
+
 //==============================================================================
 void Convolution::Mixer::prepare (const ProcessSpec& spec)
 {
@@ -1291,4 +2220,63 @@ int Convolution::getCurrentIRSize() const { return pimpl->getCurrentIRSize(); }
 
 int Convolution::getLatency() const { return pimpl->getLatency(); }
 
+//==============================================================================
+MatrixConvolution::MatrixConvolution()
+    : MatrixConvolution (OptionalQueue { std::make_unique<ConvolutionMessageQueue>() })
+{}
+
+MatrixConvolution::MatrixConvolution (ConvolutionMessageQueue& queue)
+    : MatrixConvolution (OptionalQueue { queue })
+{}
+
+MatrixConvolution::MatrixConvolution (OptionalQueue&& queue)
+    : pimpl (std::make_unique<Impl> (std::move (queue)))
+{}
+
+MatrixConvolution::~MatrixConvolution() noexcept = default;
+
+void MatrixConvolution::loadImpulseResponses (AudioBuffer<float>&& buffer,
+                                              double originalSampleRate,
+                                              int numInputs,
+                                              Convolution::Trim trim,
+                                              Convolution::Normalise normalise)
+{
+    pimpl->loadImpulseResponses (std::move (buffer), originalSampleRate, numInputs, trim, normalise);
+}
+
+void MatrixConvolution::prepare (const ProcessSpec& spec)
+{
+    pimpl->prepare (spec);
+    isActive = true;
+}
+
+void MatrixConvolution::reset() noexcept
+{
+    pimpl->reset();
+}
+
+void MatrixConvolution::processSamples (const AudioBlock<const float>& input,
+                                        AudioBlock<float>& output,
+                                        bool isBypassed) noexcept
+{
+    if (! isActive)
+        return;
+
+    if (isBypassed)
+    {
+        if (input.getChannelPointer (0) != output.getChannelPointer (0))
+            output.copyFrom (input);
+
+        return;
+    }
+
+    pimpl->processSamples (input, output);
+}
+
+int MatrixConvolution::getNumInputs() const      { return pimpl->getNumInputs(); }
+
+int MatrixConvolution::getNumOutputs() const     { return pimpl->getNumOutputs(); }
+
+int MatrixConvolution::getCurrentIRSize() const  { return pimpl->getCurrentIRSize(); }
+
 } // namespace juce::dsp
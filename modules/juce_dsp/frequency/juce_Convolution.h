@@ -65,6 +65,7 @@ private:
     std::unique_ptr<Impl> pimpl;
 
     friend class Convolution;
+    friend class MatrixConvolution;
 };
 
 /**
@@ -85,8 +86,8 @@ private:
     Note: The default operation of this class uses zero latency and a uniform
     partitioned algorithm. If the impulse response size is large, or if the
     algorithm is too CPU intensive, it is possible to use either a fixed
-    latency version of the algorithm, or a simple non-uniform partitioned
-    convolution algorithm.
+    latency version of the algorithm, or a non-uniform partitioned convolution
+    algorithm which moves most of the work to background threads.
 
     Threading: It is not safe to interleave calls to the methods of this
     class. If you need to load new impulse responses during processing the
@@ -138,7 +139,16 @@ public:
         efficiency of the processing for IR sizes of 4096 samples or greater
         (recommended for reverberation IRs).
 
-        @param requiredHeadSize       the head IR size for two stage non-uniform
+        The head of the IR is processed on the audio thread, using partitions
+        the size of the maximum block size. The rest of the IR is split into
+        partitions that double in size, which are processed on a pool of
+        background threads shared by all Convolution instances. Each of these
+        partitions has a deadline, and if a background thread hasn't started it
+        by the time its output is needed, the audio thread will process it
+        instead, so there is no added latency. The head is always at least twice
+        the maximum block size.
+
+        @param requiredHeadSize       the head IR size for non-uniform
                                       partitioned convolution
      */
     explicit Convolution (const NonUniform& requiredHeadSize);
@@ -304,4 +314,116 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Convolution)
 };
 
+//==============================================================================
+/**
+    Performs true stereo or multichannel convolution, where every output is the
+    sum of each input convolved with its own impulse response.
+
+    This is the kind of processing needed for true stereo and ambisonic reverbs.
+    A matrix with N inputs and M outputs could be built from N * M Convolution
+    objects, but this class only needs to transform each block of each input
+    once, and accumulates the products for each output in the frequency domain,
+    so that each output only needs a single inverse transform.
+
+    The impulse responses are supplied in a single AudioBuffer, with one channel
+    for each pair of input and output. The impulse response from input i to
+    output o is in channel (o * numInputs + i). For example, a true stereo
+    impulse response has the channels: left to left, right to left, left to
+    right, right to right.
+
+    The processing uses zero latency and a uniform partitioned algorithm.
+    As with Convolution, impulse responses are loaded on a background thread, and
+    new ones are crossfaded in. Until the first impulse response has been loaded,
+    each input is passed straight through to the corresponding output.
+
+    @see Convolution
+
+    @tags{DSP}
+*/
+class JUCE_API  MatrixConvolution
+{
+public:
+    //==============================================================================
+    /** Initialises an object for performing matrix convolution. */
+    MatrixConvolution();
+
+    /** Initialises an object for performing matrix convolution, using a shared
+        background message queue.
+
+        IMPORTANT: the queue *must* remain alive throughout the lifetime of the
+        MatrixConvolution.
+    */
+    explicit MatrixConvolution (ConvolutionMessageQueue& queue);
+
+    ~MatrixConvolution() noexcept;
+
+    //==============================================================================
+    /** Must be called before first calling process.
+
+        The numChannels in the ProcessSpec must be at least as large as the number
+        of output channels that will be passed to process().
+
+        Calling prepare() will ensure that the impulse responses supplied to the most
+        recent call to loadImpulseResponses() are fully initialised, and will be active
+        during the next call to process().
+    */
+    void prepare (const ProcessSpec&);
+
+    /** Resets the processing pipeline ready to start a new stream of data. */
+    void reset() noexcept;
+
+    /** Performs the convolution on the given set of samples.
+
+        The input and output blocks may have different numbers of channels. Missing
+        inputs are treated as silence, and any outputs beyond the size of the matrix
+        are cleared. When the context is bypassed, the input is copied to the output.
+    */
+    template <typename ProcessContext,
+              std::enable_if_t<std::is_same_v<typename ProcessContext::SampleType, float>, int> = 0>
+    void process (const ProcessContext& context) noexcept
+    {
+        processSamples (context.getInputBlock(), context.getOutputBlock(), context.isBypassed);
+    }
+
+    //==============================================================================
+    /** Loads a matrix of impulse responses from an audio buffer.
+
+        To avoid memory allocation on the audio thread, this function takes
+        ownership of the buffer passed in. The number of outputs is the number of
+        channels in the buffer divided by the number of inputs.
+
+        @param buffer                   the AudioBuffer to use, laid out as described in the class description
+        @param bufferSampleRate         the sampleRate of the data in the AudioBuffer
+        @param numInputs                the number of inputs in the matrix
+        @param requiresTrimming         optionally trim the start and the end of the impulse responses
+        @param requiresNormalisation    optionally normalise the impulse response amplitudes
+    */
+    void loadImpulseResponses (AudioBuffer<float>&& buffer, double bufferSampleRate, int numInputs,
+                               Convolution::Trim requiresTrimming, Convolution::Normalise requiresNormalisation);
+
+    /** Returns the number of inputs of the current matrix. */
+    int getNumInputs() const;
+
+    /** Returns the number of outputs of the current matrix. */
+    int getNumOutputs() const;
+
+    /** Returns the size of the current impulse responses in samples. */
+    int getCurrentIRSize() const;
+
+private:
+    //==============================================================================
+    explicit MatrixConvolution (OptionalScopedPointer<ConvolutionMessageQueue>&&);
+
+    void processSamples (const AudioBlock<const float>&, AudioBlock<float>&, bool isBypassed) noexcept;
+
+    //==============================================================================
+    class Impl;
+    std::unique_ptr<Impl> pimpl;
+
+    bool isActive = false;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MatrixConvolution)
+};
+
 } // namespace juce::dsp
@@ -546,6 +546,81 @@ public:
             }
         }
 
+        beginTest ("Non-uniform convolutions with long tails work");
+        {
+            const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 80);
+
+            testConvolution (spec,
+                             Convolution::NonUniform { 256 },
+                             ramp,
+                             spec.sampleRate,
+                             Convolution::Stereo::yes,
+                             Convolution::Trim::no,
+                             Convolution::Normalise::no,
+                             ramp);
+        }
+
+        beginTest ("Non-uniform convolutions match uniform convolutions with varying block sizes");
+        {
+            Random random (1);
+
+            const auto ir = [&]
+            {
+                AudioBuffer<float> result (2, 30000);
+
+                for (auto channel = 0; channel != result.getNumChannels(); ++channel)
+                    for (auto sample = 0; sample != result.getNumSamples(); ++sample)
+                        result.setSample (channel, sample, (random.nextFloat() * 2.0f - 1.0f) * 0.05f
+                                                           * std::exp (-4.0f * (float) sample / (float) result.getNumSamples()));
+
+                return result;
+            }();
+
+            Convolution uniform, nonUniform (Convolution::NonUniform { 256 });
+
+            for (auto* convolution : { &uniform, &nonUniform })
+            {
+                auto copiedIr = ir;
+                convolution->loadImpulseResponse (std::move (copiedIr), spec.sampleRate, Convolution::Stereo::yes, Convolution::Trim::no, Convolution::Normalise::no);
+                convolution->prepare (spec);
+            }
+
+            AudioBuffer<float> uniformBuffer (static_cast<int> (spec.numChannels), static_cast<int> (spec.maximumBlockSize));
+            AudioBuffer<float> nonUniformBuffer (uniformBuffer.getNumChannels(), uniformBuffer.getNumSamples());
+            auto maxError = 0.0f;
+
+            for (auto i = 0; i != 400; ++i)
+            {
+                // Check that partially-processed partitions are discarded properly
+                if (i == 200)
+                {
+                    uniform.reset();
+                    nonUniform.reset();
+                }
+
+                const auto numSamples = (size_t) random.nextInt ({ 1, static_cast<int> (spec.maximumBlockSize) + 1 });
+
+                for (auto channel = 0; channel != uniformBuffer.getNumChannels(); ++channel)
+                    for (auto sample = 0; sample != uniformBuffer.getNumSamples(); ++sample)
+                        uniformBuffer.setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+                nonUniformBuffer.makeCopyOf (uniformBuffer, true);
+
+                auto uniformBlock    = AudioBlock<float> (uniformBuffer).getSubBlock (0, numSamples);
+                auto nonUniformBlock = AudioBlock<float> (nonUniformBuffer).getSubBlock (0, numSamples);
+
+                uniform.process (ProcessContextReplacing<float> (uniformBlock));
+                nonUniform.process (ProcessContextReplacing<float> (nonUniformBlock));
+
+                for (size_t channel = 0; channel != uniformBlock.getNumChannels(); ++channel)
+                    for (size_t sample = 0; sample != numSamples; ++sample)
+                        maxError = jmax (maxError, std::abs (uniformBlock.getSample ((int) channel, (int) sample)
+                                                             - nonUniformBlock.getSample ((int) channel, (int) sample)));
+            }
+
+            expectLessThan (maxError, 1.0e-4f);
+        }
+
         beginTest ("Convolutions with latency work");
         {
             const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 8);
@@ -572,6 +647,311 @@ public:
 
 ConvolutionTest convolutionUnitTest;
 
+//==============================================================================
+class MatrixConvolutionTest final : public UnitTest
+{
+public:
+    MatrixConvolutionTest()
+        : UnitTest ("MatrixConvolution", UnitTestCategories::dsp)
+    {}
+
+    static AudioBuffer<float> makeNoise (Random& random, int numChannels, int numSamples, float level)
+    {
+        AudioBuffer<float> result (numChannels, numSamples);
+
+        for (auto channel = 0; channel != numChannels; ++channel)
+            for (auto sample = 0; sample != numSamples; ++sample)
+                result.setSample (channel, sample, (random.nextFloat() * 2.0f - 1.0f) * level);
+
+        return result;
+    }
+
+    // Convolves each input with each impulse response in the time domain
+    static AudioBuffer<float> convolveDirectly (const AudioBuffer<float>& input, const AudioBuffer<float>& irs)
+    {
+        const auto numInputs = input.getNumChannels();
+        const auto numOutputs = irs.getNumChannels() / numInputs;
+        AudioBuffer<float> result (numOutputs, input.getNumSamples());
+        result.clear();
+
+        for (auto output = 0; output != numOutputs; ++output)
+            for (auto in = 0; in != numInputs; ++in)
+                for (auto sample = 0; sample != input.getNumSamples(); ++sample)
+                    for (auto k = 0; k <= jmin (sample, irs.getNumSamples() - 1); ++k)
+                        result.addSample (output, sample, irs.getSample (output * numInputs + in, k) * input.getSample (in, sample - k));
+
+        return result;
+    }
+
+    // Processes the input in blocks of random sizes, and returns the largest
+    // difference from the expected output
+    static float processAndCompare (Random& random,
+                                    MatrixConvolution& convolution,
+                                    const AudioBuffer<float>& input,
+                                    const AudioBuffer<float>& expected,
+                                    int maxBlockSize,
+                                    bool inPlace)
+    {
+        const auto numChannels = jmax (input.getNumChannels(), expected.getNumChannels());
+        AudioBuffer<float> inputBuffer (numChannels, maxBlockSize), outputBuffer (numChannels, maxBlockSize);
+        auto maxError = 0.0f;
+
+        for (auto position = 0; position < input.getNumSamples();)
+        {
+            const auto numSamples = jmin (random.nextInt ({ 1, maxBlockSize + 1 }), input.getNumSamples() - position);
+
+            inputBuffer.clear();
+
+            for (auto channel = 0; channel != input.getNumChannels(); ++channel)
+                inputBuffer.copyFrom (channel, 0, input, channel, position, numSamples);
+
+            const auto inputBlock = AudioBlock<float> (inputBuffer).getSubBlock (0, (size_t) numSamples)
+                                                                   .getSubsetChannelBlock (0, (size_t) input.getNumChannels());
+            auto outputBlock = AudioBlock<float> (outputBuffer).getSubBlock (0, (size_t) numSamples)
+                                                               .getSubsetChannelBlock (0, (size_t) expected.getNumChannels());
+
+            if (inPlace)
+            {
+                auto block = AudioBlock<float> (inputBuffer).getSubBlock (0, (size_t) numSamples);
+                convolution.process (ProcessContextReplacing<float> (block));
+                outputBlock.copyFrom (block);
+            }
+            else
+            {
+                convolution.process (ProcessContextNonReplacing<float> (inputBlock, outputBlock));
+            }
+
+            for (auto channel = 0; channel != expected.getNumChannels(); ++channel)
+                for (auto sample = 0; sample != numSamples; ++sample)
+                    maxError = jmax (maxError, std::abs (outputBlock.getSample (channel, sample)
+                                                         - expected.getSample (channel, position + sample)));
+
+            position += numSamples;
+        }
+
+        return maxError;
+    }
+
+    void runTest() override
+    {
+        Random random (1);
+
+        beginTest ("Each output is the sum of every input convolved with its own impulse response");
+        {
+            const ProcessSpec spec { 44100.0, 256, 3 };
+            const auto irs = makeNoise (random, 6, 700, 0.1f);
+            const auto input = makeNoise (random, 2, 3000, 1.0f);
+            const auto expected = convolveDirectly (input, irs);
+
+            MatrixConvolution convolution;
+            auto copiedIrs = irs;
+            convolution.loadImpulseResponses (std::move (copiedIrs), spec.sampleRate, 2, Convolution::Trim::no, Convolution::Normalise::no);
+            convolution.prepare (spec);
+
+            expectEquals (convolution.getNumInputs(), 2);
+            expectEquals (convolution.getNumOutputs(), 3);
+            expectEquals (convolution.getCurrentIRSize(), 700);
+
+            expectLessThan (processAndCompare (random, convolution, input, expected, (int) spec.maximumBlockSize, false), 1.0e-4f);
+
+            convolution.reset();
+            expectLessThan (processAndCompare (random, convolution, input, expected, (int) spec.maximumBlockSize, false), 1.0e-4f);
+        }
+
+        beginTest ("True stereo convolutions can be processed in place");
+        {
+            const ProcessSpec spec { 44100.0, 64, 2 };
+            const auto irs = makeNoise (random, 4, 1000, 0.1f);
+            const auto input = makeNoise (random, 2, 3000, 1.0f);
+            const auto expected = convolveDirectly (input, irs);
+
+            MatrixConvolution convolution;
+            auto copiedIrs = irs;
+            convolution.loadImpulseResponses (std::move (copiedIrs), spec.sampleRate, 2, Convolution::Trim::no, Convolution::Normalise::no);
+            convolution.prepare (spec);
+
+            expectLessThan (processAndCompare (random, convolution, input, expected, (int) spec.maximumBlockSize, true), 1.0e-4f);
+        }
+
+        beginTest ("Inputs are passed through until impulse responses are loaded");
+        {
+            const ProcessSpec spec { 44100.0, 128, 2 };
+            const auto input = makeNoise (random, 2, 1000, 1.0f);
+
+            MatrixConvolution convolution;
+            convolution.prepare (spec);
+
+            expectLessThan (processAndCompare (random, convolution, input, input, (int) spec.maximumBlockSize, false), 1.0e-5f);
+        }
+
+        beginTest ("Impulse responses can be loaded without allocating on the audio thread");
+        {
+            const ProcessSpec spec { 44100.0, 128, 4 };
+            auto irs = makeNoise (random, 16, 2000, 0.1f);
+            AudioBuffer<float> buffer ((int) spec.numChannels, (int) spec.maximumBlockSize);
+            AudioBlock<float> block (buffer);
+
+            MatrixConvolution convolution;
+            convolution.prepare (spec);
+
+            {
+                JUCE_FAIL_ON_ALLOCATION_IN_SCOPE;
+
+                convolution.loadImpulseResponses (std::move (irs), spec.sampleRate, 4, Convolution::Trim::no, Convolution::Normalise::yes);
+
+                const auto time = Time::getMillisecondCounter();
+
+                while (convolution.getCurrentIRSize() != 2000 && Time::getMillisecondCounter() - time < 10'000)
+                {
+                    block.clear();
+                    convolution.process (ProcessContextReplacing<float> (block));
+                }
+            }
+
+            expectEquals (convolution.getNumInputs(), 4);
+            expectEquals (convolution.getNumOutputs(), 4);
+            expectEquals (convolution.getCurrentIRSize(), 2000);
+        }
+    }
+};
+
+static MatrixConvolutionTest matrixConvolutionTest;
+
+//==============================================================================
+class ConvolutionBenchmark final : public Benchmark
+{
+public:
+    ConvolutionBenchmark()
+        : Benchmark ("Convolution", UnitTestCategories::dsp)
+    {}
+
+    void runBenchmark() override
+    {
+        constexpr auto sampleRate = 48000.0;
+
+        // Five seconds of exponentially decaying noise
+        const auto ir = []
+        {
+            Random random (1);
+            AudioBuffer<float> result (2, (int) (5.0 * sampleRate));
+
+            for (auto channel = 0; channel != result.getNumChannels(); ++channel)
+                for (auto sample = 0; sample != result.getNumSamples(); ++sample)
+                    result.setSample (channel, sample, (random.nextFloat() * 2.0f - 1.0f)
+                                                       * std::exp (-6.0f * (float) sample / (float) result.getNumSamples()));
+
+            return result;
+        }();
+
+        for (auto blockSize : { 64, 256 })
+        {
+            const ProcessSpec spec { sampleRate, (uint32) blockSize, 2 };
+            AudioBuffer<float> buffer (2, blockSize);
+            AudioBlock<float> block (buffer);
+            Random random (2);
+
+            const auto measureConvolution = [&] (const String& caseName, Convolution& convolution)
+            {
+                auto copiedIr = ir;
+                convolution.loadImpulseResponse (std::move (copiedIr), sampleRate, Convolution::Stereo::yes, Convolution::Trim::no, Convolution::Normalise::no);
+                convolution.prepare (spec);
+
+                measure (caseName + " (" + String (blockSize) + " sample blocks)", [&]
+                {
+                    for (auto channel = 0; channel != buffer.getNumChannels(); ++channel)
+                        buffer.setSample (channel, 0, random.nextFloat());
+
+                    convolution.process (ProcessContextReplacing<float> (block));
+                    doNotOptimise (buffer.getSample (0, 0));
+                }, blockSize);
+            };
+
+            Convolution uniform;
+            measureConvolution ("Uniform", uniform);
+
+            Convolution nonUniform (Convolution::NonUniform { 1024 });
+            measureConvolution ("Non-uniform", nonUniform);
+        }
+    }
+};
+
+static ConvolutionBenchmark convolutionBenchmark;
+
+//==============================================================================
+class MatrixConvolutionBenchmark final : public Benchmark
+{
+public:
+    MatrixConvolutionBenchmark()
+        : Benchmark ("MatrixConvolution", UnitTestCategories::dsp)
+    {}
+
+    void runBenchmark() override
+    {
+        constexpr auto sampleRate = 48000.0;
+        constexpr auto blockSize = 256;
+        constexpr auto irLength = 24000;
+
+        Random random (1);
+
+        for (auto numChannels : { 2, 4 })
+        {
+            const ProcessSpec spec { sampleRate, (uint32) blockSize, (uint32) numChannels };
+            const auto irs = MatrixConvolutionTest::makeNoise (random, numChannels * numChannels, irLength, 0.01f);
+            const auto caseSuffix = " (" + String (numChannels) + "x" + String (numChannels) + ", "
+                                  + String (irLength) + " sample IRs)";
+
+            auto input = MatrixConvolutionTest::makeNoise (random, numChannels, blockSize, 1.0f);
+            AudioBuffer<float> output (numChannels, blockSize), temp (1, blockSize);
+
+            // One mono Convolution for each pair of input and output
+            std::vector<std::unique_ptr<Convolution>> convolutions;
+
+            for (auto channel = 0; channel != irs.getNumChannels(); ++channel)
+            {
+                AudioBuffer<float> ir (1, irLength);
+                ir.copyFrom (0, 0, irs, channel, 0, irLength);
+
+                auto& convolution = *convolutions.emplace_back (std::make_unique<Convolution>());
+                convolution.loadImpulseResponse (std::move (ir), sampleRate, Convolution::Stereo::no, Convolution::Trim::no, Convolution::Normalise::no);
+                convolution.prepare ({ sampleRate, (uint32) blockSize, 1 });
+            }
+
+            measure ("Separate Convolutions" + caseSuffix, [&]
+            {
+                output.clear();
+
+                for (auto out = 0; out != numChannels; ++out)
+                {
+                    for (auto in = 0; in != numChannels; ++in)
+                    {
+                        const auto inputBlock = AudioBlock<float> (input).getSingleChannelBlock ((size_t) in);
+                        auto tempBlock = AudioBlock<float> (temp);
+                        convolutions[(size_t) (out * numChannels + in)]->process (ProcessContextNonReplacing<float> (inputBlock, tempBlock));
+                        output.addFrom (out, 0, temp, 0, 0, blockSize);
+                    }
+                }
+
+                doNotOptimise (output.getSample (0, 0));
+            }, blockSize);
+
+            MatrixConvolution matrix;
+            auto copiedIrs = irs;
+            matrix.loadImpulseResponses (std::move (copiedIrs), sampleRate, numChannels, Convolution::Trim::no, Convolution::Normalise::no);
+            matrix.prepare (spec);
+
+            measure ("MatrixConvolution" + caseSuffix, [&]
+            {
+                const auto inputBlock = AudioBlock<float> (input);
+                auto outputBlock = AudioBlock<float> (output);
+                matrix.process (ProcessContextNonReplacing<float> (inputBlock, outputBlock));
+                doNotOptimise (output.getSample (0, 0));
+            }, blockSize);
+        }
+    }
+};
+
+static MatrixConvolutionBenchmark matrixConvolutionBenchmark;
+
 }
 } // namespace juce::dsp
 
@@ -32,6 +32,19 @@ struct FFT::Instance
     virtual void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept = 0;
     virtual void performRealOnlyForwardTransform (float*, bool) const noexcept = 0;
     virtual void performRealOnlyInverseTransform (float*) const noexcept = 0;
+
+    // Engines that can transform several channels at once can override these
+    virtual void performRealOnlyForwardTransforms (float* const* channels, int numChannels, bool ignoreNegativeFreqs) const noexcept
+    {
+        for (int i = 0; i < numChannels; ++i)
+            performRealOnlyForwardTransform (channels[i], ignoreNegativeFreqs);
+    }
+
+    virtual void performRealOnlyInverseTransforms (float* const* channels, int numChannels) const noexcept
+    {
+        for (int i = 0; i < numChannels; ++i)
+            performRealOnlyInverseTransform (channels[i]);
+    }
 };
 
 struct FFT::Engine
@@ -429,6 +442,724 @@ struct FFTFallback final : public FFT::Instance
 
 FFT::EngineImpl<FFTFallback> fftFallback;
 
+//==============================================================================
+//==============================================================================
+#if JUCE_USE_SIMD
+/*  A radix-4 decimation-in-frequency FFT that keeps the real and imaginary parts in
+    separate arrays, so that each SIMDRegister holds the same part of neighbouring
+    values and the butterflies don't need any shuffling.
+
+    The last few butterflies, which work on groups smaller than a register, are done
+    with scalar code that also writes the results out in bit-reversed order.
+
+    Real transforms of size N are done as a complex transform of size N / 2 on the
+    even and odd samples, followed by a vectorised pass that separates their spectra.
+*/
+struct SIMDFFT final : public FFT::Instance
+{
+    // faster than the fallback, but slower than any of the library-based engines
+    static constexpr int priority = 0;
+
+    using Vec = SIMDRegister<float>;
+    static constexpr int vecSize = (int) Vec::size();
+
+    static_assert (vecSize <= 8, "The smallest supported transform must fill a register");
+
+    static SIMDFFT* create (int order)
+    {
+        // The real transforms need a complex transform of at least one register
+        if (order < 4)
+            return nullptr;
+
+        return new SIMDFFT (order);
+    }
+
+    explicit SIMDFFT (int order)
+        : size (1 << order),
+          complexPlan (size),
+          realPlan (size / 2),
+          realCoefficients ((size_t) size * 2),
+          scratch ((size_t) size * (size_t) vecSize),
+          laneTwiddles ((size_t) size / 2)
+    {
+        const auto halfSize = size / 2;
+        auto* forwardRe = realCoefficients.data;
+        auto* forwardIm = forwardRe + halfSize;
+        auto* inverseRe = forwardIm + halfSize;
+        auto* inverseIm = inverseRe + halfSize;
+
+        for (int k = 0; k < halfSize; ++k)
+        {
+            const auto phase = MathConstants<double>::twoPi * k / size;
+            const auto c = std::cos (phase), s = std::sin (phase);
+
+            // -i * exp (-i * phase) / 2, and i * exp (i * phase) / size
+            forwardRe[k] = (float) (-0.5 * s);
+            forwardIm[k] = (float) (-0.5 * c);
+            inverseRe[k] = (float) (-s / size);
+            inverseIm[k] = (float) (c / size);
+
+            const auto lanePhase = -MathConstants<double>::twoPi * k / halfSize;
+            laneTwiddles[(size_t) k] = { (float) std::cos (lanePhase), (float) std::sin (lanePhase) };
+        }
+    }
+
+    void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        auto* re = scratch.data;
+        auto* im = re + size;
+
+        float* const splitInput[] { re, im };
+        FloatVectorOperations::deinterleave (splitInput, reinterpret_cast<const float*> (input), 2, size);
+
+        auto* out = reinterpret_cast<float*> (output);
+        const auto scale = inverse ? 1.0f / (float) size : 1.0f;
+
+        const auto writeOutput = [out, scale] (int index, float r, float i)
+        {
+            out[2 * index]     = r * scale;
+            out[2 * index + 1] = i * scale;
+        };
+
+        if (inverse)
+            complexPlan.perform<true> (re, im, writeOutput);
+        else
+            complexPlan.perform<false> (re, im, writeOutput);
+    }
+
+    void performRealOnlyForwardTransform (float* d, bool ignoreNegativeFreqs) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        const auto halfSize = size / 2;
+        auto* evenOdd  = scratch.data;
+        auto* zRe      = evenOdd + size;
+        auto* zIm      = zRe + halfSize;
+        auto* mirrorRe = zIm + halfSize;
+        auto* mirrorIm = mirrorRe + halfSize;
+
+        // The even samples become the real parts, and the odd samples the imaginary parts
+        float* const splitInput[] { evenOdd, evenOdd + halfSize };
+        FloatVectorOperations::deinterleave (splitInput, d, 2, halfSize);
+
+        // Z[k] is needed alongside Z[halfSize - k], so keep a mirrored copy too
+        realPlan.perform<false> (splitInput[0], splitInput[1], [=] (int index, float r, float i)
+        {
+            const auto mirrored = (halfSize - index) & (halfSize - 1);
+            zRe[index] = r;
+            zIm[index] = i;
+            mirrorRe[mirrored] = r;
+            mirrorIm[mirrored] = i;
+        });
+
+        const auto* forwardRe = realCoefficients.data;
+        const auto* forwardIm = forwardRe + halfSize;
+        const auto half = Vec::expand (0.5f);
+
+        for (int k = 0; k < halfSize; k += vecSize)
+        {
+            const auto ar = load (zRe + k),      ai = load (zIm + k);
+            const auto br = load (mirrorRe + k), bi = load (mirrorIm + k);
+            const auto sumRe  = ar + br, sumIm  = ai - bi;
+            const auto diffRe = ar - br, diffIm = ai + bi;
+            const auto cr = load (forwardRe + k), ci = load (forwardIm + k);
+
+            (sumRe * half + cr * diffRe - ci * diffIm).copyToRawArray (splitInput[0] + k);
+            (sumIm * half + cr * diffIm + ci * diffRe).copyToRawArray (splitInput[1] + k);
+        }
+
+        const float* const splitOutput[] { splitInput[0], splitInput[1] };
+        FloatVectorOperations::interleave (d, splitOutput, 2, halfSize);
+
+        d[size] = zRe[0] - zIm[0];
+        d[size + 1] = 0.0f;
+
+        if (! ignoreNegativeFreqs)
+        {
+            auto* out = reinterpret_cast<Complex<float>*> (d);
+
+            for (int k = 1; k < halfSize; ++k)
+                out[size - k] = std::conj (out[k]);
+        }
+    }
+
+    void performRealOnlyInverseTransform (float* d) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        const auto halfSize = size / 2;
+        auto* xRe      = scratch.data;
+        auto* xIm      = xRe + halfSize;
+        auto* mirrorRe = xIm + halfSize;
+        auto* mirrorIm = mirrorRe + halfSize;
+
+        for (int k = 0; k < halfSize; ++k)
+        {
+            xRe[k] = d[2 * k];
+            xIm[k] = d[2 * k + 1];
+            mirrorRe[k] = d[size - 2 * k];
+            mirrorIm[k] = d[size - 2 * k + 1];
+        }
+
+        // Recombine the spectra of the even and odd samples, including the 1 / size scaling
+        const auto* inverseRe = realCoefficients.data + size;
+        const auto* inverseIm = inverseRe + halfSize;
+        const auto scale = Vec::expand (1.0f / (float) size);
+
+        for (int k = 0; k < halfSize; k += vecSize)
+        {
+            const auto ar = load (xRe + k),      ai = load (xIm + k);
+            const auto br = load (mirrorRe + k), bi = load (mirrorIm + k);
+            const auto sumRe  = ar + br, sumIm  = ai - bi;
+            const auto diffRe = ar - br, diffIm = ai + bi;
+            const auto cr = load (inverseRe + k), ci = load (inverseIm + k);
+
+            (sumRe * scale + cr * diffRe - ci * diffIm).copyToRawArray (xRe + k);
+            (sumIm * scale + cr * diffIm + ci * diffRe).copyToRawArray (xIm + k);
+        }
+
+        realPlan.perform<true> (xRe, xIm, [d] (int index, float r, float i)
+        {
+            d[2 * index]     = r;
+            d[2 * index + 1] = i;
+        });
+    }
+
+    /*  The batched transforms give each channel its own lane of the registers, so every
+        step of the transform works on several channels at once, and there's no need for
+        the scalar tail that the single-channel transforms use.
+    */
+    void performRealOnlyForwardTransforms (float* const* channels, int numChannels, bool ignoreNegativeFreqs) const noexcept override
+    {
+        for (int first = 0; first < numChannels; first += vecSize)
+        {
+            const auto num = jmin (vecSize, numChannels - first);
+
+            if (num == 1)
+                performRealOnlyForwardTransform (channels[first], ignoreNegativeFreqs);
+            else
+                performLanesForward (channels + first, num, ignoreNegativeFreqs);
+        }
+    }
+
+    void performRealOnlyInverseTransforms (float* const* channels, int numChannels) const noexcept override
+    {
+        for (int first = 0; first < numChannels; first += vecSize)
+        {
+            const auto num = jmin (vecSize, numChannels - first);
+
+            if (num == 1)
+                performRealOnlyInverseTransform (channels[first]);
+            else
+                performLanesInverse (channels + first, num);
+        }
+    }
+
+private:
+    //==============================================================================
+    struct AlignedBuffer
+    {
+        explicit AlignedBuffer (size_t numElements)
+            : storage (numElements + (size_t) vecSize, true),
+              data (Vec::getNextSIMDAlignedPtr (storage.get()))
+        {}
+
+        HeapBlock<float> storage;
+        float* data;
+    };
+
+    static forcedinline Vec load (const float* src) noexcept     { return Vec::fromRawArray (src); }
+
+    static int reverseBits (int value, int numBits) noexcept
+    {
+        int result = 0;
+
+        for (; numBits > 0; --numBits, value >>= 1)
+            result = (result << 1) | (value & 1);
+
+        return result;
+    }
+
+    template <bool inverse>
+    static forcedinline void multiplyByTwiddle (Vec& re, Vec& im, Vec wr, Vec wi) noexcept
+    {
+        const auto r = re;
+
+        if constexpr (inverse)
+        {
+            re = r * wr + im * wi;
+            im = im * wr - r * wi;
+        }
+        else
+        {
+            re = r * wr - im * wi;
+            im = r * wi + im * wr;
+        }
+    }
+
+    template <bool inverse>
+    static forcedinline void radix2Butterfly (Vec* r, Vec* i, Vec wr, Vec wi) noexcept
+    {
+        auto dr = r[0] - r[1], di = i[0] - i[1];
+        r[0] += r[1];
+        i[0] += i[1];
+        multiplyByTwiddle<inverse> (dr, di, wr, wi);
+        r[1] = dr;
+        i[1] = di;
+    }
+
+    /*  Does the work of two radix-2 decimation-in-frequency stages on the values that are
+        a quarter of a block apart. The twiddles are the first, second and third powers.
+    */
+    template <bool inverse>
+    static forcedinline void radix4Butterfly (Vec* r, Vec* i, const Vec* wr, const Vec* wi) noexcept
+    {
+        const auto t0r = r[0] + r[2], t0i = i[0] + i[2];
+        const auto t1r = r[0] - r[2], t1i = i[0] - i[2];
+        const auto t2r = r[1] + r[3], t2i = i[1] + i[3];
+        const auto t3r = r[1] - r[3], t3i = i[1] - i[3];
+
+        r[0] = t0r + t2r;
+        i[0] = t0i + t2i;
+        r[1] = t0r - t2r;
+        i[1] = t0i - t2i;
+
+        // t3 is multiplied by -i for the forward transform, or i for the inverse
+        r[2] = inverse ? t1r - t3i : t1r + t3i;
+        i[2] = inverse ? t1i + t3r : t1i - t3r;
+        r[3] = inverse ? t1r + t3i : t1r - t3i;
+        i[3] = inverse ? t1i - t3r : t1i + t3r;
+
+        multiplyByTwiddle<inverse> (r[1], i[1], wr[1], wi[1]);
+        multiplyByTwiddle<inverse> (r[2], i[2], wr[0], wi[0]);
+        multiplyByTwiddle<inverse> (r[3], i[3], wr[2], wi[2]);
+    }
+
+    //==============================================================================
+    /*  A complex transform of size / 2 on interleaved lanes, with the twiddles shared
+        between the lanes. The results are left in bit-reversed order, and the inverse
+        isn't scaled.
+    */
+    template <bool inverse>
+    void performLanes (float* re, float* im) const noexcept
+    {
+        const auto n = size / 2;
+        auto blockSize = n;
+
+        if (roundToInt (std::log2 (n)) % 2 != 0)
+        {
+            const auto half = blockSize / 2;
+
+            for (int j = 0; j < half; ++j)
+            {
+                Vec r[2] { load (re + j * vecSize), load (re + (j + half) * vecSize) };
+                Vec i[2] { load (im + j * vecSize), load (im + (j + half) * vecSize) };
+
+                const auto w = laneTwiddles[(size_t) j];
+                radix2Butterfly<inverse> (r, i, Vec::expand (w.real()), Vec::expand (w.imag()));
+
+                for (int m = 0; m < 2; ++m)
+                {
+                    r[m].copyToRawArray (re + (j + m * half) * vecSize);
+                    i[m].copyToRawArray (im + (j + m * half) * vecSize);
+                }
+            }
+
+            blockSize = half;
+        }
+
+        for (; blockSize > 1; blockSize /= 4)
+        {
+            const auto q = blockSize / 4;
+            const auto twiddleStride = n / blockSize;
+
+            for (int block = 0; block < n; block += blockSize)
+            {
+                for (int j = 0; j < q; ++j)
+                {
+                    Vec r[4], i[4], wr[3], wi[3];
+
+                    for (int m = 0; m < 4; ++m)
+                    {
+                        r[m] = load (re + (block + j + m * q) * vecSize);
+                        i[m] = load (im + (block + j + m * q) * vecSize);
+                    }
+
+                    for (int power = 1; power < 4; ++power)
+                    {
+                        const auto w = laneTwiddles[(size_t) (power * j * twiddleStride)];
+                        wr[power - 1] = Vec::expand (w.real());
+                        wi[power - 1] = Vec::expand (w.imag());
+                    }
+
+                    radix4Butterfly<inverse> (r, i, wr, wi);
+
+                    for (int m = 0; m < 4; ++m)
+                    {
+                        r[m].copyToRawArray (re + (block + j + m * q) * vecSize);
+                        i[m].copyToRawArray (im + (block + j + m * q) * vecSize);
+                    }
+                }
+            }
+        }
+    }
+
+    void performLanesForward (float* const* channels, int numChannels, bool ignoreNegativeFreqs) const noexcept
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        const auto halfSize = size / 2;
+        auto* re = scratch.data;
+        auto* im = re + halfSize * vecSize;
+
+        // The even samples become the real parts, and the odd samples the imaginary parts
+        if (numChannels < vecSize)
+            std::fill (re, re + size * vecSize, 0.0f);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int k = 0; k < halfSize; ++k)
+            {
+                re[k * vecSize + ch] = channels[ch][2 * k];
+                im[k * vecSize + ch] = channels[ch][2 * k + 1];
+            }
+        }
+
+        performLanes<false> (re, im);
+
+        // Separates the spectra of Z[k] and Z[halfSize - k] into X[k] and X[halfSize - k]
+        const auto* forwardRe = realCoefficients.data;
+        const auto* forwardIm = forwardRe + halfSize;
+        const auto half = Vec::expand (0.5f);
+        alignas (Vec::SIMDRegisterSize) float lanesRe[vecSize], lanesIm[vecSize];
+
+        const auto writeLanes = [&] (int index, Vec valueRe, Vec valueIm)
+        {
+            valueRe.copyToRawArray (lanesRe);
+            valueIm.copyToRawArray (lanesIm);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                channels[ch][2 * index]     = lanesRe[ch];
+                channels[ch][2 * index + 1] = lanesIm[ch];
+            }
+        };
+
+        const auto separate = [&] (int k, Vec ar, Vec ai, Vec br, Vec bi)
+        {
+            const auto sumRe  = ar + br, sumIm  = ai - bi;
+            const auto diffRe = ar - br, diffIm = ai + bi;
+            const auto cr = Vec::expand (forwardRe[k]), ci = Vec::expand (forwardIm[k]);
+
+            writeLanes (k, sumRe * half + cr * diffRe - ci * diffIm,
+                           sumIm * half + cr * diffIm + ci * diffRe);
+        };
+
+        for (int k = 0; k <= halfSize / 2; ++k)
+        {
+            const auto mirrored = (halfSize - k) & (halfSize - 1);
+            const auto a = realPlan.getBitReversedIndex (k) * vecSize;
+            const auto b = realPlan.getBitReversedIndex (mirrored) * vecSize;
+            const auto ar = load (re + a), ai = load (im + a);
+            const auto br = load (re + b), bi = load (im + b);
+
+            separate (k, ar, ai, br, bi);
+
+            if (k == 0)
+                writeLanes (halfSize, ar - ai, Vec::expand (0.0f));
+            else if (mirrored != k)
+                separate (mirrored, br, bi, ar, ai);
+        }
+
+        if (! ignoreNegativeFreqs)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto* out = reinterpret_cast<Complex<float>*> (channels[ch]);
+
+                for (int k = 1; k < halfSize; ++k)
+                    out[size - k] = std::conj (out[k]);
+            }
+        }
+    }
+
+    void performLanesInverse (float* const* channels, int numChannels) const noexcept
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        const auto halfSize = size / 2;
+        auto* re = scratch.data;
+        auto* im = re + halfSize * vecSize;
+        alignas (Vec::SIMDRegisterSize) float nyquistRe[vecSize] {}, nyquistIm[vecSize] {};
+
+        if (numChannels < vecSize)
+            std::fill (re, re + size * vecSize, 0.0f);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int k = 0; k < halfSize; ++k)
+            {
+                re[k * vecSize + ch] = channels[ch][2 * k];
+                im[k * vecSize + ch] = channels[ch][2 * k + 1];
+            }
+
+            nyquistRe[ch] = channels[ch][size];
+            nyquistIm[ch] = channels[ch][size + 1];
+        }
+
+        // Recombines X[k] and X[halfSize - k] into Z[k] and Z[halfSize - k], including
+        // the 1 / size scaling
+        const auto* inverseRe = realCoefficients.data + size;
+        const auto* inverseIm = inverseRe + halfSize;
+        const auto scale = Vec::expand (1.0f / (float) size);
+
+        const auto combine = [&] (int k, Vec ar, Vec ai, Vec br, Vec bi)
+        {
+            const auto sumRe  = ar + br, sumIm  = ai - bi;
+            const auto diffRe = ar - br, diffIm = ai + bi;
+            const auto cr = Vec::expand (inverseRe[k]), ci = Vec::expand (inverseIm[k]);
+
+            (sumRe * scale + cr * diffRe - ci * diffIm).copyToRawArray (re + k * vecSize);
+            (sumIm * scale + cr * diffIm + ci * diffRe).copyToRawArray (im + k * vecSize);
+        };
+
+        for (int k = 0; k <= halfSize / 2; ++k)
+        {
+            const auto mirrored = halfSize - k;
+            const auto ar = load (re + k * vecSize), ai = load (im + k * vecSize);
+            const auto br = k == 0 ? load (nyquistRe) : load (re + mirrored * vecSize);
+            const auto bi = k == 0 ? load (nyquistIm) : load (im + mirrored * vecSize);
+
+            combine (k, ar, ai, br, bi);
+
+            if (k != 0 && mirrored != k)
+                combine (mirrored, br, bi, ar, ai);
+        }
+
+        performLanes<true> (re, im);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int k = 0; k < halfSize; ++k)
+            {
+                const auto index = realPlan.getBitReversedIndex (k) * vecSize + ch;
+                channels[ch][2 * k]     = re[index];
+                channels[ch][2 * k + 1] = im[index];
+            }
+        }
+    }
+
+    //==============================================================================
+    /*  The stages and twiddle factors for a complex transform of one size, which has
+        to be at least vecSize.
+    */
+    struct Plan
+    {
+        explicit Plan (int sizeToUse)
+            : size (sizeToUse),
+              twiddles ((size_t) sizeToUse * 2)
+        {
+            jassert (isPowerOfTwo (size) && size >= vecSize);
+
+            const auto numBlocks = size / vecSize;
+            const auto numBlockBits = roundToInt (std::log2 (numBlocks));
+            const auto numVecBits = roundToInt (std::log2 (vecSize));
+
+            for (int b = 0; b < numBlocks; ++b)
+                blockOffsets.push_back (reverseBits (b, numBlockBits));
+
+            for (int i = 0; i < vecSize; ++i)
+            {
+                elementOffsets[(size_t) i] = reverseBits (i, numVecBits) * numBlocks;
+
+                if (i < vecSize / 2)
+                {
+                    const auto phase = -MathConstants<double>::twoPi * i / vecSize;
+                    tailTwiddles[(size_t) i] = { (float) std::cos (phase), (float) std::sin (phase) };
+                }
+            }
+
+            // Each radix-4 stage does the work of two radix-2 stages, so if there's
+            // an odd number of them, the first one has to be radix-2
+            auto blockSize = size;
+            auto* tw = twiddles.data;
+
+            const auto addStage = [&] (int radix)
+            {
+                const auto length = blockSize / radix;
+                stages.push_back ({ radix, blockSize, (int) (tw - twiddles.data) });
+
+                for (int power = 1; power < radix; ++power)
+                {
+                    for (int j = 0; j < length; ++j)
+                    {
+                        const auto phase = -MathConstants<double>::twoPi * power * j / blockSize;
+                        tw[j]          = (float) std::cos (phase);
+                        tw[length + j] = (float) std::sin (phase);
+                    }
+
+                    tw += 2 * length;
+                }
+
+                blockSize /= radix;
+            };
+
+            if (numBlockBits % 2 != 0)
+                addStage (2);
+
+            while (blockSize > vecSize)
+                addStage (4);
+        }
+
+        /*  Transforms the data in-place, then calls writeResult (index, real, imag) for
+            each output value, as the last stage of the transform happens in a different order.
+            The inverse transform isn't scaled.
+        */
+        template <bool inverse, typename WriteResult>
+        void perform (float* re, float* im, WriteResult&& writeResult) const noexcept
+        {
+            for (const auto& stage : stages)
+            {
+                const auto* tw = twiddles.data + stage.twiddleOffset;
+
+                if (stage.radix == 4)
+                    performRadix4<inverse> (re, im, stage.blockSize, tw);
+                else
+                    performRadix2<inverse> (re, im, stage.blockSize, tw);
+            }
+
+            performTail<inverse> (re, im, writeResult);
+        }
+
+        /*  Returns the position of the result for the given index, when the transform
+            is done without reordering.
+        */
+        int getBitReversedIndex (int index) const noexcept
+        {
+            return blockOffsets[(size_t) (index / vecSize)] + elementOffsets[(size_t) (index % vecSize)];
+        }
+
+    private:
+        template <bool inverse>
+        void performRadix2 (float* re, float* im, int blockSize, const float* tw) const noexcept
+        {
+            const auto half = blockSize / 2;
+
+            for (int block = 0; block < size; block += blockSize)
+            {
+                auto* r = re + block;
+                auto* i = im + block;
+
+                for (int j = 0; j < half; j += vecSize)
+                {
+                    Vec vr[2] { load (r + j), load (r + half + j) };
+                    Vec vi[2] { load (i + j), load (i + half + j) };
+
+                    radix2Butterfly<inverse> (vr, vi, load (tw + j), load (tw + half + j));
+
+                    for (int m = 0; m < 2; ++m)
+                    {
+                        vr[m].copyToRawArray (r + m * half + j);
+                        vi[m].copyToRawArray (i + m * half + j);
+                    }
+                }
+            }
+        }
+
+        template <bool inverse>
+        void performRadix4 (float* re, float* im, int blockSize, const float* tw) const noexcept
+        {
+            const auto q = blockSize / 4;
+
+            for (int block = 0; block < size; block += blockSize)
+            {
+                auto* r = re + block;
+                auto* i = im + block;
+
+                for (int j = 0; j < q; j += vecSize)
+                {
+                    Vec vr[4], vi[4];
+                    const Vec wr[] { load (tw + j),         load (tw + 2 * q + j), load (tw + 4 * q + j) };
+                    const Vec wi[] { load (tw + q + j),     load (tw + 3 * q + j), load (tw + 5 * q + j) };
+
+                    for (int m = 0; m < 4; ++m)
+                    {
+                        vr[m] = load (r + m * q + j);
+                        vi[m] = load (i + m * q + j);
+                    }
+
+                    radix4Butterfly<inverse> (vr, vi, wr, wi);
+
+                    for (int m = 0; m < 4; ++m)
+                    {
+                        vr[m].copyToRawArray (r + m * q + j);
+                        vi[m].copyToRawArray (i + m * q + j);
+                    }
+                }
+            }
+        }
+
+        template <bool inverse, typename WriteResult>
+        void performTail (const float* re, const float* im, WriteResult& writeResult) const noexcept
+        {
+            for (size_t block = 0; block < blockOffsets.size(); ++block)
+            {
+                float r[vecSize], i[vecSize];
+                std::copy (re + block * vecSize, re + (block + 1) * vecSize, r);
+                std::copy (im + block * vecSize, im + (block + 1) * vecSize, i);
+
+                for (int half = vecSize / 2, step = 1; half > 0; half /= 2, step *= 2)
+                {
+                    for (int start = 0; start < vecSize; start += 2 * half)
+                    {
+                        for (int j = 0; j < half; ++j)
+                        {
+                            const auto a = start + j, b = a + half;
+                            const auto dr = r[a] - r[b], di = i[a] - i[b];
+                            r[a] += r[b];
+                            i[a] += i[b];
+
+                            const auto w = tailTwiddles[(size_t) (j * step)];
+                            const auto wi = inverse ? -w.imag() : w.imag();
+                            r[b] = dr * w.real() - di * wi;
+                            i[b] = dr * wi + di * w.real();
+                        }
+                    }
+                }
+
+                const auto offset = blockOffsets[block];
+
+                for (int t = 0; t < vecSize; ++t)
+                    writeResult (offset + elementOffsets[(size_t) t], r[t], i[t]);
+            }
+        }
+
+        struct Stage
+        {
+            int radix, blockSize, twiddleOffset;
+        };
+
+        int size;
+        std::vector<Stage> stages;
+        AlignedBuffer twiddles;
+        std::vector<int> blockOffsets;
+        std::array<int, vecSize> elementOffsets;
+        std::array<Complex<float>, vecSize / 2> tailTwiddles;
+    };
+
+    //==============================================================================
+    const int size;
+    const Plan complexPlan, realPlan;
+    const AlignedBuffer realCoefficients, scratch;
+    std::vector<Complex<float>> laneTwiddles;
+    SpinLock processLock;
+};
+
+FFT::EngineImpl<SIMDFFT> simdFFT;
+#endif
+
 //==============================================================================
 //==============================================================================
 #if (JUCE_MAC || JUCE_IOS) && JUCE_USE_VDSP_FRAMEWORK
@@ -1059,6 +1790,34 @@ void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData, bool ign
         return;
 
     performRealOnlyForwardTransform (inputOutputData, ignoreNegativeFreqs);
+    convertToMagnitudes (inputOutputData, ignoreNegativeFreqs);
+}
+
+void FFT::performRealOnlyForwardTransform (float* const* inputOutputData, int numChannels, bool ignoreNegativeFreqs) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyForwardTransforms (inputOutputData, numChannels, ignoreNegativeFreqs);
+}
+
+void FFT::performRealOnlyInverseTransform (float* const* inputOutputData, int numChannels) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyInverseTransforms (inputOutputData, numChannels);
+}
+
+void FFT::performFrequencyOnlyForwardTransform (float* const* inputOutputData, int numChannels, bool ignoreNegativeFreqs) const noexcept
+{
+    if (size == 1)
+        return;
+
+    performRealOnlyForwardTransform (inputOutputData, numChannels, ignoreNegativeFreqs);
+
+    for (int i = 0; i < numChannels; ++i)
+        convertToMagnitudes (inputOutputData[i], ignoreNegativeFreqs);
+}
+
+void FFT::convertToMagnitudes (float* inputOutputData, bool ignoreNegativeFreqs) const noexcept
+{
     auto* out = reinterpret_cast<Complex<float>*> (inputOutputData);
 
     const auto limit = ignoreNegativeFreqs ? (size / 2) + 1 : size;
@@ -105,6 +105,31 @@ public:
     void performFrequencyOnlyForwardTransform (float* inputOutputData,
                                                bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
 
+    //==============================================================================
+    /** Performs in-place forward transforms on several blocks of real data.
+
+        This gives the same results as calling performRealOnlyForwardTransform() on
+        each channel in turn, but some engines can transform several channels at the
+        same time, which is faster. Each of the numChannels arrays must follow the same
+        rules as the array passed to the single-channel version.
+    */
+    void performRealOnlyForwardTransform (float* const* inputOutputData, int numChannels,
+                                          bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
+
+    /** Performs in-place inverse transforms on several blocks of data that were created
+        by performRealOnlyForwardTransform().
+
+        This gives the same results as calling performRealOnlyInverseTransform() on each
+        channel in turn, but some engines can transform several channels at the same time.
+    */
+    void performRealOnlyInverseTransform (float* const* inputOutputData, int numChannels) const noexcept;
+
+    /** Transforms several arrays into their magnitude frequency response spectra, in the
+        same way as the single-channel version of performFrequencyOnlyForwardTransform().
+    */
+    void performFrequencyOnlyForwardTransform (float* const* inputOutputData, int numChannels,
+                                               bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
+
     /** Returns the number of data points that this FFT was created to work with. */
     int getSize() const noexcept            { return size; }
 
@@ -119,6 +144,8 @@ private:
     //==============================================================================
     struct Engine;
 
+    void convertToMagnitudes (float*, bool) const noexcept;
+
     std::unique_ptr<Instance> engine;
     int size;
 
@@ -194,6 +194,122 @@ struct FFTUnitTest final : public UnitTest
         }
     };
 
+    struct BatchedTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (int order = 0; order <= 12; ++order)
+            {
+                const auto n = (size_t) 1 << order;
+                const auto tolerance = 1.0e-5f * std::sqrt ((float) n) * (float) (order + 1);
+                FFT fft (order);
+
+                for (auto numChannels : { 1, 2, 3, 5, 8, 9 })
+                {
+                    std::vector<std::vector<float>> input, batched, separate;
+                    std::vector<float*> batchedChannels;
+
+                    for (int ch = 0; ch < numChannels; ++ch)
+                    {
+                        input.emplace_back (n * 2, 0.0f);
+                        fillRandom (random, input.back().data(), n);
+                    }
+
+                    const auto isSimilar = [&] (size_t numToCheck)
+                    {
+                        for (int ch = 0; ch < numChannels; ++ch)
+                            for (size_t i = 0; i < numToCheck; ++i)
+                                if (std::abs (batched[(size_t) ch][i] - separate[(size_t) ch][i]) > tolerance)
+                                    return false;
+
+                        return true;
+                    };
+
+                    for (auto ignoreNegativeFreqs : { false, true })
+                    {
+                        batched = separate = input;
+                        batchedChannels.clear();
+
+                        for (auto& channel : batched)
+                            batchedChannels.push_back (channel.data());
+
+                        fft.performRealOnlyForwardTransform (batchedChannels.data(), numChannels, ignoreNegativeFreqs);
+
+                        for (auto& channel : separate)
+                            fft.performRealOnlyForwardTransform (channel.data(), ignoreNegativeFreqs);
+
+                        u.expect (isSimilar (ignoreNegativeFreqs ? (n / 2 + 1) * 2 : n * 2));
+                    }
+
+                    fft.performRealOnlyInverseTransform (batchedChannels.data(), numChannels);
+                    separate = input;
+                    u.expect (isSimilar (n));
+                }
+            }
+        }
+    };
+
+   #if JUCE_USE_SIMD
+    struct SIMDEngineTest
+    {
+        // The reference transforms are too slow for large sizes, so compare with the fallback engine
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (int order = 4; order <= 14; ++order)
+            {
+                const auto n = (size_t) 1 << order;
+                const std::unique_ptr<FFT::Instance> simd (SIMDFFT::create (order));
+                const FFTFallback fallback (order);
+
+                u.expect (simd != nullptr);
+
+                if (simd == nullptr)
+                    return;
+
+                // The errors grow with the size of the transform and its output
+                const auto tolerance = 1.0e-5f * std::sqrt ((float) n) * (float) order;
+
+                const auto isSimilar = [&] (const auto* a, const auto* b, size_t num)
+                {
+                    for (size_t i = 0; i < num; ++i)
+                        if (std::abs (a[i] - b[i]) > tolerance)
+                            return false;
+
+                    return true;
+                };
+
+                std::vector<Complex<float>> input (n), expected (n), actual (n);
+                fillRandom (random, input.data(), n);
+
+                for (auto inverse : { false, true })
+                {
+                    fallback.perform (input.data(), expected.data(), inverse);
+                    simd->perform (input.data(), actual.data(), inverse);
+                    u.expect (isSimilar (actual.data(), expected.data(), n));
+                }
+
+                std::vector<float> realInput (n * 2), realExpected (n * 2), realActual (n * 2);
+                fillRandom (random, realInput.data(), n);
+
+                for (auto ignoreNegativeFreqs : { false, true })
+                {
+                    realExpected = realActual = realInput;
+                    fallback.performRealOnlyForwardTransform (realExpected.data(), ignoreNegativeFreqs);
+                    simd->performRealOnlyForwardTransform (realActual.data(), ignoreNegativeFreqs);
+                    u.expect (isSimilar (realActual.data(), realExpected.data(), ignoreNegativeFreqs ? n + 2 : n * 2));
+                }
+
+                simd->performRealOnlyInverseTransform (realActual.data());
+                u.expect (checkArrayIsSimilar (realActual.data(), realInput.data(), n));
+            }
+        }
+    };
+   #endif
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -207,9 +323,165 @@ struct FFTUnitTest final : public UnitTest
         runTestForAllTypes<RealTest> ("Real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+        runTestForAllTypes<BatchedTest> ("Batched real input numbers Test");
+
+       #if JUCE_USE_SIMD
+        runTestForAllTypes<SIMDEngineTest> ("SIMD engine Test");
+       #endif
     }
 };
 
 static FFTUnitTest fftUnitTest;
 
+//==============================================================================
+struct FFTBenchmark final : public Benchmark
+{
+    FFTBenchmark()
+        : Benchmark ("FFT", UnitTestCategories::dsp)
+    {}
+
+    void runBenchmark() override
+    {
+        Random random (1);
+
+        for (auto order : { 6, 10, 14 })
+        {
+            FFT fft (order);
+            const auto size = (size_t) fft.getSize();
+            const auto sizeName = " (" + String ((int) size) + ")";
+
+            std::vector<Complex<float>> complexInput (size), complexOutput (size);
+            FFTUnitTest::fillRandom (random, complexInput.data(), size);
+
+            measure ("perform" + sizeName, [&]
+            {
+                fft.perform (complexInput.data(), complexOutput.data(), false);
+                doNotOptimise (complexOutput[0]);
+            }, (int64) size);
+
+            // The real-only transforms work in-place, so each call restores the input first
+            std::vector<float> realInput (size), realBuffer (size * 2);
+            FFTUnitTest::fillRandom (random, realInput.data(), size);
+
+            measure ("performRealOnlyForwardTransform" + sizeName, [&]
+            {
+                std::copy (realInput.begin(), realInput.end(), realBuffer.begin());
+                fft.performRealOnlyForwardTransform (realBuffer.data());
+                doNotOptimise (realBuffer[0]);
+            }, (int64) size);
+
+            measure ("performFrequencyOnlyForwardTransform" + sizeName, [&]
+            {
+                std::copy (realInput.begin(), realInput.end(), realBuffer.begin());
+                fft.performFrequencyOnlyForwardTransform (realBuffer.data());
+                doNotOptimise (realBuffer[0]);
+            }, (int64) size);
+
+            // Eight channels, transformed one at a time and then all at once
+            constexpr int numChannels = 8;
+            std::vector<std::vector<float>> channels (numChannels, std::vector<float> (size * 2));
+            std::vector<float*> channelPointers;
+
+            for (auto& channel : channels)
+                channelPointers.push_back (channel.data());
+
+            const auto restoreChannels = [&]
+            {
+                for (auto& channel : channels)
+                    std::copy (realInput.begin(), realInput.end(), channel.begin());
+            };
+
+            measure ("performRealOnlyForwardTransform, 8 separate channels" + sizeName, [&]
+            {
+                restoreChannels();
+
+                for (auto* channel : channelPointers)
+                    fft.performRealOnlyForwardTransform (channel, true);
+
+                doNotOptimise (channels[0][0]);
+            }, (int64) size * numChannels);
+
+            measure ("performRealOnlyForwardTransform, 8 batched channels" + sizeName, [&]
+            {
+                restoreChannels();
+                fft.performRealOnlyForwardTransform (channelPointers.data(), numChannels, true);
+                doNotOptimise (channels[0][0]);
+            }, (int64) size * numChannels);
+        }
+    }
+};
+
+static FFTBenchmark fftBenchmark;
+
+#if JUCE_USE_SIMD
+//==============================================================================
+struct FFTEngineBenchmark final : public Benchmark
+{
+    FFTEngineBenchmark()
+        : Benchmark ("FFT engines", UnitTestCategories::dsp)
+    {}
+
+    void runBenchmark() override
+    {
+        Random random (1);
+        StringArray table;
+
+        for (int order = 5; order <= 16; ++order)
+        {
+            const auto size = (size_t) 1 << order;
+            const std::unique_ptr<FFT::Instance> simd (SIMDFFT::create (order));
+            const FFTFallback fallback (order);
+
+            std::vector<Complex<float>> complexInput (size), complexOutput (size);
+            std::vector<float> realInput (size), realBuffer (size * 2);
+            FFTUnitTest::fillRandom (random, complexInput.data(), size);
+            FFTUnitTest::fillRandom (random, realInput.data(), size);
+
+            const auto measureEngine = [&] (const String& engineName, const FFT::Instance& engine)
+            {
+                const auto suffix = " (" + String ((int) size) + ", " + engineName + ")";
+
+                const auto complexTime = measure ("perform" + suffix, [&]
+                {
+                    engine.perform (complexInput.data(), complexOutput.data(), false);
+                    doNotOptimise (complexOutput[0]);
+                }, (int64) size);
+
+                const auto realTime = measure ("performRealOnlyForwardTransform" + suffix, [&]
+                {
+                    std::copy (realInput.begin(), realInput.end(), realBuffer.begin());
+                    engine.performRealOnlyForwardTransform (realBuffer.data(), true);
+                    engine.performRealOnlyInverseTransform (realBuffer.data());
+                    doNotOptimise (realBuffer[0]);
+                }, (int64) size);
+
+                return std::make_pair (complexTime, realTime);
+            };
+
+            const auto fallbackTimes = measureEngine ("fallback", fallback);
+            const auto simdTimes = measureEngine ("simd", *simd);
+
+            const auto formatTimes = [] (double fallbackTime, double simdTime)
+            {
+                return (String (fallbackTime, 1) + " / " + String (simdTime, 1)
+                          + " (" + String (fallbackTime / simdTime, 2) + "x)").paddedLeft (' ', 32);
+            };
+
+            table.add (String ((int) size).paddedLeft (' ', 6)
+                         + formatTimes (fallbackTimes.first, simdTimes.first)
+                         + formatTimes (fallbackTimes.second, simdTimes.second));
+        }
+
+        logMessage ("Fallback / SIMD engine times (ns)");
+        logMessage (String ("Size").paddedLeft (' ', 6) + String ("Complex").paddedLeft (' ', 32)
+                      + String ("Real forward + inverse").paddedLeft (' ', 32));
+
+        for (const auto& line : table)
+            logMessage (line);
+    }
+};
+
+static FFTEngineBenchmark fftEngineBenchmark;
+#endif
+
 } // namespace juce::dsp
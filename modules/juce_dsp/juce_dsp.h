@@ -255,6 +255,7 @@ namespace util
 #include "processors/juce_ProcessorDuplicator.h"
 #include "processors/juce_IIRFilter.h"
 #include "processors/juce_IIRFilter_Impl.h"
+#include "processors/juce_MultichannelIIRFilter.h"
 #include "processors/juce_FIRFilter.h"
 #include "processors/juce_StateVariableFilter.h"
 #include "processors/juce_FirstOrderTPTFilter.h"
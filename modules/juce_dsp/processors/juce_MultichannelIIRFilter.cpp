@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp::IIR
+{
+
+//==============================================================================
+template <typename SampleType>
+MultichannelFilter<SampleType>::MultichannelFilter (CoefficientsPtr coefficientsToUse)
+    : sections { std::move (coefficientsToUse) }
+{
+}
+
+template <typename SampleType>
+MultichannelFilter<SampleType>::MultichannelFilter (std::vector<CoefficientsPtr> sectionsToUse)
+    : sections (std::move (sectionsToUse))
+{
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultichannelFilter<SampleType>::prepare (const ProcessSpec& spec)
+{
+    numChannels = (size_t) spec.numChannels;
+
+    tile.resize (maxTileSize * maxGroupsPerPass);
+    silence.assign (maxTileSize, SampleType());
+    discarded.resize (maxTileSize);
+
+    reset();
+}
+
+template <typename SampleType>
+void MultichannelFilter<SampleType>::reset()
+{
+    const auto numGroups = (numChannels + numLanes - 1) / numLanes;
+
+    numStatesPerGroup = getNumStatesPerGroup();
+    state.assign (numGroups * numStatesPerGroup, Vec());
+}
+
+template <typename SampleType>
+size_t MultichannelFilter<SampleType>::getNumStatesPerGroup() const noexcept
+{
+    size_t total = 0;
+
+    for (auto& section : sections)
+    {
+        jassert (section != nullptr);
+        total += section->getFilterOrder();
+    }
+
+    return total;
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultichannelFilter<SampleType>::processInternal (const AudioBlock<const SampleType>& inputBlock,
+                                                      const AudioBlock<SampleType>& outputBlock,
+                                                      bool bypassed) noexcept
+{
+    jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+    jassert (inputBlock.getNumSamples() == outputBlock.getNumSamples());
+
+    // The filter needs to be prepared with at least as many channels as it processes
+    jassert (outputBlock.getNumChannels() <= numChannels);
+
+    // The orders of the sections have changed since the state was allocated, so it doesn't
+    // fit them any more. You need to call reset() after changing the sections! Until you
+    // do, the input is passed through unchanged and the state is left as it is.
+    if (getNumStatesPerGroup() != numStatesPerGroup)
+    {
+        jassertfalse;
+
+        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        {
+            const auto* source = inputBlock.getChannelPointer (channel);
+            auto* destination = outputBlock.getChannelPointer (channel);
+
+            if (source != destination)
+                FloatVectorOperations::copy (destination, source, (int) outputBlock.getNumSamples());
+        }
+
+        return;
+    }
+
+    const auto numBlockChannels = jmin (outputBlock.getNumChannels(), numChannels);
+    const auto numGroups = (numBlockChannels + numLanes - 1) / numLanes;
+
+    // Each section's recursion has to wait for the result of the previous sample, so
+    // filtering several groups together keeps the processor busy in the meantime
+    size_t group = 0;
+
+    for (; group + maxGroupsPerPass <= numGroups; group += maxGroupsPerPass)
+        processGroups<maxGroupsPerPass> (inputBlock, outputBlock, group, numBlockChannels, bypassed);
+
+    for (; group + 2 <= numGroups; group += 2)
+        processGroups<2> (inputBlock, outputBlock, group, numBlockChannels, bypassed);
+
+    for (; group < numGroups; ++group)
+        processGroups<1> (inputBlock, outputBlock, group, numBlockChannels, bypassed);
+
+    snapToZero();
+}
+
+template <typename SampleType>
+template <size_t numGroups>
+void MultichannelFilter<SampleType>::processGroups (const AudioBlock<const SampleType>& inputBlock,
+                                                    const AudioBlock<SampleType>& outputBlock,
+                                                    size_t firstGroup,
+                                                    size_t numBlockChannels,
+                                                    bool bypassed) noexcept
+{
+    constexpr auto numPassChannels = numGroups * numLanes;
+
+    const auto numSamples = outputBlock.getNumSamples();
+    auto* tileSamples = reinterpret_cast<SampleType*> (tile.data());
+
+    std::array<const SampleType*, numPassChannels> sources;
+    std::array<SampleType*, numPassChannels> destinations;
+
+    for (size_t start = 0; start < numSamples; start += maxTileSize)
+    {
+        const auto numTileSamples = jmin (maxTileSize, numSamples - start);
+
+        // Unused lanes in the last group filter silence, and their output is thrown away
+        for (size_t i = 0; i < numPassChannels; ++i)
+        {
+            const auto channel = firstGroup * numLanes + i;
+            const auto isUsed = channel < numBlockChannels;
+
+            sources[i]      = isUsed ? inputBlock.getChannelPointer (channel) + start : silence.data();
+            destinations[i] = isUsed ? outputBlock.getChannelPointer (channel) + start : discarded.data();
+        }
+
+        FloatVectorOperations::interleave (tileSamples, sources.data(), (int) numPassChannels, numTileSamples);
+
+        auto* sectionState = state.data() + firstGroup * numStatesPerGroup;
+
+        for (auto& section : sections)
+        {
+            const auto order = section->getFilterOrder();
+            processSection<numGroups> (tile.data(), numTileSamples, sectionState, numStatesPerGroup,
+                                       section->getRawCoefficients(), order);
+            sectionState += order;
+        }
+
+        if (! bypassed)
+            FloatVectorOperations::deinterleave (destinations.data(), tileSamples, (int) numPassChannels, numTileSamples);
+    }
+}
+
+template <typename SampleType>
+template <size_t numGroups>
+void MultichannelFilter<SampleType>::processSection (Vec* data, size_t numSamples, Vec* sectionState, size_t stateStride,
+                                                     const SampleType* coeffs, size_t order) noexcept
+{
+    // The samples of each group are interleaved, so data[i * numGroups + g] holds
+    // sample i of group g, and that group's state starts at sectionState[g * stateStride]
+    switch (order)
+    {
+        case 1:
+        {
+            auto b0 = coeffs[0];
+            auto b1 = coeffs[1];
+            auto a1 = coeffs[2];
+
+            std::array<Vec, numGroups> lv1;
+
+            for (size_t g = 0; g < numGroups; ++g)
+                lv1[g] = sectionState[g * stateStride];
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                for (size_t g = 0; g < numGroups; ++g)
+                {
+                    auto input = data[i * numGroups + g];
+                    auto output = (input * b0) + lv1[g];
+                    data[i * numGroups + g] = output;
+
+                    lv1[g] = (input * b1) - (output * a1);
+                }
+            }
+
+            for (size_t g = 0; g < numGroups; ++g)
+                sectionState[g * stateStride] = lv1[g];
+        }
+        break;
+
+        case 2:
+        {
+            auto b0 = coeffs[0];
+            auto b1 = coeffs[1];
+            auto b2 = coeffs[2];
+            auto a1 = coeffs[3];
+            auto a2 = coeffs[4];
+
+            std::array<Vec, numGroups> lv1, lv2;
+
+            for (size_t g = 0; g < numGroups; ++g)
+            {
+                lv1[g] = sectionState[g * stateStride];
+                lv2[g] = sectionState[g * stateStride + 1];
+            }
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                for (size_t g = 0; g < numGroups; ++g)
+                {
+                    auto input = data[i * numGroups + g];
+                    auto output = (input * b0) + lv1[g];
+                    data[i * numGroups + g] = output;
+
+                    lv1[g] = (input * b1) - (output * a1) + lv2[g];
+                    lv2[g] = (input * b2) - (output * a2);
+                }
+            }
+
+            for (size_t g = 0; g < numGroups; ++g)
+            {
+                sectionState[g * stateStride]     = lv1[g];
+                sectionState[g * stateStride + 1] = lv2[g];
+            }
+        }
+        break;
+
+        default:
+        {
+            for (size_t g = 0; g < numGroups; ++g)
+            {
+                auto* lv = sectionState + g * stateStride;
+
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    auto input = data[i * numGroups + g];
+                    auto output = (input * coeffs[0]) + lv[0];
+                    data[i * numGroups + g] = output;
+
+                    for (size_t j = 0; j < order - 1; ++j)
+                        lv[j] = (input * coeffs[j + 1]) - (output * coeffs[order + j + 1]) + lv[j + 1];
+
+                    lv[order - 1] = (input * coeffs[order]) - (output * coeffs[order * 2]);
+                }
+            }
+        }
+        break;
+    }
+}
+
+template <typename SampleType>
+void MultichannelFilter<SampleType>::snapToZero() noexcept
+{
+    auto* values = reinterpret_cast<SampleType*> (state.data());
+
+    for (size_t i = 0; i < state.size() * numLanes; ++i)
+        util::snapToZero (values[i]);
+}
+
+//==============================================================================
+template class MultichannelFilter<float>;
+template class MultichannelFilter<double>;
+
+} // namespace juce::dsp::IIR
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp::IIR
+{
+
+/**
+    A processing class that applies the same IIR filter, or chain of IIR filters,
+    to every channel of a multichannel signal.
+
+    Wrapping a Filter in a ProcessorDuplicator runs a separate filter for each
+    channel, one channel after the other. This class instead keeps the states of
+    neighbouring channels in the lanes of a SIMDRegister, so that each instruction
+    advances the filters of several channels at once: 4 float channels with SSE or
+    NEON, or 8 with AVX2. When JUCE_USE_SIMD is disabled, the channels are processed
+    one at a time. Either way, the output matches that of a separate Filter for each
+    channel. The benefit grows with the number of channels and sections: with fewer
+    channels than there are lanes, a ProcessorDuplicator can be just as fast.
+
+    The filter is made of one or more sections that are applied in series, which
+    is a convenient way to build something like a parametric EQ out of peak and
+    shelf filters:
+
+    @code
+    IIR::MultichannelFilter<float> eq ({ IIR::Coefficients<float>::makeLowShelf   (sampleRate, 100.0f,  0.7f, 2.0f),
+                                         IIR::Coefficients<float>::makePeakFilter (sampleRate, 1000.0f, 1.0f, 0.5f),
+                                         IIR::Coefficients<float>::makeHighShelf  (sampleRate, 8000.0f, 0.7f, 1.5f) });
+    eq.prepare (spec);
+    @endcode
+
+    Sections of any order can be used, but first and second order sections have
+    their own faster code paths.
+
+    @see Filter, ProcessorDuplicator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class MultichannelFilter
+{
+public:
+    //==============================================================================
+    /** A typedef for a ref-counted pointer to the coefficients object */
+    using CoefficientsPtr = typename Coefficients<SampleType>::Ptr;
+
+    //==============================================================================
+    /** Creates a filter with no sections, which passes its input through unchanged. */
+    MultichannelFilter() = default;
+
+    /** Creates a filter with a single section. */
+    explicit MultichannelFilter (CoefficientsPtr coefficientsToUse);
+
+    /** Creates a filter from a chain of sections, which are applied in order. */
+    explicit MultichannelFilter (std::vector<CoefficientsPtr> sectionsToUse);
+
+    //==============================================================================
+    /** The coefficients of each of the sections, in the order they're applied.
+
+        It's up to the caller to ensure that these are modified in a thread-safe way.
+        If you add or remove sections, or change the order of any of them, then you
+        must call reset afterwards. Until you do, the filter passes its input through
+        unchanged.
+    */
+    std::vector<CoefficientsPtr> sections;
+
+    //==============================================================================
+    /** Allocates the state for the number of channels in the spec, and resets it. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the filter's processing pipeline, ready to start a new stream of data.
+
+        This will allocate more memory if the orders of the sections have grown
+        since the last call to prepare or reset.
+    */
+    void reset();
+
+    //==============================================================================
+    /** Processes a block of samples. The number of channels must be no more than
+        the number that the filter was prepared with.
+
+        When the context is bypassed, the input is copied to the output, but the
+        filter's state is still updated, so that there's no discontinuity when the
+        bypass is turned off again.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same_v<typename ProcessContext::SampleType, SampleType>,
+                       "The sample-type of the filter must match the sample-type supplied to this process callback");
+
+        processInternal (context.getInputBlock(), context.getOutputBlock(), context.isBypassed);
+
+        if (context.isBypassed && context.usesSeparateInputAndOutputBlocks())
+            context.getOutputBlock().copyFrom (context.getInputBlock());
+    }
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vec = SIMDRegister<SampleType>;
+   #else
+    using Vec = SampleType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (Vec) / sizeof (SampleType);
+    static constexpr size_t maxGroupsPerPass = 4, maxTileSize = 128;
+
+    void processInternal (const AudioBlock<const SampleType>&, const AudioBlock<SampleType>&, bool) noexcept;
+
+    template <size_t numGroups>
+    void processGroups (const AudioBlock<const SampleType>&, const AudioBlock<SampleType>&, size_t, size_t, bool) noexcept;
+
+    template <size_t numGroups>
+    static void processSection (Vec*, size_t, Vec*, size_t, const SampleType*, size_t) noexcept;
+
+    size_t getNumStatesPerGroup() const noexcept;
+    void snapToZero() noexcept;
+
+    //==============================================================================
+    std::vector<Vec> state, tile;
+    std::vector<SampleType> silence, discarded;
+    size_t numChannels = 0, numStatesPerGroup = 0;
+
+    JUCE_LEAK_DETECTOR (MultichannelFilter)
+};
+
+} // namespace juce::dsp::IIR
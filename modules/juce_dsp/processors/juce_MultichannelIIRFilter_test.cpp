@@ -0,0 +1,313 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp::IIR
+{
+
+class MultichannelFilterTest final : public UnitTest
+{
+public:
+    MultichannelFilterTest()
+        : UnitTest ("IIR::MultichannelFilter", UnitTestCategories::dsp)
+    {}
+
+    template <typename SampleType>
+    static std::vector<typename Coefficients<SampleType>::Ptr> makeEQ (double sampleRate)
+    {
+        using Coeffs = Coefficients<SampleType>;
+
+        return { Coeffs::makeFirstOrderHighPass (sampleRate, (SampleType) 30),
+                 Coeffs::makeLowShelf   (sampleRate, (SampleType) 120,   (SampleType) 0.7, (SampleType) 1.8),
+                 Coeffs::makePeakFilter (sampleRate, (SampleType) 500,   (SampleType) 2.0, (SampleType) 0.4),
+                 Coeffs::makePeakFilter (sampleRate, (SampleType) 2500,  (SampleType) 1.0, (SampleType) 1.5),
+                 Coeffs::makeHighShelf  (sampleRate, (SampleType) 8000,  (SampleType) 0.7, (SampleType) 0.6),
+                 Coeffs::makeLowPass    (sampleRate, (SampleType) 18000) };
+    }
+
+    template <typename SampleType>
+    static AudioBuffer<SampleType> makeNoise (Random& random, int numChannels, int numSamples)
+    {
+        AudioBuffer<SampleType> buffer (numChannels, numSamples);
+
+        for (auto channel = 0; channel != numChannels; ++channel)
+            for (auto i = 0; i != numSamples; ++i)
+                buffer.setSample (channel, i, (SampleType) (random.nextFloat() * 2.0f - 1.0f));
+
+        return buffer;
+    }
+
+private:
+    // A separate Filter for each section of each channel, to compare against
+    template <typename SampleType>
+    struct ReferenceFilters
+    {
+        ReferenceFilters (const std::vector<typename Coefficients<SampleType>::Ptr>& sections, size_t numChannels)
+        {
+            for (size_t channel = 0; channel != numChannels; ++channel)
+            {
+                auto& chain = filters.emplace_back();
+
+                for (auto& section : sections)
+                    chain.emplace_back (section);
+            }
+        }
+
+        // When bypassed, the whole chain still runs, but its output is thrown away
+        void process (AudioBlock<SampleType> block, bool bypassed)
+        {
+            AudioBuffer<SampleType> filtered ((int) block.getNumChannels(), (int) block.getNumSamples());
+            AudioBlock<SampleType> filteredBlock (filtered);
+            filteredBlock.copyFrom (block);
+
+            for (size_t channel = 0; channel != block.getNumChannels(); ++channel)
+            {
+                auto channelBlock = filteredBlock.getSingleChannelBlock (channel);
+
+                for (auto& filter : filters[channel])
+                    filter.process (ProcessContextReplacing<SampleType> (channelBlock));
+            }
+
+            if (! bypassed)
+                block.copyFrom (filteredBlock);
+        }
+
+        std::vector<std::vector<Filter<SampleType>>> filters;
+    };
+
+    template <typename SampleType>
+    void expectBuffersMatch (const AudioBuffer<SampleType>& actual, const AudioBuffer<SampleType>& expected)
+    {
+        auto maxError = (SampleType) 0;
+
+        for (auto channel = 0; channel != expected.getNumChannels(); ++channel)
+            for (auto i = 0; i != expected.getNumSamples(); ++i)
+                maxError = jmax (maxError, std::abs (actual.getSample (channel, i) - expected.getSample (channel, i)));
+
+        expectLessOrEqual (maxError, (SampleType) 1.0e-5);
+    }
+
+    template <typename SampleType>
+    void checkMatchesReference (Random& random,
+                                const std::vector<typename Coefficients<SampleType>::Ptr>& sections,
+                                int numChannels,
+                                bool replacing)
+    {
+        constexpr auto numSamples = 3000;
+        const auto input = makeNoise<SampleType> (random, numChannels, numSamples);
+
+        MultichannelFilter<SampleType> filter (sections);
+        filter.prepare ({ 48000.0, (uint32) numSamples, (uint32) numChannels });
+        ReferenceFilters<SampleType> reference (sections, (size_t) numChannels);
+
+        AudioBuffer<SampleType> actual (numChannels, numSamples), expected (input);
+
+        if (replacing)
+            actual.makeCopyOf (input);
+
+        // Irregular block sizes, some of them longer than the internal tile size, and
+        // with a bypassed block in the middle
+        for (int start = 0, blockIndex = 0; start < numSamples; ++blockIndex)
+        {
+            const auto blockSize = jmin (numSamples - start, random.nextInt ({ 1, 400 }));
+            const auto bypassed = blockIndex == 3;
+
+            auto actualBlock = AudioBlock<SampleType> (actual).getSubBlock ((size_t) start, (size_t) blockSize);
+
+            if (replacing)
+            {
+                ProcessContextReplacing<SampleType> context (actualBlock);
+                context.isBypassed = bypassed;
+                filter.process (context);
+            }
+            else
+            {
+                const auto inputBlock = AudioBlock<const SampleType> (input).getSubBlock ((size_t) start, (size_t) blockSize);
+                ProcessContextNonReplacing<SampleType> context (inputBlock, actualBlock);
+                context.isBypassed = bypassed;
+                filter.process (context);
+            }
+
+            reference.process (AudioBlock<SampleType> (expected).getSubBlock ((size_t) start, (size_t) blockSize), bypassed);
+            start += blockSize;
+        }
+
+        expectBuffersMatch (actual, expected);
+    }
+
+    template <typename SampleType>
+    void runTestsForType (Random& random)
+    {
+        using Coeffs = Coefficients<SampleType>;
+
+        beginTest ("A single section matches a Filter on every channel");
+        {
+            for (auto numChannels = 1; numChannels <= 17; ++numChannels)
+                checkMatchesReference<SampleType> (random, { Coeffs::makeLowPass (48000.0, (SampleType) 1000) }, numChannels, true);
+        }
+
+        beginTest ("Chains of sections match chained Filters");
+        {
+            for (auto numChannels : { 1, 2, 5, 8, 12 })
+                checkMatchesReference<SampleType> (random, makeEQ<SampleType> (48000.0), numChannels, true);
+        }
+
+        beginTest ("Sections of higher order match a Filter");
+        {
+            const typename Coeffs::Ptr thirdOrder = new Coeffs ((SampleType) 0.1, (SampleType) 0.2, (SampleType) 0.2, (SampleType) 0.1,
+                                                (SampleType) 1.0, (SampleType) -0.5, (SampleType) 0.25, (SampleType) -0.05);
+
+            for (auto numChannels : { 3, 6 })
+                checkMatchesReference<SampleType> (random, { thirdOrder, Coeffs::makeHighPass (48000.0, (SampleType) 200) }, numChannels, true);
+        }
+
+        beginTest ("Non-replacing contexts match a Filter");
+        {
+            for (auto numChannels : { 1, 4, 7 })
+                checkMatchesReference<SampleType> (random, makeEQ<SampleType> (48000.0), numChannels, false);
+        }
+
+        beginTest ("A filter with no sections passes its input through");
+        {
+            const auto input = makeNoise<SampleType> (random, 3, 256);
+            auto output = input;
+
+            MultichannelFilter<SampleType> filter;
+            filter.prepare ({ 48000.0, 256, 3 });
+
+            AudioBlock<SampleType> block (output);
+            filter.process (ProcessContextReplacing<SampleType> (block));
+
+            expectBuffersMatch (output, input);
+        }
+
+        beginTest ("Adding sections after preparing resizes the state");
+        {
+            MultichannelFilter<SampleType> filter (Coeffs::makeLowPass (48000.0, (SampleType) 1000));
+            filter.prepare ({ 48000.0, 256, 5 });
+
+            const auto sections = makeEQ<SampleType> (48000.0);
+            filter.sections = sections;
+            filter.reset();
+
+            ReferenceFilters<SampleType> reference (sections, 5);
+
+            auto actual = makeNoise<SampleType> (random, 5, 256);
+            auto expected = actual;
+
+            AudioBlock<SampleType> actualBlock (actual);
+            filter.process (ProcessContextReplacing<SampleType> (actualBlock));
+            reference.process (AudioBlock<SampleType> (expected), false);
+
+            expectBuffersMatch (actual, expected);
+        }
+    }
+
+public:
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        runTestsForType<float>  (random);
+        runTestsForType<double> (random);
+    }
+};
+
+static MultichannelFilterTest multichannelFilterTest;
+
+//==============================================================================
+class MultichannelFilterBenchmark final : public Benchmark
+{
+public:
+    MultichannelFilterBenchmark()
+        : Benchmark ("IIR::MultichannelFilter", UnitTestCategories::dsp)
+    {}
+
+    void runBenchmark() override
+    {
+        constexpr auto sampleRate = 48000.0;
+        constexpr auto blockSize = 512;
+
+        using Duplicator = ProcessorDuplicator<Filter<float>, Coefficients<float>>;
+
+        const auto single = Coefficients<float>::makeLowPass (sampleRate, 1000.0f);
+        const auto eq = MultichannelFilterTest::makeEQ<float> (sampleRate);
+        const auto eqName = String ((int) eq.size()) + " section EQ";
+
+        Random random (1);
+
+        for (auto numChannels : { 2, 8, 16 })
+        {
+            const ProcessSpec spec { sampleRate, (uint32) blockSize, (uint32) numChannels };
+            const auto caseSuffix = " (" + String (numChannels) + " channels)";
+            const auto numItems = blockSize * numChannels;
+
+            // Every call filters the same input, so that the level can't drift towards
+            // denormals or infinity over the course of the run
+            const auto input = MultichannelFilterTest::makeNoise<float> (random, numChannels, blockSize);
+            AudioBuffer<float> output (numChannels, blockSize);
+
+            const AudioBlock<const float> inputBlock (input);
+            AudioBlock<float> outputBlock (output);
+
+            const auto runDuplicators = [&] (std::vector<Duplicator>& duplicators)
+            {
+                outputBlock.copyFrom (inputBlock);
+
+                for (auto& duplicator : duplicators)
+                    duplicator.process (ProcessContextReplacing<float> (outputBlock));
+
+                doNotOptimise (output.getSample (0, 0));
+            };
+
+            const auto runFilter = [&] (MultichannelFilter<float>& filter)
+            {
+                filter.process (ProcessContextNonReplacing<float> (inputBlock, outputBlock));
+                doNotOptimise (output.getSample (0, 0));
+            };
+
+            std::vector<Duplicator> singleDuplicator, eqDuplicators;
+            singleDuplicator.emplace_back (single);
+
+            for (auto& section : eq)
+                eqDuplicators.emplace_back (section);
+
+            for (auto& duplicator : singleDuplicator)  duplicator.prepare (spec);
+            for (auto& duplicator : eqDuplicators)     duplicator.prepare (spec);
+
+            MultichannelFilter<float> singleFilter (single), eqFilter (eq);
+            singleFilter.prepare (spec);
+            eqFilter.prepare (spec);
+
+            measure ("ProcessorDuplicator, one biquad" + caseSuffix,   [&] { runDuplicators (singleDuplicator); }, numItems);
+            measure ("MultichannelFilter, one biquad" + caseSuffix,    [&] { runFilter (singleFilter); },          numItems);
+            measure ("ProcessorDuplicators, " + eqName + caseSuffix,   [&] { runDuplicators (eqDuplicators); },    numItems);
+            measure ("MultichannelFilter, " + eqName + caseSuffix,     [&] { runFilter (eqFilter); },              numItems);
+        }
+    }
+};
+
+static MultichannelFilterBenchmark multichannelFilterBenchmark;
+
+} // namespace juce::dsp::IIR
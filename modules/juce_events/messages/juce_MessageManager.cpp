@@ -70,6 +70,8 @@ bool MessageManager::MessageBase::post()
 {
     auto* mm = MessageManager::instance;
 
+    JUCE_TRACE_FLOW_BEGIN ("messages", "Message", (pointer_sized_int) this);
+
     if (mm == nullptr || mm->quitMessagePosted.get() != 0 || ! postMessageToSystemQueue (this))
     {
         Ptr deleter (this); // (this will delete messages that were just created with a 0 ref count)
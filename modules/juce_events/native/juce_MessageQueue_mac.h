@@ -74,6 +74,9 @@ private:
         if (nextMessage == nullptr)
             return false;
 
+        JUCE_TRACE_SCOPE ("messages", "Message");
+        JUCE_TRACE_FLOW_END ("messages", "Message", (pointer_sized_int) nextMessage.get());
+
         JUCE_AUTORELEASEPOOL
         {
             JUCE_TRY
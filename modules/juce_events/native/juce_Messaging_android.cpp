@@ -101,6 +101,9 @@ private:
             if (message == nullptr)
                 break;
 
+            JUCE_TRACE_SCOPE ("messages", "Message");
+            JUCE_TRACE_FLOW_END ("messages", "Message", (pointer_sized_int) message.get());
+
             message->messageCallback();
         }
     }
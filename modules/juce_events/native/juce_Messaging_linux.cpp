@@ -37,6 +37,9 @@ public:
                                             {
                                                 while (auto msg = popNextMessage (fd))
                                                 {
+                                                    JUCE_TRACE_SCOPE ("messages", "Message");
+                                                    JUCE_TRACE_FLOW_END ("messages", "Message", (pointer_sized_int) msg.get());
+
                                                     JUCE_TRY
                                                     {
                                                         msg->messageCallback();
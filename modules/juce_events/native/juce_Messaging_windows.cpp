@@ -186,6 +186,9 @@ private:
 
     static void dispatchMessage (MessageManager::MessageBase* message)
     {
+        JUCE_TRACE_SCOPE ("messages", "Message");
+        JUCE_TRACE_FLOW_END ("messages", "Message", (pointer_sized_int) message);
+
         JUCE_TRY
         {
             message->messageCallback();
@@ -134,6 +134,8 @@ public:
 
     void callTimers()
     {
+        JUCE_TRACE_SCOPE ("timers", "callTimers");
+
         auto timeout = Time::getMillisecondCounter() + 100;
 
         const LockType::ScopedLockType sl (lock);
@@ -154,6 +156,7 @@ public:
 
             JUCE_TRY
             {
+                JUCE_TRACE_SCOPE ("timers", "Timer::timerCallback");
                 timer->timerCallback();
             }
             JUCE_CATCH_EXCEPTION
@@ -41,4 +41,57 @@ LowLevelGraphicsSoftwareRenderer::LowLevelGraphicsSoftwareRenderer (const Image&
 
 LowLevelGraphicsSoftwareRenderer::~LowLevelGraphicsSoftwareRenderer() {}
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SoftwareRendererBenchmark final : public Benchmark
+{
+public:
+    SoftwareRendererBenchmark()
+        : Benchmark ("Software renderer", UnitTestCategories::graphics)
+    {}
+
+    void runBenchmark() override
+    {
+        constexpr int size = 512;
+
+        Image image (Image::ARGB, size, size, true, SoftwareImageType());
+        Graphics g (image);
+
+        Image sprite (Image::ARGB, 64, 64, true, SoftwareImageType());
+        Graphics (sprite).fillEllipse (sprite.getBounds().toFloat());
+
+        Path star;
+        star.addStar ({ size * 0.5f, size * 0.5f }, 12, size * 0.2f, size * 0.45f);
+
+        const ColourGradient gradient (Colours::red, 0.0f, 0.0f, Colours::blue, (float) size, (float) size, false);
+        const auto area = image.getBounds().reduced (size / 8);
+
+        measure ("fillRect (opaque)",       [&] { g.setColour (Colours::black);                  g.fillRect (area); }, area.getWidth() * area.getHeight());
+        measure ("fillRect (transparent)",  [&] { g.setColour (Colours::white.withAlpha (0.5f)); g.fillRect (area); }, area.getWidth() * area.getHeight());
+        measure ("fillRect (gradient)",     [&] { g.setGradientFill (gradient);                  g.fillRect (area); }, area.getWidth() * area.getHeight());
+        measure ("fillPath",                [&] { g.setColour (Colours::green);                  g.fillPath (star); });
+        measure ("strokePath",              [&] { g.setColour (Colours::yellow);                 g.strokePath (star, PathStrokeType (3.0f)); });
+
+        measure ("drawImage (scaled)",      [&]
+        {
+            g.setOpacity (1.0f);
+            g.drawImage (sprite, area.toFloat());
+        }, area.getWidth() * area.getHeight());
+
+        measure ("drawText",                [&]
+        {
+            g.setColour (Colours::white);
+            g.setFont (16.0f);
+            g.drawText ("The quick brown fox jumps over the lazy dog", area, Justification::centred);
+        });
+    }
+};
+
+static SoftwareRendererBenchmark softwareRendererBenchmark;
+
+#endif
+
 } // namespace juce